@@ -11,6 +11,7 @@ CC=gcc
 AR=ar
 
 # Folders
+FOLDER_BENCH=$(ROOT_PATH)/bench
 FOLDER_BIN=$(ROOT_PATH)/bin
 FOLDER_BUILD=$(ROOT_PATH)/build
 FOLDER_DATASETS=$(ROOT_PATH)/datasets
@@ -0,0 +1,531 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_bench.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Throughput benchmarks (parsers, printers, realignment kernels and GTF search)
+ *   Inputs are synthetically scaled from the files in GEMTools/datasets up to the requested
+ *   size (and cached in the data folder). Results are reported as a JSON document with
+ *   records/second and bytes/second per benchmark (best and median of all repetitions).
+ */
+
+#include <getopt.h>
+#include <sys/stat.h>
+
+#include "gem_tools.h"
+
+#define GT_BENCH_MAP_DATASET   "gem.new.PE.Illumina.Dall.map"
+#define GT_BENCH_SAM_DATASET   "Bowtie.PE.sam"
+#define GT_BENCH_MAX_REPEAT    100
+#define GT_BENCH_READ_LENGTH   100
+#define GT_BENCH_NUM_PAIRS     1024   /* Realignment {pattern,sequence} pool */
+#define GT_BENCH_GTF_CONTIGS   24
+#define GT_BENCH_GTF_GENES     2000   /* Genes per contig */
+#define GT_BENCH_GTF_SPACING   25000  /* Distance between genes */
+#define GT_BENCH_PRINT_FLUSH   (1<<20)
+
+typedef struct {
+  char* name_datasets_folder;
+  char* name_data_folder;
+  char* name_output_file;
+  char* filter;
+  uint64_t size;   // Bytes of input/output processed by the I/O benchmarks
+  uint64_t repeat;
+} gt_bench_args;
+
+gt_bench_args parameters = {
+    .name_datasets_folder="../datasets",
+    .name_data_folder="./data",
+    .name_output_file=NULL,
+    .filter=NULL,
+    .size=1024ull<<20,
+    .repeat=3,
+};
+
+/*
+ * Benchmark runs
+ */
+typedef struct {
+  uint64_t records;
+  uint64_t bytes;
+  double seconds;
+} gt_bench_run;
+typedef void (*gt_bench_fx)(gt_bench_run* const run);
+typedef struct {
+  char* name;
+  char* input;
+  gt_bench_fx bench_fx;
+} gt_bench;
+
+GT_INLINE double gt_bench_get_time() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (double)now.tv_sec + (double)now.tv_nsec/1E9;
+}
+GT_INLINE uint64_t gt_bench_rand(uint64_t* const state) {
+  *state ^= *state << 13; // xorshift64 (reproducible across platforms)
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+GT_INLINE uint64_t gt_bench_get_file_size(char* const file_name) {
+  struct stat file_stat;
+  return (stat(file_name,&file_stat)==0) ? file_stat.st_size : 0;
+}
+GT_INLINE char* gt_bench_get_data_file(char* const name) {
+  char* file_name;
+  gt_cond_fatal_error(asprintf(&file_name,"%s/%s.%"PRIu64"MB",
+      parameters.name_data_folder,name,parameters.size>>20)<0,MEM_HANDLER);
+  return file_name;
+}
+
+/*
+ * Scaled inputs
+ *   The body of @seed is replicated until the file reaches @parameters.size
+ *   (header lines, starting with @header_prefix, are written only once)
+ */
+GT_INLINE void gt_bench_load_file(char* const file_name,gt_string* const content) {
+  FILE* const file = fopen(file_name,"r");
+  gt_cond_fatal_error(file==NULL,FILE_OPEN,file_name);
+  char buffer[1<<16];
+  size_t chars_read;
+  gt_string_clear(content);
+  while ((chars_read=fread(buffer,1,sizeof(buffer),file))>0) {
+    gt_string_right_append_string(content,buffer,chars_read);
+  }
+  fclose(file);
+}
+GT_INLINE void gt_bench_scale(gt_string* const seed,const char header_prefix,char* const file_name) {
+  if (gt_bench_get_file_size(file_name)>=parameters.size) return; // Cached
+  char* const seed_buffer = gt_string_get_string(seed);
+  const uint64_t seed_length = gt_string_get_length(seed);
+  uint64_t header_length = 0;
+  while (header_prefix!=0 && header_length<seed_length && seed_buffer[header_length]==header_prefix) {
+    char* const eol = memchr(seed_buffer+header_length,'\n',seed_length-header_length);
+    header_length = (eol==NULL) ? seed_length : (eol-seed_buffer)+1;
+  }
+  gt_cond_fatal_error_msg(header_length==seed_length,"Empty seed for '%s'",file_name);
+  FILE* const file = fopen(file_name,"w");
+  gt_cond_fatal_error(file==NULL,FILE_OPEN,file_name);
+  uint64_t total_length = fwrite(seed_buffer,1,header_length,file);
+  while (total_length<parameters.size) {
+    total_length += fwrite(seed_buffer+header_length,1,seed_length-header_length,file);
+  }
+  gt_cond_fatal_error(fclose(file)!=0,FILE_WRITE,file_name);
+}
+GT_INLINE char* gt_bench_scale_dataset(char* const dataset,const char header_prefix) {
+  char* const file_name = gt_bench_get_data_file(dataset);
+  char* source_file_name;
+  gt_cond_fatal_error(asprintf(&source_file_name,"%s/%s",parameters.name_datasets_folder,dataset)<0,MEM_HANDLER);
+  gt_string* const seed = gt_string_new(1<<20);
+  gt_bench_load_file(source_file_name,seed);
+  gt_bench_scale(seed,header_prefix,file_name);
+  gt_string_delete(seed);
+  free(source_file_name);
+  return file_name;
+}
+
+/*
+ * Dataset templates (Input for the printers)
+ */
+GT_INLINE gt_vector* gt_bench_load_templates(void) {
+  char* file_name;
+  gt_cond_fatal_error(asprintf(&file_name,"%s/%s",parameters.name_datasets_folder,GT_BENCH_MAP_DATASET)<0,MEM_HANDLER);
+  gt_input_file* const input_file = gt_input_file_open(file_name,false);
+  gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+  gt_vector* const templates = gt_vector_new(1000,sizeof(gt_template*));
+  gt_template* template = gt_template_new();
+  gt_status error_code;
+  while ((error_code=gt_input_map_parser_get_template(buffered_input,template,NULL))) {
+    if (error_code!=GT_IMP_OK) continue;
+    gt_vector_insert(templates,template,gt_template*);
+    template = gt_template_new();
+  }
+  gt_template_delete(template);
+  gt_buffered_input_file_close(buffered_input);
+  gt_input_file_close(input_file);
+  free(file_name);
+  return templates;
+}
+GT_INLINE void gt_bench_delete_templates(gt_vector* const templates) {
+  GT_VECTOR_ITERATE(templates,template,template_pos,gt_template*) {
+    gt_template_delete(*template);
+  }
+  gt_vector_delete(templates);
+}
+
+/*
+ * Parsers
+ */
+void gt_bench_parse_map(gt_bench_run* const run) {
+  char* const file_name = gt_bench_scale_dataset(GT_BENCH_MAP_DATASET,0);
+  const double start_time = gt_bench_get_time();
+  gt_input_file* const input_file = gt_input_file_open(file_name,false);
+  gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+  gt_template* const template = gt_template_new();
+  gt_status error_code;
+  while ((error_code=gt_input_map_parser_get_template(buffered_input,template,NULL))) {
+    if (error_code==GT_IMP_OK) ++(run->records);
+  }
+  gt_template_delete(template);
+  gt_buffered_input_file_close(buffered_input);
+  gt_input_file_close(input_file);
+  run->seconds = gt_bench_get_time()-start_time;
+  run->bytes = gt_bench_get_file_size(file_name);
+  free(file_name);
+}
+void gt_bench_parse_sam(gt_bench_run* const run) {
+  char* const file_name = gt_bench_scale_dataset(GT_BENCH_SAM_DATASET,GT_SAM_HEADER_BEGIN);
+  const double start_time = gt_bench_get_time();
+  gt_input_file* const input_file = gt_input_file_open(file_name,false);
+  gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+  gt_sam_parser_attributes* const sam_parser_attr = gt_input_sam_parser_attributes_new();
+  gt_template* const template = gt_template_new();
+  gt_status error_code;
+  while ((error_code=gt_input_sam_parser_get_template(buffered_input,template,sam_parser_attr))) {
+    if (error_code==GT_ISP_OK) ++(run->records);
+  }
+  gt_template_delete(template);
+  gt_input_sam_parser_attributes_delete(sam_parser_attr);
+  gt_buffered_input_file_close(buffered_input);
+  gt_input_file_close(input_file);
+  run->seconds = gt_bench_get_time()-start_time;
+  run->bytes = gt_bench_get_file_size(file_name);
+  free(file_name);
+}
+void gt_bench_parse_fastq(gt_bench_run* const run) {
+  // FASTQ seed (the reads of the MAP dataset)
+  char* const file_name = gt_bench_get_data_file("reads.fastq");
+  if (gt_bench_get_file_size(file_name)<parameters.size) {
+    gt_vector* const templates = gt_bench_load_templates();
+    gt_generic_printer_attributes* const printer_attr = gt_generic_printer_attributes_new(FASTA);
+    gt_string* const seed = gt_string_new(1<<20);
+    GT_VECTOR_ITERATE(templates,template,template_pos,gt_template*) {
+      gt_output_generic_sprint_template(seed,*template,printer_attr);
+    }
+    gt_bench_scale(seed,0,file_name);
+    gt_string_delete(seed);
+    gt_generic_printer_attributes_delete(printer_attr);
+    gt_bench_delete_templates(templates);
+  }
+  // Parse
+  const double start_time = gt_bench_get_time();
+  gt_input_file* const input_file = gt_input_file_open(file_name,false);
+  gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+  gt_alignment* const alignment = gt_alignment_new();
+  gt_status error_code;
+  while ((error_code=gt_input_fasta_parser_get_alignment(buffered_input,alignment))) {
+    if (error_code==GT_IFP_OK) ++(run->records);
+  }
+  gt_alignment_delete(alignment);
+  gt_buffered_input_file_close(buffered_input);
+  gt_input_file_close(input_file);
+  run->seconds = gt_bench_get_time()-start_time;
+  run->bytes = gt_bench_get_file_size(file_name);
+  free(file_name);
+}
+
+/*
+ * Printers (into memory, flushed every GT_BENCH_PRINT_FLUSH bytes)
+ */
+GT_INLINE void gt_bench_print(gt_bench_run* const run,const gt_file_format file_format) {
+  gt_vector* const templates = gt_bench_load_templates();
+  gt_generic_printer_attributes* const printer_attr = gt_generic_printer_attributes_new(file_format);
+  gt_string* const output = gt_string_new(2*GT_BENCH_PRINT_FLUSH);
+  const uint64_t num_templates = gt_vector_get_used(templates);
+  gt_template** const template = gt_vector_get_mem(templates,gt_template*);
+  const double start_time = gt_bench_get_time();
+  uint64_t i = 0;
+  while (run->bytes<parameters.size) {
+    gt_output_generic_sprint_template(output,template[i],printer_attr);
+    ++(run->records);
+    if (++i==num_templates) i = 0;
+    if (gt_string_get_length(output)>=GT_BENCH_PRINT_FLUSH) {
+      run->bytes += gt_string_get_length(output);
+      gt_string_clear(output);
+    }
+  }
+  run->seconds = gt_bench_get_time()-start_time;
+  gt_string_delete(output);
+  gt_generic_printer_attributes_delete(printer_attr);
+  gt_bench_delete_templates(templates);
+}
+void gt_bench_print_map(gt_bench_run* const run) { gt_bench_print(run,MAP); }
+void gt_bench_print_sam(gt_bench_run* const run) { gt_bench_print(run,SAM); }
+void gt_bench_print_fastq(gt_bench_run* const run) { gt_bench_print(run,FASTA); }
+
+/*
+ * Realignment kernels
+ *   Synthetic {pattern,sequence} pairs (~2% mismatches, plus an indel in 1/4
+ *   of the pairs for Levenshtein). Hamming aligns @parameters.size bases, while
+ *   Levenshtein (quadratic) aligns one pair per 4KB of @parameters.size
+ */
+typedef struct {
+  char pattern[GT_BENCH_READ_LENGTH+1];
+  char sequence[GT_BENCH_READ_LENGTH+2];
+  uint64_t sequence_length;
+} gt_bench_pair;
+GT_INLINE gt_bench_pair* gt_bench_generate_pairs(const bool indels) {
+  gt_bench_pair* const pairs = gt_calloc(GT_BENCH_NUM_PAIRS,gt_bench_pair,true);
+  uint64_t state = 88172645463325252ull, i, j;
+  for (i=0;i<GT_BENCH_NUM_PAIRS;++i) {
+    gt_bench_pair* const pair = pairs+i;
+    for (j=0;j<GT_BENCH_READ_LENGTH;++j) {
+      pair->sequence[j] = "ACGT"[gt_bench_rand(&state)%4];
+      pair->pattern[j] = (gt_bench_rand(&state)%50==0) ? "ACGT"[gt_bench_rand(&state)%4] : pair->sequence[j];
+    }
+    pair->sequence_length = GT_BENCH_READ_LENGTH;
+    if (indels && gt_bench_rand(&state)%4==0) { // Insertion in the sequence
+      const uint64_t position = gt_bench_rand(&state)%GT_BENCH_READ_LENGTH;
+      memmove(pair->sequence+position+1,pair->sequence+position,GT_BENCH_READ_LENGTH-position);
+      pair->sequence[position] = 'A';
+      pair->sequence_length = GT_BENCH_READ_LENGTH+1;
+    }
+  }
+  return pairs;
+}
+GT_INLINE uint64_t gt_bench_get_num_alignments(const uint64_t bytes_per_alignment) {
+  return GT_MAX(parameters.size/bytes_per_alignment,GT_BENCH_NUM_PAIRS);
+}
+void gt_bench_realign_hamming(gt_bench_run* const run) {
+  gt_bench_pair* const pairs = gt_bench_generate_pairs(false);
+  gt_map* const map = gt_map_new();
+  const uint64_t num_alignments = gt_bench_get_num_alignments(GT_BENCH_READ_LENGTH);
+  const double start_time = gt_bench_get_time();
+  uint64_t i;
+  for (i=0;i<num_alignments;++i) {
+    gt_bench_pair* const pair = pairs+(i%GT_BENCH_NUM_PAIRS);
+    gt_map_block_realign_hamming(map,pair->pattern,pair->sequence,GT_BENCH_READ_LENGTH);
+  }
+  run->seconds = gt_bench_get_time()-start_time;
+  run->records = num_alignments;
+  run->bytes = num_alignments*GT_BENCH_READ_LENGTH;
+  gt_map_delete(map);
+  gt_free(pairs);
+}
+void gt_bench_realign_levenshtein(gt_bench_run* const run) {
+  gt_bench_pair* const pairs = gt_bench_generate_pairs(true);
+  gt_map* const map = gt_map_new();
+  const uint64_t num_alignments = gt_bench_get_num_alignments(1<<12);
+  const double start_time = gt_bench_get_time();
+  uint64_t i;
+  for (i=0;i<num_alignments;++i) {
+    gt_bench_pair* const pair = pairs+(i%GT_BENCH_NUM_PAIRS);
+    gt_map_block_realign_levenshtein(map,pair->pattern,GT_BENCH_READ_LENGTH,pair->sequence,pair->sequence_length,false);
+  }
+  run->seconds = gt_bench_get_time()-start_time;
+  run->records = num_alignments;
+  run->bytes = num_alignments*GT_BENCH_READ_LENGTH;
+  gt_map_delete(map);
+  gt_free(pairs);
+}
+
+/*
+ * GTF
+ *   Synthetic annotation (gene, transcript and 3 exons per gene)
+ */
+GT_INLINE char* gt_bench_generate_gtf(void) {
+  char* file_name;
+  gt_cond_fatal_error(asprintf(&file_name,"%s/annotation.gtf",parameters.name_data_folder)<0,MEM_HANDLER);
+  if (gt_bench_get_file_size(file_name)>0) return file_name; // Cached
+  FILE* const file = fopen(file_name,"w");
+  gt_cond_fatal_error(file==NULL,FILE_OPEN,file_name);
+  uint64_t contig, gene, exon;
+  for (contig=1;contig<=GT_BENCH_GTF_CONTIGS;++contig) {
+    for (gene=0;gene<GT_BENCH_GTF_GENES;++gene) {
+      const uint64_t start = 1+gene*GT_BENCH_GTF_SPACING;
+      const uint64_t end = start+GT_BENCH_GTF_SPACING/2;
+      const char strand = (gene%2) ? '-' : '+';
+      char attributes[128];
+      sprintf(attributes,"gene_id \"G%"PRIu64".%"PRIu64"\"; transcript_id \"T%"PRIu64".%"PRIu64"\"; gene_type \"protein_coding\";",
+          contig,gene,contig,gene);
+      fprintf(file,"chr%"PRIu64"\tbench\tgene\t%"PRIu64"\t%"PRIu64"\t.\t%c\t.\t%s\n",contig,start,end,strand,attributes);
+      fprintf(file,"chr%"PRIu64"\tbench\ttranscript\t%"PRIu64"\t%"PRIu64"\t.\t%c\t.\t%s\n",contig,start,end,strand,attributes);
+      for (exon=0;exon<3;++exon) {
+        const uint64_t exon_start = start+exon*(GT_BENCH_GTF_SPACING/6);
+        fprintf(file,"chr%"PRIu64"\tbench\texon\t%"PRIu64"\t%"PRIu64"\t.\t%c\t.\t%s\n",
+            contig,exon_start,exon_start+GT_BENCH_GTF_SPACING/12,strand,attributes);
+      }
+    }
+  }
+  gt_cond_fatal_error(fclose(file)!=0,FILE_WRITE,file_name);
+  return file_name;
+}
+void gt_bench_gtf_read(gt_bench_run* const run) {
+  char* const file_name = gt_bench_generate_gtf();
+  const double start_time = gt_bench_get_time();
+  gt_gtf* const gtf = gt_gtf_read_from_file(file_name,1);
+  run->seconds = gt_bench_get_time()-start_time;
+  run->records = GT_BENCH_GTF_CONTIGS*GT_BENCH_GTF_GENES*5;
+  run->bytes = gt_bench_get_file_size(file_name);
+  gt_gtf_delete(gtf);
+  free(file_name);
+}
+void gt_bench_gtf_search(gt_bench_run* const run) {
+  char* const file_name = gt_bench_generate_gtf();
+  gt_gtf* const gtf = gt_gtf_read_from_file(file_name,1);
+  // Random queries (~read-sized)
+  const uint64_t num_queries = GT_MAX(parameters.size>>10,1000);
+  char contig_names[GT_BENCH_GTF_CONTIGS][8];
+  uint64_t i, state = 2463534242ull;
+  for (i=0;i<GT_BENCH_GTF_CONTIGS;++i) sprintf(contig_names[i],"chr%"PRIu64,i+1);
+  gt_vector* const hits = gt_vector_new(16,sizeof(gt_gtf_entry*));
+  const double start_time = gt_bench_get_time();
+  for (i=0;i<num_queries;++i) {
+    const uint64_t start = gt_bench_rand(&state)%(GT_BENCH_GTF_GENES*GT_BENCH_GTF_SPACING);
+    gt_gtf_search(gtf,hits,contig_names[gt_bench_rand(&state)%GT_BENCH_GTF_CONTIGS],
+        start,start+GT_BENCH_READ_LENGTH+gt_bench_rand(&state)%200,true);
+  }
+  run->seconds = gt_bench_get_time()-start_time;
+  run->records = num_queries;
+  run->bytes = 0; // Not applicable
+  gt_vector_delete(hits);
+  gt_gtf_delete(gtf);
+  free(file_name);
+}
+
+/*
+ * Benchmarks
+ */
+gt_bench gt_benchmarks[] = {
+  { "parse_map",           GT_BENCH_MAP_DATASET, gt_bench_parse_map },
+  { "parse_sam",           GT_BENCH_SAM_DATASET, gt_bench_parse_sam },
+  { "parse_fastq",         GT_BENCH_MAP_DATASET, gt_bench_parse_fastq },
+  { "print_map",           GT_BENCH_MAP_DATASET, gt_bench_print_map },
+  { "print_sam",           GT_BENCH_MAP_DATASET, gt_bench_print_sam },
+  { "print_fastq",         GT_BENCH_MAP_DATASET, gt_bench_print_fastq },
+  { "realign_hamming",     "synthetic",          gt_bench_realign_hamming },
+  { "realign_levenshtein", "synthetic",          gt_bench_realign_levenshtein },
+  { "gtf_read",            "synthetic",          gt_bench_gtf_read },
+  { "gtf_search",          "synthetic",          gt_bench_gtf_search },
+  { NULL, NULL, NULL }
+};
+
+int gt_bench_cmp_seconds(const void* const a,const void* const b) {
+  const double seconds_a = ((gt_bench_run*)a)->seconds;
+  const double seconds_b = ((gt_bench_run*)b)->seconds;
+  return (seconds_a > seconds_b) - (seconds_a < seconds_b);
+}
+GT_INLINE JsonNode* gt_bench_run_benchmark(gt_bench* const bench) {
+  gt_bench_run runs[GT_BENCH_MAX_REPEAT];
+  uint64_t i;
+  for (i=0;i<parameters.repeat;++i) {
+    memset(runs+i,0,sizeof(gt_bench_run));
+    bench->bench_fx(runs+i);
+  }
+  qsort(runs,parameters.repeat,sizeof(gt_bench_run),gt_bench_cmp_seconds);
+  gt_bench_run* const best = runs;
+  gt_bench_run* const median = runs+parameters.repeat/2;
+  JsonNode* const result = json_mkobject();
+  json_append_member(result,"name",json_mkstring(bench->name));
+  json_append_member(result,"input",json_mkstring(bench->input));
+  json_append_member(result,"records",json_mknumber(best->records));
+  json_append_member(result,"bytes",json_mknumber(best->bytes));
+  json_append_member(result,"best_seconds",json_mknumber(best->seconds));
+  json_append_member(result,"median_seconds",json_mknumber(median->seconds));
+  json_append_member(result,"records_per_second",json_mknumber(GT_DIV(best->records,best->seconds)));
+  json_append_member(result,"bytes_per_second",json_mknumber(GT_DIV(best->bytes,best->seconds)));
+  json_append_member(result,"median_records_per_second",json_mknumber(GT_DIV(median->records,median->seconds)));
+  json_append_member(result,"median_bytes_per_second",json_mknumber(GT_DIV(median->bytes,median->seconds)));
+  return result;
+}
+
+/*
+ * Arguments
+ */
+void usage() {
+  fprintf(stderr, "USE: ./gt_bench [ARGS]...\n"
+                  "      --size <MB> (Size of the scaled inputs/outputs, default=1024)\n"
+                  "      --repeat <number> (Repetitions of each benchmark, default=3)\n"
+                  "      --filter <name-prefix>\n"
+                  "      --datasets <folder> (default=../datasets)\n"
+                  "      --data <folder> (Scaled inputs cache, default=./data)\n"
+                  "      --output <file> (JSON report, default=stdout)\n"
+                  "      --list\n"
+                  "      --help|h\n");
+}
+void parse_arguments(int argc,char** argv) {
+  struct option long_options[] = {
+    { "size", required_argument, 0, 's' },
+    { "repeat", required_argument, 0, 'r' },
+    { "filter", required_argument, 0, 'f' },
+    { "datasets", required_argument, 0, 'D' },
+    { "data", required_argument, 0, 'd' },
+    { "output", required_argument, 0, 'o' },
+    { "list", no_argument, 0, 'l' },
+    { "help", no_argument, 0, 'h' },
+    { 0, 0, 0, 0 } };
+  int c,option_index;
+  while (1) {
+    c=getopt_long(argc,argv,"s:r:f:D:d:o:lh",long_options,&option_index);
+    if (c==-1) break;
+    switch (c) {
+    case 's':
+      parameters.size = atoll(optarg)<<20;
+      break;
+    case 'r':
+      parameters.repeat = atoll(optarg);
+      break;
+    case 'f':
+      parameters.filter = optarg;
+      break;
+    case 'D':
+      parameters.name_datasets_folder = optarg;
+      break;
+    case 'd':
+      parameters.name_data_folder = optarg;
+      break;
+    case 'o':
+      parameters.name_output_file = optarg;
+      break;
+    case 'l': {
+      gt_bench* bench;
+      for (bench=gt_benchmarks;bench->name!=NULL;++bench) fprintf(stdout,"%s\n",bench->name);
+      exit(0);
+    }
+    case 'h':
+      usage();
+      exit(1);
+    case '?': default:
+      gt_fatal_error_msg("Option not recognized");
+    }
+  }
+  // Checks
+  if (parameters.size==0) gt_fatal_error_msg("Size must be at least 1MB");
+  if (parameters.repeat==0 || parameters.repeat>GT_BENCH_MAX_REPEAT) {
+    gt_fatal_error_msg("Number of repetitions must be in [1,%d]",GT_BENCH_MAX_REPEAT);
+  }
+}
+
+int main(int argc,char** argv) {
+  // GT error handler
+  gt_handle_error_signals();
+
+  // Parsing command-line options
+  parse_arguments(argc,argv);
+  mkdir(parameters.name_data_folder,0755);
+
+  // Run the benchmarks
+  JsonNode* const report = json_mkobject();
+  json_append_member(report,"size",json_mknumber(parameters.size));
+  json_append_member(report,"repeat",json_mknumber(parameters.repeat));
+  JsonNode* const results = json_mkarray();
+  gt_bench* bench;
+  for (bench=gt_benchmarks;bench->name!=NULL;++bench) {
+    if (parameters.filter!=NULL && strncmp(bench->name,parameters.filter,strlen(parameters.filter))!=0) continue;
+    fprintf(stderr,"[bench] %s...\n",bench->name);
+    json_append_element(results,gt_bench_run_benchmark(bench));
+  }
+  json_append_member(report,"results",results);
+
+  // Report
+  FILE* const output_file = (parameters.name_output_file!=NULL) ? fopen(parameters.name_output_file,"w") : stdout;
+  gt_cond_fatal_error(output_file==NULL,FILE_OPEN,parameters.name_output_file);
+  char* const buffer = json_stringify(report,"  ");
+  fprintf(output_file,"%s\n",buffer);
+  free(buffer);
+  json_delete(report);
+  if (output_file!=stdout) fclose(output_file);
+
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include "gt_input_file.h"
 #include "gt_buffered_input_file.h"
 // Input parsers/utils
+#include "gt_scan.h"
 #include "gt_input_parser.h"
 #include "gt_input_map_parser.h"
 #include "gt_input_map_utils.h"
@@ -35,6 +36,7 @@
 
 // GEM-Tools basic data structures: Template/Alignment/Maps/...
 #include "gt_misms.h"
+#include "gt_contig_dictionary.h"
 #include "gt_map.h"
 #include "gt_dna_read.h"
 #include "gt_attributes.h"
@@ -49,6 +51,8 @@
 // HighLevel Modules
 #include "gt_stats.h"
 #include "gt_gtf.h"
+#include "gt_junctions.h"
+#include "gt_record_sort.h"
 
 // Utilities
 #include "gt_json.h"
@@ -120,6 +124,9 @@ extern char* gt_gtfcount_groups[];
 extern gt_option gt_region_options[];
 extern char* gt_region_groups[];
 
+extern gt_option gt_junctions_options[];
+extern char* gt_junctions_groups[];
+
 GT_INLINE uint64_t gt_options_get_num_options(const gt_option* const options);
 GT_INLINE struct option* gt_options_adaptor_getopt(const gt_option* const options);
 GT_INLINE gt_string* gt_options_adaptor_getopt_short(const gt_option* const options);
@@ -13,6 +13,7 @@
 #include "gt_attributes.h"
 
 #include "gt_map.h"
+#include "gt_map_index.h"
 
 #include "gt_input_parser.h"
 
@@ -33,6 +34,8 @@ typedef struct {
   gt_attributes* attributes;
   /* Hashed Dictionary */
   gt_alignment_dictionary* alg_dictionary;
+  /* Duplicates Index (Lazily built, see @gt_alignment_find_map_fx) */
+  gt_map_index* map_index;
 } gt_alignment;
 
 // Iterator
@@ -131,6 +134,7 @@ GT_INLINE void gt_alignment_add_map_gt_vector(gt_alignment* const alignment,gt_v
 GT_INLINE gt_map* gt_alignment_get_map(gt_alignment* const alignment,const uint64_t position);
 GT_INLINE void gt_alignment_set_map(gt_alignment* const alignment,gt_map* const map,const uint64_t position);
 GT_INLINE void gt_alignment_clear_maps(gt_alignment* const alignment);
+GT_INLINE void gt_alignment_invalidate_map_index(gt_alignment* const alignment); /* After reordering/removing maps */
 
 GT_INLINE bool gt_alignment_locate_map_reference(gt_alignment* const alignment,gt_map* const map,uint64_t* const position);
 
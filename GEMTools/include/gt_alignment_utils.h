@@ -62,9 +62,23 @@ GT_INLINE bool gt_alignment_get_next_matching_strata(
 
 /*
  * Alignment's Maps Sorting
+ *   Sort keys {distance,score} are computed once per map (not per comparison) and ties
+ *   keep their original order.
+ *   @gt_alignment_reduce_maps_by_distance__score() leaves the same maps as sorting and then
+ *     calling @gt_alignment_reduce_maps(), but only the @max_num_matches best maps are selected
+ *     and sorted (partial selection). The rest are freed in bulk.
  */
+typedef struct {
+  uint64_t distance;
+  uint64_t score;
+  uint64_t position;
+} gt_sort_key;
+GT_INLINE void gt_sort_keys_select(gt_sort_key* const keys,const uint64_t num_keys,const uint64_t num_selected);
+
 GT_INLINE void gt_alignment_sort_by_distance__score(gt_alignment* const alignment);
 GT_INLINE void gt_alignment_sort_by_distance__score_no_split(gt_alignment* const alignment);
+GT_INLINE void gt_alignment_reduce_maps_by_distance__score(gt_alignment* const alignment,const uint64_t max_num_matches);
+GT_INLINE void gt_alignment_reduce_maps_by_distance__score_no_split(gt_alignment* const alignment,const uint64_t max_num_matches);
 
 /*
  * Alignment's Maps Utils
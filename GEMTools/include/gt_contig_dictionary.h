@@ -0,0 +1,32 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_contig_dictionary.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Process-wide dictionary of sequence names (chromosomes,contigs,...)
+ *   Each distinct name is interned once and given a dense ID, so maps only carry
+ *   the ID (plus a pointer to the interned name) and lookups become array indexing.
+ *   Lookups are lock-free; insertions of new names are serialized.
+ */
+
+#ifndef GT_CONTIG_DICTIONARY_H_
+#define GT_CONTIG_DICTIONARY_H_
+
+#include "gt_essentials.h"
+
+/*
+ * Constants
+ */
+#define GT_CONTIG_NULL 0 /* ID of the empty name (unset) */
+
+/*
+ * Contig Dictionary
+ *   @gt_contig_dictionary_get_id() interns the name if not present
+ *   Interned names are never freed (until @gt_contig_dictionary_destroy) nor moved
+ */
+GT_INLINE uint32_t gt_contig_dictionary_get_id(const char* const name,const uint64_t length);
+GT_INLINE gt_string* gt_contig_dictionary_get_name(const uint32_t contig_id);
+GT_INLINE uint64_t gt_contig_dictionary_get_num_contigs(void);
+GT_INLINE void gt_contig_dictionary_destroy(void);
+
+#endif /* GT_CONTIG_DICTIONARY_H_ */
@@ -0,0 +1,75 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_cycle_stats.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Vectorized (SSE2/AVX2) base composition and quality histograms
+ *   Per-read counters (used by gt_stats) and per-cycle {quality,base} histograms
+ *   (used by align_stats)
+ */
+
+#ifndef GT_CYCLE_STATS_H_
+#define GT_CYCLE_STATS_H_
+
+#include "gt_commons.h"
+#include "gt_mm.h"
+
+/*
+ * Per-read counters
+ *   @nt_counting is indexed as gt_cdna_encode {A,C,G,T,N} (anything else counts as N)
+ */
+GT_INLINE void gt_cycle_stats_count_bases(const char* const read,const uint64_t length,uint64_t* const nt_counting);
+GT_INLINE uint64_t gt_cycle_stats_sum_qualities(const char* const qualities,const uint64_t length);
+
+/*
+ * Cycle Histogram
+ *   Counts {quality,base} per cycle into @histogram_by_cycle[cycle][qual*GT_CYCLE_NUM_BASES+base]
+ *   Reads are compared a vector of cycles at a time against a small palette of quality
+ *   values (learnt from the input) and counted into per-cycle byte counters, which are
+ *   flushed into the histogram before they can overflow. Qualities out of the palette
+ *   are counted one by one (and if most of them are, as with unbinned qualities, the
+ *   histogram switches to count everything one by one)
+ */
+#define GT_CYCLE_NUM_BASES 5
+#define GT_CYCLE_BASE_N 0
+#define GT_CYCLE_BASE_A 1
+#define GT_CYCLE_BASE_C 2
+#define GT_CYCLE_BASE_G 3
+#define GT_CYCLE_BASE_T 4
+#define GT_CYCLE_MAX_PALETTE 8
+typedef struct {
+  /* Quality range */
+  uint8_t qual_offset;
+  uint8_t max_qual;
+  /* Palette */
+  bool vectorized;
+  char palette[GT_CYCLE_MAX_PALETTE];
+  uint64_t palette_size;
+  /* Byte counters [palette][base][chunk of cycles] */
+  uint8_t* counters;
+  uint64_t num_chunks;       // Allocated chunks of cycles
+  uint64_t max_length;       // Longest read in the counters
+  uint64_t num_reads;        // Reads in the counters
+  uint64_t num_vector_cycles; // Cycles compared against the palette
+  uint64_t num_scalar_cycles; // ... of which were out of it
+  /* Totals (up to the last flush) */
+  uint64_t base_counts[GT_CYCLE_NUM_BASES];
+} gt_cycle_histogram;
+
+GT_INLINE gt_cycle_histogram* gt_cycle_histogram_new(const uint8_t qual_offset,const uint8_t max_qual);
+GT_INLINE void gt_cycle_histogram_delete(gt_cycle_histogram* const cycle_histogram);
+
+/*
+ * @histogram_by_cycle must have (at least) @length rows. Returns false on a base other
+ * than ACGTN or a quality outside [qual_offset,qual_offset+max_qual] (the read is then
+ * partially counted)
+ */
+GT_INLINE bool gt_cycle_histogram_add(
+    gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle,
+    const char* const read,const char* const qualities,const uint64_t length);
+/*
+ * Adds the pending counters into @histogram_by_cycle (must be called before reading it)
+ */
+GT_INLINE void gt_cycle_histogram_flush(gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle);
+
+#endif /* GT_CYCLE_STATS_H_ */
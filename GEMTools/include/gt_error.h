@@ -283,6 +283,7 @@ gt_status gt_tprintf(const char* format,...);
 #define GT_ERROR_SYS_MMAP_FILE "Could not map file '%s' to memory"
 #define GT_ERROR_SYS_UNMAP "Could not unmap memory"
 #define GT_ERROR_SYS_THREAD "Could not create thread"
+#define GT_ERROR_SYS_THREAD_JOIN "Could not join thread"
 #define GT_ERROR_SYS_PIPE "Could not create pipe"
 #define GT_ERROR_SYS_MUTEX "Mutex call error"
 #define GT_ERROR_SYS_MUTEX_INIT "Mutex initialization error"
@@ -292,6 +293,8 @@ gt_status gt_tprintf(const char* format,...);
 #define GT_ERROR_SYS_COND_VAR_DESTROY "Conditional variable destroy call error"
 #define GT_ERROR_SYS_MKSTEMP "Could not create a temporal file (mkstemp:'%s')"
 #define GT_ERROR_SYS_HANDLE_TMP "Failed to handle temporal file"
+#define GT_ERROR_NUMA_NODE_OUT_OF_RANGE "NUMA node %"PRIu64" out of range [0,%"PRIu64")"
+#define GT_ERROR_NUMA_BIND "Could not bind thread to NUMA node %"PRIu64""
 
 // String errors
 #define GT_ERROR_STRING_STATIC "Could not perform operation on static string"
@@ -309,6 +312,9 @@ gt_status gt_tprintf(const char* format,...);
 #define GT_ERROR_FILE_GZIP_NO_ZLIB "Could not open GZIPPED file '%s': no zlib support compiled in"
 #define GT_ERROR_FILE_BZIP2_OPEN "Could not open BZIPPED file '%s'"
 #define GT_ERROR_FILE_BZIP2_NO_BZLIB "Could not open BZIPPED file '%s': no bzlib support compiled in"
+#define GT_ERROR_FILE_SAMPLING_NOT_SEEKABLE "Could not sample file '%s': a seekable uncompressed file is required"
+#define GT_ERROR_FILE_SAMPLING_FORMAT "Could not sample file '%s': format not supported (FASTQ, FASTA, MAP or SAM)"
+#define GT_ERROR_FILE_RECORD_SORT_FORMAT "Could not sort file '%s': format not supported (MAP or SAM)"
 #define GT_ERROR_FILE_FDOPEN "Could not fdopen file descriptor"
 
 // Output errors
@@ -354,6 +360,8 @@ gt_status gt_tprintf(const char* format,...);
 #define GT_ERROR_SEQ_ARCHIVE_CHUNK_OUT_OF_RANGE "Requested sequence string [%"PRIu64",%"PRIu64") out of sequence '%s' boundaries"
 #define GT_ERROR_GEMIDX_SEQ_ARCHIVE_NOT_FOUND "GEMIdx. Sequence '%s' not found in reference archive"
 #define GT_ERROR_GEMIDX_INTERVAL_NOT_FOUND "GEMIdx. Interval relative to sequence '%s' not found in reference archive"
+#define GT_ERROR_CONTIG_DICTIONARY_FULL "Contig dictionary full. Too many different sequence names"
+#define GT_ERROR_CONTIG_DICTIONARY_WRONG_ID "Contig dictionary. Invalid sequence ID (%"PRIu32")"
 
 // Stats vector
 #define GT_ERROR_VSTATS_INVALID_MIN_MAX "Invalid step range for stats vector, min_value <= max_value"
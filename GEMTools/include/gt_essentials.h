@@ -23,6 +23,9 @@
 // Basic Profiling
 #include "gt_profiler.h"
 
+// NUMA placement
+#include "gt_numa.h"
+
 // Basic DataStructures
 #include "gt_vector.h"
 #include "gt_string.h"
@@ -65,30 +65,35 @@ GT_INLINE gt_status gt_gprintf(gt_generic_printer* const generic_printer,const c
 #define GT_GENERIC_PRINTER_IMPLEMENTATION(MODULE_NAME,FUNCTION_NAME,SIGNATURE...) \
   GT_INLINE gt_status MODULE_NAME##_f##FUNCTION_NAME(FILE* file,##SIGNATURE) { \
     GT_NULL_CHECK(file); \
+    GT_STAGE_PROF_SCOPE(GT_STAGE_FORMAT); \
     gt_generic_printer gprinter; \
     gt_generic_new_file_printer(&gprinter,file); \
     return MODULE_NAME##_g##FUNCTION_NAME(&gprinter,GT_GENERIC_PRINTER_DELEGATE_CALL_PARAMS); \
   } \
   GT_INLINE gt_status MODULE_NAME##_s##FUNCTION_NAME(gt_string* const string,##SIGNATURE) { \
     GT_STRING_CHECK(string); \
+    GT_STAGE_PROF_SCOPE(GT_STAGE_FORMAT); \
     gt_generic_printer gprinter; \
     gt_generic_new_string_printer(&gprinter,string); \
     return MODULE_NAME##_g##FUNCTION_NAME(&gprinter,GT_GENERIC_PRINTER_DELEGATE_CALL_PARAMS); \
   } \
   GT_INLINE gt_status MODULE_NAME##_b##FUNCTION_NAME(gt_output_buffer* const output_buffer,##SIGNATURE) { \
     GT_OUTPUT_BUFFER_CHECK(output_buffer); \
+    GT_STAGE_PROF_SCOPE(GT_STAGE_FORMAT); \
     gt_generic_printer gprinter; \
     gt_generic_new_buffer_printer(&gprinter,output_buffer); \
     return MODULE_NAME##_g##FUNCTION_NAME(&gprinter,GT_GENERIC_PRINTER_DELEGATE_CALL_PARAMS); \
   } \
   GT_INLINE gt_status MODULE_NAME##_of##FUNCTION_NAME(gt_output_file* const output_file,##SIGNATURE) { \
     GT_OUTPUT_FILE_CHECK(output_file); \
+    GT_STAGE_PROF_SCOPE(GT_STAGE_FORMAT); \
     gt_generic_printer gprinter; \
     gt_generic_new_output_file_printer(&gprinter,output_file); \
     return MODULE_NAME##_g##FUNCTION_NAME(&gprinter,GT_GENERIC_PRINTER_DELEGATE_CALL_PARAMS); \
   } \
   GT_INLINE gt_status MODULE_NAME##_bof##FUNCTION_NAME(gt_buffered_output_file* const buffered_output_file,##SIGNATURE) { \
     GT_BUFFERED_OUTPUT_FILE_CHECK(buffered_output_file); \
+    GT_STAGE_PROF_SCOPE(GT_STAGE_FORMAT); \
     gt_generic_printer gprinter; \
     gt_generic_new_buffered_output_file_printer(&gprinter,buffered_output_file); \
     return MODULE_NAME##_g##FUNCTION_NAME(&gprinter,GT_GENERIC_PRINTER_DELEGATE_CALL_PARAMS); \
@@ -94,14 +94,44 @@ typedef struct {
  */
 typedef struct {
 	gt_shash* refs; // maps from the ref name to the ref char* -> gt_gtf_ref*
+	gt_vector* contig_refs; // refs indexed by contig ID (gt_contig_dictionary) -> gt_gtf_ref* (NULL if not annotated)
 	gt_shash* types; // maps from the type name to the gt_string type ref char* -> gt_string*
 	gt_shash* gene_ids; // maps from char* to gt_string* for gene_ids char* -> gt_string*
 	gt_shash* transcript_ids; // maps from char* to gt_string* for gene_ids char* -> gt_string*
 	gt_shash* gene_types; // maps from char* to gt_string* for gene_types char* -> gt_string*
 	gt_shash* genes; // maps from char* to gt_gtf_entry for genes
 	gt_shash* transcripts; // maps from char* to gt_gtf_entry for genes
+	gt_shash* gene_coverage; // maps from gene_id to gt_gtf_coverage_table* (NULL until gt_gtf_build_coverage_tables)
 }gt_gtf;
 
+/**
+ * Exon of a gene coverage table. Carries everything needed to map a block
+ * overlapping the exon to gene body buckets (the exon offset on its transcript
+ * is already turned into the transcript start bucket)
+ */
+typedef struct {
+  uint32_t seq_id; // contig of the exon (a gene may be annotated on several contigs)
+  uint64_t start; // the exon start position
+  uint64_t end; // the exon end position
+  uint64_t exon_length;
+  uint64_t transcript_length;
+  uint64_t transcript_start_bucket; // bucket of the exon start on the transcript
+  double scale; // exon_length / transcript_length
+  uint64_t length_range; // GT_GTF_COVERAGE_LENGTH_* of the transcript (GT_GTF_COVERAGE_LENGTH_ALL if none)
+  gt_strand strand;
+  bool single_transcript; // the gene has a single transcript
+} gt_gtf_coverage_exon;
+
+/**
+ * Exons of a gene sorted by start position. max_ends[i] is the max end of
+ * exons[0..i], so the first exon that can overlap a block is found with one
+ * binary search
+ */
+typedef struct {
+  gt_vector* exons; // gt_gtf_coverage_exon
+  gt_vector* max_ends; // uint64_t
+} gt_gtf_coverage_table;
+
 /**
  * gtf hit that are filled by the template search methods
  */
@@ -185,11 +215,18 @@ GT_INLINE gt_gtf* gt_gtf_read(gt_input_file* input, uint64_t threads);
 GT_INLINE gt_gtf* gt_gtf_read_from_stream(FILE* input, uint64_t threads);
 GT_INLINE gt_gtf* gt_gtf_read_from_file(char* input, uint64_t threads);
 
+/**
+ * Build the per gene exon tables used to count coverage profiles
+ * (required before counting with coverage enabled)
+ */
+GT_INLINE void gt_gtf_build_coverage_tables(gt_gtf* const gtf);
+
 /**
  * Access the chromosome refs
  */
 GT_INLINE gt_gtf_ref* gt_gtf_get_ref(const gt_gtf* const gtf, char* const name);
 GT_INLINE bool gt_gtf_contains_ref(const gt_gtf* const gtf, char* const name);
+GT_INLINE gt_gtf_ref* gt_gtf_get_contig_ref(const gt_gtf* const gtf, const uint32_t contig_id);
 
 /**
  * Access available types
@@ -241,6 +278,11 @@ GT_INLINE uint64_t gt_gtf_count_map(const gt_gtf* const gtf, gt_map* const map1,
  * vector. Note that the target vector is cleared at the beginning of the method!
  */
 GT_INLINE uint64_t gt_gtf_search(const gt_gtf* const gtf, gt_vector* const target, char* const ref, const uint64_t start, const uint64_t end, const bool clean_target);
+/**
+ * Same as gt_gtf_search but the reference is given by its contig ID
+ * (i.e. gt_map_get_seq_id(map)), so no name lookup is involved
+ */
+GT_INLINE uint64_t gt_gtf_search_contig(const gt_gtf* const gtf, gt_vector* const target, const uint32_t contig_id, const uint64_t start, const uint64_t end, const bool clean_target);
 /**
  * Search for exons that overlap with the given template mappings.
  */
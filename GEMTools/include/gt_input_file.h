@@ -12,6 +12,7 @@
 #include "gt_essentials.h"
 #include "gt_attributes.h"
 #include "gt_sam_attributes.h"
+#include "gt_scan.h"
 
 #ifdef HAVE_ZLIB
 #include <zlib.h>
@@ -38,6 +39,26 @@
  */
 typedef enum { FASTA, MAP, SAM, FILE_FORMAT_UNKNOWN } gt_file_format;
 typedef enum { STREAM, REGULAR_FILE, MAPPED_FILE, GZIPPED_FILE, BZIPPED_FILE } gt_file_type;
+/*
+ * Read-ahead
+ *   A prefetch thread reads (and decompresses) the next buffers of the file into a ring
+ *   while the current one is parsed, so refilling the buffer (done holding the input mutex)
+ *   only waits if the I/O falls behind. Started at the first refill (never for mmap'd
+ *   or sampled files)
+ */
+#define GT_INPUT_FILE_READ_AHEAD_BUFFERS 2 /* Buffer being parsed + buffers in flight */
+typedef struct {
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t filled_cond;
+  pthread_cond_t free_cond;
+  uint8_t* buffer[GT_INPUT_FILE_READ_AHEAD_BUFFERS];
+  uint64_t buffer_size[GT_INPUT_FILE_READ_AHEAD_BUFFERS];
+  uint64_t next_consumed; /* Buffers handed to the input file */
+  uint64_t next_filled;   /* Buffers read by the prefetch thread */
+  bool eof;
+  bool stop;
+} gt_input_file_read_ahead;
 typedef struct {
   /* Input file */
   char* file_name;
@@ -61,8 +82,15 @@ typedef struct {
   uint64_t buffer_pos;
   uint64_t global_pos;
   uint64_t processed_lines;
+  gt_input_file_read_ahead* read_ahead; /* NULL if the buffer is filled synchronously */
   /* ID generator */
   uint64_t processed_id;
+  /* Sampling */
+  uint64_t sampling_num_chunks;   // Number of chunks sampled (0 if the whole file is read)
+  uint64_t sampling_chunk_lines;  // Lines read per chunk
+  uint64_t sampling_begin;        // File offset of the first record
+  uint64_t sampling_next_chunk;   // Next chunk to be sampled
+  uint64_t sampling_lines_left;   // Lines left in the current chunk
 } gt_input_file;
 
 /*
@@ -82,6 +110,17 @@ GT_INLINE void gt_input_file_lock(gt_input_file* const input_file);
 GT_INLINE void gt_input_file_unlock(gt_input_file* const input_file);
 GT_INLINE uint64_t gt_input_file_next_id(gt_input_file* const input_file);
 
+/*
+ * Sampling
+ *   Restricts the reading to uniformly spaced chunks of the file totalling ~@num_records
+ *   records. Each chunk starts at the next record boundary after its offset. Requires a
+ *   seekable uncompressed file (regular or mmap'd) in FASTQ, single-line FASTA, MAP or SAM format
+ */
+GT_INLINE void gt_input_file_set_sampling(gt_input_file* const input_file,const uint64_t num_records);
+GT_INLINE bool gt_input_file_is_sampling(gt_input_file* const input_file);
+/* Lines to read for the next block (0 & EOF when all chunks were read). Thread-unsafe */
+GT_INLINE uint64_t gt_input_file_sampling_next_lines(gt_input_file* const input_file,const uint64_t num_lines);
+
 /*
  * Basic line functions
  */
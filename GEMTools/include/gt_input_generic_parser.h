@@ -25,6 +25,12 @@
 #define GT_IGP_EOF 0
 #define GT_IGP_OK 1
 
+/*
+ * Parsing error/state codes (Paired files)
+ */
+#define GT_IGP_PE_PREMATURE_EOB 10
+#define GT_IGP_PE_TAG_MISMATCH 11
+
 /*
  * Parsing Attributes
  */
@@ -48,6 +54,15 @@ GT_INLINE gt_status gt_input_generic_parser_get_alignment(
 GT_INLINE gt_status gt_input_generic_parser_get_template(
     gt_buffered_input_file* const buffered_input,gt_template* const template,gt_generic_parser_attributes* const attributes);
 
+/*
+ * Paired Parser (end/1 and end/2 stored in separate files)
+ *   Reloads both inputs in synch (same number of records per block) and builds
+ *   the template from one record of each. The output buffers must be attached to @buffered_input_end1
+ */
+GT_INLINE gt_status gt_input_generic_parser_get_paired_template(
+    gt_buffered_input_file* const buffered_input_end1,gt_buffered_input_file* const buffered_input_end2,
+    pthread_mutex_t* const input_mutex,gt_template* const template,gt_generic_parser_attributes* const attributes);
+
 /*
  * Synch read of blocks
  */
@@ -201,4 +201,23 @@ GT_INLINE gt_status gt_input_map_parser_synch_blocks_by_subset(
     pthread_mutex_t* const input_mutex,gt_map_parser_attributes* const map_parser_attr,
     gt_buffered_input_file* const buffered_map_input_master,gt_buffered_input_file* const buffered_map_input_slave); // Used to merge files in parallel
 
+/*
+ * Synch read of blocks (N slaves, each a subset of the master)
+ *   Slave records read past the current master block are kept in a lookahead (one per slave)
+ *   that must be shared by all the threads reading the same files
+ */
+typedef struct {
+  gt_vector* record; /* Pending record (char) */
+  gt_string* tag;    /* Pending record's TAG */
+  bool pending;
+} gt_imp_subset_lookahead;
+
+GT_INLINE gt_imp_subset_lookahead* gt_imp_subset_lookahead_new(const uint64_t num_slaves);
+GT_INLINE void gt_imp_subset_lookahead_delete(gt_imp_subset_lookahead* const lookahead,const uint64_t num_slaves);
+
+GT_INLINE gt_status gt_input_map_parser_synch_blocks_by_subset_a(
+    pthread_mutex_t* const input_mutex,gt_map_parser_attributes* const map_parser_attr,
+    gt_buffered_input_file* const buffered_map_input_master,gt_buffered_input_file** const buffered_map_input_slaves,
+    gt_imp_subset_lookahead* const lookahead,const uint64_t num_slaves);
+
 #endif /* GT_INPUT_MAP_PARSER_H_ */
@@ -13,6 +13,7 @@
 
 #include "gt_input_file.h"
 #include "gt_output_file.h"
+#include "gt_input_map_parser.h"
 
 // Merge functions (synch files)
 #define gt_merge_synch_map_files(input_mutex,paired_end,output_file,input_map_master,input_map_slave) \
@@ -31,5 +32,13 @@ GT_INLINE void gt_merge_synch_map_files_va(
 GT_INLINE void gt_merge_unsynch_map_files(
     pthread_mutex_t* const input_mutex,gt_input_file* const input_map_master,gt_input_file* const input_map_slave,
     const bool paired_end,gt_output_file* const output_file);
+/*
+ * Merges the master with K slaves (subsets of the master, in the same order) in one pass.
+ *   @lookahead must be allocated with @gt_imp_subset_lookahead_new(num_slaves) and shared by all threads
+ */
+GT_INLINE void gt_merge_unsynch_map_files_a(
+    pthread_mutex_t* const input_mutex,gt_imp_subset_lookahead* const lookahead,const bool paired_end,
+    gt_output_file* const output_file,gt_input_file* const input_map_master,
+    gt_input_file** const input_map_slaves,const uint64_t num_slaves);
 
 #endif /* GT_INPUT_MAP_UTILS_H_ */
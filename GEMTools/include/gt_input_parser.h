@@ -12,6 +12,7 @@
 
 #include "gt_essentials.h"
 #include "gt_attributes.h"
+#include "gt_scan.h"
 
 /*
  * Parsing error/state codes
@@ -40,6 +41,10 @@ GT_INLINE uint64_t gt_input_parse_tag_chomp_pairend_info(gt_string* const tag);
   while (gt_expect_true(!(test) && !GT_IS_EOL(text_line))) { \
     GT_NEXT_CHAR(text_line); \
   }
+// Vectorized GT_READ_UNTIL for plain character delimiters (also stops at EOL/EOS)
+#define GT_READ_UNTIL_CHARS(text_line,char1,char2) \
+  *(text_line) = (typeof(*(text_line)))gt_scan_until(*(text_line),char1,char2)
+#define GT_READ_UNTIL_CHAR(text_line,character) GT_READ_UNTIL_CHARS(text_line,character,character)
 #define GT_PARSE_HEX_OR_DEC(text_line,number) \
   number=0; \
   if(**text_line=='0' && (*(*text_line+1)=='x' || *(*text_line+1)=='X')) { \
@@ -68,9 +73,6 @@ GT_INLINE uint64_t gt_input_parse_tag_chomp_pairend_info(gt_string* const tag);
 #define GT_PARSE_SIGNED_NUMBER_END_BLOCK(number) \
   if (is_negative) number = -number; \
 }
-#define GT_SKIP_LINE(text_line) \
-  while (!GT_IS_EOL(text_line)) { \
-    ++(*text_line); \
-  }
+#define GT_SKIP_LINE(text_line) GT_READ_UNTIL_CHAR(text_line,EOL)
 
 #endif /* GT_INPUT_PARSER_H_ */
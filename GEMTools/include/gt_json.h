@@ -7,6 +7,7 @@
 
 #include "gt_commons.h"
 #include "gt_shash.h"
+#include "gt_profiler.h"
 #include "json.h"
 
 /**
@@ -31,4 +32,15 @@ GT_INLINE JsonNode* gt_json_int_array(const uint64_t start, const uint64_t len,
  * Convert a counter hash from string->uint64_t to a json object
  */
 GT_INLINE JsonNode* gt_json_int_hash(gt_shash* const data);
+/**
+ * Stage profiler report (see gt_profiler.h). Times in seconds:
+ *
+ * {
+ *   "clock": "monotonic", "wall_time": 1.2, "num_threads": 2,
+ *   "stages": { "process": {"time": 0.4}, "parse": {"time": 0.7, "calls": 1000}, ... },
+ *   "threads": [ { <per-thread stages> }, ... ]
+ * }
+ */
+GT_INLINE JsonNode* gt_json_profiler_stages(void);
+GT_INLINE void gt_json_profiler_stages_fprint(FILE* const stream);
 #endif /* GT_JSON_H_ */
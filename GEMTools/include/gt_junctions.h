@@ -0,0 +1,107 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_junctions.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Splice junctions of split maps aggregated by support
+ *   A junction is identified by {contig ID, last base before the intron, first base after
+ *   the intron} (1-based, forward strand). Threads count into a private gt_junction_table
+ *   and flush it now and then into the shared gt_junction_set, which is split into
+ *   independently locked shards.
+ */
+
+#ifndef GT_JUNCTIONS_H_
+#define GT_JUNCTIONS_H_
+
+#include "gt_essentials.h"
+#include "gt_contig_dictionary.h"
+#include "gt_map.h"
+#include "gt_gtf.h"
+
+/*
+ * Junction
+ */
+typedef enum { GT_JUNCTION_NOVEL, GT_JUNCTION_ANNOTATED_SITE, GT_JUNCTION_ANNOTATED } gt_junction_annotation;
+typedef struct {
+  uint32_t seq_id;  // Contig ID (GT_CONTIG_NULL if the slot is free)
+  gt_strand strand; // UNKNOWN unless given by the annotation or a junctions file
+  uint64_t begin;   // Last base before the intron
+  uint64_t end;     // First base after the intron
+  uint64_t support; // Number of split reads (or counts of the merged junctions files)
+  gt_junction_annotation annotation;
+} gt_junction;
+
+/*
+ * Junction Table (open addressing, linear probing)
+ */
+typedef struct {
+  gt_junction* junctions;
+  uint64_t num_slots;
+  uint64_t num_junctions;
+} gt_junction_table;
+
+GT_INLINE gt_junction_table* gt_junction_table_new(void);
+GT_INLINE void gt_junction_table_clear(gt_junction_table* const junction_table);
+GT_INLINE void gt_junction_table_delete(gt_junction_table* const junction_table);
+
+GT_INLINE uint64_t gt_junction_table_get_num_junctions(gt_junction_table* const junction_table);
+GT_INLINE gt_junction* gt_junction_table_add(
+    gt_junction_table* const junction_table,const uint32_t seq_id,
+    const uint64_t begin,const uint64_t end,const gt_strand strand,const uint64_t support);
+GT_INLINE gt_junction* gt_junction_table_get(
+    gt_junction_table* const junction_table,const uint32_t seq_id,const uint64_t begin,const uint64_t end);
+
+/*
+ * Adds (support 1) each splice of @map between blocks of at least @min_block_length bases
+ * and with an intron of at most @max_intron_length bases. Returns the number of junctions added
+ */
+GT_INLINE uint64_t gt_junction_table_add_map(
+    gt_junction_table* const junction_table,gt_map* const map,
+    const uint64_t min_block_length,const uint64_t max_intron_length);
+/*
+ * Adds (support 0) the introns between consecutive exons of the transcripts of @gtf
+ */
+GT_INLINE uint64_t gt_junction_table_add_gtf(gt_junction_table* const junction_table,const gt_gtf* const gtf);
+
+/*
+ * Junction Set
+ */
+#define GT_JUNCTION_SET_NUM_SHARDS 64
+typedef struct {
+  pthread_mutex_t mutex;
+  gt_junction_table* junction_table;
+} gt_junction_shard;
+typedef struct {
+  gt_junction_shard shards[GT_JUNCTION_SET_NUM_SHARDS];
+} gt_junction_set;
+
+GT_INLINE gt_junction_set* gt_junction_set_new(void);
+GT_INLINE void gt_junction_set_delete(gt_junction_set* const junction_set);
+
+GT_INLINE uint64_t gt_junction_set_get_num_junctions(gt_junction_set* const junction_set);
+/*
+ * Adds all the junctions of @junction_table (locking each shard once) and clears it
+ */
+GT_INLINE void gt_junction_set_flush_table(gt_junction_set* const junction_set,gt_junction_table* const junction_table);
+/*
+ * Copies all the junctions into @junctions (gt_junction), sorted by {contig name,begin,end}
+ */
+GT_INLINE void gt_junction_set_get_junctions(gt_junction_set* const junction_set,gt_vector* const junctions);
+
+/*
+ * Annotation
+ *   ANNOTATED if an exon ends at @begin and an exon of the same transcript starts at @end
+ *   (the strand is then taken from the transcript), ANNOTATED_SITE if only one of the
+ *   sites is an exon boundary
+ */
+GT_INLINE void gt_junction_annotate(const gt_gtf* const gtf,gt_junction* const junction,gt_vector* const hits);
+
+/*
+ * Junctions file (GEM format)
+ *   <chr> <strand> <donor> <chr> <strand> <acceptor> [<support>]
+ *   Reverse strand junctions are written with the donor (higher coordinate) first
+ */
+GT_INLINE gt_status gt_junction_parse(const char* const line,gt_junction* const junction);
+GT_INLINE void gt_junction_fprint(FILE* const stream,gt_junction* const junction,const bool print_support);
+
+#endif /* GT_JUNCTIONS_H_ */
@@ -11,6 +11,7 @@
 
 #include "gt_essentials.h"
 #include "gt_attributes.h"
+#include "gt_contig_dictionary.h"
 
 #include "gt_misms.h"
 #include "gt_dna_string.h"
@@ -38,7 +39,8 @@ typedef struct {
  */
 struct _gt_map {
   /* Sequence-name(Chromosome/Contig/...), position and strand */
-  gt_string* seq_name;
+  uint32_t seq_id;     // ID at the contig dictionary
+  gt_string* seq_name; // Interned name (read-only, owned by the contig dictionary)
   uint64_t position;
   uint64_t base_length; // Length not including indels
   gt_strand strand;
@@ -102,6 +104,8 @@ GT_INLINE uint64_t gt_map_get_seq_name_length(gt_map* const map);
 GT_INLINE gt_string* gt_map_get_string_seq_name(gt_map* const map);
 GT_INLINE void gt_map_set_seq_name(gt_map* const map,const char* const seq_name,const uint64_t length);
 GT_INLINE void gt_map_set_string_seq_name(gt_map* const map,gt_string* const seq_name);
+GT_INLINE uint32_t gt_map_get_seq_id(gt_map* const map);
+GT_INLINE void gt_map_set_seq_id(gt_map* const map,const uint32_t seq_id);
 GT_INLINE gt_strand gt_map_get_strand(gt_map* const map);
 GT_INLINE void gt_map_set_strand(gt_map* const map,const gt_strand strand);
 // Length of the base read (no indels)
@@ -189,7 +193,7 @@ GT_INLINE void gt_map_reverse_misms(gt_map* const map);
  *   This concept is essential as to handle properly QUIMERAS
  */
 #define GT_MAP_IS_SAME_SEGMENT(map_1,map_2) \
-  (gt_string_equals(gt_map_get_string_seq_name(map_1),gt_map_get_string_seq_name(map_2)) && \
+  (gt_map_get_seq_id(map_1)==gt_map_get_seq_id(map_2) && \
    gt_map_get_strand(map_1)==gt_map_get_strand(map_2))
 GT_INLINE uint64_t gt_map_segment_get_num_segments(gt_map* const map);
 GT_INLINE gt_map* gt_map_segment_get_next_block(gt_map* const map);
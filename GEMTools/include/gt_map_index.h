@@ -0,0 +1,65 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_map_index.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Hash index over the maps (or mmaps) of an alignment (or template)
+ *   Used to detect duplicated maps on insertion without scanning all the maps.
+ *   Keys are computed from {contig ID, strand, begin/end positions} of the first block,
+ *   so maps equal wrt @gt_map_cmp/@gt_mmap_cmp always share the same key. Candidates
+ *   are always confirmed with the comparison function.
+ */
+
+#ifndef GT_MAP_INDEX_H_
+#define GT_MAP_INDEX_H_
+
+#include "gt_essentials.h"
+#include "gt_map.h"
+
+/*
+ * Constants
+ */
+#define GT_MAP_INDEX_THRESHOLD 16 /* Below this number of maps, a linear scan is cheaper */
+#define GT_MAP_INDEX_NOT_FOUND UINT64_MAX
+
+/*
+ * Map Index
+ *   Open addressing (linear probing) table of {key,position}.
+ *   Positions [0,num_indexed) of the indexed container are in the table.
+ */
+typedef struct {
+  uint64_t key;
+  uint64_t pos;
+} gt_map_index_entry;
+typedef struct {
+  gt_map_index_entry* entries;
+  uint64_t num_slots;
+  uint64_t num_entries;
+  uint64_t num_indexed;
+} gt_map_index;
+
+/*
+ * Setup
+ */
+GT_INLINE gt_map_index* gt_map_index_new(void);
+GT_INLINE void gt_map_index_clear(gt_map_index* const map_index);
+GT_INLINE void gt_map_index_delete(gt_map_index* const map_index);
+
+/*
+ * Keys
+ */
+GT_INLINE uint64_t gt_map_index_map_key(gt_map* const map);
+GT_INLINE uint64_t gt_map_index_mmap_key(gt_map** const mmap,const uint64_t num_blocks);
+
+/*
+ * Index operators
+ *   @gt_map_index_add() can be called again for an already indexed position (the old
+ *     entry is left behind and simply fails the comparison step)
+ *   @gt_map_index_probe() returns the next candidate position for @key starting
+ *     at *@slot (GT_MAP_INDEX_NOT_FOUND when exhausted)
+ */
+GT_INLINE void gt_map_index_add(gt_map_index* const map_index,const uint64_t key,const uint64_t pos);
+GT_INLINE uint64_t gt_map_index_probe_begin(gt_map_index* const map_index,const uint64_t key);
+GT_INLINE uint64_t gt_map_index_probe(gt_map_index* const map_index,const uint64_t key,uint64_t* const slot);
+
+#endif /* GT_MAP_INDEX_H_ */
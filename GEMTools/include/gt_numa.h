@@ -0,0 +1,51 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_numa.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: NUMA-aware thread placement and per-node replicas of read-only structures
+ *   Topology is read from sysfs (no libnuma needed). Memory placement relies on the
+ *   kernel's first-touch policy: whatever a pinned thread allocates and initializes
+ *   lands on its node.
+ */
+
+#ifndef GT_NUMA_H_
+#define GT_NUMA_H_
+
+#include "gt_commons.h"
+#include <sched.h>
+#include "gt_mm.h"
+
+#define GT_NUMA_MAX_NODES 64
+#define GT_NUMA_SYSFS_NODES "/sys/devices/system/node"
+
+extern bool gt_numa_enabled;
+
+/*
+ * Setup
+ *   Until @gt_numa_enable() (or if the topology cannot be read) there is a single node
+ *   and threads are left unpinned
+ */
+void gt_numa_enable();
+GT_INLINE uint64_t gt_numa_get_num_nodes();
+GT_INLINE uint64_t gt_numa_parse_cpulist(const char* const cpulist,cpu_set_t* const cpu_set);
+
+/*
+ * Thread placement
+ *   Threads are spread over the nodes in contiguous ranges (thread_idx*num_nodes/num_threads),
+ *   so that neighbouring threads share a node
+ */
+GT_INLINE void gt_numa_bind_thread(const uint64_t thread_idx,const uint64_t num_threads);
+GT_INLINE void gt_numa_bind_thread_to_node(const uint64_t node);
+GT_INLINE uint64_t gt_numa_get_thread_node();
+
+/*
+ * Replicas
+ *   @gt_numa_replicate() calls @loader once per node, from a thread pinned to it, and
+ *   returns the replicas indexed by node (gt_numa_get_num_nodes() of them)
+ */
+typedef void* (*gt_numa_replica_loader)(void* const loader_arg);
+void** gt_numa_replicate(gt_numa_replica_loader const loader,void* const loader_arg);
+#define gt_numa_get_replica(replicas) ((replicas)[gt_numa_get_thread_node()])
+
+#endif /* GT_NUMA_H_ */
@@ -37,9 +37,17 @@ typedef struct {
   /* Block ID (for synchronization purposes) */
   uint32_t mayor_block_id;
   uint32_t minor_block_id;
+  /* Writer thread (dumped buffers are queued in output order) */
+  pthread_t writer_thread;
+  gt_output_buffer* write_queue[GT_MAX_OUTPUT_BUFFERS];
+  uint64_t write_queue_begin;
+  uint64_t write_queue_size;
+  bool writer_stop;
   /* Mutexes */
   pthread_cond_t  out_buffer_cond;
   pthread_cond_t  out_write_cond;
+  pthread_cond_t  out_queue_cond;   // Buffers queued (or stop)
+  pthread_cond_t  out_flushed_cond; // Write queue drained
   pthread_mutex_t out_file_mutex;
 } gt_output_file;
 
@@ -59,7 +67,8 @@ typedef struct {
   GT_OUTPUT_FILE_CHECK(output_file); \
   gt_fatal_check( \
     output_file->buffer_busy>GT_MAX_OUTPUT_BUFFERS|| \
-    output_file->buffer_write_pending>GT_MAX_OUTPUT_BUFFERS,OUTPUT_FILE_INCONSISTENCY)
+    output_file->buffer_write_pending>GT_MAX_OUTPUT_BUFFERS|| \
+    output_file->write_queue_size>GT_MAX_OUTPUT_BUFFERS,OUTPUT_FILE_INCONSISTENCY)
 
 /*
  * Output File Setup
@@ -78,6 +87,8 @@ GT_INLINE gt_status gt_ofprintf(gt_output_file* const output_file,const char *te
 
 /*
  * Internal Buffers Accessors
+ *   Dumped buffers are handed to the writer thread of the output file (in order, for sorted files)
+ *   and a fresh buffer is returned, so the caller only waits if all the buffers are queued
  */
 GT_INLINE gt_output_buffer* gt_output_file_request_buffer(gt_output_file* const output_file);
 GT_INLINE void gt_output_file_release_buffer(
@@ -112,6 +112,53 @@
   #define gt_profiler_exit()
 #endif
 
+/*
+ * Stage Profiler (Runtime enabled, thread-safe)
+ *   Splits each thread's time into the stages of the tools' pipeline.
+ *   Stages nest (e.g. an output-wait triggered while formatting) and time is
+ *   always accounted to the innermost stage, so per-thread stage times add up to
+ *   the thread's lifetime. Anything outside the other stages is GT_STAGE_PROCESS.
+ *   Counters are per-thread (no sharing) and merged when reported.
+ *   Clock is CLOCK_MONOTONIC (or the TSC if compiled with -DGT_PROFILE_RDTSC)
+ */
+typedef enum {
+  GT_STAGE_PROCESS,     // Default (tool's own work)
+  GT_STAGE_INPUT_WAIT,  // Waiting for/reading input blocks
+  GT_STAGE_PARSE,       // Parsing records
+  GT_STAGE_FORMAT,      // Printing records
+  GT_STAGE_OUTPUT_WAIT, // Waiting for/writing output buffers
+  GT_STAGE_NUM_STAGES
+} gt_stage;
+#define GT_STAGE_NESTING_DEPTH 16
+
+extern bool gt_profiler_stages_enabled;
+
+/* Marks (@gt_profiler_stage_begin & @gt_profiler_stage_end must be paired) */
+#define GT_STAGE_PROF_BEGIN(stage) if (gt_expect_false(gt_profiler_stages_enabled)) gt_profiler_stage_begin(stage)
+#define GT_STAGE_PROF_END(stage) if (gt_expect_false(gt_profiler_stages_enabled)) gt_profiler_stage_end(stage)
+/* Stage lasting until the end of the enclosing scope (handy with multiple returns) */
+#define GT_STAGE_PROF_SCOPE(stage) \
+  gt_stage __gt_stage_scope __attribute__((cleanup(gt_profiler_stage_scope_end),unused)) = \
+    gt_profiler_stage_scope_begin(stage)
+
+void gt_profiler_stage_begin(const gt_stage stage);
+void gt_profiler_stage_end(const gt_stage stage);
+gt_stage gt_profiler_stage_scope_begin(const gt_stage stage);
+void gt_profiler_stage_scope_end(gt_stage* const stage);
 
+/*
+ * Setup & Report
+ *   Threads account their stages without locking, so the figures (and @gt_profiler_stages_destroy)
+ *   are only consistent once the worker threads are joined (or idle, outside stage marks)
+ */
+void gt_profiler_stages_enable();
+void gt_profiler_stages_destroy();
+char* gt_profiler_stage_get_name(const gt_stage stage);
+char* gt_profiler_stages_get_clock_name();
+double gt_profiler_stages_get_wall_time();
+uint64_t gt_profiler_stages_get_num_threads();
+/* Per thread (thread_idx<num_threads) or merged (thread_idx==UINT64_MAX) figures. Time in seconds */
+void gt_profiler_stages_get_times(
+    const uint64_t thread_idx,double* const stage_time,uint64_t* const stage_calls);
 
 #endif /* GT_PROFILER_H_ */
@@ -0,0 +1,45 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_record_sort.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: External sort of MAP/SAM records by tag under a memory budget
+ *   Reader threads copy the records (lines) into private buffers which, once full, are
+ *   sorted and spilled into a temporal run file (with a sparse index of its keys). Runs are
+ *   then k-way merged in parallel, each thread merging a key range (cut at the sampled keys
+ *   of the runs) into its own block of the sorted output file. Too many runs are first merged
+ *   down (the smallest ones, in intermediate passes) so open files and merge buffers stay bounded.
+ *   Records with the same tag keep their input order (i.e. the lines of a SAM template stay
+ *   together and in order).
+ */
+
+#ifndef GT_RECORD_SORT_H_
+#define GT_RECORD_SORT_H_
+
+#include "gt_essentials.h"
+#include "gt_input_file.h"
+#include "gt_output_file.h"
+
+#define GT_RECORD_SORT_DEFAULT_MEMORY ((uint64_t)768*1024*1024)
+
+/*
+ * Sort key: the tag of the record (up to the first TAB or SPACE) without the
+ * "/1" or "/2" suffix of the ends of a pair
+ */
+GT_INLINE uint64_t gt_record_sort_get_key_length(const char* const record,const uint64_t length);
+GT_INLINE int gt_record_sort_cmp_keys(
+    const char* const key_a,const uint64_t length_a,const char* const key_b,const uint64_t length_b);
+
+/*
+ * Sorts the records of @input_file (MAP or SAM) by key into @output_file (must be a SORTED_FILE).
+ * SAM headers are copied first, as they are. @memory_budget bounds the records buffered in memory
+ * (the rest goes to temporal files in gt_mm_get_tmp_folder()) plus the read-ahead buffers of the
+ * merge (up to 1/4 of it). Small budgets are rounded up to a minimum per thread (256KB of records
+ * and 64x64KB of read-ahead). A few fixed-size I/O buffers per thread are not counted.
+ * Returns the number of records sorted
+ */
+GT_INLINE uint64_t gt_record_sort(
+    gt_input_file* const input_file,gt_output_file* const output_file,
+    const uint64_t memory_budget,const uint64_t num_threads);
+
+#endif /* GT_RECORD_SORT_H_ */
@@ -0,0 +1,46 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_scan.h
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Vectorized (SSE2/AVX2) character scanning primitives used by
+ *   the input file block splitting and the MAP/SAM/FASTQ field tokenizers
+ */
+
+#ifndef GT_SCAN_H_
+#define GT_SCAN_H_
+
+#include "gt_commons.h"
+
+/*
+ * Target dependent scanning width
+ */
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define GT_SCAN_VECTOR_WIDTH 32
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+  #define GT_SCAN_VECTOR_WIDTH 16
+#else
+  #define GT_SCAN_VECTOR_WIDTH 8
+#endif
+
+/*
+ * Bounded scanning [begin,end)
+ *   Returns a pointer to the first matching character, or @end if none
+ */
+GT_INLINE const char* gt_scan_eol(const char* const begin,const char* const end);
+GT_INLINE const char* gt_scan_eol_count(
+    const char* const begin,const char* const end,const char counted_char,uint64_t* const count);
+GT_INLINE const char* gt_scan_chr3(
+    const char* const begin,const char* const end,const char c1,const char c2,const char c3);
+GT_INLINE uint64_t gt_scan_count(const char* const begin,const char* const end,const char counted_char);
+
+/*
+ * Unbounded scanning (text terminated by EOL or EOS)
+ *   Returns a pointer to the first occurrence of {c1,c2,EOL,EOS}
+ *   Vector loads are always aligned, so they never cross into an unmapped page
+ */
+GT_INLINE const char* gt_scan_until(const char* const text,const char c1,const char c2);
+
+#endif /* GT_SCAN_H_ */
@@ -12,6 +12,7 @@
 
 #include "gt_essentials.h"
 #include "gt_segmented_sequence.h"
+#include "gt_contig_dictionary.h"
 #include "gt_dna_string.h"
 
 /*
@@ -28,6 +29,7 @@ typedef struct {
   gt_sequence_archive_t sequence_archive_type;
   /* GT_CDNA_ARCHIVE */
   gt_shash* sequences; /* (gt_segmented_sequence*<gt_compact_dna_string>) */
+  gt_vector* contig_sequences; /* (gt_segmented_sequence*) indexed by contig ID (NULL if not present) */
   /* GT_BED_ARCHIVE */
   gt_shash* bed_intervals; /* (gt_vector*<gem_loc_t>) */
   uint64_t* bed; /* (GEMBitmap*) */
@@ -76,6 +78,7 @@ GT_INLINE void gt_sequence_archive_delete(gt_sequence_archive* const seq_archive
 GT_INLINE void gt_sequence_archive_add_segmented_sequence(gt_sequence_archive* const seq_archive,gt_segmented_sequence* const sequence);
 GT_INLINE void gt_sequence_archive_remove_segmented_sequence(gt_sequence_archive* const seq_archive,char* const seq_id);
 GT_INLINE gt_segmented_sequence* gt_sequence_archive_get_segmented_sequence(gt_sequence_archive* const seq_archive,char* const seq_id);
+GT_INLINE gt_segmented_sequence* gt_sequence_archive_get_contig_sequence(gt_sequence_archive* const seq_archive,const uint32_t contig_id);
 /* GT_BED_ARCHIVE */
 GT_INLINE void gt_sequence_archive_add_bed_sequence(gt_sequence_archive* const seq_archive,gt_segmented_sequence* const sequence);
 GT_INLINE void gt_sequence_archive_remove_bed_sequence(gt_sequence_archive* const seq_archive,char* const seq_id);
@@ -91,6 +94,9 @@ GT_INLINE gt_status gt_sequence_archive_get_sequence_string(
 GT_INLINE gt_status gt_sequence_archive_retrieve_sequence_chunk(
     gt_sequence_archive* const seq_archive,char* const seq_id,const gt_strand strand,
     const uint64_t position,const uint64_t length,const uint64_t extra_length,gt_string* const string);
+GT_INLINE gt_status gt_sequence_archive_retrieve_contig_chunk(
+    gt_sequence_archive* const seq_archive,const uint32_t contig_id,const gt_strand strand,
+    const uint64_t position,const uint64_t length,const uint64_t extra_length,gt_string* const string);
 
 /*
  * SequenceARCHIVE sorting functions
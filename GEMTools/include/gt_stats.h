@@ -11,6 +11,7 @@
 
 #include "gt_commons.h"
 #include "gt_compact_dna_string.h"
+#include "gt_cycle_stats.h"
 #include "gt_alignment_utils.h"
 #include "gt_template_utils.h"
 
@@ -210,6 +211,24 @@ typedef struct {
   uint64_t pe_rm_rm;
 } gt_splitmaps_profile;
 
+/*
+ * Global diversity set
+ *   Set of sequence names shared by all the stats of a parallel run. It is split into
+ *   independently locked shards so threads seldom contend for the same lock
+ */
+#define GT_STATS_DIVERSITY_NUM_SHARDS 16
+typedef struct {
+  pthread_mutex_t mutex;
+  gt_shash* sequences;
+} gt_diversity_shard;
+typedef struct {
+  gt_diversity_shard shards[GT_STATS_DIVERSITY_NUM_SHARDS];
+} gt_diversity_set;
+typedef struct {
+  gt_string* seq_name;
+  uint64_t count;
+} gt_diversity_counter;
+
 typedef struct {
   // Diversity
   uint64_t* local_diversity;           /* GT_STATS_DIVERSITY_RANGE */
@@ -220,8 +239,10 @@ typedef struct {
   uint64_t num_map_quimeras;
   uint64_t num_pair_quimeras;
   // Aux
-  gt_shash* _local_diversity_hash;    // Auxiliary hash for diversity
-  gt_shash* _global_diversity_hash;   // Auxiliary hash for diversity
+  gt_vector* _local_diversity;         // Sequences of the current template (gt_diversity_counter)
+  gt_shash* _global_diversity_hash;    // Sequences already published into @_global_diversity
+  gt_diversity_set* _global_diversity; // Global set of sequences (possibly shared)
+  bool _global_diversity_owner;
 } gt_population_profile;
 
 typedef struct {
@@ -257,6 +278,8 @@ typedef struct {
   gt_splitmaps_profile* splitmaps_profile;
   // Population profile
   gt_population_profile* population_profile;
+  // Histograms memory block (backs all the histograms above)
+  uint64_t* histograms;
 } gt_stats;
 
 typedef struct {
@@ -287,12 +310,15 @@ typedef struct {
  * STATS Profile
  */
 GT_INLINE gt_stats* gt_stats_new();
+GT_INLINE gt_stats* gt_stats_new_shared(gt_stats* const stats_master);
 GT_INLINE void gt_stats_clear(gt_stats *stats);
 GT_INLINE void gt_stats_delete(gt_stats *stats);
 
 /*
  * STATS Merge
+ *   Reduces @stats[1..stats_array_size) into @stats[0] (pairwise, in parallel) and deletes them
  */
+GT_INLINE void gt_stats_merge_pair(gt_stats* const stats_dst,gt_stats* const stats_src);
 void gt_stats_merge(gt_stats** const stats,const uint64_t stats_array_size);
 
 /*
@@ -35,6 +35,8 @@ typedef struct {
   gt_attributes* attributes;
   /* Hashed Dictionary */
   gt_template_dictionary* alg_dictionary;
+  /* Duplicates Index (Lazily built, see @gt_template_find_mmap_fx) */
+  gt_map_index* mmap_index;
 } gt_template;
 typedef struct {
   uint64_t distance;
@@ -160,6 +162,7 @@ GT_INLINE gt_map** gt_template_get_mmap_primary(gt_template* const template);
  */
 GT_INLINE uint64_t gt_template_get_num_mmaps(gt_template* const template);
 GT_INLINE void gt_template_clear_mmaps(gt_template* const template);
+GT_INLINE void gt_template_invalidate_mmap_index(gt_template* const template); /* After reordering/removing mmaps */
 /* MMap attributes */
 GT_INLINE void gt_template_mmap_attributes_clear(gt_mmap_attributes* const mmap_attributes);
 /* MMap record */
@@ -79,9 +79,13 @@ GT_INLINE bool gt_template_get_next_matching_strata(
 
 /*
  * Template's Maps Sorting
+ *   @gt_template_reduce_mmaps_by_distance__score() is the partial selection counterpart of
+ *     sorting and then calling @gt_template_reduce_mmaps()
  */
 GT_INLINE void gt_template_sort_by_distance__score(gt_template* const template);
 GT_INLINE void gt_template_sort_by_distance__score_no_split(gt_template* const template);
+GT_INLINE void gt_template_reduce_mmaps_by_distance__score(gt_template* const template,const uint64_t max_num_matches);
+GT_INLINE void gt_template_reduce_mmaps_by_distance__score_no_split(gt_template* const template,const uint64_t max_num_matches);
 
 /*
  * Template's MMaps Utils
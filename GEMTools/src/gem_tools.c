@@ -24,6 +24,9 @@ gt_option gt_filter_options[] = {
   { 203, "discarded-output", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "" , "" },
   { 204, "no-output", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 2 , true, "" , "" },
   { 205, "check-duplicates", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 2 , true, "" , "Check for duplicated mappings" },
+  { 206, "i2", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file> (end/2 when both ends are in separate files. Implies --paired-end)" , "" },
+  { 207, "sample-input", GT_OPT_REQUIRED, GT_OPT_INT, 2 , true, "<number> (read ~<number> records from chunks spread over the file)" , "" },
+  { 208, "route", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<class>,<file>[,'FASTA'|'MAP'|'SAM'][,'gzip'|'bzip2'] (repeatable)" , "Write templates to the first matching route (classes 'unmapped'|'mapped'|'unique'|'multimap'|'split'|'contig=<name>'|'any'). Unrouted templates go to --output" },
   /* Filter Read/Qualities */
   { 300, "hard-trim", GT_OPT_REQUIRED, GT_OPT_FLOAT, 3 , true, "<left>,<right>" , "" },
   { 301, "quality-trim", GT_OPT_REQUIRED, GT_OPT_FLOAT, 3 , false, "<quality-threshold>,<min-read-length>" , "" },
@@ -88,6 +91,9 @@ gt_option gt_filter_options[] = {
   { 900, "split-reads", GT_OPT_REQUIRED, GT_OPT_NONE, 9 , true, "<number>[,'lines'|'files'] (default=files)" , "" },
   { 901, "sample-read", GT_OPT_REQUIRED, GT_OPT_STRING, 9 , true, "<chunk_size>,<step_size>,<left_trim>,<right_trim>[,<min_remainder>]" , "" },
   { 902, "group-read-chunks", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 9 , true, "" , "" },
+  { 903, "sort-by-tag", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 9 , true, "(MAP/SAM records)" , "" },
+  { 904, "sort-memory", GT_OPT_REQUIRED, GT_OPT_STRING, 9 , true, "<size>[K|M|G] (default=768M, buffered records and merge read-ahead)" , "" },
+  { 905, "tmp-folder", GT_OPT_REQUIRED, GT_OPT_STRING, 9 , true, "<path> (default=/tmp/)" , "" },
   /* Display/Information */
   { 1000, "error-plot", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 10 , false, "" , "" },
   { 1001, "insert-size-plot", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 10 , false, "" , "" },
@@ -98,6 +104,8 @@ gt_option gt_filter_options[] = {
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 11 , true, "" , "" },
 #endif
   { 'v', "verbose", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , true, "" , "" },
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , true, "(print a JSON per-stage timing breakdown to stderr on exit)" , "" },
+  { 1101, "numa", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , true, "(pin threads per NUMA node and load the reference/annotation once per node)" , "" },
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , true, "" , "" },
   { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , false, "" , "" },
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 11 , false, "" , "" },
@@ -130,6 +138,7 @@ gt_option gt_stats_options[] = {
   { 'I', "gem-index", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , false, "<file> (GEM2-Index)" , "" },
   { 'p', "paired-end", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 2 , true, "" , "" },
   { 'n', "num-reads", GT_OPT_REQUIRED, GT_OPT_INT, 2 , true, "<number>" , "" },
+  { 201, "sample-input", GT_OPT_REQUIRED, GT_OPT_INT, 2 , true, "<number> (read ~<number> records from chunks spread over the file)" , "" },
   { 'o', "output", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file>" , "" },
   { 'f', "output-format", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "'report'|'json'|'both' (default='report')" , "" },
   /* Analysis */
@@ -143,14 +152,21 @@ gt_option gt_stats_options[] = {
   // { 'D', "indel-profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3, true, "", ""},
   /* MAP Specific */
   { 400, "use-only-decoded-maps", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "(instead of counters)", ""},
+  /* Snapshots */
+  { 500, "snapshot-reads", GT_OPT_REQUIRED, GT_OPT_INT, 5, true, "<number> (emit a JSON snapshot every <number> reads)", ""},
+  { 501, "snapshot-seconds", GT_OPT_REQUIRED, GT_OPT_FLOAT, 5, true, "<seconds> (emit a JSON snapshot every <seconds>)", ""},
+  { 502, "snapshot-output", GT_OPT_REQUIRED, GT_OPT_STRING, 5, true, "<file> (default=stderr)", ""},
+  { 503, "converge", GT_OPT_REQUIRED, GT_OPT_FLOAT, 5, true, "<tolerance> (stop once mapping-rate and insert-size are stable across snapshots)", ""},
   /* Misc */
-  { 'v', "verbose", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "", ""},
+  { 'v', "verbose", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6, true, "", ""},
 #ifdef HAVE_OPENMP
-  { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 5, true, "", ""},
+  { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 6, true, "", ""},
 #endif
-  { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "", ""},
-  { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
-  { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
+  { 1101, "numa", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6, true, "(pin threads per NUMA node and load the reference once per node)", ""},
+  { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6, true, "", ""},
+  { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6 , false, "" , "" },
+  { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 6 , false, "" , "" },
   {  0, "", 0, 0, 0, false, "", ""}
 };
 char* gt_stats_options_short = "i:r:I:pn:o:f:aMTQRPDvt:hH";
@@ -159,7 +175,9 @@ char* gt_stats_groups[] = {
   /*  1 */ "Unclassified",
   /*  2 */ "I/O",
   /*  3 */ "Analysis",
-  /*  4 */ "Misc"
+  /*  4 */ "MAP Specific",
+  /*  5 */ "Snapshots",
+  /*  6 */ "Misc"
 };
 
 /*
@@ -180,8 +198,8 @@ gt_option gt_mapset_options[] = {
       "     [Map Specific]\n"
       "        merge-map\n" , "" },
   /* I/O */
-  { 300, "i1", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
-  { 301, "i2", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
+  { 300, "i1", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>|'-' (merge-map: master)" , "" },
+  { 301, "i2", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>|'-' (merge-map: slave, can be repeated to merge all the slaves in one pass)" , "" },
   { 'p', "paired-end", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "" },
   { 302, "mmap-input", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , false, "" , "" },
   { 'o', "output", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
@@ -194,6 +212,7 @@ gt_option gt_mapset_options[] = {
 #ifdef HAVE_OPENMP
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 5, true, "", ""},
 #endif
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "", ""},
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
   {  0, "", 0, 0, 0, false, "", ""}
@@ -217,6 +236,7 @@ gt_option gt_scorereads_options[] = {
   { 300, "i1", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
   { 301, "i2", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
   { 'i', "insert-dist", GT_OPT_REQUIRED, GT_OPT_STRING, 3 , true, "<file>" , "" },
+  { 404, "learn-insert-dist", GT_OPT_REQUIRED, GT_OPT_INT, 3 , true, "<num_pairs> (learn it from the first uniquely mapped pairs of the input)" , "" },
   { 'p', "paired-end", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "" },
   { 'z', "gzip", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "" },
   { 'j', "bzip2", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "" },
@@ -235,6 +255,7 @@ gt_option gt_scorereads_options[] = {
 #ifdef HAVE_OPENMP
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 5, true, "", ""},
 #endif
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "", ""},
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
   {  0, "", 0, 0, 0, false, "", ""}
@@ -279,6 +300,8 @@ gt_option gt_map2sam_options[] = {
 #ifdef HAVE_OPENMP
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 7, true, "", ""},
 #endif
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 7, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
+  { 1101, "numa", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 7, true, "(pin threads per NUMA node)", ""},
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 7, true, "", ""},
   { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 7 , false, "" , "" },
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
@@ -318,6 +341,8 @@ gt_option gt_gtfcount_options[] = {
   { 'c', "coverage", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "", "Compute coverage profiles (stored in JSON output)"},
   { 'v', "verbose", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "", ""},
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 4, true, "", ""},
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
+  { 1101, "numa", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "(pin threads per NUMA node and load the annotation once per node)", ""},
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "", ""},
   { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4 , false, "" , "" },
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4 , false, "" , "" },
@@ -345,6 +370,7 @@ gt_option gt_region_options[] = {
   /* Misc */
   { 'g', "gene-id", GT_OPT_REQUIRED, GT_OPT_NONE, 5 , true, "" , "" },
   { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 5, true, "", ""},
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
   { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5, true, "", ""},
   { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 5 , false, "" , "" },
   { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , false, "" , "" },
@@ -360,6 +386,42 @@ char* gt_region_groups[] = {
   /*  5 */ "Misc",
 };
 
+/*
+ * gt.junctions menu options
+ */
+gt_option gt_junctions_options[] = {
+  /* I/O */
+  { 'i', "input", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file> (MAP/SAM)" , "" },
+  { 'o', "output", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file>" , "" },
+  { 'j', "junctions", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file> (merge a junctions file, can be repeated)" , "" },
+  { 'a', "annotation", GT_OPT_REQUIRED, GT_OPT_STRING, 2 , true, "<file>" , "GTF annotation" },
+  { 'p', "paired-end", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 2 , true, "" , "" },
+  { 200, "mmap-input", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 2 , false, "" , "" },
+  /* Junctions */
+  { 300, "min-split-size", GT_OPT_REQUIRED, GT_OPT_INT, 3 , true, "<number> (default=4)" , "Minimum length of the blocks around the junction" },
+  { 301, "max-split-size", GT_OPT_REQUIRED, GT_OPT_INT, 3 , true, "<number> (default=2500000)" , "Maximum intron length" },
+  { 'm', "max-matches", GT_OPT_REQUIRED, GT_OPT_INT, 3 , true, "<number> (default=1)" , "Skip reads with more maps" },
+  { 'c', "coverage", GT_OPT_REQUIRED, GT_OPT_INT, 3 , true, "<number> (default=0)" , "Minimum support of novel junctions (annotated sites are always kept)" },
+  { 302, "add-annotation", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "Add all the introns of the annotation" },
+  { 's', "print-support", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 3 , true, "" , "Add the support and the annotation status columns" },
+  /* Misc */
+  { 'v', "verbose", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "", ""},
+  { 't', "threads", GT_OPT_REQUIRED, GT_OPT_INT, 4, true, "", ""},
+  { 1100, "profile", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "(print a JSON per-stage timing breakdown to stderr on exit)", ""},
+  { 'h', "help", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4, true, "", ""},
+  { 'H', "help-full", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4 , false, "" , "" },
+  { 'J', "help-json", GT_OPT_NO_ARGUMENT, GT_OPT_NONE, 4 , false, "" , "" },
+  {  0, "", 0, 0, 0, false, "", ""}
+};
+char* gt_junctions_options_short = "i:o:j:a:pm:c:svt:hHJ";
+char* gt_junctions_groups[] = {
+  /*  0 */ "Null",
+  /*  1 */ "Unclassified",
+  /*  2 */ "I/O",
+  /*  3 */ "Junctions",
+  /*  4 */ "Misc",
+};
+
 
 
 GT_INLINE uint64_t gt_options_get_num_options(const gt_option* const options) {
@@ -28,6 +28,7 @@ GT_INLINE gt_alignment* gt_alignment_new() {
   alignment->maps = gt_vector_new(GT_ALIGNMENT_NUM_INITIAL_MAPS,sizeof(gt_map));
   alignment->attributes = gt_attributes_new();
   alignment->alg_dictionary = NULL;
+  alignment->map_index = NULL;
   return alignment;
 }
 GT_INLINE void gt_alignment_clear_handler(gt_alignment* const alignment) {
@@ -55,6 +56,7 @@ GT_INLINE void gt_alignment_delete(gt_alignment* const alignment) {
   gt_vector_delete(alignment->maps);
   gt_attributes_delete(alignment->attributes);
   if (alignment->alg_dictionary!=NULL) gt_alignment_dictionary_delete(alignment->alg_dictionary);
+  if (alignment->map_index!=NULL) gt_map_index_delete(alignment->map_index);
   gt_free(alignment);
 }
 
@@ -216,6 +218,10 @@ GT_INLINE void gt_alignment_set_map(gt_alignment* const alignment,gt_map* const
   GT_MAP_CHECK(map);
   // Insert the map
   *gt_vector_get_elm(alignment->maps,position,gt_map*) = map;
+  // Keep the index up to date
+  if (alignment->map_index!=NULL && position < alignment->map_index->num_indexed) {
+    gt_map_index_add(alignment->map_index,gt_map_index_map_key(map),position);
+  }
 }
 GT_INLINE void gt_alignment_clear_maps(gt_alignment* const alignment) {
   GT_ALIGNMENT_CHECK(alignment);
@@ -223,6 +229,11 @@ GT_INLINE void gt_alignment_clear_maps(gt_alignment* const alignment) {
     gt_map_delete(*alg_map);
   }
   gt_vector_clear(alignment->maps);
+  gt_alignment_invalidate_map_index(alignment);
+}
+GT_INLINE void gt_alignment_invalidate_map_index(gt_alignment* const alignment) {
+  GT_ALIGNMENT_CHECK(alignment);
+  if (alignment->map_index!=NULL) gt_map_index_clear(alignment->map_index);
 }
 GT_INLINE bool gt_alignment_locate_map_reference(gt_alignment* const alignment,gt_map* const map,uint64_t* const position) {
   GT_ALIGNMENT_CHECK(alignment);
@@ -87,6 +87,31 @@ GT_INLINE void gt_alignment_insert_map_fx_gt_vector(
   }
 }
 
+GT_INLINE bool gt_alignment_find_map_indexed(
+    gt_alignment* const alignment,gt_map* const map,uint64_t* const found_map_pos,gt_map** const found_map) {
+  // Index the maps added since the last search
+  if (alignment->map_index==NULL) alignment->map_index = gt_map_index_new();
+  gt_map_index* const map_index = alignment->map_index;
+  const uint64_t num_maps = gt_alignment_get_num_maps(alignment);
+  if (num_maps < map_index->num_indexed) gt_map_index_clear(map_index);
+  gt_map** const maps = gt_vector_get_mem(alignment->maps,gt_map*);
+  uint64_t pos;
+  for (pos=map_index->num_indexed;pos<num_maps;++pos) {
+    gt_map_index_add(map_index,gt_map_index_map_key(maps[pos]),pos);
+  }
+  map_index->num_indexed = num_maps;
+  // Confirm the candidates (keeping the first occurrence, as the linear scan does)
+  const uint64_t key = gt_map_index_map_key(map);
+  uint64_t slot = gt_map_index_probe_begin(map_index,key);
+  uint64_t candidate_pos, first_pos = GT_MAP_INDEX_NOT_FOUND;
+  while ((candidate_pos=gt_map_index_probe(map_index,key,&slot))!=GT_MAP_INDEX_NOT_FOUND) {
+    if (candidate_pos<first_pos && gt_map_cmp(maps[candidate_pos],map)==0) first_pos = candidate_pos;
+  }
+  if (first_pos==GT_MAP_INDEX_NOT_FOUND) return false;
+  *found_map_pos = first_pos;
+  *found_map = maps[first_pos];
+  return true;
+}
 GT_INLINE bool gt_alignment_find_map_fx(
     int64_t (*gt_map_cmp_fx)(gt_map*,gt_map*),gt_alignment* const alignment,gt_map* const map,
     uint64_t* const found_map_pos,gt_map** const found_map) {
@@ -96,6 +121,10 @@ GT_INLINE bool gt_alignment_find_map_fx(
   // Search for the map
   uint64_t pos = 0;
   if(alignment->alg_dictionary == NULL || alignment->alg_dictionary->refs_dictionary == NULL){
+    // Hashed search (only valid for exact comparisons)
+    if (gt_map_cmp_fx==gt_map_cmp && gt_alignment_get_num_maps(alignment) >= GT_MAP_INDEX_THRESHOLD) {
+      return gt_alignment_find_map_indexed(alignment,map,found_map_pos,found_map);
+    }
     GT_ALIGNMENT_ITERATE(alignment,map_it) {
       if (gt_map_cmp_fx(map_it,map)==0) {
         *found_map_pos = pos;
@@ -145,6 +174,7 @@ GT_INLINE void gt_alignment_reduce_maps(gt_alignment* const alignment,const uint
     }
     // Shrink maps vector
     gt_vector_set_used(alignment->maps,max_num_matches);
+    gt_alignment_invalidate_map_index(alignment);
   }
 }
 
@@ -211,35 +241,91 @@ GT_INLINE bool gt_alignment_get_next_matching_strata(
  *                n if (a>b)
  *                0 if (a==b)
  */
-int gt_alignment_cmp_distance__score(gt_map** const map_a,gt_map** const map_b) {
+GT_INLINE bool gt_sort_key_lt(const gt_sort_key* const key_a,const gt_sort_key* const key_b) {
   // Sort by distance
-  const int64_t distance_a = gt_map_get_global_distance(*map_a);
-  const int64_t distance_b = gt_map_get_global_distance(*map_b);
-  if (distance_a != distance_b) return distance_a-distance_b;
-  // Sort by score (here we cannot do the trick as gt_score fills the whole uint64_t range)
-  const uint64_t score_a = (*map_a)->gt_score;
-  const uint64_t score_b = (*map_b)->gt_score;
-  return (score_a > score_b) ? -1 : (score_a < score_b ? 1 : 0);
-}
-int gt_alignment_cmp_distance__score_no_split(gt_map** const map_a,gt_map** const map_b) {
-  // Sort by distance
-  const int64_t distance_a = gt_map_get_no_split_distance(*map_a);
-  const int64_t distance_b = gt_map_get_no_split_distance(*map_b);
-  if (distance_a != distance_b) return distance_a-distance_b;
-  // Sort by score (here we cannot do the trick as gt_score fills the whole uint64_t range)
-  const uint64_t score_a = (*map_a)->gt_score;
-  const uint64_t score_b = (*map_b)->gt_score;
-  return (score_a > score_b) ? -1 : (score_a < score_b ? 1 : 0);
+  if (key_a->distance != key_b->distance) return key_a->distance < key_b->distance;
+  // Sort by score (descending)
+  if (key_a->score != key_b->score) return key_a->score > key_b->score;
+  // Keep the original order
+  return key_a->position < key_b->position;
+}
+int gt_sort_key_cmp(const gt_sort_key* const key_a,const gt_sort_key* const key_b) {
+  return gt_sort_key_lt(key_a,key_b) ? -1 : (gt_sort_key_lt(key_b,key_a) ? 1 : 0);
+}
+GT_INLINE void gt_sort_keys_swap(gt_sort_key* const key_a,gt_sort_key* const key_b) {
+  const gt_sort_key key = *key_a;
+  *key_a = *key_b;
+  *key_b = key;
+}
+GT_INLINE void gt_sort_keys_select(gt_sort_key* const keys,const uint64_t num_keys,const uint64_t num_selected) {
+  if (num_selected==0) return;
+  // Quickselect the @num_selected smallest keys into the front (all keys are distinct)
+  if (num_selected < num_keys) {
+    const uint64_t nth = num_selected;
+    uint64_t lo = 0, hi = num_keys-1;
+    while (lo < hi) {
+      // Median of three (left at @hi)
+      const uint64_t mid = lo+(hi-lo)/2;
+      if (gt_sort_key_lt(keys+mid,keys+lo)) gt_sort_keys_swap(keys+mid,keys+lo);
+      if (gt_sort_key_lt(keys+hi,keys+lo)) gt_sort_keys_swap(keys+hi,keys+lo);
+      if (gt_sort_key_lt(keys+mid,keys+hi)) gt_sort_keys_swap(keys+mid,keys+hi);
+      // Partition
+      uint64_t i, store = lo;
+      for (i=lo;i<hi;++i) {
+        if (gt_sort_key_lt(keys+i,keys+hi)) gt_sort_keys_swap(keys+i,keys+(store++));
+      }
+      gt_sort_keys_swap(keys+store,keys+hi);
+      if (store==nth) break;
+      if (store < nth) lo = store+1; else hi = store-1;
+    }
+  }
+  // Sort the selected ones
+  qsort(keys,num_selected,sizeof(gt_sort_key),(int (*)(const void *,const void *))gt_sort_key_cmp);
 }
-GT_INLINE void gt_alignment_sort_by_distance__score(gt_alignment* const alignment) {
+#define GT_SORT_KEYS_STACK 32
+GT_INLINE void gt_alignment_select_by_distance__score(
+    gt_alignment* const alignment,const uint64_t max_num_matches,const bool no_split) {
   GT_ALIGNMENT_CHECK(alignment);
-  qsort(gt_vector_get_mem(alignment->maps,gt_map*),gt_vector_get_used(alignment->maps),
-      sizeof(gt_map*),(int (*)(const void *,const void *))gt_alignment_cmp_distance__score);
+  const uint64_t num_maps = gt_alignment_get_num_maps(alignment);
+  if (num_maps==0) return;
+  const uint64_t num_selected = GT_MIN(max_num_matches,num_maps);
+  // Compute keys
+  gt_sort_key keys_stack[GT_SORT_KEYS_STACK];
+  gt_map* selected_stack[GT_SORT_KEYS_STACK];
+  const bool on_stack = (num_maps <= GT_SORT_KEYS_STACK);
+  gt_sort_key* const keys = (on_stack) ? keys_stack : gt_calloc(num_maps,gt_sort_key,false);
+  gt_map** const selected = (on_stack) ? selected_stack : gt_calloc(num_selected,gt_map*,false);
+  gt_map** const maps = gt_vector_get_mem(alignment->maps,gt_map*);
+  uint64_t i;
+  for (i=0;i<num_maps;++i) {
+    keys[i].distance = (no_split) ? gt_map_get_no_split_distance(maps[i]) : gt_map_get_global_distance(maps[i]);
+    keys[i].score = maps[i]->gt_score;
+    keys[i].position = i;
+  }
+  // Select
+  gt_sort_keys_select(keys,num_maps,num_selected);
+  for (i=num_selected;i<num_maps;++i) gt_map_delete(maps[keys[i].position]);
+  for (i=0;i<num_selected;++i) selected[i] = maps[keys[i].position];
+  memcpy(maps,selected,num_selected*sizeof(gt_map*));
+  gt_vector_set_used(alignment->maps,num_selected);
+  gt_alignment_invalidate_map_index(alignment);
+  // Free
+  if (!on_stack) {
+    gt_free(keys);
+    gt_free(selected);
+  }
+}
+GT_INLINE void gt_alignment_sort_by_distance__score(gt_alignment* const alignment) {
+  gt_alignment_select_by_distance__score(alignment,GT_ALL,false);
 }
 GT_INLINE void gt_alignment_sort_by_distance__score_no_split(gt_alignment* const alignment) {
-  GT_ALIGNMENT_CHECK(alignment);
-  qsort(gt_vector_get_mem(alignment->maps,gt_map*),gt_vector_get_used(alignment->maps),
-      sizeof(gt_map*),(int (*)(const void *,const void *))gt_alignment_cmp_distance__score_no_split);
+  gt_alignment_select_by_distance__score(alignment,GT_ALL,true);
+}
+GT_INLINE void gt_alignment_reduce_maps_by_distance__score(gt_alignment* const alignment,const uint64_t max_num_matches) {
+  gt_alignment_select_by_distance__score(alignment,max_num_matches,false);
+}
+GT_INLINE void gt_alignment_reduce_maps_by_distance__score_no_split(gt_alignment* const alignment,const uint64_t max_num_matches) {
+  gt_alignment_select_by_distance__score(alignment,max_num_matches,true);
 }
 
 /*
@@ -46,10 +46,13 @@ GT_INLINE bool gt_buffered_input_file_eob(gt_buffered_input_file* const buffered
 GT_INLINE gt_status gt_buffered_input_file_get_block(
     gt_buffered_input_file* const buffered_input_file,const uint64_t num_lines) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_input_file);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
   gt_input_file* const input_file = buffered_input_file->input_file;
   // Read lines
   if (input_file->eof) return GT_BMI_EOF;
   gt_input_file_lock(input_file);
+  const uint64_t block_lines =
+      gt_input_file_sampling_next_lines(input_file,gt_expect_true(num_lines)?num_lines:GT_BMI_NUM_LINES);
   if (input_file->eof) {
     gt_input_file_unlock(input_file);
     return GT_BMI_EOF;
@@ -57,8 +60,7 @@ GT_INLINE gt_status gt_buffered_input_file_get_block(
   buffered_input_file->block_id = gt_input_file_next_id(input_file) % UINT32_MAX;
   buffered_input_file->current_line_num = input_file->processed_lines+1;
   buffered_input_file->lines_in_buffer =
-      gt_input_file_get_lines(input_file,buffered_input_file->block_buffer,
-          gt_expect_true(num_lines)?num_lines:GT_BMI_NUM_LINES);
+      gt_input_file_get_lines(input_file,buffered_input_file->block_buffer,block_lines);
   gt_input_file_unlock(input_file);
   // Setup the block
   buffered_input_file->cursor = gt_vector_get_mem(buffered_input_file->block_buffer,char);
@@ -67,6 +69,7 @@ GT_INLINE gt_status gt_buffered_input_file_get_block(
 GT_INLINE gt_status gt_buffered_input_file_add_lines_to_block(
     gt_buffered_input_file* const buffered_input_file,const uint64_t num_lines) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_input_file);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
   gt_input_file* const input_file = buffered_input_file->input_file;
   // Read lines
   if (input_file->eof) return GT_BMI_EOF;
@@ -0,0 +1,176 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_contig_dictionary.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Process-wide dictionary of sequence names (chromosomes,contigs,...)
+ */
+
+#include "gt_contig_dictionary.h"
+
+/*
+ * Constants
+ */
+#define GT_CONTIG_DICTIONARY_INITIAL_SLOTS 1024 /* Power of two */
+#define GT_CONTIG_DICTIONARY_BLOCK_SIZE 1024
+#define GT_CONTIG_DICTIONARY_MAX_BLOCKS 16384
+#define GT_CONTIG_DICTIONARY_EMPTY_SLOT UINT32_MAX
+
+/*
+ * Dictionary
+ *   - Open addressing (linear probing) table of IDs. Full tables are replaced by
+ *     a bigger copy and retired (not freed), so concurrent readers stay valid
+ *   - Names are stored in fixed-size blocks, so they never move once interned
+ */
+typedef struct {
+  uint64_t num_slots;
+  uint32_t* slots;
+} gt_contig_table;
+
+static pthread_mutex_t gt_contig_dictionary_mutex = PTHREAD_MUTEX_INITIALIZER;
+static gt_contig_table* gt_contig_dictionary_table = NULL;
+static gt_vector* gt_contig_dictionary_retired_tables = NULL; /* (gt_contig_table*) */
+static gt_string** gt_contig_dictionary_names[GT_CONTIG_DICTIONARY_MAX_BLOCKS];
+static uint64_t gt_contig_dictionary_num_contigs = 0;
+static gt_string gt_contig_dictionary_null_name = { .buffer="", .allocated=0, .length=0 };
+
+/*
+ * Internals
+ */
+GT_INLINE uint64_t gt_contig_dictionary_hash(const char* const name,const uint64_t length) {
+  uint64_t i, hash = 14695981039346656037ull; // FNV-1a
+  for (i=0;i<length;++i) {
+    hash ^= (uint8_t)name[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+GT_INLINE gt_string* gt_contig_dictionary_get_name_(const uint32_t contig_id) {
+  return gt_contig_dictionary_names[contig_id/GT_CONTIG_DICTIONARY_BLOCK_SIZE][contig_id%GT_CONTIG_DICTIONARY_BLOCK_SIZE];
+}
+GT_INLINE gt_contig_table* gt_contig_table_new(const uint64_t num_slots) {
+  gt_contig_table* const table = gt_alloc(gt_contig_table);
+  table->num_slots = num_slots;
+  table->slots = gt_malloc(num_slots*sizeof(uint32_t));
+  memset(table->slots,0xFF,num_slots*sizeof(uint32_t)); // All GT_CONTIG_DICTIONARY_EMPTY_SLOT
+  return table;
+}
+GT_INLINE void gt_contig_table_delete(gt_contig_table* const table) {
+  gt_free(table->slots);
+  gt_free(table);
+}
+GT_INLINE uint32_t gt_contig_table_lookup(
+    gt_contig_table* const table,const char* const name,const uint64_t length,const uint64_t hash,uint64_t* const free_slot) {
+  const uint64_t mask = table->num_slots-1;
+  uint64_t slot = hash & mask;
+  while (true) {
+    const uint32_t contig_id = __atomic_load_n(table->slots+slot,__ATOMIC_ACQUIRE);
+    if (contig_id==GT_CONTIG_DICTIONARY_EMPTY_SLOT) {
+      if (free_slot) *free_slot = slot;
+      return GT_CONTIG_DICTIONARY_EMPTY_SLOT;
+    }
+    gt_string* const contig_name = gt_contig_dictionary_get_name_(contig_id);
+    if (contig_name->length==length && memcmp(contig_name->buffer,name,length)==0) return contig_id;
+    slot = (slot+1) & mask;
+  }
+}
+GT_INLINE void gt_contig_table_insert(gt_contig_table* const table,const uint32_t contig_id) {
+  gt_string* const contig_name = gt_contig_dictionary_get_name_(contig_id);
+  uint64_t free_slot = 0;
+  gt_contig_table_lookup(table,contig_name->buffer,contig_name->length,
+      gt_contig_dictionary_hash(contig_name->buffer,contig_name->length),&free_slot);
+  __atomic_store_n(table->slots+free_slot,contig_id,__ATOMIC_RELEASE);
+}
+GT_INLINE uint32_t gt_contig_dictionary_add(const char* const name,const uint64_t length) {
+  // Store the name
+  const uint64_t contig_id = gt_contig_dictionary_num_contigs;
+  const uint64_t block = contig_id/GT_CONTIG_DICTIONARY_BLOCK_SIZE;
+  gt_cond_fatal_error(block>=GT_CONTIG_DICTIONARY_MAX_BLOCKS,CONTIG_DICTIONARY_FULL);
+  if (gt_contig_dictionary_names[block]==NULL) {
+    gt_contig_dictionary_names[block] = gt_calloc(GT_CONTIG_DICTIONARY_BLOCK_SIZE,gt_string*,true);
+  }
+  gt_string* const contig_name = gt_string_new(length+1);
+  gt_string_set_nstring(contig_name,(char*)name,length);
+  gt_contig_dictionary_names[block][contig_id%GT_CONTIG_DICTIONARY_BLOCK_SIZE] = contig_name;
+  __atomic_store_n(&gt_contig_dictionary_num_contigs,contig_id+1,__ATOMIC_RELEASE);
+  // Grow the table (keeping load under 1/2)
+  gt_contig_table* table = gt_contig_dictionary_table;
+  if (2*gt_contig_dictionary_num_contigs > table->num_slots) {
+    gt_contig_table* const new_table = gt_contig_table_new(2*table->num_slots);
+    uint64_t i;
+    for (i=0;i<contig_id;++i) gt_contig_table_insert(new_table,i);
+    gt_vector_insert(gt_contig_dictionary_retired_tables,table,gt_contig_table*);
+    __atomic_store_n(&gt_contig_dictionary_table,new_table,__ATOMIC_RELEASE);
+    table = new_table;
+  }
+  // Publish
+  gt_contig_table_insert(table,contig_id);
+  return contig_id;
+}
+GT_INLINE void gt_contig_dictionary_setup(void) {
+  if (gt_contig_dictionary_table!=NULL) return;
+  gt_contig_dictionary_retired_tables = gt_vector_new(10,sizeof(gt_contig_table*));
+  gt_contig_dictionary_names[0] = gt_calloc(GT_CONTIG_DICTIONARY_BLOCK_SIZE,gt_string*,true);
+  gt_contig_dictionary_names[0][GT_CONTIG_NULL] = &gt_contig_dictionary_null_name;
+  gt_contig_dictionary_num_contigs = 1;
+  gt_contig_table* const table = gt_contig_table_new(GT_CONTIG_DICTIONARY_INITIAL_SLOTS);
+  gt_contig_table_insert(table,GT_CONTIG_NULL);
+  __atomic_store_n(&gt_contig_dictionary_table,table,__ATOMIC_RELEASE);
+}
+
+/*
+ * Contig Dictionary
+ */
+GT_INLINE uint32_t gt_contig_dictionary_get_id(const char* const name,const uint64_t length) {
+  GT_NULL_CHECK(name);
+  const uint64_t hash = gt_contig_dictionary_hash(name,length);
+  // Lock-free lookup
+  gt_contig_table* const table = __atomic_load_n(&gt_contig_dictionary_table,__ATOMIC_ACQUIRE);
+  if (gt_expect_true(table!=NULL)) {
+    const uint32_t contig_id = gt_contig_table_lookup(table,name,length,hash,NULL);
+    if (gt_expect_true(contig_id!=GT_CONTIG_DICTIONARY_EMPTY_SLOT)) return contig_id;
+  }
+  // Intern new name (double-checked under the mutex)
+  uint32_t contig_id;
+  GT_BEGIN_MUTEX_SECTION(gt_contig_dictionary_mutex) {
+    gt_contig_dictionary_setup();
+    contig_id = gt_contig_table_lookup(gt_contig_dictionary_table,name,length,hash,NULL);
+    if (contig_id==GT_CONTIG_DICTIONARY_EMPTY_SLOT) contig_id = gt_contig_dictionary_add(name,length);
+  } GT_END_MUTEX_SECTION(gt_contig_dictionary_mutex);
+  return contig_id;
+}
+GT_INLINE gt_string* gt_contig_dictionary_get_name(const uint32_t contig_id) {
+  if (contig_id==GT_CONTIG_NULL) return &gt_contig_dictionary_null_name;
+  gt_fatal_check(contig_id>=__atomic_load_n(&gt_contig_dictionary_num_contigs,__ATOMIC_ACQUIRE),CONTIG_DICTIONARY_WRONG_ID,contig_id);
+  return gt_contig_dictionary_get_name_(contig_id);
+}
+GT_INLINE uint64_t gt_contig_dictionary_get_num_contigs(void) {
+  uint64_t num_contigs;
+  GT_BEGIN_MUTEX_SECTION(gt_contig_dictionary_mutex) {
+    num_contigs = (gt_contig_dictionary_table!=NULL) ? gt_contig_dictionary_num_contigs : 1;
+  } GT_END_MUTEX_SECTION(gt_contig_dictionary_mutex);
+  return num_contigs;
+}
+GT_INLINE void gt_contig_dictionary_destroy(void) {
+  GT_BEGIN_MUTEX_SECTION(gt_contig_dictionary_mutex) {
+    if (gt_contig_dictionary_table!=NULL) {
+      // Names
+      uint64_t i;
+      for (i=GT_CONTIG_NULL+1;i<gt_contig_dictionary_num_contigs;++i) {
+        gt_string_delete(gt_contig_dictionary_get_name_(i));
+      }
+      for (i=0;i<GT_CONTIG_DICTIONARY_MAX_BLOCKS && gt_contig_dictionary_names[i]!=NULL;++i) {
+        gt_free(gt_contig_dictionary_names[i]);
+        gt_contig_dictionary_names[i] = NULL;
+      }
+      gt_contig_dictionary_num_contigs = 0;
+      // Tables
+      GT_VECTOR_ITERATE(gt_contig_dictionary_retired_tables,retired_table,retired_pos,gt_contig_table*) {
+        gt_contig_table_delete(*retired_table);
+      }
+      gt_vector_delete(gt_contig_dictionary_retired_tables);
+      gt_contig_table_delete(gt_contig_dictionary_table);
+      gt_contig_dictionary_table = NULL;
+    }
+  } GT_END_MUTEX_SECTION(gt_contig_dictionary_mutex);
+}
@@ -0,0 +1,267 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_cycle_stats.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_cycle_stats.h"
+
+#define GT_CYCLE_MAX_BYTE_COUNT 255 /* Additions before the byte counters are flushed */
+
+/*
+ * Vector operators (byte lanes)
+ */
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define GT_CYCLE_SIMD
+  #define GT_CYCLE_VECTOR_WIDTH 32
+  typedef __m256i gt_cycle_vector;
+  #define GT_CYCLE_LOADU(address) _mm256_loadu_si256((const __m256i*)(address))
+  #define GT_CYCLE_STOREU(address,vector) _mm256_storeu_si256((__m256i*)(address),vector)
+  #define GT_CYCLE_SET1(character) _mm256_set1_epi8(character)
+  #define GT_CYCLE_ZERO() _mm256_setzero_si256()
+  #define GT_CYCLE_CMPEQ(vector_a,vector_b) _mm256_cmpeq_epi8(vector_a,vector_b)
+  #define GT_CYCLE_OR(vector_a,vector_b) _mm256_or_si256(vector_a,vector_b)
+  #define GT_CYCLE_AND(vector_a,vector_b) _mm256_and_si256(vector_a,vector_b)
+  #define GT_CYCLE_SUB(vector_a,vector_b) _mm256_sub_epi8(vector_a,vector_b)
+  #define GT_CYCLE_MASK(vector) ((uint64_t)(uint32_t)_mm256_movemask_epi8(vector))
+  #define GT_CYCLE_FULL_MASK ((uint64_t)0xFFFFFFFF)
+  #define GT_CYCLE_SAD_ADD(sum,vector) sum = _mm256_add_epi64(sum,_mm256_sad_epu8(vector,_mm256_setzero_si256()))
+  #define GT_CYCLE_SUM64(sum) \
+    ((uint64_t)_mm256_extract_epi64(sum,0)+(uint64_t)_mm256_extract_epi64(sum,1)+ \
+     (uint64_t)_mm256_extract_epi64(sum,2)+(uint64_t)_mm256_extract_epi64(sum,3))
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+  #define GT_CYCLE_SIMD
+  #define GT_CYCLE_VECTOR_WIDTH 16
+  typedef __m128i gt_cycle_vector;
+  #define GT_CYCLE_LOADU(address) _mm_loadu_si128((const __m128i*)(address))
+  #define GT_CYCLE_STOREU(address,vector) _mm_storeu_si128((__m128i*)(address),vector)
+  #define GT_CYCLE_SET1(character) _mm_set1_epi8(character)
+  #define GT_CYCLE_ZERO() _mm_setzero_si128()
+  #define GT_CYCLE_CMPEQ(vector_a,vector_b) _mm_cmpeq_epi8(vector_a,vector_b)
+  #define GT_CYCLE_OR(vector_a,vector_b) _mm_or_si128(vector_a,vector_b)
+  #define GT_CYCLE_AND(vector_a,vector_b) _mm_and_si128(vector_a,vector_b)
+  #define GT_CYCLE_SUB(vector_a,vector_b) _mm_sub_epi8(vector_a,vector_b)
+  #define GT_CYCLE_MASK(vector) ((uint64_t)(uint16_t)_mm_movemask_epi8(vector))
+  #define GT_CYCLE_FULL_MASK ((uint64_t)0xFFFF)
+  #define GT_CYCLE_SAD_ADD(sum,vector) sum = _mm_add_epi64(sum,_mm_sad_epu8(vector,_mm_setzero_si128()))
+  #define GT_CYCLE_SUM64(sum) \
+    ((uint64_t)_mm_cvtsi128_si64(sum)+(uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum,sum)))
+#else
+  #define GT_CYCLE_VECTOR_WIDTH 16
+#endif
+
+/*
+ * Base codes {N,A,C,G,T} (GT_CYCLE_BASE_ILLEGAL otherwise)
+ */
+#define GT_CYCLE_BASE_ILLEGAL ((uint8_t)0xFF)
+const uint8_t gt_cycle_base_encode[256] = {
+  [0 ... 255] = GT_CYCLE_BASE_ILLEGAL,
+  ['A'] = GT_CYCLE_BASE_A, ['C'] = GT_CYCLE_BASE_C, ['G'] = GT_CYCLE_BASE_G, ['T'] = GT_CYCLE_BASE_T, ['N'] = GT_CYCLE_BASE_N,
+  ['a'] = GT_CYCLE_BASE_A, ['c'] = GT_CYCLE_BASE_C, ['g'] = GT_CYCLE_BASE_G, ['t'] = GT_CYCLE_BASE_T, ['n'] = GT_CYCLE_BASE_N,
+};
+const char gt_cycle_base_lower_char[GT_CYCLE_NUM_BASES] = { 'n', 'a', 'c', 'g', 't' };
+
+/*
+ * Per-read counters
+ */
+GT_INLINE void gt_cycle_stats_count_bases(const char* const read,const uint64_t length,uint64_t* const nt_counting) {
+  GT_NULL_CHECK(read); GT_NULL_CHECK(nt_counting);
+  uint64_t num_a = 0, num_c = 0, num_g = 0, num_t = 0, pos = 0;
+#ifdef GT_CYCLE_SIMD
+  // Lower-case the chunk and count each base into byte counters (summed up every 255 chunks)
+  const gt_cycle_vector lower_case = GT_CYCLE_SET1(0x20);
+  const gt_cycle_vector base_a = GT_CYCLE_SET1('a'), base_c = GT_CYCLE_SET1('c');
+  const gt_cycle_vector base_g = GT_CYCLE_SET1('g'), base_t = GT_CYCLE_SET1('t');
+  while (pos+GT_CYCLE_VECTOR_WIDTH<=length) {
+    gt_cycle_vector count_a = GT_CYCLE_ZERO(), count_c = GT_CYCLE_ZERO();
+    gt_cycle_vector count_g = GT_CYCLE_ZERO(), count_t = GT_CYCLE_ZERO();
+    uint64_t num_chunks;
+    for (num_chunks=0;num_chunks<GT_CYCLE_MAX_BYTE_COUNT && pos+GT_CYCLE_VECTOR_WIDTH<=length;
+         ++num_chunks,pos+=GT_CYCLE_VECTOR_WIDTH) {
+      const gt_cycle_vector chunk = GT_CYCLE_OR(GT_CYCLE_LOADU(read+pos),lower_case);
+      count_a = GT_CYCLE_SUB(count_a,GT_CYCLE_CMPEQ(chunk,base_a));
+      count_c = GT_CYCLE_SUB(count_c,GT_CYCLE_CMPEQ(chunk,base_c));
+      count_g = GT_CYCLE_SUB(count_g,GT_CYCLE_CMPEQ(chunk,base_g));
+      count_t = GT_CYCLE_SUB(count_t,GT_CYCLE_CMPEQ(chunk,base_t));
+    }
+    gt_cycle_vector sum = GT_CYCLE_ZERO();
+    GT_CYCLE_SAD_ADD(sum,count_a); num_a += GT_CYCLE_SUM64(sum); sum = GT_CYCLE_ZERO();
+    GT_CYCLE_SAD_ADD(sum,count_c); num_c += GT_CYCLE_SUM64(sum); sum = GT_CYCLE_ZERO();
+    GT_CYCLE_SAD_ADD(sum,count_g); num_g += GT_CYCLE_SUM64(sum); sum = GT_CYCLE_ZERO();
+    GT_CYCLE_SAD_ADD(sum,count_t); num_t += GT_CYCLE_SUM64(sum);
+  }
+#endif
+  for (;pos<length;++pos) {
+    switch (read[pos] | 0x20) {
+      case 'a': ++num_a; break;
+      case 'c': ++num_c; break;
+      case 'g': ++num_g; break;
+      case 't': ++num_t; break;
+      default: break;
+    }
+  }
+  nt_counting[0] += num_a;
+  nt_counting[1] += num_c;
+  nt_counting[2] += num_g;
+  nt_counting[3] += num_t;
+  nt_counting[4] += length-(num_a+num_c+num_g+num_t);
+}
+GT_INLINE uint64_t gt_cycle_stats_sum_qualities(const char* const qualities,const uint64_t length) {
+  GT_NULL_CHECK(qualities);
+  uint64_t sum = 0, pos = 0;
+#ifdef GT_CYCLE_SIMD
+  gt_cycle_vector vector_sum = GT_CYCLE_ZERO();
+  for (;pos+GT_CYCLE_VECTOR_WIDTH<=length;pos+=GT_CYCLE_VECTOR_WIDTH) {
+    GT_CYCLE_SAD_ADD(vector_sum,GT_CYCLE_LOADU(qualities+pos));
+  }
+  sum = GT_CYCLE_SUM64(vector_sum);
+#endif
+  for (;pos<length;++pos) sum += (uint8_t)qualities[pos];
+  return sum;
+}
+
+/*
+ * Cycle Histogram
+ */
+#define GT_CYCLE_COUNTERS(cycle_histogram,palette_pos,base,chunk) \
+  ((cycle_histogram)->counters + \
+   ((((palette_pos)*GT_CYCLE_NUM_BASES+(base))*(cycle_histogram)->num_chunks+(chunk))*GT_CYCLE_VECTOR_WIDTH))
+GT_INLINE gt_cycle_histogram* gt_cycle_histogram_new(const uint8_t qual_offset,const uint8_t max_qual) {
+  gt_cycle_histogram* const cycle_histogram = gt_alloc(gt_cycle_histogram);
+  cycle_histogram->qual_offset = qual_offset;
+  cycle_histogram->max_qual = max_qual;
+#ifdef GT_CYCLE_SIMD
+  cycle_histogram->vectorized = true;
+#else
+  cycle_histogram->vectorized = false;
+#endif
+  cycle_histogram->palette_size = 0;
+  cycle_histogram->counters = NULL;
+  cycle_histogram->num_chunks = 0;
+  cycle_histogram->max_length = 0;
+  cycle_histogram->num_reads = 0;
+  cycle_histogram->num_vector_cycles = 0;
+  cycle_histogram->num_scalar_cycles = 0;
+  memset(cycle_histogram->base_counts,0,sizeof(cycle_histogram->base_counts));
+  return cycle_histogram;
+}
+GT_INLINE void gt_cycle_histogram_delete(gt_cycle_histogram* const cycle_histogram) {
+  GT_NULL_CHECK(cycle_histogram);
+  if (cycle_histogram->counters!=NULL) gt_free(cycle_histogram->counters);
+  gt_free(cycle_histogram);
+}
+GT_INLINE void gt_cycle_histogram_flush(gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle) {
+  GT_NULL_CHECK(cycle_histogram);
+  if (cycle_histogram->num_reads==0) return;
+  const uint64_t max_length = cycle_histogram->max_length;
+  const uint64_t num_chunks = (max_length+GT_CYCLE_VECTOR_WIDTH-1)/GT_CYCLE_VECTOR_WIDTH;
+  uint64_t palette_pos, base, chunk, lane;
+  for (palette_pos=0;palette_pos<cycle_histogram->palette_size;++palette_pos) {
+    const uint64_t qual_bin = (uint64_t)((uint8_t)cycle_histogram->palette[palette_pos]-cycle_histogram->qual_offset)*GT_CYCLE_NUM_BASES;
+    for (base=0;base<GT_CYCLE_NUM_BASES;++base) {
+      uint64_t total = 0;
+      for (chunk=0;chunk<num_chunks;++chunk) {
+        uint8_t* const counters = GT_CYCLE_COUNTERS(cycle_histogram,palette_pos,base,chunk);
+        const uint64_t cycle = chunk*GT_CYCLE_VECTOR_WIDTH;
+        const uint64_t num_lanes = GT_MIN(GT_CYCLE_VECTOR_WIDTH,max_length-cycle);
+        for (lane=0;lane<num_lanes;++lane) {
+          histogram_by_cycle[cycle+lane][qual_bin+base] += counters[lane];
+          total += counters[lane];
+        }
+        memset(counters,0,GT_CYCLE_VECTOR_WIDTH);
+      }
+      cycle_histogram->base_counts[base] += total;
+    }
+  }
+  cycle_histogram->max_length = 0;
+  cycle_histogram->num_reads = 0;
+  // Give up on the palette if most qualities fall outside it
+  if (2*cycle_histogram->num_scalar_cycles > cycle_histogram->num_vector_cycles) {
+    cycle_histogram->vectorized = false;
+  }
+}
+GT_INLINE void gt_cycle_histogram_reserve(
+    gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle,const uint64_t length) {
+  const uint64_t num_chunks = (length+GT_CYCLE_VECTOR_WIDTH-1)/GT_CYCLE_VECTOR_WIDTH;
+  if (num_chunks <= cycle_histogram->num_chunks) return;
+  gt_cycle_histogram_flush(cycle_histogram,histogram_by_cycle);
+  if (cycle_histogram->counters!=NULL) gt_free(cycle_histogram->counters);
+  cycle_histogram->num_chunks = num_chunks;
+  cycle_histogram->counters = gt_malloc_(GT_CYCLE_MAX_PALETTE*GT_CYCLE_NUM_BASES*num_chunks,GT_CYCLE_VECTOR_WIDTH,true,0);
+}
+GT_INLINE bool gt_cycle_histogram_add_cycle(
+    gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle,
+    const uint64_t cycle,const char character,const char quality) {
+  const uint8_t base = gt_cycle_base_encode[(uint8_t)character];
+  const uint8_t qual = (uint8_t)quality-cycle_histogram->qual_offset;
+  if (gt_expect_false(base==GT_CYCLE_BASE_ILLEGAL || qual>cycle_histogram->max_qual)) return false;
+  ++histogram_by_cycle[cycle][(uint64_t)qual*GT_CYCLE_NUM_BASES+base];
+  ++cycle_histogram->base_counts[base];
+  return true;
+}
+GT_INLINE void gt_cycle_histogram_learn_quality(gt_cycle_histogram* const cycle_histogram,const char quality) {
+  // Only called with (valid) qualities out of the palette
+  if (cycle_histogram->palette_size < GT_CYCLE_MAX_PALETTE) {
+    uint64_t palette_pos;
+    for (palette_pos=0;palette_pos<cycle_histogram->palette_size;++palette_pos) {
+      if (cycle_histogram->palette[palette_pos]==quality) return; // Already learnt in this chunk
+    }
+    cycle_histogram->palette[cycle_histogram->palette_size++] = quality;
+  }
+}
+GT_INLINE bool gt_cycle_histogram_add(
+    gt_cycle_histogram* const cycle_histogram,uint64_t** const histogram_by_cycle,
+    const char* const read,const char* const qualities,const uint64_t length) {
+  GT_NULL_CHECK(cycle_histogram); GT_NULL_CHECK(histogram_by_cycle);
+  GT_NULL_CHECK(read); GT_NULL_CHECK(qualities);
+  uint64_t pos = 0;
+#ifdef GT_CYCLE_SIMD
+  if (cycle_histogram->vectorized) {
+    gt_cycle_histogram_reserve(cycle_histogram,histogram_by_cycle,length);
+    const gt_cycle_vector lower_case = GT_CYCLE_SET1(0x20);
+    gt_cycle_vector base_chars[GT_CYCLE_NUM_BASES];
+    uint64_t base, palette_pos, chunk;
+    for (base=0;base<GT_CYCLE_NUM_BASES;++base) base_chars[base] = GT_CYCLE_SET1(gt_cycle_base_lower_char[base]);
+    for (chunk=0;pos+GT_CYCLE_VECTOR_WIDTH<=length;++chunk,pos+=GT_CYCLE_VECTOR_WIDTH) {
+      // Bases & qualities of the chunk of cycles
+      const gt_cycle_vector chunk_bases = GT_CYCLE_OR(GT_CYCLE_LOADU(read+pos),lower_case);
+      const gt_cycle_vector chunk_quals = GT_CYCLE_LOADU(qualities+pos);
+      gt_cycle_vector base_masks[GT_CYCLE_NUM_BASES];
+      gt_cycle_vector counted = GT_CYCLE_ZERO();
+      for (base=0;base<GT_CYCLE_NUM_BASES;++base) base_masks[base] = GT_CYCLE_CMPEQ(chunk_bases,base_chars[base]);
+      // Count the qualities of the palette
+      const uint64_t palette_size = cycle_histogram->palette_size;
+      for (palette_pos=0;palette_pos<palette_size;++palette_pos) {
+        const gt_cycle_vector qual_mask = GT_CYCLE_CMPEQ(chunk_quals,GT_CYCLE_SET1(cycle_histogram->palette[palette_pos]));
+        for (base=0;base<GT_CYCLE_NUM_BASES;++base) {
+          uint8_t* const counters = GT_CYCLE_COUNTERS(cycle_histogram,palette_pos,base,chunk);
+          const gt_cycle_vector hits = GT_CYCLE_AND(qual_mask,base_masks[base]);
+          GT_CYCLE_STOREU(counters,GT_CYCLE_SUB(GT_CYCLE_LOADU(counters),hits));
+          counted = GT_CYCLE_OR(counted,hits);
+        }
+      }
+      // Count the rest of cycles one by one
+      uint64_t pending = GT_CYCLE_MASK(counted) ^ GT_CYCLE_FULL_MASK;
+      for (;pending!=0;pending&=pending-1) {
+        const uint64_t cycle = pos+__builtin_ctzll(pending);
+        if (!gt_cycle_histogram_add_cycle(cycle_histogram,histogram_by_cycle,cycle,read[cycle],qualities[cycle])) return false;
+        gt_cycle_histogram_learn_quality(cycle_histogram,qualities[cycle]);
+        ++cycle_histogram->num_scalar_cycles;
+      }
+    }
+    cycle_histogram->num_vector_cycles += pos;
+    cycle_histogram->max_length = GT_MAX(cycle_histogram->max_length,pos);
+    if (++cycle_histogram->num_reads==GT_CYCLE_MAX_BYTE_COUNT) {
+      gt_cycle_histogram_flush(cycle_histogram,histogram_by_cycle);
+    }
+  }
+#endif
+  for (;pos<length;++pos) {
+    if (!gt_cycle_histogram_add_cycle(cycle_histogram,histogram_by_cycle,pos,read[pos],qualities[pos])) return false;
+  }
+  return true;
+}
@@ -36,23 +36,33 @@ GT_INLINE void gt_gtf_ref_delete(gt_gtf_ref* const ref){
 GT_INLINE gt_gtf* gt_gtf_new(void){
   gt_gtf* gtf = malloc(sizeof(gt_gtf));
   gtf->refs = gt_shash_new();
+  gtf->contig_refs = gt_vector_new(16, sizeof(gt_gtf_ref*));
   gtf->types = gt_shash_new();
   gtf->gene_ids = gt_shash_new();
   gtf->transcript_ids = gt_shash_new();
   gtf->gene_types = gt_shash_new();
   gtf->genes = gt_shash_new();
   gtf->transcripts = gt_shash_new();
+  gtf->gene_coverage = NULL;
   return gtf;
 }
 
 GT_INLINE void gt_gtf_delete(gt_gtf* const gtf){
   gt_shash_delete(gtf->refs, true);
+  gt_vector_delete(gtf->contig_refs);
   gt_shash_delete(gtf->types, true);
   gt_shash_delete(gtf->gene_ids, true);
   gt_shash_delete(gtf->transcript_ids, true);
   gt_shash_delete(gtf->gene_types, true);
   gt_shash_delete(gtf->genes, false);
   gt_shash_delete(gtf->transcripts, false);
+  if(gtf->gene_coverage != NULL){
+    GT_SHASH_BEGIN_ELEMENT_ITERATE(gtf->gene_coverage, table, gt_gtf_coverage_table){
+      gt_vector_delete(table->exons);
+      gt_vector_delete(table->max_ends);
+    }GT_SHASH_END_ITERATE;
+    gt_shash_delete(gtf->gene_coverage, true);
+  }
   free(gtf);
 }
 
@@ -126,9 +136,20 @@ GT_INLINE gt_gtf_ref* gt_gtf_get_ref(const gt_gtf* const gtf, char* const name){
   if(!gt_gtf_contains_ref(gtf, name)){
     gt_gtf_ref* rr = gt_gtf_ref_new();
     gt_shash_insert(gtf->refs, name, rr, gt_gtf_ref*);
+    // index by contig ID
+    const uint32_t contig_id = gt_contig_dictionary_get_id(name, strlen(name));
+    if(contig_id >= gt_vector_get_used(gtf->contig_refs)){
+      gt_vector_reserve(gtf->contig_refs, contig_id+1, true);
+      gt_vector_set_used(gtf->contig_refs, contig_id+1);
+    }
+    *gt_vector_get_elm(gtf->contig_refs, contig_id, gt_gtf_ref*) = rr;
   }
   return gt_shash_get(gtf->refs, name, gt_gtf_ref);
 }
+GT_INLINE gt_gtf_ref* gt_gtf_get_contig_ref(const gt_gtf* const gtf, const uint32_t contig_id){
+  if(contig_id >= gt_vector_get_used(gtf->contig_refs)) return NULL;
+  return *gt_vector_get_elm(gtf->contig_refs, contig_id, gt_gtf_ref*);
+}
 GT_INLINE bool gt_gtf_contains_ref(const gt_gtf* const gtf, char* const name){
 	return gt_shash_is_contained(gtf->refs, name);
 }
@@ -457,7 +478,7 @@ GT_INLINE uint64_t gt_gtf_count_junction(const gt_gtf* const gtf, gt_map* const
   uint64_t blocks = gt_map_get_num_blocks(map);
   if(blocks <= 1) return 0; // single block map
   uint64_t num_junctions = 0;
-  char* seq_name = gt_map_get_seq_name(map);
+  const uint32_t seq_id = gt_map_get_seq_id(map);
   gt_vector* hits = gt_vector_new(16, sizeof(gt_gtf_entry*));
   gt_shash* last_hits = NULL;
   GT_MAP_ITERATE(map, block){
@@ -465,7 +486,7 @@ GT_INLINE uint64_t gt_gtf_count_junction(const gt_gtf* const gtf, gt_map* const
     uint64_t end = gt_map_get_end_mapping_position(block);
     if(last_hits != NULL){
       // there was a block before, check if we found an annotated junction
-      gt_gtf_search(gtf, hits, seq_name, start, start, true);
+      gt_gtf_search_contig(gtf, hits, seq_id, start, start, true);
       GT_VECTOR_ITERATE(hits, e, c, gt_gtf_entry*){
         gt_gtf_entry* hit = *e;
         if(hit->transcript_id != NULL && hit->type != NULL && strcmp(hit->type->buffer, "exon") == 0){
@@ -479,7 +500,7 @@ GT_INLINE uint64_t gt_gtf_count_junction(const gt_gtf* const gtf, gt_map* const
     if(last_hits == NULL) last_hits = gt_shash_new();
     else gt_shash_clear(last_hits, true);
     // search for the overlaps with the end of the block
-    gt_gtf_search(gtf, hits, seq_name, end, end, true);
+    gt_gtf_search_contig(gtf, hits, seq_id, end, end, true);
     GT_VECTOR_ITERATE(hits, e, c, gt_gtf_entry*){
       gt_gtf_entry* hit = *e;
       if(hit->transcript_id != NULL && hit->type != NULL && strcmp(hit->type->buffer, "exon") == 0){
@@ -736,6 +757,94 @@ GT_INLINE gt_gtf* gt_gtf_read(gt_input_file* input_file, const uint64_t threads)
   return gtf;
 }
 
+/*
+ * Coverage tables
+ */
+GT_INLINE uint64_t gt_gtf_coverage_length_range(const uint64_t transcript_length){
+  if(transcript_length <= 150) return GT_GTF_COVERAGE_LENGTH_150;
+  if(transcript_length <= 250) return GT_GTF_COVERAGE_LENGTH_250;
+  if(transcript_length <= 500) return GT_GTF_COVERAGE_LENGTH_500;
+  if(transcript_length <= 1000) return GT_GTF_COVERAGE_LENGTH_1000;
+  if(transcript_length <= 2500) return GT_GTF_COVERAGE_LENGTH_2500;
+  if(transcript_length <= 5000) return GT_GTF_COVERAGE_LENGTH_5000;
+  if(transcript_length <= 7500) return GT_GTF_COVERAGE_LENGTH_7500;
+  if(transcript_length <= 10000) return GT_GTF_COVERAGE_LENGTH_10000;
+  if(transcript_length <= 15000) return GT_GTF_COVERAGE_LENGTH_15000;
+  if(transcript_length <= 20000) return GT_GTF_COVERAGE_LENGTH_20000;
+  return GT_GTF_COVERAGE_LENGTH_ALL; // only counted in all
+}
+GT_INLINE int gt_gtf_coverage_exon_cmp_(const gt_gtf_coverage_exon* a, const gt_gtf_coverage_exon* b){
+  return a->start < b->start ? -1 : (a->start > b->start ? 1 : 0);
+}
+GT_INLINE void gt_gtf_add_coverage_exons_(const gt_gtf* const gtf, const gt_gtf_node* const node, const uint32_t seq_id){
+  // the entries of a ref are only kept in its interval tree (each entry lies in one node)
+  if(node == NULL) return;
+  GT_VECTOR_ITERATE(node->entries_by_start, element, counter, gt_gtf_entry*){
+    gt_gtf_entry* const hit = *element;
+    if(hit->transcript_id == NULL || hit->gene_id == NULL) continue; // no transcript or gene id
+    if(hit->type == NULL || strcmp(GT_GTF_TYPE_EXON, hit->type->buffer) != 0) continue; // no exon or no type
+    gt_gtf_entry* const transcript = gt_gtf_get_transcript_by_id(gtf, hit->transcript_id->buffer);
+    if(transcript == NULL || transcript->length <= 100) continue;
+    gt_gtf_entry* const gene = gt_gtf_get_gene_by_id(gtf, hit->gene_id->buffer);
+    if(gene == NULL) continue; // no gene found
+    // exon offset on the transcript (exon order is flipped on the reverse strand)
+    gt_gtf_coverage_exon exon;
+    exon.seq_id = seq_id;
+    exon.start = hit->start;
+    exon.end = hit->end;
+    exon.exon_length = (hit->end - hit->start) + 1;
+    exon.transcript_length = transcript->length;
+    uint64_t hit_start_on_transcript = hit->length;
+    if(hit->strand == REVERSE){
+      hit_start_on_transcript = (transcript->length - hit_start_on_transcript) - exon.exon_length;
+    }
+    exon.transcript_start_bucket = ((((double)hit_start_on_transcript / (double)transcript->length) * 100.0) + 0.5) - 1;
+    exon.scale = (double)exon.exon_length / (double) transcript->length;
+    exon.length_range = gt_gtf_coverage_length_range(transcript->length);
+    exon.strand = hit->strand;
+    exon.single_transcript = (gene->num_children == 1);
+    // add to the gene table
+    gt_gtf_coverage_table* table;
+    if(!gt_shash_is_contained(gtf->gene_coverage, gene->gene_id->buffer)){
+      table = malloc(sizeof(gt_gtf_coverage_table));
+      table->exons = gt_vector_new(16, sizeof(gt_gtf_coverage_exon));
+      table->max_ends = gt_vector_new(16, sizeof(uint64_t));
+      gt_shash_insert(gtf->gene_coverage, gene->gene_id->buffer, table, gt_gtf_coverage_table);
+    }else{
+      table = gt_shash_get(gtf->gene_coverage, gene->gene_id->buffer, gt_gtf_coverage_table);
+    }
+    gt_vector_insert(table->exons, exon, gt_gtf_coverage_exon);
+  }
+  gt_gtf_add_coverage_exons_(gtf, node->left, seq_id);
+  gt_gtf_add_coverage_exons_(gtf, node->right, seq_id);
+}
+GT_INLINE void gt_gtf_build_coverage_tables(gt_gtf* const gtf){
+  GT_NULL_CHECK(gtf);
+  if(gtf->gene_coverage != NULL) return;
+  gtf->gene_coverage = gt_shash_new();
+  // by contig ID, so each exon knows its contig
+  uint32_t contig_id;
+  for(contig_id=0; contig_id<gt_vector_get_used(gtf->contig_refs); contig_id++){
+    const gt_gtf_ref* const ref = gt_gtf_get_contig_ref(gtf, contig_id);
+    if(ref != NULL) gt_gtf_add_coverage_exons_(gtf, ref->node, contig_id);
+  }
+  // sort by start and keep the running max end
+  GT_SHASH_BEGIN_ELEMENT_ITERATE(gtf->gene_coverage, table, gt_gtf_coverage_table){
+    const uint64_t num_exons = gt_vector_get_used(table->exons);
+    gt_gtf_coverage_exon* const exons = gt_vector_get_mem(table->exons, gt_gtf_coverage_exon);
+    qsort(exons, num_exons, sizeof(gt_gtf_coverage_exon),
+        (int (*)(const void *,const void *))gt_gtf_coverage_exon_cmp_);
+    gt_vector_reserve(table->max_ends, num_exons, false);
+    gt_vector_set_used(table->max_ends, num_exons);
+    uint64_t* const max_ends = gt_vector_get_mem(table->max_ends, uint64_t);
+    uint64_t i, max_end = 0;
+    for(i=0; i<num_exons; i++){
+      max_end = GT_MAX(max_end, exons[i].end);
+      max_ends[i] = max_end;
+    }
+  }GT_SHASH_END_ITERATE;
+}
+
 /*
  * Binary search for start position
  */
@@ -806,6 +915,13 @@ GT_INLINE uint64_t gt_gtf_search(const gt_gtf* const gtf,  gt_vector* const targ
   gt_gtf_search_node_(source_ref->node, start, end, target);
   return gt_vector_get_used(target);
 }
+GT_INLINE uint64_t gt_gtf_search_contig(const gt_gtf* const gtf, gt_vector* const target, const uint32_t contig_id, const uint64_t start, const uint64_t end, const bool clear_target){
+  if(clear_target)gt_vector_clear(target);
+  const gt_gtf_ref* const source_ref = gt_gtf_get_contig_ref(gtf, contig_id);
+  if(source_ref == NULL) return 0;
+  gt_gtf_search_node_(source_ref->node, start, end, target);
+  return gt_vector_get_used(target);
+}
 
 GT_INLINE void gt_gtf_count_(gt_shash* const table, char* const element){
   if(!gt_shash_is_contained(table, element)){
@@ -967,38 +1083,13 @@ GT_INLINE void gt_gtf_count_add_(gt_shash* const source, gt_shash* const target)
   }GT_SHASH_END_ITERATE;
 }
 
-GT_INLINE void gt_gtf_add_coverage(uint64_t* store, const uint64_t transcript_length, const uint64_t bucket){
-  // add to all
-  store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_ALL, bucket)] += 1;
-  if(transcript_length <= 150){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_150, bucket)] += 1;
-  }
-  if(transcript_length > 150 && transcript_length <= 250){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_250, bucket)] += 1;
-  }
-  if(transcript_length > 250 && transcript_length <= 500){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_500, bucket)] += 1;
-  }
-  if(transcript_length > 500 && transcript_length <= 1000){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_1000, bucket)] += 1;
-  }
-  if(transcript_length > 1000 && transcript_length <= 2500){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_2500, bucket)] += 1;
-  }
-  if(transcript_length > 2500 && transcript_length <= 5000){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_5000, bucket)] += 1;
-  }
-  if(transcript_length > 5000 && transcript_length <= 7500){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_7500, bucket)] += 1;
-  }
-  if(transcript_length > 7500 && transcript_length <= 10000){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_10000, bucket)] += 1;
-  }
-  if(transcript_length > 10000 && transcript_length <= 15000){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_15000, bucket)] += 1;
-  }
-  if(transcript_length > 15000 && transcript_length <= 20000){
-    store[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_20000, bucket)] += 1;
+GT_INLINE void gt_gtf_add_coverage(uint64_t* store, const uint64_t length_range, const uint64_t start_bucket, const uint64_t end_bucket){
+  uint64_t* const all = store + GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_ALL, 0);
+  uint64_t s;
+  for(s=start_bucket; s<=end_bucket; s++) all[s] += 1;
+  if(length_range != GT_GTF_COVERAGE_LENGTH_ALL){
+    uint64_t* const range = store + GT_GTF_COVERGAGE_GET_BUCKET(length_range, 0);
+    for(s=start_bucket; s<=end_bucket; s++) range[s] += 1;
   }
 }
 
@@ -1015,28 +1106,30 @@ GT_INLINE void gt_gtf_count_coverage_(const gt_gtf* const gtf, gt_map* const map
     // count only maps with at least 2 bases in length
     return;
   }
-
-  // store the search hits and search
-  gt_vector* const hits = gt_vector_new(32, sizeof(gt_gtf_entry*));
-  gt_gtf_search(gtf, hits, gt_map_get_seq_name(map), start, end, true);
-
-  GT_VECTOR_ITERATE(hits, e, i, gt_gtf_entry*){
-    gt_gtf_entry* hit = *e;
-    if(hit->transcript_id == NULL) continue; // no transcript id
-    if(hit->type == NULL || strcmp("exon", hit->type->buffer) != 0) continue; // no exon or no type
-    if(gene_id != NULL && (hit->gene_id == NULL || strcmp(hit->gene_id->buffer, gene_id) != 0)) continue; // we are looking for a specific gene_id
-
-    gt_gtf_entry* transcript = gt_gtf_get_transcript_by_id(gtf, hit->transcript_id->buffer);
-    if(transcript == NULL || transcript->length <= 100){
-      continue;
+  gt_cond_fatal_error_msg(gtf->gene_coverage == NULL, "Coverage tables not built (gt_gtf_build_coverage_tables)");
+  if(!gt_shash_is_contained(gtf->gene_coverage, gene_id)) return; // no exons for the gene
+  const gt_gtf_coverage_table* const table = gt_shash_get(gtf->gene_coverage, gene_id, gt_gtf_coverage_table);
+  const gt_gtf_coverage_exon* const exons = gt_vector_get_mem(table->exons, gt_gtf_coverage_exon);
+  const uint64_t* const max_ends = gt_vector_get_mem(table->max_ends, uint64_t);
+  const uint64_t num_exons = gt_vector_get_used(table->exons);
+  // first exon that can overlap (max_ends is sorted)
+  uint64_t lo = 0, hi = num_exons;
+  while(lo < hi){
+    const uint64_t mid = (lo + hi) / 2;
+    if(max_ends[mid] > start){
+      hi = mid;
+    }else{
+      lo = mid + 1;
     }
+  }
+  uint64_t i;
+  for(i=lo; i<num_exons && exons[i].start<=end; i++){
+    const gt_gtf_coverage_exon* const hit = exons + i;
+    if(hit->seq_id != gt_map_get_seq_id(map)) continue; // exon on another contig
+    // same overlap as the annotation search
+    if(!(start < hit->end && (end > hit->start || end >= hit->end))) continue;
 
-    if(hit->gene_id == NULL) continue; // no gene id on the hit
-    gt_gtf_entry* gene = gt_gtf_get_gene_by_id(gtf,hit->gene_id->buffer);
-    if(gene == NULL) continue; // no gene found
-    if(gene_id != NULL && strcmp(gene_id, gene->gene_id->buffer) != 0) continue; // we are looking for a specific hit
-
-    uint64_t exon_length = (hit->end - hit->start) + 1;
+    uint64_t exon_length = hit->exon_length;
     int64_t rel_start = start - hit->start;
     int64_t rel_end = (rel_start + map_length) - 1;
     if(rel_start < 0){
@@ -1050,7 +1143,6 @@ GT_INLINE void gt_gtf_count_coverage_(const gt_gtf* const gtf, gt_map* const map
       // count for exon count
       uint64_t start_bucket = (((rel_start/(double)exon_length) * 100.0) + 0.5) - 1;
       uint64_t end_bucket = (((rel_end/(double)exon_length) * 100.0) + 0.5) - 1;
-      uint64_t s = 0;
       if(start_bucket >= 0 && start_bucket < 100 && end_bucket >= start_bucket && end_bucket < 100){
         // handle reverse strand and flip coordinates
         if(hit->strand == REVERSE){
@@ -1058,30 +1150,15 @@ GT_INLINE void gt_gtf_count_coverage_(const gt_gtf* const gtf, gt_map* const map
           start_bucket = (GT_GTF_COVERAGE_BUCKETS - 1) - end_bucket;
           end_bucket = (GT_GTF_COVERAGE_BUCKETS - 1) - tmp;
         }
-        // scale up
-        // count for global count and make exon coordinates relative to transcript
-        // coordinate range
-        uint64_t hit_start_on_transcript = hit->length;
-        if(hit->strand == REVERSE){
-          // flip the bucket start if this is a gene on reverse strand
-          // the exon start/end is already flipped
-          // so we just flip the order of the exons here
-          hit_start_on_transcript = (transcript->length - hit_start_on_transcript) - exon_length;
-        }
-        uint64_t trans_start_bucket = ((((double)hit_start_on_transcript / (double)transcript->length) * 100.0) + 0.5) - 1;
-        double scale = (double)exon_length / (double) transcript->length;
-        start_bucket = (scale * (double)start_bucket) + trans_start_bucket;
-        end_bucket = (scale * (double)end_bucket) + trans_start_bucket;
-
+        // scale up to the exon range on the transcript
+        start_bucket = (hit->scale * (double)start_bucket) + hit->transcript_start_bucket;
+        end_bucket = (hit->scale * (double)end_bucket) + hit->transcript_start_bucket;
         if(start_bucket >= 0 && start_bucket < 100 && end_bucket >= start_bucket && end_bucket < 100){
-          for(s=start_bucket;s<=end_bucket; s++){
-            //fprintf(stderr, ">>>GLOBAL COUNT %s : %"PRIu64" S/E: %"PRIu64" %"PRIu64" (%"PRIu64") Exon: %"PRIu64" %"PRIu64"\n", transcript->transcript_id->buffer, s, start, end, map_length, hit->start, hit->end);
-            // count gene body coverage
-            gt_gtf_add_coverage(params->gene_body_coverage, transcript->length, s);
-            // count single transcript
-            if( gene->num_children == 1){
-              gt_gtf_add_coverage(params->single_transcript_coverage, transcript->length, s);
-            }
+          // count gene body coverage
+          gt_gtf_add_coverage(params->gene_body_coverage, hit->length_range, start_bucket, end_bucket);
+          // count single transcript
+          if(hit->single_transcript){
+            gt_gtf_add_coverage(params->single_transcript_coverage, hit->length_range, start_bucket, end_bucket);
           }
         }
       }else{
@@ -1089,7 +1166,6 @@ GT_INLINE void gt_gtf_count_coverage_(const gt_gtf* const gtf, gt_map* const map
       }
     }
   }
-  gt_vector_delete(hits);
 }
 
 
@@ -1125,7 +1201,7 @@ GT_INLINE uint64_t gt_gtf_count_map_(const gt_gtf* const gtf, gt_map* const map,
 
   // store the search hits and search
   gt_vector* const hits = gt_vector_new(32, sizeof(gt_gtf_entry*));
-  gt_gtf_search(gtf, hits, gt_map_get_seq_name(map), start, end, true);
+  gt_gtf_search_contig(gtf, hits, gt_map_get_seq_id(map), start, end, true);
 
   // we do a complete local count for this block
   // and then merge the local count with the global count
@@ -1571,7 +1647,7 @@ GT_INLINE void gt_gtf_search_map(const gt_gtf* const gtf, gt_vector* const hits,
   GT_MAP_ITERATE(map, block){
     uint64_t start = gt_map_get_begin_mapping_position(map);
     uint64_t end   = gt_map_get_end_mapping_position(map);
-    gt_gtf_search(gtf, hits, gt_map_get_seq_name(map), start, end, clean_target);
+    gt_gtf_search_contig(gtf, hits, gt_map_get_seq_id(map), start, end, clean_target);
   }
 }
 
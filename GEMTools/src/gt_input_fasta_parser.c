@@ -308,6 +308,7 @@ GT_INLINE gt_status gt_input_fasta_parser_get_read(
     gt_buffered_input_file* const buffered_fasta_input,gt_dna_read* const dna_read) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_fasta_input);
   GT_DNA_READ_CHECK(dna_read);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   // Prepare read
   gt_dna_read_clear(dna_read);
   // Parse FASTA/FASTQ record
@@ -318,6 +319,7 @@ GT_INLINE gt_status gt_input_fasta_parser_get_alignment(
     gt_buffered_input_file* const buffered_fasta_input,gt_alignment* const alignment) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_fasta_input);
   GT_ALIGNMENT_CHECK(alignment);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   // Prepare read
   gt_alignment_clear(alignment);
   // Parse FASTA/FASTQ record
@@ -328,6 +330,7 @@ GT_INLINE gt_status gt_input_fasta_parser_get_template(
     gt_buffered_input_file* const buffered_fasta_input,gt_template* const template,const bool paired_read) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_fasta_input);
   GT_TEMPLATE_CHECK(template);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   // Prepare read
   gt_template_clear(template,true);
   // Parse FASTA/FASTQ record (end/1)
@@ -13,9 +13,142 @@
 #include <bzlib.h>
 #endif
 #include "gt_input_file.h"
+#include "gt_input_parser.h"
 
 // Internal constants
 #define GT_INPUT_BUFFER_SIZE GT_BUFFER_SIZE_64M
+#define GT_INPUT_SAMPLING_BUFFER_SIZE GT_BUFFER_SIZE_1M
+#define GT_INPUT_SAMPLING_CHUNK_RECORDS 1000
+#define GT_INPUT_SAMPLING_FASTA_TAG_BEGIN '>'
+#define GT_INPUT_SAMPLING_FASTQ_TAG_BEGIN '@'
+#define GT_INPUT_SAMPLING_FASTQ_SEP '+'
+
+/*
+ * Read-ahead
+ */
+GT_INLINE uint64_t gt_input_file_read_chunk(gt_input_file* const input_file,uint8_t* const buffer) {
+#ifdef HAVE_BZLIB
+  int bzerr;
+#endif
+  switch (input_file->file_type) {
+    case STREAM:
+    case REGULAR_FILE:
+      if (feof(input_file->file)) return 0;
+      return fread(buffer,sizeof(uint8_t),
+          (input_file->sampling_num_chunks>0) ? GT_INPUT_SAMPLING_BUFFER_SIZE : GT_INPUT_BUFFER_SIZE,input_file->file);
+#ifdef HAVE_ZLIB
+    case GZIPPED_FILE:
+      if (gzeof((gzFile)input_file->file)) return 0;
+      return gzread((gzFile)input_file->file,buffer,GT_INPUT_BUFFER_SIZE);
+#endif
+#ifdef HAVE_BZLIB
+    case BZIPPED_FILE:
+      return BZ2_bzRead(&bzerr,input_file->file,buffer,GT_INPUT_BUFFER_SIZE);
+#endif
+    default:
+      return 0;
+  }
+}
+void* gt_input_file_read_ahead_thread(void* const thread_arg) {
+  gt_input_file* const input_file = (gt_input_file*) thread_arg;
+  gt_input_file_read_ahead* const read_ahead = input_file->read_ahead;
+  while (true) {
+    // Wait for a free buffer (the one being parsed is never reused)
+    bool stop;
+    GT_BEGIN_MUTEX_SECTION(read_ahead->mutex) {
+      while (!read_ahead->stop &&
+          read_ahead->next_filled-read_ahead->next_consumed >= GT_INPUT_FILE_READ_AHEAD_BUFFERS-1) {
+        GT_CV_WAIT(read_ahead->free_cond,read_ahead->mutex);
+      }
+      stop = read_ahead->stop;
+    } GT_END_MUTEX_SECTION(read_ahead->mutex);
+    if (stop) break;
+    // Read (only this thread touches the file now)
+    const uint64_t slot = read_ahead->next_filled % GT_INPUT_FILE_READ_AHEAD_BUFFERS;
+    const uint64_t chunk_size = gt_input_file_read_chunk(input_file,read_ahead->buffer[slot]);
+    GT_BEGIN_MUTEX_SECTION(read_ahead->mutex) {
+      read_ahead->buffer_size[slot] = chunk_size;
+      ++(read_ahead->next_filled);
+      if (chunk_size==0) read_ahead->eof = true;
+      GT_CV_SIGNAL(read_ahead->filled_cond);
+    } GT_END_MUTEX_SECTION(read_ahead->mutex);
+    if (chunk_size==0) break;
+  }
+  return NULL;
+}
+GT_INLINE bool gt_input_file_read_ahead_is_worth(gt_input_file* const input_file) {
+  if (input_file->sampling_num_chunks>0) return false; // Seeks
+  switch (input_file->file_type) {
+    case STREAM: return !feof(input_file->file);
+    case REGULAR_FILE: return !feof(input_file->file) && input_file->global_pos<input_file->file_size;
+    case GZIPPED_FILE: case BZIPPED_FILE: return true;
+    default: return false;
+  }
+}
+GT_INLINE void gt_input_file_read_ahead_start(gt_input_file* const input_file) {
+  gt_input_file_read_ahead* const read_ahead = gt_alloc(gt_input_file_read_ahead);
+  gt_cond_fatal_error(pthread_mutex_init(&read_ahead->mutex,NULL),SYS_MUTEX_INIT);
+  gt_cond_fatal_error(pthread_cond_init(&read_ahead->filled_cond,NULL),SYS_COND_VAR_INIT);
+  gt_cond_fatal_error(pthread_cond_init(&read_ahead->free_cond,NULL),SYS_COND_VAR_INIT);
+  // The current buffer becomes the first of the ring
+  uint64_t i;
+  read_ahead->buffer[0] = input_file->file_buffer;
+  read_ahead->buffer_size[0] = 0;
+  for (i=1;i<GT_INPUT_FILE_READ_AHEAD_BUFFERS;++i) {
+    read_ahead->buffer[i] = gt_malloc(GT_INPUT_BUFFER_SIZE);
+    read_ahead->buffer_size[i] = 0;
+  }
+  read_ahead->next_consumed = 1;
+  read_ahead->next_filled = 1;
+  read_ahead->eof = false;
+  read_ahead->stop = false;
+  input_file->read_ahead = read_ahead;
+  gt_cond_fatal_error(pthread_create(&read_ahead->thread,NULL,gt_input_file_read_ahead_thread,input_file),SYS_THREAD);
+}
+GT_INLINE uint64_t gt_input_file_read_ahead_next(gt_input_file* const input_file) {
+  gt_input_file_read_ahead* const read_ahead = input_file->read_ahead;
+  uint64_t chunk_size = 0;
+  GT_BEGIN_MUTEX_SECTION(read_ahead->mutex) {
+    while (read_ahead->next_filled==read_ahead->next_consumed && !read_ahead->eof) {
+      GT_CV_WAIT(read_ahead->filled_cond,read_ahead->mutex);
+    }
+    if (read_ahead->next_filled > read_ahead->next_consumed) {
+      const uint64_t slot = read_ahead->next_consumed % GT_INPUT_FILE_READ_AHEAD_BUFFERS;
+      input_file->file_buffer = read_ahead->buffer[slot];
+      chunk_size = read_ahead->buffer_size[slot];
+      ++(read_ahead->next_consumed);
+      GT_CV_SIGNAL(read_ahead->free_cond);
+    }
+  } GT_END_MUTEX_SECTION(read_ahead->mutex);
+  return chunk_size;
+}
+GT_INLINE void gt_input_file_read_ahead_delete(gt_input_file* const input_file) {
+  gt_input_file_read_ahead* const read_ahead = input_file->read_ahead;
+  GT_BEGIN_MUTEX_SECTION(read_ahead->mutex) {
+    read_ahead->stop = true;
+    GT_CV_SIGNAL(read_ahead->free_cond);
+  } GT_END_MUTEX_SECTION(read_ahead->mutex);
+  gt_cond_fatal_error(pthread_join(read_ahead->thread,NULL),SYS_THREAD_JOIN);
+  // Free the ring (but the current buffer, freed along with the input file)
+  uint64_t i;
+  for (i=0;i<GT_INPUT_FILE_READ_AHEAD_BUFFERS;++i) {
+    if (read_ahead->buffer[i]!=input_file->file_buffer) gt_free(read_ahead->buffer[i]);
+  }
+  gt_cond_error(pthread_mutex_destroy(&read_ahead->mutex),SYS_MUTEX_DESTROY);
+  gt_cond_error(pthread_cond_destroy(&read_ahead->filled_cond),SYS_COND_VAR_DESTROY);
+  gt_cond_error(pthread_cond_destroy(&read_ahead->free_cond),SYS_COND_VAR_DESTROY);
+  gt_free(read_ahead);
+  input_file->read_ahead = NULL;
+}
+GT_INLINE void gt_input_file_read_ahead_stop(gt_input_file* const input_file) {
+  if (input_file->read_ahead==NULL) return;
+  gt_input_file_read_ahead_delete(input_file);
+  // The thread read past the current buffer. Rewind the file to its end
+  if (input_file->file_type==REGULAR_FILE) {
+    const uint64_t file_position = input_file->global_pos+input_file->buffer_size;
+    gt_cond_fatal_error(fseeko(input_file->file,file_position,SEEK_SET),FILE_SEEK,input_file->file_name,file_position);
+  }
+}
 
 /*
  * Basic I/O functions
@@ -40,8 +173,11 @@ gt_input_file* gt_input_stream_open(FILE* stream) {
   input_file->buffer_pos = 0;
   input_file->global_pos = 0;
   input_file->processed_lines = 0;
+  input_file->read_ahead = NULL;
   // ID generator
   input_file->processed_id = 0;
+  // Sampling
+  input_file->sampling_num_chunks = 0;
   // Detect file format
   gt_input_file_detect_file_format(input_file);
   return input_file;
@@ -94,6 +230,7 @@ gt_input_file* gt_input_file_open(char* const file_name,const bool mmap_file) {
 #endif
       } else {
         fseek(input_file->file,0L,SEEK_SET);
+        posix_fadvise(fileno(input_file->file),0,0,POSIX_FADV_SEQUENTIAL);
       }
     } else {
       input_file->eof=0;
@@ -106,8 +243,11 @@ gt_input_file* gt_input_file_open(char* const file_name,const bool mmap_file) {
   input_file->buffer_pos = 0;
   input_file->global_pos = 0;
   input_file->processed_lines = 0;
+  input_file->read_ahead = NULL;
   // ID generator
   input_file->processed_id = 0;
+  // Sampling
+  input_file->sampling_num_chunks = 0;
   // Detect file format
   gt_input_file_detect_file_format(input_file);
   return input_file;
@@ -122,6 +262,7 @@ gt_status gt_input_file_close(gt_input_file* const input_file) {
 #ifdef HAVE_BZLIB
   int bzerr;
 #endif
+  if (input_file->read_ahead!=NULL) gt_input_file_read_ahead_delete(input_file);
   switch (input_file->file_type) {
     case REGULAR_FILE:
       gt_free(input_file->file_buffer);
@@ -141,7 +282,7 @@ gt_status gt_input_file_close(gt_input_file* const input_file) {
 #endif
       break;
     case MAPPED_FILE:
-      gt_cond_error(munmap(input_file->file,input_file->file_size)==-1,SYS_UNMAP);
+      gt_cond_error(munmap(input_file->file_buffer,input_file->file_size)==-1,SYS_UNMAP);
       if (close(input_file->fildes)) status = GT_INPUT_FILE_CLOSE_ERR;
       break;
     case STREAM:
@@ -168,6 +309,122 @@ GT_INLINE uint64_t gt_input_file_next_id(gt_input_file* const input_file) {
   return (input_file->processed_id)++;
 }
 
+/*
+ * Sampling
+ */
+GT_INLINE void gt_input_file_set_sampling(gt_input_file* const input_file,const uint64_t num_records) {
+  GT_INPUT_FILE_CHECK(input_file);
+  gt_cond_fatal_error(input_file->file_type!=REGULAR_FILE && input_file->file_type!=MAPPED_FILE,
+      FILE_SAMPLING_NOT_SEEKABLE,input_file->file_name);
+  // Lines per record
+  uint64_t record_lines;
+  switch (input_file->file_format) {
+    case FASTA:
+      gt_cond_fatal_error(input_file->fasta_type.fasta_format==F_MULTI_FASTA,FILE_SAMPLING_FORMAT,input_file->file_name);
+      record_lines = (input_file->fasta_type.fasta_format==F_FASTQ) ? 4 : 2;
+      break;
+    case MAP: case SAM:
+      record_lines = 1;
+      break;
+    default:
+      gt_fatal_error(FILE_SAMPLING_FORMAT,input_file->file_name);
+      break;
+  }
+  // Chunks
+  if (num_records==0) return;
+  gt_input_file_read_ahead_stop(input_file); // Started by the format detection (sampling seeks the file)
+  const uint64_t chunk_records = GT_MIN(num_records,GT_INPUT_SAMPLING_CHUNK_RECORDS);
+  input_file->sampling_num_chunks = (num_records+chunk_records-1)/chunk_records;
+  input_file->sampling_chunk_lines = chunk_records*record_lines;
+  input_file->sampling_begin = (input_file->file_type==MAPPED_FILE) ?
+      input_file->buffer_pos : input_file->global_pos+input_file->buffer_pos;
+  input_file->sampling_next_chunk = 0;
+  input_file->sampling_lines_left = 0;
+}
+GT_INLINE bool gt_input_file_is_sampling(gt_input_file* const input_file) {
+  GT_INPUT_FILE_CHECK(input_file);
+  return input_file->sampling_num_chunks>0;
+}
+GT_INLINE uint64_t gt_input_file_get_position(gt_input_file* const input_file) {
+  return (input_file->file_type==MAPPED_FILE) ?
+      input_file->buffer_pos : input_file->global_pos+input_file->buffer_pos;
+}
+GT_INLINE void gt_input_file_seek(gt_input_file* const input_file,const uint64_t file_position) {
+  if (input_file->file_type==MAPPED_FILE) {
+    input_file->buffer_pos = file_position;
+    input_file->buffer_begin = file_position;
+  } else {
+    gt_input_file_read_ahead_stop(input_file);
+    gt_cond_fatal_error(fseeko(input_file->file,file_position,SEEK_SET),FILE_SEEK,input_file->file_name,file_position);
+    input_file->global_pos = file_position;
+    input_file->buffer_size = 0;
+    input_file->buffer_pos = 0;
+    input_file->buffer_begin = 0;
+    input_file->eof = false;
+    gt_input_file_fill_buffer(input_file);
+  }
+}
+GT_INLINE void gt_input_file_sampling_synch(gt_input_file* const input_file) {
+  gt_vector* const discarded = gt_vector_new(GT_BUFFER_SIZE_1K,sizeof(char));
+  // Skip the (partial) line we landed in
+  gt_input_file_next_line(input_file,discarded);
+  if (input_file->file_format==FASTA) {
+    if (input_file->fasta_type.fasta_format==F_FASTQ) {
+      // Skip lines until the last four read are '@TAG','READ','+','QUALS'
+      char first_chars[4] = {0,0,0,0};
+      while (!input_file->eof && !(first_chars[0]==GT_INPUT_SAMPLING_FASTQ_TAG_BEGIN && first_chars[2]==GT_INPUT_SAMPLING_FASTQ_SEP)) {
+        first_chars[0]=first_chars[1]; first_chars[1]=first_chars[2]; first_chars[2]=first_chars[3];
+        first_chars[3]=GT_INPUT_FILE_CURRENT_CHAR(input_file);
+        gt_vector_clear(discarded);
+        gt_input_file_next_line(input_file,discarded);
+      }
+    } else {
+      while (!input_file->eof && GT_INPUT_FILE_CURRENT_CHAR(input_file)!=GT_INPUT_SAMPLING_FASTA_TAG_BEGIN) {
+        gt_vector_clear(discarded);
+        gt_input_file_next_line(input_file,discarded);
+      }
+    }
+  } else {
+    // Skip the first full record and the ones sharing its tag (mates, multiple SAM alignments)
+    gt_string* const reference_tag = gt_string_new(30);
+    uint64_t num_blocks=0, num_tabs=0;
+    if (gt_input_file_next_record(input_file,discarded,reference_tag,&num_blocks,&num_tabs)) {
+      gt_input_parse_tag_chomp_pairend_info(reference_tag);
+      while (!input_file->eof && gt_input_file_next_record_cmp_first_field(input_file,reference_tag)) {
+        gt_vector_clear(discarded);
+        gt_input_file_next_line(input_file,discarded);
+      }
+    }
+    gt_string_delete(reference_tag);
+  }
+  input_file->buffer_begin = input_file->buffer_pos;
+  gt_vector_delete(discarded);
+}
+GT_INLINE uint64_t gt_input_file_sampling_next_lines(gt_input_file* const input_file,const uint64_t num_lines) {
+  GT_INPUT_FILE_CHECK(input_file);
+  if (gt_expect_true(input_file->sampling_num_chunks==0)) return num_lines;
+  // Next chunk
+  if (input_file->sampling_lines_left==0) {
+    if (input_file->sampling_next_chunk>=input_file->sampling_num_chunks) {
+      input_file->eof = true;
+      return 0;
+    }
+    const uint64_t stride = (input_file->file_size-input_file->sampling_begin)/input_file->sampling_num_chunks;
+    const uint64_t chunk_position = input_file->sampling_begin + input_file->sampling_next_chunk*stride;
+    ++input_file->sampling_next_chunk;
+    input_file->sampling_lines_left = input_file->sampling_chunk_lines;
+    // Seek (unless the previous chunk already went past the chunk offset)
+    if (chunk_position > gt_input_file_get_position(input_file)) {
+      gt_input_file_seek(input_file,chunk_position);
+      gt_input_file_sampling_synch(input_file);
+      if (input_file->eof) return 0;
+    }
+  }
+  const uint64_t chunk_lines = GT_MIN(num_lines,input_file->sampling_lines_left);
+  input_file->sampling_lines_left -= chunk_lines;
+  return chunk_lines;
+}
+
 /*
  * Basic line functions
  */
@@ -186,56 +443,40 @@ GT_INLINE size_t gt_input_file_dump_to_buffer(gt_input_file* const input_file,gt
   return chunk_size;
 }
 GT_INLINE size_t gt_input_file_fill_buffer(gt_input_file* const input_file) {
-#ifdef HAVE_BZLIB
-  int bzerr;
-#endif
   GT_INPUT_FILE_CHECK(input_file);
   input_file->global_pos += input_file->buffer_size;
   input_file->buffer_pos = 0;
   input_file->buffer_begin = 0;
-  if (gt_expect_true(
-      (input_file->file_type==STREAM && !feof(input_file->file)) ||
-      (input_file->file_type==REGULAR_FILE && !feof(input_file->file)))) {
-    input_file->buffer_size =
-        fread(input_file->file_buffer,sizeof(uint8_t),GT_INPUT_BUFFER_SIZE,input_file->file);
-    if (input_file->buffer_size==0) {
-      input_file->eof = true;
+  if (input_file->file_type==MAPPED_FILE) {
+    if (input_file->global_pos < input_file->file_size) {
+      input_file->buffer_size = input_file->file_size-input_file->global_pos;
+      return input_file->buffer_size;
     }
-    return input_file->buffer_size;
-  } else if (input_file->file_type==MAPPED_FILE && input_file->global_pos < input_file->file_size) {
-    input_file->buffer_size = input_file->file_size-input_file->global_pos;
-    return input_file->buffer_size;
-#ifdef HAVE_ZLIB
-  } else if (input_file->file_type==GZIPPED_FILE && !gzeof((gzFile)input_file->file)) {
-    input_file->buffer_size = gzread((gzFile)input_file->file,input_file->file_buffer,GT_INPUT_BUFFER_SIZE);
-    if (input_file->buffer_size==0) {
-      input_file->eof = true;
-    }
-    return input_file->buffer_size;
-#endif
-#ifdef HAVE_BZLIB
-  } else if (input_file->file_type==BZIPPED_FILE) {
-    input_file->buffer_size = BZ2_bzRead(&bzerr,input_file->file,input_file->file_buffer,GT_INPUT_BUFFER_SIZE);
-    if(input_file->buffer_size==0) {
-      input_file->eof=true;
-    }
-    return input_file->buffer_size;
-#endif
   } else {
-    input_file->eof = true;
-    return 0;
+    // Read next chunk (handed by the read-ahead thread from the first refill on)
+    if (input_file->read_ahead==NULL && gt_input_file_read_ahead_is_worth(input_file)) {
+      gt_input_file_read_ahead_start(input_file);
+    }
+    input_file->buffer_size = (input_file->read_ahead!=NULL) ?
+        gt_input_file_read_ahead_next(input_file) : gt_input_file_read_chunk(input_file,input_file->file_buffer);
+    if (input_file->buffer_size>0) return input_file->buffer_size;
   }
+  input_file->buffer_size = 0;
+  input_file->eof = true;
+  return 0;
 }
 GT_INLINE size_t gt_input_file_next_line(gt_input_file* const input_file,gt_vector* const buffer_dst) {
   GT_INPUT_FILE_CHECK(input_file);
   GT_VECTOR_CHECK(buffer_dst);
   GT_INPUT_FILE_CHECK_BUFFER__DUMP(input_file,buffer_dst);
   if (input_file->eof) return GT_INPUT_FILE_EOF;
-  // Read line
-  while (gt_expect_true(!input_file->eof &&
-      GT_INPUT_FILE_CURRENT_CHAR(input_file)!=EOL &&
-      GT_INPUT_FILE_CURRENT_CHAR(input_file)!=DOS_EOL)) {
-    GT_INPUT_FILE_NEXT_CHAR__DUMP(input_file,buffer_dst);
+  // Read line (scan the whole buffered chunk for the EOL, refill if not found)
+  while (gt_expect_true(!input_file->eof)) {
+    const char* const buffer = (char*)input_file->file_buffer;
+    const char* const eol = gt_scan_eol(buffer+input_file->buffer_pos,buffer+input_file->buffer_size);
+    input_file->buffer_pos = eol-buffer;
+    if (gt_expect_true(input_file->buffer_pos < input_file->buffer_size)) break;
+    GT_INPUT_FILE_CHECK_BUFFER__DUMP(input_file,buffer_dst);
   }
   // Handle EOL
   GT_INPUT_FILE_HANDLE_EOL(input_file,buffer_dst);
@@ -252,27 +493,32 @@ GT_INLINE size_t gt_input_file_next_record(
   uint64_t const begin_line_pos_at_file = input_file->buffer_pos;
   uint64_t const begin_line_pos_at_buffer = gt_vector_get_used(buffer_dst);
   uint64_t current_pfield = 0, length_first_field = 0;
-  while (gt_expect_true(!input_file->eof &&
-      GT_INPUT_FILE_CURRENT_CHAR(input_file)!=EOL &&
-      GT_INPUT_FILE_CURRENT_CHAR(input_file)!=DOS_EOL)) {
-    if (current_pfield==0) {
-      if (gt_expect_false(GT_INPUT_FILE_CURRENT_CHAR(input_file)==TAB)) {
-        ++current_pfield; ++(*num_tabs);
-      } else {
-        ++length_first_field;
-      }
-    } else if (current_pfield==1) {
-      if (gt_expect_false(GT_INPUT_FILE_CURRENT_CHAR(input_file)==SPACE)) {
-        ++(*num_blocks);
-      } else if (gt_expect_false(GT_INPUT_FILE_CURRENT_CHAR(input_file)==TAB)) {
-        ++current_pfield; ++(*num_tabs); ++(*num_blocks);
+  while (gt_expect_true(!input_file->eof)) {
+    const char* const buffer = (char*)input_file->file_buffer;
+    const char* const chunk_end = buffer+input_file->buffer_size;
+    const char* centinel = buffer+input_file->buffer_pos;
+    if (current_pfield==0) { // First field (TAG)
+      const char* const field_end = gt_scan_chr3(centinel,chunk_end,TAB,EOL,DOS_EOL);
+      length_first_field += field_end-centinel;
+      centinel = field_end;
+      if (centinel<chunk_end && *centinel==TAB) {
+        ++current_pfield; ++(*num_tabs); ++centinel;
       }
-    } else {
-      if (gt_expect_false(GT_INPUT_FILE_CURRENT_CHAR(input_file)==TAB)) {
-        ++current_pfield; ++(*num_tabs);
+    }
+    if (current_pfield==1 && centinel<chunk_end) { // Second field (blocks separated by SPACE)
+      const char* const field_end = gt_scan_chr3(centinel,chunk_end,TAB,EOL,DOS_EOL);
+      *num_blocks += gt_scan_count(centinel,field_end,SPACE);
+      centinel = field_end;
+      if (centinel<chunk_end && *centinel==TAB) {
+        ++current_pfield; ++(*num_tabs); ++(*num_blocks); ++centinel;
       }
     }
-    GT_INPUT_FILE_NEXT_CHAR__DUMP(input_file,buffer_dst);
+    if (current_pfield>=2 && centinel<chunk_end) { // Remaining fields
+      centinel = gt_scan_eol_count(centinel,chunk_end,TAB,num_tabs);
+    }
+    input_file->buffer_pos = centinel-buffer;
+    if (gt_expect_true(centinel<chunk_end)) break; // EOL found
+    GT_INPUT_FILE_CHECK_BUFFER__DUMP(input_file,buffer_dst);
   }
   // Handle EOL
   GT_INPUT_FILE_HANDLE_EOL(input_file,buffer_dst);
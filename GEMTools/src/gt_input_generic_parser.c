@@ -88,6 +88,47 @@ GT_INLINE gt_status gt_input_generic_parser_get_template(
   }
   return error_code;
 }
+GT_INLINE gt_status gt_input_generic_parser_get_paired_template(
+    gt_buffered_input_file* const buffered_input_end1,gt_buffered_input_file* const buffered_input_end2,
+    pthread_mutex_t* const input_mutex,gt_template* const template,gt_generic_parser_attributes* const attributes) {
+  GT_BUFFERED_INPUT_FILE_CHECK(buffered_input_end1);
+  GT_BUFFERED_INPUT_FILE_CHECK(buffered_input_end2);
+  GT_NULL_CHECK(input_mutex);
+  GT_TEMPLATE_CHECK(template);
+  GT_NULL_CHECK(attributes);
+  gt_status error_code;
+  // Reload both blocks (synch)
+  if ((error_code=gt_input_generic_parser_synch_blocks_va(input_mutex,attributes,
+      2,buffered_input_end1,buffered_input_end2))!=GT_IGP_OK) return error_code;
+  // Prepare template
+  gt_template_clear(template,true);
+  // Parse end/1
+  gt_alignment* const alignment_end1 = gt_template_get_block_dyn(template,0);
+  if ((error_code=gt_input_generic_parser_get_alignment(buffered_input_end1,alignment_end1,attributes))!=GT_IGP_OK) {
+    // Skip the mate (keeps both blocks aligned)
+    if (!gt_buffered_input_file_eob(buffered_input_end2)) {
+      gt_input_generic_parser_get_alignment(buffered_input_end2,gt_template_get_block_dyn(template,1),attributes);
+    }
+    return error_code;
+  }
+  // Parse end/2 (never reload here, the block would get out of synch)
+  if (gt_buffered_input_file_eob(buffered_input_end2)) return GT_IGP_PE_PREMATURE_EOB;
+  gt_alignment* const alignment_end2 = gt_template_get_block_dyn(template,1);
+  if ((error_code=gt_input_generic_parser_get_alignment(buffered_input_end2,alignment_end2,attributes))!=GT_IGP_OK) {
+    return error_code;
+  }
+  if (!gt_string_equals(alignment_end1->tag,alignment_end2->tag)) return GT_IGP_PE_TAG_MISMATCH;
+  // Setup template tag & pair info
+  int64_t pair = GT_PAIR_PE_1;
+  gt_attributes_add(alignment_end1->attributes,GT_ATTR_ID_TAG_PAIR,&pair,int64_t);
+  pair = GT_PAIR_PE_2;
+  gt_attributes_add(alignment_end2->attributes,GT_ATTR_ID_TAG_PAIR,&pair,int64_t);
+  gt_string_copy(template->tag,alignment_end1->tag);
+  gt_attributes_copy(template->attributes,alignment_end1->attributes);
+  pair = GT_PAIR_SE;
+  gt_attributes_add(template->attributes,GT_ATTR_ID_TAG_PAIR,&pair,int64_t);
+  return GT_IGP_OK;
+}
 
 
 /*
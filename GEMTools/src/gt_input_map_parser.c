@@ -252,6 +252,7 @@ GT_INLINE gt_status gt_imp_reload_buffer_matching_tag(
   // Dump buffer if BOF it attached to Map-input, and get new out block (always FIRST)
   gt_buffered_input_file_dump_attached_buffers(buffered_map_input->attached_buffered_output_file);
   // Read new input block
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
   gt_input_file* const input_file = buffered_map_input->input_file;
   // Read lines
   if (input_file->eof) return GT_BMI_EOF;
@@ -298,10 +299,12 @@ GT_INLINE gt_status gt_imp_reload_buffer_matching_tag(
 GT_INLINE gt_status gt_imp_get_block(
     gt_buffered_input_file* const buffered_map_input,const uint64_t num_records) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_map_input);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
   gt_input_file* const input_file = buffered_map_input->input_file;
   // Read lines
   if (input_file->eof) return GT_BMI_EOF;
   gt_input_file_lock(input_file);
+  const uint64_t block_records = gt_input_file_sampling_next_lines(input_file,num_records);
   if (input_file->eof) {
     gt_input_file_unlock(input_file);
     return GT_BMI_EOF;
@@ -311,7 +314,7 @@ GT_INLINE gt_status gt_imp_get_block(
   gt_vector_clear(buffered_map_input->block_buffer); // Clear dst buffer
   // Read lines
   uint64_t lines_read = 0, num_blocks = 0, num_tabs = 0;
-  while ( (lines_read<num_records || num_blocks%2!=0) &&
+  while ( (lines_read<block_records || num_blocks%2!=0) &&
       gt_input_file_next_record(input_file,buffered_map_input->block_buffer,NULL,&num_blocks,&num_tabs) ) ++lines_read;
   // Dump remaining content into the buffer
   gt_input_file_dump_to_buffer(input_file,buffered_map_input->block_buffer);
@@ -559,7 +562,7 @@ GT_INLINE gt_status gt_imp_parse_mismatch_string_v0(const char** const text_line
         last_cut_point = position;
         // Create a new map block
         gt_map* next_map = gt_map_new();
-        gt_map_set_seq_name(next_map,gt_map_get_seq_name(map),gt_map_get_seq_name_length(map));
+        gt_map_set_seq_id(next_map,gt_map_get_seq_id(map));
         gt_map_set_strand(next_map,gt_map_get_strand(map));
         gt_map_set_base_length(next_map,global_length-position);
         // Attach the next block
@@ -672,7 +675,7 @@ GT_INLINE gt_status gt_imp_parse_mismatch_string_v1(const char** const text_line
         GT_NEXT_CHAR(text_line);
         // Create a new map block
         gt_map* const next_map = gt_map_new();
-        gt_map_set_seq_name(next_map,gt_map_get_seq_name(map),gt_map_get_seq_name_length(map));
+        gt_map_set_seq_id(next_map,gt_map_get_seq_id(map));
         gt_map_set_strand(next_map,gt_map_get_strand(map));
         // FIXME: gt_map_set_base_length(next_map,gt_map_get_base_length(map)-read_span);
         // Attach the next block & close current map block
@@ -801,7 +804,7 @@ GT_INLINE gt_status gt_imp_parse_split_map_v0(const char** const text_line,gt_ma
    */
   // Read TAG
   const char* const donor_name = *text_line;
-  GT_READ_UNTIL(text_line,(**text_line)==GT_MAP_SEP);
+  GT_READ_UNTIL_CHAR(text_line,GT_MAP_SEP);
   if (GT_IS_EOL(text_line)) return GT_IMP_PE_PREMATURE_EOL;
   gt_map_set_seq_name(donor_map,donor_name,(*text_line-donor_name));
   GT_NEXT_CHAR(text_line);
@@ -842,7 +845,7 @@ GT_INLINE gt_status gt_imp_parse_split_map_v0(const char** const text_line,gt_ma
   // Read acceptor's TAG
   gt_map* const acceptor_map = gt_map_new();
   const char* const acceptor_name = *text_line;
-  GT_READ_UNTIL(text_line,(**text_line)==GT_MAP_SEP);
+  GT_READ_UNTIL_CHAR(text_line,GT_MAP_SEP);
   if (GT_IS_EOL(text_line)) GT_IMP_PARSE_SPLIT_MAP_CLEAN2__RETURN(GT_IMP_PE_PREMATURE_EOL);
   gt_map_set_seq_name(acceptor_map,acceptor_name,(*text_line-acceptor_name));
   GT_NEXT_CHAR(text_line);
@@ -941,7 +944,7 @@ GT_INLINE gt_status gt_imp_parse_map(
     gt_map_set_base_length(map,read_base_length); // Tentative base length (for GEMv0)
     // Read TAG
     const char* const seq_name_start = *text_line;
-    GT_READ_UNTIL(text_line,(**text_line)==GT_MAP_SEP);
+    GT_READ_UNTIL_CHAR(text_line,GT_MAP_SEP);
     if (GT_IS_EOL(text_line)) GT_IMP_PARSE_MAP_CLEAN__RETURN(GT_IMP_PE_PREMATURE_EOL);
     gt_map_set_seq_name(map,seq_name_start,(*text_line-seq_name_start));
     GT_NEXT_CHAR(text_line); // Separator ':'
@@ -1557,6 +1560,7 @@ GT_INLINE gt_status gt_input_map_parser_get_template(
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_map_input);
   GT_TEMPLATE_CHECK(template);
   GT_MAP_PARSER_CHECK_ATTRIBUTES(map_parser_attr);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   gt_status error_code;
   if ((error_code=gt_imp_get_template(buffered_map_input,template,map_parser_attr))!=GT_IMP_OK) {
     return (error_code==GT_IMP_EOF) ? GT_IMP_EOF : GT_IMP_FAIL;
@@ -1579,6 +1583,7 @@ GT_INLINE gt_status gt_input_map_parser_get_alignment(
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_map_input);
   GT_ALIGNMENT_CHECK(alignment);
   GT_MAP_PARSER_CHECK_ATTRIBUTES(map_parser_attr);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   return gt_imp_get_alignment(buffered_map_input,alignment,map_parser_attr);
 }
 /*
@@ -1716,5 +1721,148 @@ GT_INLINE gt_status gt_input_map_parser_synch_blocks_by_subset(
   } GT_END_MUTEX_SECTION(*input_mutex);
   return GT_IMP_OK;
 }
-
-
+/*
+ * Synch read of blocks (N slaves, each a subset of the master)
+ */
+typedef struct {
+  uint64_t offset;
+  uint64_t length;
+} gt_imp_tag_ref;
+GT_INLINE gt_imp_subset_lookahead* gt_imp_subset_lookahead_new(const uint64_t num_slaves) {
+  gt_imp_subset_lookahead* const lookahead = gt_calloc(num_slaves,gt_imp_subset_lookahead,false);
+  uint64_t i;
+  for (i=0;i<num_slaves;++i) {
+    lookahead[i].record = gt_vector_new(GT_IMP_NUM_INIT_TAG_CHARS,sizeof(char));
+    lookahead[i].tag = gt_string_new(GT_IMP_NUM_INIT_TAG_CHARS);
+    lookahead[i].pending = false;
+  }
+  return lookahead;
+}
+GT_INLINE void gt_imp_subset_lookahead_delete(gt_imp_subset_lookahead* const lookahead,const uint64_t num_slaves) {
+  GT_NULL_CHECK(lookahead);
+  uint64_t i;
+  for (i=0;i<num_slaves;++i) {
+    gt_vector_delete(lookahead[i].record);
+    gt_string_delete(lookahead[i].tag);
+  }
+  gt_free(lookahead);
+}
+/* Length of the TAG used for synchronization (up to the first SPACE and without the /1 /2 suffix) */
+GT_INLINE uint64_t gt_imp_subset_tag_length(const char* const tag,const uint64_t length) {
+  uint64_t tag_length = 0;
+  while (tag_length<length && tag[tag_length]!=SPACE) ++tag_length;
+  if (tag_length>2 && tag[tag_length-2]==SLASH) tag_length-=2;
+  return tag_length;
+}
+GT_INLINE void gt_imp_subset_get_block_tags(gt_buffered_input_file* const buffered_map_input,gt_vector* const block_tags) {
+  const char* const block = gt_vector_get_mem(buffered_map_input->block_buffer,char);
+  const char* const block_end = block+gt_vector_get_used(buffered_map_input->block_buffer);
+  const char* line = block;
+  gt_vector_clear(block_tags);
+  while (line<block_end) {
+    const char* field_end = line;
+    while (field_end<block_end && *field_end!=TAB && *field_end!=EOL) ++field_end;
+    const gt_imp_tag_ref tag_ref = { .offset=line-block, .length=gt_imp_subset_tag_length(line,field_end-line) };
+    gt_vector_insert(block_tags,tag_ref,gt_imp_tag_ref);
+    // Next line
+    line = field_end;
+    while (line<block_end && *line!=EOL) ++line;
+    ++line;
+  }
+}
+/*
+ * Reads the next slave record (line) into the lookahead
+ *   Mates in separate lines are synchronized one line at a time (so the block is cut exactly
+ *   where the template parser would, even if some mates are missing from the slave)
+ */
+GT_INLINE bool gt_imp_subset_lookahead_read(gt_input_file* const input_file,gt_imp_subset_lookahead* const lookahead) {
+  uint64_t num_blocks = 0, num_tabs = 0;
+  gt_vector_clear(lookahead->record);
+  if (gt_input_file_next_record(input_file,lookahead->record,lookahead->tag,&num_blocks,&num_tabs)==0) return false;
+  gt_input_file_dump_to_buffer(input_file,lookahead->record);
+  if (*gt_vector_get_last_elm(lookahead->record,char) != EOL) gt_vector_insert(lookahead->record,EOL,char);
+  ++input_file->processed_lines;
+  lookahead->pending = true;
+  return true;
+}
+/*
+ * Fills the slave block with the records whose TAG is in the master block (in the same order).
+ *   A TAG can match the previously matched master TAG (i.e. the master holds both mates in one line)
+ */
+GT_INLINE void gt_imp_subset_reload_buffer_matching_tags(
+    gt_buffered_input_file* const buffered_map_input,gt_imp_subset_lookahead* const lookahead,
+    const char* const master_block,gt_vector* const master_tags) {
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
+  gt_input_file* const input_file = buffered_map_input->input_file;
+  const gt_imp_tag_ref* const tags = gt_vector_get_mem(master_tags,gt_imp_tag_ref);
+  const uint64_t num_tags = gt_vector_get_used(master_tags);
+  gt_input_file_lock(input_file);
+  buffered_map_input->block_id = gt_input_file_next_id(input_file) % UINT32_MAX;
+  buffered_map_input->current_line_num = input_file->processed_lines+1 - (lookahead->pending ? 1 : 0);
+  gt_vector_clear(buffered_map_input->block_buffer); // Clear dst buffer
+  uint64_t next_tag = 0, lines_read = 0;
+  while (lookahead->pending || gt_imp_subset_lookahead_read(input_file,lookahead)) {
+    // Look for the record's TAG among the remaining master TAGs
+    const uint64_t tag_length = gt_imp_subset_tag_length(lookahead->tag->buffer,lookahead->tag->length);
+    while (next_tag<num_tags && (tags[next_tag].length!=tag_length ||
+        !gt_strneq(master_block+tags[next_tag].offset,lookahead->tag->buffer,tag_length))) ++next_tag;
+    if (next_tag==num_tags) break; // Not in this master block (keep it pending)
+    // Append the record to the block
+    const uint64_t record_length = gt_vector_get_used(lookahead->record);
+    gt_vector_reserve_additional(buffered_map_input->block_buffer,record_length);
+    memcpy(gt_vector_get_mem(buffered_map_input->block_buffer,char)+gt_vector_get_used(buffered_map_input->block_buffer),
+        gt_vector_get_mem(lookahead->record,char),record_length);
+    gt_vector_add_used(buffered_map_input->block_buffer,record_length);
+    ++lines_read;
+    lookahead->pending = false;
+  }
+  buffered_map_input->lines_in_buffer = lines_read;
+  gt_input_file_unlock(input_file);
+  // Setup the block
+  buffered_map_input->cursor = gt_vector_get_mem(buffered_map_input->block_buffer,char);
+}
+// Used to merge files in parallel
+GT_INLINE gt_status gt_input_map_parser_synch_blocks_by_subset_a(
+    pthread_mutex_t* const input_mutex,gt_map_parser_attributes* const map_parser_attr,
+    gt_buffered_input_file* const buffered_map_input_master,gt_buffered_input_file** const buffered_map_input_slaves,
+    gt_imp_subset_lookahead* const lookahead,const uint64_t num_slaves) {
+  GT_NULL_CHECK(input_mutex);
+  GT_NULL_CHECK(map_parser_attr);
+  GT_BUFFERED_INPUT_FILE_CHECK(buffered_map_input_master);
+  GT_NULL_CHECK(buffered_map_input_slaves);
+  GT_NULL_CHECK(lookahead);
+  // Check the end_of_block. Reload buffer if needed (synch)
+  if (!gt_buffered_input_file_eob(buffered_map_input_master)) return GT_IMP_OK;
+  gt_vector* const master_tags = gt_vector_new(GT_IMP_SUBSET_NUM_LINES,sizeof(gt_imp_tag_ref));
+  gt_status error_code;
+  uint64_t i;
+  /*
+   * Read synch blocks
+   */
+  GT_BEGIN_MUTEX_SECTION(*input_mutex) {
+    // Read new input block for the master (dumps the attached output)
+    error_code = gt_input_map_parser_reload_buffer(buffered_map_input_master,
+        map_parser_attr->force_read_paired,GT_IMP_SUBSET_NUM_LINES);
+    if (error_code==GT_IMP_OK) {
+      // Read new input blocks for the slaves (records matching the master block)
+      gt_imp_subset_get_block_tags(buffered_map_input_master,master_tags);
+      const char* const master_block = gt_vector_get_mem(buffered_map_input_master->block_buffer,char);
+      for (i=0;i<num_slaves;++i) {
+        GT_BUFFERED_INPUT_FILE_CHECK(buffered_map_input_slaves[i]);
+        gt_imp_subset_reload_buffer_matching_tags(buffered_map_input_slaves[i],lookahead+i,master_block,master_tags);
+      }
+    } else {
+      // Master exhausted (so must be the slaves)
+      for (i=0;i<num_slaves;++i) {
+        gt_input_file* const input_file = buffered_map_input_slaves[i]->input_file;
+        gt_input_file_lock(input_file);
+        if (lookahead[i].pending || gt_imp_subset_lookahead_read(input_file,lookahead+i)) {
+          error_code = GT_IMP_FAIL;
+        }
+        gt_input_file_unlock(input_file);
+      }
+    }
+  } GT_END_MUTEX_SECTION(*input_mutex);
+  gt_vector_delete(master_tags);
+  return error_code;
+}
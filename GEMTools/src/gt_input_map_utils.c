@@ -226,3 +226,89 @@ GT_INLINE void gt_merge_unsynch_map_files(
   gt_buffered_input_file_close(buffered_input_slave);
   gt_buffered_output_file_close(buffered_output);
 }
+
+GT_INLINE void gt_merge_unsynch_map_files_a(
+    pthread_mutex_t* const input_mutex,gt_imp_subset_lookahead* const lookahead,const bool paired_end,
+    gt_output_file* const output_file,gt_input_file* const input_map_master,
+    gt_input_file** const input_map_slaves,const uint64_t num_slaves) {
+  GT_NULL_CHECK(input_mutex);
+  GT_NULL_CHECK(lookahead);
+  GT_OUTPUT_FILE_CHECK(output_file);
+  GT_INPUT_FILE_CHECK(input_map_master);
+  GT_NULL_CHECK(input_map_slaves);
+  GT_ZERO_CHECK(num_slaves);
+  // Init Buffered Input/Output Files
+  gt_buffered_input_file* const buffered_input_master = gt_buffered_input_file_new(input_map_master);
+  gt_buffered_output_file* const buffered_output = gt_buffered_output_file_new(output_file);
+  gt_buffered_input_file_attach_buffered_output(buffered_input_master,buffered_output);
+  gt_buffered_input_file** const buffered_input_slaves = gt_calloc(num_slaves,gt_buffered_input_file*,false);
+  // Init templates ([0] is the master; [i+1] is the last template read from the slave i)
+  gt_template** const template = gt_calloc(num_slaves+1,gt_template*,false);
+  gt_template** const merged_templates = gt_calloc(num_slaves+1,gt_template*,false);
+  bool* const slave_pending = gt_calloc(num_slaves,bool,true);
+  uint64_t i;
+  template[0] = gt_template_new();
+  for (i=0;i<num_slaves;++i) {
+    GT_INPUT_FILE_CHECK(input_map_slaves[i]);
+    buffered_input_slaves[i] = gt_buffered_input_file_new(input_map_slaves[i]);
+    template[i+1] = gt_template_new();
+  }
+  // Merge loop
+  gt_map_parser_attributes map_parser_attr = GT_MAP_PARSER_ATTR_DEFAULT(paired_end);
+  gt_output_map_attributes output_attributes = GT_OUTPUT_MAP_ATTR_DEFAULT();
+  gt_status error_code;
+  while ((error_code=gt_input_map_parser_synch_blocks_by_subset_a(input_mutex,&map_parser_attr,
+      buffered_input_master,buffered_input_slaves,lookahead,num_slaves))==GT_IMP_OK) {
+    // Read master (always guaranteed)
+    if (gt_input_map_parser_get_template(buffered_input_master,template[0],NULL)==GT_IMP_FAIL) {
+      gt_fatal_error_msg("Fatal error parsing file Master::%s",input_map_master->file_name);
+    }
+    // Collect the slaves' templates matching the master's one
+    uint64_t num_merged = 0;
+    merged_templates[num_merged++] = template[0];
+    for (i=0;i<num_slaves;++i) {
+      if (!slave_pending[i]) {
+        if (gt_buffered_input_file_eob(buffered_input_slaves[i])) continue;
+        if (gt_input_map_parser_get_template(buffered_input_slaves[i],template[i+1],NULL)==GT_IMP_FAIL) {
+          gt_fatal_error_msg("Fatal error parsing file Slave::%s",input_map_slaves[i]->file_name);
+        }
+        slave_pending[i] = true;
+      }
+      if (gt_streq(gt_template_get_tag(template[0]),gt_template_get_tag(template[i+1]))) {
+        merged_templates[num_merged++] = template[i+1];
+        slave_pending[i] = false;
+      }
+    }
+    // Merge maps & print
+    if (num_merged==1) {
+      gt_output_map_bofprint_template(buffered_output,template[0],&output_attributes);
+    } else {
+      gt_template* const ptemplate = gt_template_union_template_mmaps_a(merged_templates,num_merged);
+      gt_output_map_bofprint_template(buffered_output,ptemplate,&output_attributes);
+      gt_template_delete(ptemplate);
+    }
+    // Master block done. The slaves' blocks must be done too
+    if (gt_buffered_input_file_eob(buffered_input_master)) {
+      for (i=0;i<num_slaves;++i) {
+        if (slave_pending[i] || !gt_buffered_input_file_eob(buffered_input_slaves[i])) {
+          gt_fatal_error_msg("<<Slave>> contains more/different reads from <<Master>>, ('%s','%s')",
+              input_map_master->file_name,input_map_slaves[i]->file_name);
+        }
+      }
+    }
+  }
+  if (error_code==GT_IMP_FAIL) gt_fatal_error_msg("<<Slave>> contains more/different reads from <<Master>>");
+  // Clean
+  for (i=0;i<num_slaves;++i) {
+    gt_buffered_input_file_close(buffered_input_slaves[i]);
+  }
+  for (i=0;i<=num_slaves;++i) {
+    gt_template_delete(template[i]);
+  }
+  gt_free(buffered_input_slaves);
+  gt_free(template);
+  gt_free(merged_templates);
+  gt_free(slave_pending);
+  gt_buffered_input_file_close(buffered_input_master);
+  gt_buffered_output_file_close(buffered_output);
+}
@@ -12,12 +12,8 @@
 
 // Count number of ':' in field + 1
 GT_INLINE uint64_t gt_input_parse_count_colons_in_field(const char* const text_line) {
-  uint64_t i = 0, count = 0;
-  while (text_line[i]!=TAB && text_line[i]!=SPACE && text_line[i]!=EOL && text_line[i]!=EOS) {
-    if (text_line[i]==':') ++count;
-    ++i;
-  }
-  return count;
+  const char* const field_end = gt_scan_until(text_line,TAB,SPACE);
+  return gt_scan_count(text_line,field_end,COLON);
 }
 /*
  * Read trim. Covers
@@ -52,7 +48,7 @@ GT_INLINE gt_status gt_input_parse_attribute_trim(const char** const text_line,g
   if (**text_line!=COLON) return GT_PE_BAD_CHARACTER;
   GT_NEXT_CHAR(text_line);
   const char* const trimmed_qual_begin = *text_line;
-  GT_READ_UNTIL(text_line,**text_line==SPACE || **text_line==TAB);
+  GT_READ_UNTIL_CHARS(text_line,SPACE,TAB);
   const uint64_t trimmed_qual_length = *text_line-trimmed_qual_begin;
   if (trimmed_qual_length!=trim_info->length) return GT_PE_BAD_TRIM_QUAL_STRING_LENGTH;
   // Set trimmed qualities
@@ -105,7 +101,7 @@ GT_INLINE gt_status gt_input_parse_tag(const char** const text_line,gt_string* c
   register uint64_t i = 0;
   const char* const tag_begin = *text_line;
   // Parse Tag
-  GT_READ_UNTIL(text_line,**text_line==TAB || **text_line==SPACE); // Read until first SPACE or TAB
+  GT_READ_UNTIL_CHARS(text_line,TAB,SPACE); // Read until first SPACE or TAB
   const uint64_t tag_length = *text_line-tag_begin;
   gt_string_set_nstring_static(tag,tag_begin,tag_length);
   // Add pair info and chomp /1/2/3 info (if any)
@@ -158,7 +154,7 @@ GT_INLINE gt_status gt_input_parse_tag(const char** const text_line,gt_string* c
       const int64_t pair = (casava_info_begin[0]=='1') ? GT_PAIR_PE_1 :
         ((casava_info_begin[0]=='2' || casava_info_begin[0]=='3') ? GT_PAIR_PE_2 : GT_PAIR_SE);
       if (pair==GT_PAIR_PE_1 || pair==GT_PAIR_PE_2) {
-        GT_READ_UNTIL(text_line,**text_line==TAB || **text_line==SPACE);
+        GT_READ_UNTIL_CHARS(text_line,TAB,SPACE);
         const uint64_t casava_info_length = *text_line-casava_info_begin;
         gt_string* const casava_string = gt_string_new(casava_info_length+1);
         gt_string_set_nstring_static(casava_string,casava_info_begin,casava_info_length);
@@ -177,7 +173,7 @@ GT_INLINE gt_status gt_input_parse_tag(const char** const text_line,gt_string* c
      *     @SRR384920.1 HWI-ST382_0049:1:1:1217:1879/2
      */
     const char* const extra_tag_begin = *text_line;
-    GT_READ_UNTIL(text_line,**text_line==TAB || **text_line==SPACE);
+    GT_READ_UNTIL_CHARS(text_line,TAB,SPACE);
     const uint64_t extra_tag_length = *text_line-extra_tag_begin;
     gt_string* const extra_string = gt_string_new(extra_tag_length+1);
     gt_string_set_nstring_static(extra_string,extra_tag_begin,extra_tag_length);
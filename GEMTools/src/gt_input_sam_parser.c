@@ -230,10 +230,12 @@ GT_INLINE void gt_input_sam_parser_next_record(gt_buffered_input_file* const buf
 GT_INLINE gt_status gt_input_sam_parser_get_block(
     gt_buffered_input_file* const buffered_sam_input,const uint64_t num_records) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_sam_input);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_INPUT_WAIT);
   gt_input_file* const input_file = buffered_sam_input->input_file;
   // Read lines
   if (input_file->eof) return GT_BMI_EOF;
   gt_input_file_lock(input_file);
+  const uint64_t block_records = gt_input_file_sampling_next_lines(input_file,num_records);
   if (input_file->eof) {
     gt_input_file_unlock(input_file);
     return GT_BMI_EOF;
@@ -243,9 +245,9 @@ GT_INLINE gt_status gt_input_sam_parser_get_block(
   gt_vector_clear(buffered_sam_input->block_buffer); // Clear dst buffer
   // Read lines & synch SAM records
   uint64_t lines_read = 0;
-  while (lines_read<num_records &&
+  while (lines_read<block_records &&
       gt_input_file_next_line(input_file,buffered_sam_input->block_buffer) ) ++lines_read;
-  if (lines_read==num_records) { // !EOF, Synch wrt to tag content
+  if (lines_read==block_records) { // !EOF, Synch wrt to tag content
     uint64_t num_blocks=0, num_tabs=0;
     gt_string* const reference_tag = gt_string_new(30);
     if (gt_input_file_next_record(input_file,buffered_sam_input->block_buffer,reference_tag,&num_blocks,&num_tabs)) {
@@ -292,14 +294,14 @@ GT_INLINE uint64_t gt_isp_read_tag(char** const init_text_line,char** const end_
   char** const ptext_cp = &text_cp;
   // Read tag
   char* const tag_begin = *ptext_cp;
-  GT_READ_UNTIL(ptext_cp,**ptext_cp==TAB || **ptext_cp==SPACE);
+  GT_READ_UNTIL_CHARS(ptext_cp,TAB,SPACE);
   if (GT_IS_EOL(ptext_cp)) return GT_ISP_PE_PREMATURE_EOL;
   // Set tag
   uint64_t const tag_length = *ptext_cp-tag_begin;
   gt_string_set_nstring(tag,tag_begin,tag_length);
   // Read the rest till next field
   if (**ptext_cp==SPACE) {
-    GT_READ_UNTIL(ptext_cp,**ptext_cp==TAB);
+    GT_READ_UNTIL_CHAR(ptext_cp,TAB);
     if (GT_IS_EOL(ptext_cp)) return GT_ISP_PE_PREMATURE_EOL;
   }
   GT_NEXT_CHAR(ptext_cp);
@@ -359,7 +361,7 @@ GT_INLINE gt_status gt_isp_parse_sam_cigar(char** const text_line,gt_map** _map,
       case 'N': { // Split. Eg TOPHAT, GEM, ...
         // Create a new map block
         gt_map* next_map = gt_map_new();
-        gt_map_set_seq_name(next_map,gt_map_get_seq_name(map),gt_map_get_seq_name_length(map));
+        gt_map_set_seq_id(next_map,gt_map_get_seq_id(map));
         gt_map_set_position(next_map,gt_map_get_position(map)+reference_span+length);
         gt_map_set_strand(next_map,gt_map_get_strand(map));
         gt_map_set_base_length(next_map,gt_map_get_base_length(map)-position);
@@ -399,7 +401,7 @@ GT_INLINE gt_status gt_isp_parse_sam_cigar(char** const text_line,gt_map** _map,
   GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL(); \
   GT_NEXT_CHAR(text_line)
 #define GT_ISP_PARSE_SAM_ALG_SKIP_FIELD() \
-  GT_READ_UNTIL(text_line,**text_line==TAB); \
+  GT_READ_UNTIL_CHAR(text_line,TAB); \
   GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL__NEXT()
 #define GT_ISP_PARSE_SAM_ALG_PARSE_NUMBER(number) \
   if (!gt_is_number(**text_line)) { gt_map_delete(map); return GT_ISP_PE_EXPECTED_NUMBER; } \
@@ -417,7 +419,7 @@ GT_INLINE gt_status gt_isp_parse_sam_opt_xa_bwa(
     gt_map_set_base_length(map,gt_alignment_get_read_length(alignment));
     // Sequence-name/Chromosome
     char* const seq_name = *text_line;
-    GT_READ_UNTIL(text_line,**text_line==COMA);
+    GT_READ_UNTIL_CHAR(text_line,COMA);
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
     gt_map_set_seq_name(map,seq_name,*text_line-seq_name);
     GT_NEXT_CHAR(text_line);
@@ -436,11 +438,11 @@ GT_INLINE gt_status gt_isp_parse_sam_opt_xa_bwa(
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
     GT_NEXT_CHAR(text_line);
     // CIGAR // TODO: Parse it !!
-    GT_READ_UNTIL(text_line,**text_line==COMA);
+    GT_READ_UNTIL_CHAR(text_line,COMA);
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
     GT_NEXT_CHAR(text_line);
     // Edit distance
-    GT_READ_UNTIL(text_line,**text_line==SEMICOLON);
+    GT_READ_UNTIL_CHAR(text_line,SEMICOLON);
     if (**text_line==SEMICOLON) GT_NEXT_CHAR(text_line);
     // Add it to the list
     gt_vector_insert(maps_vector,map,gt_map*);
@@ -469,7 +471,7 @@ GT_INLINE gt_status gt_isp_parse_sam_optional_field(
   /*
    * Unknown field (store it as attribute and skip)
    */
-  GT_READ_UNTIL(text_line,**text_line==TAB);
+  GT_READ_UNTIL_CHAR(text_line,TAB);
 
   // TODO: MD field, and more ....
 
@@ -528,7 +530,7 @@ GT_INLINE gt_status gt_isp_parse_sam_alignment(
     GT_NEXT_CHAR(text_line);
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL__NEXT();
   } else {
-    GT_READ_UNTIL(text_line,**text_line==TAB);
+    GT_READ_UNTIL_CHAR(text_line,TAB);
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
     seq_length = *text_line-seq_name;
     gt_map_set_seq_name(map,seq_name,seq_length);
@@ -571,7 +573,7 @@ GT_INLINE gt_status gt_isp_parse_sam_alignment(
       GT_NEXT_CHAR(text_line);
     } else {
       char* const next_seq_name = *text_line;
-      GT_READ_UNTIL(text_line,**text_line==TAB);
+      GT_READ_UNTIL_CHAR(text_line,TAB);
       GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
       gt_string_set_nstring(&pending->next_seq_name,next_seq_name,*text_line-next_seq_name);
       GT_NEXT_CHAR(text_line);
@@ -599,7 +601,7 @@ GT_INLINE gt_status gt_isp_parse_sam_alignment(
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL__NEXT();
   } else {
     char* const seq_read = *text_line;
-    GT_READ_UNTIL(text_line,**text_line==TAB);
+    GT_READ_UNTIL_CHAR(text_line,TAB);
     GT_ISP_PARSE_SAM_ALG_CHECK_PREMATURE_EOL();
     const uint64_t read_length = *text_line-seq_read;
     GT_NEXT_CHAR(text_line);
@@ -636,7 +638,7 @@ GT_INLINE gt_status gt_isp_parse_sam_alignment(
     GT_NEXT_CHAR(text_line);
   } else {
     char* const seq_qual = *text_line;
-    GT_READ_UNTIL(text_line,**text_line==TAB);
+    GT_READ_UNTIL_CHAR(text_line,TAB);
     const uint64_t read_length = *text_line-seq_qual;
     if (gt_string_is_null(alignment->qualities)) {
       gt_string_set_nstring(alignment->qualities,seq_qual,read_length);
@@ -894,6 +896,7 @@ GT_INLINE gt_status gt_input_sam_parser_get_template(
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_sam_input);
   GT_TEMPLATE_CHECK(template);
   GT_NULL_CHECK(sam_parser_attr);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   gt_status error_code;
   // Check the end_of_block. Reload buffer if needed
   if (gt_buffered_input_file_eob(buffered_sam_input)) {
@@ -929,6 +932,7 @@ GT_INLINE gt_status gt_input_sam_parser_get_alignment(
     gt_buffered_input_file* const buffered_sam_input,gt_alignment* const alignment,gt_sam_parser_attributes* const sam_parser_attr) {
   GT_BUFFERED_INPUT_FILE_CHECK(buffered_sam_input);
   GT_ALIGNMENT_CHECK(alignment);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
   gt_status error_code;
   // Check the end_of_block. Reload buffer if needed
   if (gt_buffered_input_file_eob(buffered_sam_input)) {
@@ -28,3 +28,39 @@ GT_INLINE JsonNode* gt_json_int_hash(gt_shash* const data){
   }GT_SHASH_END_ITERATE
   return a;
 }
+GT_INLINE JsonNode* gt_json_profiler_stages_times(const uint64_t thread_idx){
+  double stage_time[GT_STAGE_NUM_STAGES];
+  uint64_t stage_calls[GT_STAGE_NUM_STAGES];
+  gt_profiler_stages_get_times(thread_idx,stage_time,stage_calls);
+  JsonNode* a = json_mkobject();
+  uint64_t i;
+  for (i=0;i<GT_STAGE_NUM_STAGES;++i) {
+    JsonNode* const stage = json_mkobject();
+    json_append_member(stage, "time", json_mknumber(stage_time[i]));
+    if (i!=GT_STAGE_PROCESS) json_append_member(stage, "calls", json_mknumber((double)stage_calls[i]));
+    json_append_member(a, gt_profiler_stage_get_name(i), stage);
+  }
+  return a;
+}
+GT_INLINE JsonNode* gt_json_profiler_stages(void){
+  JsonNode* a = json_mkobject();
+  const uint64_t num_threads = gt_profiler_stages_get_num_threads();
+  json_append_member(a, "clock", json_mkstring(gt_profiler_stages_get_clock_name()));
+  json_append_member(a, "wall_time", json_mknumber(gt_profiler_stages_get_wall_time()));
+  json_append_member(a, "num_threads", json_mknumber((double)num_threads));
+  json_append_member(a, "stages", gt_json_profiler_stages_times(UINT64_MAX));
+  JsonNode* threads = json_mkarray();
+  uint64_t i;
+  for (i=0;i<num_threads;++i) {
+    json_append_element(threads, gt_json_profiler_stages_times(i));
+  }
+  json_append_member(a, "threads", threads);
+  return a;
+}
+GT_INLINE void gt_json_profiler_stages_fprint(FILE* const stream){
+  JsonNode* const profile = gt_json_profiler_stages();
+  char* const buffer = json_stringify(profile, "  ");
+  fprintf(stream, "%s\n", buffer);
+  free(buffer);
+  json_delete(profile);
+}
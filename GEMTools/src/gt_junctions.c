@@ -0,0 +1,382 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_junctions.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Splice junctions of split maps aggregated by support
+ */
+
+#include "gt_junctions.h"
+
+/*
+ * Constants
+ */
+#define GT_JUNCTION_TABLE_INITIAL_SLOTS 1024 /* Power of two */
+#define GT_JUNCTION_SET_SHARD_SHIFT 58 /* Top bits of the key select the shard */
+
+/*
+ * Internals
+ */
+GT_INLINE uint64_t gt_junction_mix(uint64_t key) {
+  key ^= key >> 33; // MurmurHash3 finalizer
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ull;
+  key ^= key >> 33;
+  return key;
+}
+GT_INLINE uint64_t gt_junction_key(const uint32_t seq_id,const uint64_t begin,const uint64_t end) {
+  return gt_junction_mix(gt_junction_mix(((uint64_t)seq_id<<40)^begin)^end);
+}
+GT_INLINE void gt_junction_table_allocate(gt_junction_table* const junction_table,const uint64_t num_slots) {
+  junction_table->num_slots = num_slots;
+  junction_table->junctions = gt_calloc(num_slots,gt_junction,true); // All seq_id=GT_CONTIG_NULL
+}
+GT_INLINE gt_junction* gt_junction_table_probe(
+    gt_junction_table* const junction_table,const uint32_t seq_id,const uint64_t begin,const uint64_t end) {
+  const uint64_t mask = junction_table->num_slots-1;
+  uint64_t slot = gt_junction_key(seq_id,begin,end) & mask;
+  while (true) {
+    gt_junction* const junction = junction_table->junctions + slot;
+    if (junction->seq_id==GT_CONTIG_NULL) return junction;
+    if (junction->seq_id==seq_id && junction->begin==begin && junction->end==end) return junction;
+    slot = (slot+1) & mask;
+  }
+}
+GT_INLINE void gt_junction_table_grow(gt_junction_table* const junction_table) {
+  gt_junction* const junctions = junction_table->junctions;
+  const uint64_t num_slots = junction_table->num_slots;
+  gt_junction_table_allocate(junction_table,2*num_slots);
+  uint64_t i;
+  for (i=0;i<num_slots;++i) {
+    if (junctions[i].seq_id==GT_CONTIG_NULL) continue;
+    *gt_junction_table_probe(junction_table,junctions[i].seq_id,junctions[i].begin,junctions[i].end) = junctions[i];
+  }
+  gt_free(junctions);
+}
+GT_INLINE void gt_junction_merge(gt_junction* const junction,const gt_strand strand,const uint64_t support) {
+  junction->support += support;
+  if (junction->strand==UNKNOWN) junction->strand = strand;
+}
+
+/*
+ * Junction Table
+ */
+GT_INLINE gt_junction_table* gt_junction_table_new(void) {
+  gt_junction_table* const junction_table = gt_alloc(gt_junction_table);
+  gt_junction_table_allocate(junction_table,GT_JUNCTION_TABLE_INITIAL_SLOTS);
+  junction_table->num_junctions = 0;
+  return junction_table;
+}
+GT_INLINE void gt_junction_table_clear(gt_junction_table* const junction_table) {
+  GT_NULL_CHECK(junction_table);
+  if (junction_table->num_junctions > 0) {
+    memset(junction_table->junctions,0,junction_table->num_slots*sizeof(gt_junction));
+    junction_table->num_junctions = 0;
+  }
+}
+GT_INLINE void gt_junction_table_delete(gt_junction_table* const junction_table) {
+  GT_NULL_CHECK(junction_table);
+  gt_free(junction_table->junctions);
+  gt_free(junction_table);
+}
+GT_INLINE uint64_t gt_junction_table_get_num_junctions(gt_junction_table* const junction_table) {
+  GT_NULL_CHECK(junction_table);
+  return junction_table->num_junctions;
+}
+GT_INLINE gt_junction* gt_junction_table_add(
+    gt_junction_table* const junction_table,const uint32_t seq_id,
+    const uint64_t begin,const uint64_t end,const gt_strand strand,const uint64_t support) {
+  GT_NULL_CHECK(junction_table);
+  gt_junction* junction = gt_junction_table_probe(junction_table,seq_id,begin,end);
+  if (junction->seq_id==GT_CONTIG_NULL) {
+    if (2*(junction_table->num_junctions+1) > junction_table->num_slots) { // Load under 1/2
+      gt_junction_table_grow(junction_table);
+      junction = gt_junction_table_probe(junction_table,seq_id,begin,end);
+    }
+    junction->seq_id = seq_id;
+    junction->strand = strand;
+    junction->begin = begin;
+    junction->end = end;
+    junction->support = support;
+    junction->annotation = GT_JUNCTION_NOVEL;
+    ++junction_table->num_junctions;
+  } else {
+    gt_junction_merge(junction,strand,support);
+  }
+  return junction;
+}
+GT_INLINE gt_junction* gt_junction_table_get(
+    gt_junction_table* const junction_table,const uint32_t seq_id,const uint64_t begin,const uint64_t end) {
+  GT_NULL_CHECK(junction_table);
+  gt_junction* const junction = gt_junction_table_probe(junction_table,seq_id,begin,end);
+  return (junction->seq_id==GT_CONTIG_NULL) ? NULL : junction;
+}
+GT_INLINE uint64_t gt_junction_table_add_map(
+    gt_junction_table* const junction_table,gt_map* const map,
+    const uint64_t min_block_length,const uint64_t max_intron_length) {
+  GT_NULL_CHECK(junction_table);
+  GT_MAP_CHECK(map);
+  uint64_t num_junctions = 0;
+  GT_MAP_ITERATE(map,map_block) {
+    if (!gt_map_has_next_block(map_block) || gt_map_get_junction(map_block)!=SPLICE) continue;
+    gt_map* const next_block = gt_map_get_next_block(map_block);
+    if (next_block->seq_id!=map_block->seq_id) continue;
+    if (gt_map_get_base_length(map_block)<min_block_length || gt_map_get_base_length(next_block)<min_block_length) continue;
+    // Blocks follow the read, so on the reverse strand the next block is upstream
+    // (trims are not part of the block in the reference, so use the untrimmed coordinates)
+    gt_map *upstream_block, *downstream_block;
+    if (gt_map_get_position(next_block) > gt_map_get_end_mapping_position(map_block)) {
+      upstream_block = map_block; downstream_block = next_block;
+    } else if (gt_map_get_position(map_block) > gt_map_get_end_mapping_position(next_block)) {
+      upstream_block = next_block; downstream_block = map_block;
+    } else {
+      continue; // Overlapping blocks
+    }
+    const uint64_t begin = gt_map_get_end_mapping_position(upstream_block); // position+length-1
+    const uint64_t end = gt_map_get_position(downstream_block);
+    const uint64_t intron_length = end-begin-1;
+    if (intron_length==0 || intron_length>max_intron_length) continue;
+    gt_junction_table_add(junction_table,map_block->seq_id,begin,end,UNKNOWN,1);
+    ++num_junctions;
+  }
+  return num_junctions;
+}
+int gt_junction_cmp_exon(const gt_gtf_entry** const a,const gt_gtf_entry** const b) {
+  // By transcript (interned, so pointers compare), then by start
+  if ((*a)->transcript_id!=(*b)->transcript_id) return ((*a)->transcript_id<(*b)->transcript_id) ? -1 : 1;
+  if ((*a)->start!=(*b)->start) return ((*a)->start<(*b)->start) ? -1 : 1;
+  return 0;
+}
+GT_INLINE void gt_junction_collect_exons(const gt_gtf_node* const node,gt_vector* const exons) {
+  // The entries of a contig are only kept in its interval tree (each entry lies in one node)
+  if (node==NULL) return;
+  GT_VECTOR_ITERATE(node->entries_by_start,entry_ptr,entry_pos,gt_gtf_entry*) {
+    gt_gtf_entry* const entry = *entry_ptr;
+    if (entry->transcript_id==NULL || entry->type==NULL || strcmp(entry->type->buffer,GT_GTF_TYPE_EXON)!=0) continue;
+    gt_vector_insert(exons,entry,gt_gtf_entry*);
+  }
+  gt_junction_collect_exons(node->left,exons);
+  gt_junction_collect_exons(node->right,exons);
+}
+GT_INLINE uint64_t gt_junction_table_add_gtf(gt_junction_table* const junction_table,const gt_gtf* const gtf) {
+  GT_NULL_CHECK(junction_table);
+  GT_NULL_CHECK(gtf);
+  gt_vector* const exons = gt_vector_new(GTF_DEFAULT_ENTRIES,sizeof(gt_gtf_entry*));
+  uint64_t num_junctions = 0;
+  uint32_t contig_id;
+  for (contig_id=0;contig_id<gt_vector_get_used(gtf->contig_refs);++contig_id) {
+    gt_gtf_ref* const ref = gt_gtf_get_contig_ref(gtf,contig_id);
+    if (ref==NULL) continue;
+    // Collect the exons of the contig, grouped by transcript
+    gt_vector_clear(exons);
+    gt_junction_collect_exons(ref->node,exons);
+    qsort(gt_vector_get_mem(exons,gt_gtf_entry*),gt_vector_get_used(exons),sizeof(gt_gtf_entry*),
+        (int (*)(const void*,const void*))gt_junction_cmp_exon);
+    // Add the introns between consecutive exons
+    gt_gtf_entry** const exon = gt_vector_get_mem(exons,gt_gtf_entry*);
+    uint64_t i;
+    for (i=1;i<gt_vector_get_used(exons);++i) {
+      if (exon[i]->transcript_id!=exon[i-1]->transcript_id || exon[i]->start<=exon[i-1]->end+1) continue;
+      gt_junction* const junction =
+          gt_junction_table_add(junction_table,contig_id,exon[i-1]->end,exon[i]->start,exon[i]->strand,0);
+      junction->annotation = GT_JUNCTION_ANNOTATED;
+      ++num_junctions;
+    }
+  }
+  gt_vector_delete(exons);
+  return num_junctions;
+}
+
+/*
+ * Junction Set
+ */
+GT_INLINE gt_junction_set* gt_junction_set_new(void) {
+  gt_junction_set* const junction_set = gt_alloc(gt_junction_set);
+  uint64_t i;
+  for (i=0;i<GT_JUNCTION_SET_NUM_SHARDS;++i) {
+    gt_cond_fatal_error(pthread_mutex_init(&junction_set->shards[i].mutex,NULL),SYS_MUTEX_INIT);
+    junction_set->shards[i].junction_table = gt_junction_table_new();
+  }
+  return junction_set;
+}
+GT_INLINE void gt_junction_set_delete(gt_junction_set* const junction_set) {
+  GT_NULL_CHECK(junction_set);
+  uint64_t i;
+  for (i=0;i<GT_JUNCTION_SET_NUM_SHARDS;++i) {
+    gt_cond_fatal_error(pthread_mutex_destroy(&junction_set->shards[i].mutex),SYS_MUTEX_DESTROY);
+    gt_junction_table_delete(junction_set->shards[i].junction_table);
+  }
+  gt_free(junction_set);
+}
+GT_INLINE uint64_t gt_junction_set_get_num_junctions(gt_junction_set* const junction_set) {
+  GT_NULL_CHECK(junction_set);
+  uint64_t i, num_junctions = 0;
+  for (i=0;i<GT_JUNCTION_SET_NUM_SHARDS;++i) {
+    GT_BEGIN_MUTEX_SECTION(junction_set->shards[i].mutex) {
+      num_junctions += junction_set->shards[i].junction_table->num_junctions;
+    } GT_END_MUTEX_SECTION(junction_set->shards[i].mutex);
+  }
+  return num_junctions;
+}
+GT_INLINE void gt_junction_set_flush_table(gt_junction_set* const junction_set,gt_junction_table* const junction_table) {
+  GT_NULL_CHECK(junction_set);
+  GT_NULL_CHECK(junction_table);
+  if (junction_table->num_junctions==0) return;
+  // Bucket the junctions by shard
+  uint64_t shard_offsets[GT_JUNCTION_SET_NUM_SHARDS+1];
+  memset(shard_offsets,0,sizeof(shard_offsets));
+  gt_junction** const buckets = gt_calloc(junction_table->num_junctions,gt_junction*,false);
+  uint8_t* const junction_shard = gt_calloc(junction_table->num_slots,uint8_t,false);
+  uint64_t i;
+  for (i=0;i<junction_table->num_slots;++i) {
+    gt_junction* const junction = junction_table->junctions + i;
+    if (junction->seq_id==GT_CONTIG_NULL) continue;
+    junction_shard[i] = gt_junction_key(junction->seq_id,junction->begin,junction->end) >> GT_JUNCTION_SET_SHARD_SHIFT;
+    ++shard_offsets[junction_shard[i]+1];
+  }
+  for (i=0;i<GT_JUNCTION_SET_NUM_SHARDS;++i) shard_offsets[i+1] += shard_offsets[i];
+  uint64_t shard_cursor[GT_JUNCTION_SET_NUM_SHARDS];
+  memcpy(shard_cursor,shard_offsets,sizeof(shard_cursor));
+  for (i=0;i<junction_table->num_slots;++i) {
+    gt_junction* const junction = junction_table->junctions + i;
+    if (junction->seq_id==GT_CONTIG_NULL) continue;
+    buckets[shard_cursor[junction_shard[i]]++] = junction;
+  }
+  // Merge each bucket into its shard
+  uint64_t shard;
+  for (shard=0;shard<GT_JUNCTION_SET_NUM_SHARDS;++shard) {
+    if (shard_offsets[shard]==shard_offsets[shard+1]) continue;
+    gt_junction_shard* const set_shard = junction_set->shards + shard;
+    GT_BEGIN_MUTEX_SECTION(set_shard->mutex) {
+      for (i=shard_offsets[shard];i<shard_offsets[shard+1];++i) {
+        gt_junction* const junction = buckets[i];
+        gt_junction* const shard_junction = gt_junction_table_add(set_shard->junction_table,
+            junction->seq_id,junction->begin,junction->end,junction->strand,junction->support);
+        if (junction->annotation > shard_junction->annotation) shard_junction->annotation = junction->annotation;
+      }
+    } GT_END_MUTEX_SECTION(set_shard->mutex);
+  }
+  gt_free(junction_shard);
+  gt_free(buckets);
+  gt_junction_table_clear(junction_table);
+}
+int gt_junction_cmp(const gt_junction* const a,const gt_junction* const b) {
+  if (a->seq_id!=b->seq_id) {
+    return gt_strcmp(gt_string_get_string(gt_contig_dictionary_get_name(a->seq_id)),
+                     gt_string_get_string(gt_contig_dictionary_get_name(b->seq_id)));
+  }
+  if (a->begin!=b->begin) return (a->begin<b->begin) ? -1 : 1;
+  if (a->end!=b->end) return (a->end<b->end) ? -1 : 1;
+  return 0;
+}
+GT_INLINE void gt_junction_set_get_junctions(gt_junction_set* const junction_set,gt_vector* const junctions) {
+  GT_NULL_CHECK(junction_set);
+  GT_VECTOR_CHECK(junctions);
+  gt_vector_clear(junctions);
+  gt_vector_reserve(junctions,gt_junction_set_get_num_junctions(junction_set),false);
+  uint64_t shard, i;
+  for (shard=0;shard<GT_JUNCTION_SET_NUM_SHARDS;++shard) {
+    gt_junction_table* const junction_table = junction_set->shards[shard].junction_table;
+    for (i=0;i<junction_table->num_slots;++i) {
+      if (junction_table->junctions[i].seq_id==GT_CONTIG_NULL) continue;
+      gt_vector_insert(junctions,junction_table->junctions[i],gt_junction);
+    }
+  }
+  qsort(gt_vector_get_mem(junctions,gt_junction),gt_vector_get_used(junctions),sizeof(gt_junction),
+      (int (*)(const void*,const void*))gt_junction_cmp);
+}
+
+/*
+ * Annotation
+ */
+GT_INLINE void gt_junction_annotate(const gt_gtf* const gtf,gt_junction* const junction,gt_vector* const hits) {
+  GT_NULL_CHECK(gtf);
+  GT_NULL_CHECK(junction);
+  GT_VECTOR_CHECK(hits);
+  // Exons ending right before the intron
+  gt_gtf_search_contig(gtf,hits,junction->seq_id,junction->begin,junction->begin,true);
+  uint64_t i, num_upstream_exons = 0;
+  gt_gtf_entry** const upstream_exons = gt_vector_get_mem(hits,gt_gtf_entry*);
+  for (i=0;i<gt_vector_get_used(hits);++i) {
+    gt_gtf_entry* const hit = upstream_exons[i];
+    if (hit->end!=junction->begin || hit->type==NULL || strcmp(hit->type->buffer,GT_GTF_TYPE_EXON)!=0) continue;
+    upstream_exons[num_upstream_exons++] = hit;
+  }
+  // Exons starting right after the intron
+  gt_vector_set_used(hits,num_upstream_exons);
+  gt_gtf_search_contig(gtf,hits,junction->seq_id,junction->end,junction->end,false);
+  gt_gtf_entry** const exons = gt_vector_get_mem(hits,gt_gtf_entry*);
+  bool annotated_site = num_upstream_exons>0;
+  for (i=num_upstream_exons;i<gt_vector_get_used(hits);++i) {
+    gt_gtf_entry* const hit = exons[i];
+    if (hit->start!=junction->end || hit->type==NULL || strcmp(hit->type->buffer,GT_GTF_TYPE_EXON)!=0) continue;
+    annotated_site = true;
+    uint64_t j;
+    for (j=0;j<num_upstream_exons;++j) {
+      if (hit->transcript_id!=NULL && exons[j]->transcript_id==hit->transcript_id) {
+        junction->annotation = GT_JUNCTION_ANNOTATED;
+        junction->strand = hit->strand;
+        return;
+      }
+    }
+  }
+  if (annotated_site && junction->annotation==GT_JUNCTION_NOVEL) junction->annotation = GT_JUNCTION_ANNOTATED_SITE;
+}
+
+/*
+ * Junctions file (GEM format)
+ */
+GT_INLINE gt_status gt_junction_parse(const char* const line,gt_junction* const junction) {
+  GT_NULL_CHECK(line);
+  GT_NULL_CHECK(junction);
+  const char* fields[7];
+  uint64_t num_fields = 0;
+  const char* it = line;
+  fields[num_fields++] = it;
+  while (*it!=EOS && *it!=EOL && num_fields<7) {
+    if (*it==TAB) fields[num_fields++] = it+1;
+    ++it;
+  }
+  if (num_fields<6) return GT_STATUS_FAIL;
+  // Contig (both sites on the same one)
+  const uint64_t name_length = fields[1]-fields[0]-1;
+  if (name_length==0 || fields[4]-fields[3]-1!=name_length || strncmp(fields[0],fields[3],name_length)!=0) return GT_STATUS_FAIL;
+  // Positions
+  char* end;
+  const uint64_t donor = strtoull(fields[2],&end,10);
+  if (end==fields[2] || *end!=TAB) return GT_STATUS_FAIL;
+  const uint64_t acceptor = strtoull(fields[5],&end,10);
+  if (end==fields[5] || (*end!=TAB && *end!=EOL && *end!=EOS && *end!='\r')) return GT_STATUS_FAIL;
+  if (donor==acceptor) return GT_STATUS_FAIL;
+  junction->seq_id = gt_contig_dictionary_get_id(fields[0],name_length);
+  junction->strand = (*fields[1]=='-') ? REVERSE : FORWARD;
+  junction->begin = GT_MIN(donor,acceptor);
+  junction->end = GT_MAX(donor,acceptor);
+  junction->annotation = GT_JUNCTION_NOVEL;
+  // Support (optional)
+  junction->support = 1;
+  if (num_fields==7) {
+    const uint64_t support = strtoull(fields[6],&end,10);
+    if (end!=fields[6]) junction->support = support;
+  }
+  return GT_STATUS_OK;
+}
+GT_INLINE void gt_junction_fprint(FILE* const stream,gt_junction* const junction,const bool print_support) {
+  GT_NULL_CHECK(stream);
+  GT_NULL_CHECK(junction);
+  gt_string* const seq_name = gt_contig_dictionary_get_name(junction->seq_id);
+  if (junction->strand==REVERSE) {
+    fprintf(stream,PRIgts"\t-\t%"PRIu64"\t"PRIgts"\t-\t%"PRIu64,
+        PRIgts_content(seq_name),junction->end,PRIgts_content(seq_name),junction->begin);
+  } else {
+    fprintf(stream,PRIgts"\t+\t%"PRIu64"\t"PRIgts"\t+\t%"PRIu64,
+        PRIgts_content(seq_name),junction->begin,PRIgts_content(seq_name),junction->end);
+  }
+  if (print_support) {
+    fprintf(stream,"\t%"PRIu64"\t%s",junction->support,
+        (junction->annotation==GT_JUNCTION_ANNOTATED) ? "annotated" :
+        (junction->annotation==GT_JUNCTION_ANNOTATED_SITE) ? "annotated_site" : "novel");
+  }
+  fprintf(stream,"\n");
+}
@@ -10,14 +10,14 @@
 #include "gt_map.h"
 
 #define GT_MAP_NUM_INITIAL_MISMS 4
-#define GT_MAP_INITIAL_SEQ_NAME_SIZE 10
 
 /*
  * Setup
  */
 GT_INLINE gt_map* gt_map_new() {
   gt_map* map = gt_alloc(gt_map);
-  map->seq_name = gt_string_new(GT_MAP_INITIAL_SEQ_NAME_SIZE);
+  map->seq_id = GT_CONTIG_NULL;
+  map->seq_name = gt_contig_dictionary_get_name(GT_CONTIG_NULL);
   map->position = 0;
   map->base_length = 0;
   map->gt_score = GT_MAP_NO_GT_SCORE;
@@ -29,7 +29,8 @@ GT_INLINE gt_map* gt_map_new() {
 }
 GT_INLINE void gt_map_clear(gt_map* const map) {
   GT_MAP_CHECK(map);
-  gt_string_clear(map->seq_name);
+  map->seq_id = GT_CONTIG_NULL;
+  map->seq_name = gt_contig_dictionary_get_name(GT_CONTIG_NULL);
   map->position = 0;
   map->base_length = 0;
   map->gt_score = GT_MAP_NO_GT_SCORE;
@@ -40,7 +41,6 @@ GT_INLINE void gt_map_clear(gt_map* const map) {
 }
 GT_INLINE void gt_map_block_delete(gt_map* const map) {
   GT_MAP_CHECK(map);
-  gt_string_delete(map->seq_name);
   gt_vector_delete(map->mismatches);
   if (map->attributes!=NULL) gt_attributes_delete(map->attributes);
   gt_free(map);
@@ -68,12 +68,21 @@ GT_INLINE gt_string* gt_map_get_string_seq_name(gt_map* const map) {
 GT_INLINE void gt_map_set_seq_name(gt_map* const map,const char* const seq_name,const uint64_t length) {
   GT_MAP_CHECK(map);
   GT_NULL_CHECK(seq_name);
-  gt_string_set_nstring_static(map->seq_name,seq_name,length);
+  gt_map_set_seq_id(map,gt_contig_dictionary_get_id(seq_name,length));
 }
 GT_INLINE void gt_map_set_string_seq_name(gt_map* const map,gt_string* const seq_name) {
   GT_MAP_CHECK(map);
   GT_STRING_CHECK(seq_name);
-  gt_string_set_nstring(map->seq_name,gt_string_get_string(seq_name),gt_string_get_length(seq_name));
+  gt_map_set_seq_id(map,gt_contig_dictionary_get_id(gt_string_get_string(seq_name),gt_string_get_length(seq_name)));
+}
+GT_INLINE uint32_t gt_map_get_seq_id(gt_map* const map) {
+  GT_MAP_CHECK(map);
+  return map->seq_id;
+}
+GT_INLINE void gt_map_set_seq_id(gt_map* const map,const uint32_t seq_id) {
+  GT_MAP_CHECK(map);
+  map->seq_id = seq_id;
+  map->seq_name = gt_contig_dictionary_get_name(seq_id);
 }
 GT_INLINE gt_strand gt_map_get_strand(gt_map* const map) {
   GT_MAP_CHECK(map);
@@ -651,7 +660,8 @@ GT_INLINE gt_map* gt_map_segment_iterator_get_map(gt_map_segment_iterator* const
 GT_INLINE gt_map* gt_map_copy(gt_map* const map) {
   GT_MAP_CHECK(map);
   gt_map* map_cpy = gt_map_new();
-  gt_string_copy(map_cpy->seq_name,map->seq_name);
+  map_cpy->seq_id = map->seq_id;
+  map_cpy->seq_name = map->seq_name;
   map_cpy->position = map->position;
   map_cpy->base_length = map->base_length;
   map_cpy->strand = map->strand;
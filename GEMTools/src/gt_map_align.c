@@ -73,8 +73,8 @@ GT_INLINE gt_status gt_map_block_check_alignment_sa(
   const uint64_t sequence_length = gt_map_get_length(map);
   gt_string* const sequence = gt_string_new(sequence_length+1);
   gt_status error_code;
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       sequence_length,0,sequence))) return error_code;
   // Check Alignment
   error_code = gt_map_block_check_alignment(map,
@@ -177,8 +177,8 @@ GT_INLINE gt_status gt_map_block_recover_mismatches_sa(
   const uint64_t pattern_length = gt_string_get_length(pattern);
   const uint64_t sequence_length = gt_map_get_length(map);
   gt_string* const sequence = gt_string_new(pattern_length+1);
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       sequence_length,0,sequence))) return error_code;
   // Recover mismatches
   const uint64_t num_misms = gt_map_get_num_misms(map);
@@ -253,8 +253,8 @@ GT_INLINE gt_status gt_map_block_realign_hamming_sa(
   gt_status error_code;
   const uint64_t pattern_length = gt_string_get_length(pattern);
   gt_string* const sequence = gt_string_new(pattern_length+1);
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       pattern_length,0,sequence))) {
     gt_string_delete(sequence);
     return error_code;
@@ -429,8 +429,8 @@ GT_INLINE gt_status gt_map_block_realign_levenshtein_sa(
   const uint64_t decode_length = (ends_free) ? gt_string_get_length(pattern) : gt_map_get_length(map);
   const uint64_t extra_decode_length = (ends_free) ? extra_length : 0;
   gt_string* const sequence = gt_string_new(decode_length+extra_decode_length+1);
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       decode_length,extra_decode_length,sequence))) {
     gt_string_delete(sequence); // Free
     return error_code;
@@ -483,8 +483,8 @@ GT_INLINE gt_status gt_map_block_realign_weighted_sa(
   // Retrieve the sequence
   const uint64_t pattern_length = gt_string_get_length(pattern);
   gt_string* const sequence = gt_string_new(pattern_length+1);
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       pattern_length,extra_length,sequence))) return error_code;
   // Realign Weighted
   return gt_map_block_realign_weighted(map,
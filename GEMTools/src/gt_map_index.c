@@ -0,0 +1,114 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_map_index.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Hash index over the maps (or mmaps) of an alignment (or template)
+ */
+
+#include "gt_map_index.h"
+
+/*
+ * Constants
+ */
+#define GT_MAP_INDEX_INITIAL_SLOTS 64 /* Power of two */
+
+/*
+ * Internals
+ */
+GT_INLINE uint64_t gt_map_index_mix(uint64_t key) {
+  key ^= key >> 33; // MurmurHash3 finalizer
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ull;
+  key ^= key >> 33;
+  return key;
+}
+GT_INLINE void gt_map_index_allocate(gt_map_index* const map_index,const uint64_t num_slots) {
+  map_index->num_slots = num_slots;
+  map_index->entries = gt_malloc(num_slots*sizeof(gt_map_index_entry));
+  memset(map_index->entries,0xFF,num_slots*sizeof(gt_map_index_entry)); // All pos=GT_MAP_INDEX_NOT_FOUND
+}
+GT_INLINE void gt_map_index_insert(gt_map_index* const map_index,const uint64_t key,const uint64_t pos) {
+  const uint64_t mask = map_index->num_slots-1;
+  uint64_t slot = key & mask;
+  while (map_index->entries[slot].pos!=GT_MAP_INDEX_NOT_FOUND) slot = (slot+1) & mask;
+  map_index->entries[slot].key = key;
+  map_index->entries[slot].pos = pos;
+}
+GT_INLINE void gt_map_index_grow(gt_map_index* const map_index) {
+  gt_map_index_entry* const entries = map_index->entries;
+  const uint64_t num_slots = map_index->num_slots;
+  gt_map_index_allocate(map_index,2*num_slots);
+  uint64_t i;
+  for (i=0;i<num_slots;++i) {
+    if (entries[i].pos!=GT_MAP_INDEX_NOT_FOUND) gt_map_index_insert(map_index,entries[i].key,entries[i].pos);
+  }
+  gt_free(entries);
+}
+
+/*
+ * Setup
+ */
+GT_INLINE gt_map_index* gt_map_index_new(void) {
+  gt_map_index* const map_index = gt_alloc(gt_map_index);
+  gt_map_index_allocate(map_index,GT_MAP_INDEX_INITIAL_SLOTS);
+  map_index->num_entries = 0;
+  map_index->num_indexed = 0;
+  return map_index;
+}
+GT_INLINE void gt_map_index_clear(gt_map_index* const map_index) {
+  GT_NULL_CHECK(map_index);
+  if (map_index->num_entries > 0) {
+    memset(map_index->entries,0xFF,map_index->num_slots*sizeof(gt_map_index_entry));
+    map_index->num_entries = 0;
+  }
+  map_index->num_indexed = 0;
+}
+GT_INLINE void gt_map_index_delete(gt_map_index* const map_index) {
+  GT_NULL_CHECK(map_index);
+  gt_free(map_index->entries);
+  gt_free(map_index);
+}
+
+/*
+ * Keys
+ */
+GT_INLINE uint64_t gt_map_index_map_key(gt_map* const map) {
+  if (map==NULL) return 0;
+  uint64_t key = ((uint64_t)map->seq_id<<2) | (uint64_t)map->strand;
+  key = gt_map_index_mix(key ^ (gt_map_get_begin_mapping_position(map)<<24));
+  return gt_map_index_mix(key ^ gt_map_get_end_mapping_position(map));
+}
+GT_INLINE uint64_t gt_map_index_mmap_key(gt_map** const mmap,const uint64_t num_blocks) {
+  GT_NULL_CHECK(mmap);
+  uint64_t i, key = 0;
+  for (i=0;i<num_blocks;++i) {
+    key = gt_map_index_mix(key ^ gt_map_index_map_key(mmap[i]));
+  }
+  return key;
+}
+
+/*
+ * Index operators
+ */
+GT_INLINE void gt_map_index_add(gt_map_index* const map_index,const uint64_t key,const uint64_t pos) {
+  GT_NULL_CHECK(map_index);
+  if (2*(map_index->num_entries+1) > map_index->num_slots) gt_map_index_grow(map_index); // Load under 1/2
+  gt_map_index_insert(map_index,key,pos);
+  ++map_index->num_entries;
+}
+GT_INLINE uint64_t gt_map_index_probe_begin(gt_map_index* const map_index,const uint64_t key) {
+  GT_NULL_CHECK(map_index);
+  return key & (map_index->num_slots-1);
+}
+GT_INLINE uint64_t gt_map_index_probe(gt_map_index* const map_index,const uint64_t key,uint64_t* const slot) {
+  GT_NULL_CHECK(map_index); GT_NULL_CHECK(slot);
+  const uint64_t mask = map_index->num_slots-1;
+  while (true) {
+    gt_map_index_entry* const entry = map_index->entries + *slot;
+    if (entry->pos==GT_MAP_INDEX_NOT_FOUND) return GT_MAP_INDEX_NOT_FOUND;
+    *slot = (*slot+1) & mask;
+    if (entry->key==key) return entry->pos;
+  }
+}
@@ -0,0 +1,124 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_numa.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_numa.h"
+
+#define GT_NUMA_CPULIST_LENGTH 4096
+
+/*
+ * Topology (nodes with no CPU available to the process are skipped)
+ */
+bool gt_numa_enabled = false;
+uint64_t gt_numa_num_nodes = 1;
+cpu_set_t gt_numa_node_cpus[GT_NUMA_MAX_NODES];
+static __thread uint64_t gt_numa_thread_node = 0;
+
+/*
+ * Setup
+ */
+void gt_numa_enable() {
+  cpu_set_t allowed_cpus;
+  if (sched_getaffinity(0,sizeof(cpu_set_t),&allowed_cpus)) return;
+  // Read the CPUs of each node
+  char path[256], cpulist[GT_NUMA_CPULIST_LENGTH];
+  uint64_t node, num_nodes = 0;
+  for (node=0;node<GT_NUMA_MAX_NODES;++node) {
+    sprintf(path,GT_NUMA_SYSFS_NODES"/node%"PRIu64"/cpulist",node);
+    FILE* const cpulist_file = fopen(path,"r");
+    if (cpulist_file==NULL) continue; // Node IDs can be sparse
+    if (fgets(cpulist,GT_NUMA_CPULIST_LENGTH,cpulist_file)!=NULL) {
+      cpu_set_t* const node_cpus = gt_numa_node_cpus+num_nodes;
+      gt_numa_parse_cpulist(cpulist,node_cpus);
+      CPU_AND(node_cpus,node_cpus,&allowed_cpus);
+      if (CPU_COUNT(node_cpus)>0) ++num_nodes;
+    }
+    fclose(cpulist_file);
+  }
+  if (num_nodes==0) return; // Unknown topology (stay as a single unpinned node)
+  gt_numa_num_nodes = num_nodes;
+  gt_numa_enabled = true;
+}
+GT_INLINE uint64_t gt_numa_get_num_nodes() {
+  return gt_numa_num_nodes;
+}
+GT_INLINE uint64_t gt_numa_parse_cpulist(const char* const cpulist,cpu_set_t* const cpu_set) {
+  GT_NULL_CHECK(cpulist); GT_NULL_CHECK(cpu_set);
+  // Format: "0-3,8-11,16"
+  CPU_ZERO(cpu_set);
+  const char* it = cpulist;
+  while (isdigit(*it)) {
+    char* end;
+    uint64_t first = strtoull(it,&end,10), last = first;
+    if (*end=='-') {
+      it = end+1;
+      last = strtoull(it,&end,10);
+    }
+    for (;first<=last && first<CPU_SETSIZE;++first) CPU_SET(first,cpu_set);
+    it = (*end==',') ? end+1 : end;
+  }
+  return CPU_COUNT(cpu_set);
+}
+
+/*
+ * Thread placement
+ */
+GT_INLINE void gt_numa_bind_thread(const uint64_t thread_idx,const uint64_t num_threads) {
+  if (!gt_numa_enabled) return;
+  gt_numa_bind_thread_to_node((thread_idx*gt_numa_num_nodes)/num_threads);
+}
+GT_INLINE void gt_numa_bind_thread_to_node(const uint64_t node) {
+  if (!gt_numa_enabled) return;
+  gt_check(node>=gt_numa_num_nodes,NUMA_NODE_OUT_OF_RANGE,node,gt_numa_num_nodes);
+  gt_cond_error(pthread_setaffinity_np(pthread_self(),sizeof(cpu_set_t),gt_numa_node_cpus+node),NUMA_BIND,node);
+  gt_numa_thread_node = node;
+}
+GT_INLINE uint64_t gt_numa_get_thread_node() {
+  return gt_numa_thread_node;
+}
+
+/*
+ * Replicas
+ */
+typedef struct {
+  gt_numa_replica_loader loader;
+  void* loader_arg;
+  uint64_t node;
+  void* replica;
+} gt_numa_replica_job;
+void* gt_numa_replica_thread(void* const thread_arg) {
+  gt_numa_replica_job* const job = (gt_numa_replica_job*) thread_arg;
+  gt_numa_bind_thread_to_node(job->node);
+  job->replica = job->loader(job->loader_arg);
+  return NULL;
+}
+void** gt_numa_replicate(gt_numa_replica_loader const loader,void* const loader_arg) {
+  GT_NULL_CHECK(loader);
+  void** const replicas = gt_calloc(gt_numa_num_nodes,void*,true);
+  if (!gt_numa_enabled || gt_numa_num_nodes==1) {
+    gt_numa_replica_job job = { .loader=loader, .loader_arg=loader_arg, .node=0 };
+    gt_numa_replica_thread(&job);
+    replicas[0] = job.replica;
+    return replicas;
+  }
+  // Load all the replicas at once (each from its node)
+  gt_numa_replica_job jobs[GT_NUMA_MAX_NODES];
+  pthread_t threads[GT_NUMA_MAX_NODES];
+  uint64_t node;
+  for (node=0;node<gt_numa_num_nodes;++node) {
+    jobs[node].loader = loader;
+    jobs[node].loader_arg = loader_arg;
+    jobs[node].node = node;
+    jobs[node].replica = NULL;
+    gt_cond_fatal_error(pthread_create(threads+node,NULL,gt_numa_replica_thread,jobs+node),SYS_THREAD);
+  }
+  for (node=0;node<gt_numa_num_nodes;++node) {
+    gt_cond_fatal_error(pthread_join(threads[node],NULL),SYS_THREAD_JOIN);
+    replicas[node] = jobs[node].replica;
+  }
+  return replicas;
+}
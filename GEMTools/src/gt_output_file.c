@@ -14,6 +14,8 @@
 #endif
 #include "gt_output_file.h"
 
+void* gt_output_file_writer_thread(void* const thread_arg);
+
 /*
  * Setup
  */
@@ -31,7 +33,14 @@ GT_INLINE void gt_output_file_init_buffers(gt_output_file* const output_file) {
   /* Mutexes */
   gt_cond_fatal_error(pthread_cond_init(&output_file->out_buffer_cond,NULL),SYS_COND_VAR_INIT);
   gt_cond_fatal_error(pthread_cond_init(&output_file->out_write_cond,NULL),SYS_COND_VAR_INIT);
+  gt_cond_fatal_error(pthread_cond_init(&output_file->out_queue_cond,NULL),SYS_COND_VAR_INIT);
+  gt_cond_fatal_error(pthread_cond_init(&output_file->out_flushed_cond,NULL),SYS_COND_VAR_INIT);
   gt_cond_fatal_error(pthread_mutex_init(&output_file->out_file_mutex, NULL),SYS_MUTEX_INIT);
+  /* Writer thread */
+  output_file->write_queue_begin=0;
+  output_file->write_queue_size=0;
+  output_file->writer_stop=false;
+  gt_cond_fatal_error(pthread_create(&output_file->writer_thread,NULL,gt_output_file_writer_thread,output_file),SYS_THREAD);
 }
 
 #ifdef HAVE_ZLIB
@@ -169,6 +178,12 @@ gt_output_file* gt_output_file_new_compress(char* const file_name,const gt_outpu
 gt_status gt_output_file_close(gt_output_file* const output_file) {
   GT_OUTPUT_FILE_CONSISTENCY_CHECK(output_file);
   gt_status error_code = 0;
+  // Drain the write queue and stop the writer
+  GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex) {
+    output_file->writer_stop = true;
+    GT_CV_SIGNAL(output_file->out_queue_cond);
+  } GT_END_MUTEX_SECTION(output_file->out_file_mutex);
+  gt_cond_fatal_error(pthread_join(output_file->writer_thread,NULL),SYS_THREAD_JOIN);
   switch(output_file->compression_type) {
   case GZIP:
   case BZIP2:
@@ -192,6 +207,8 @@ gt_status gt_output_file_close(gt_output_file* const output_file) {
   // Free mutex/CV
   gt_cond_error(error_code|=pthread_cond_destroy(&output_file->out_buffer_cond),SYS_COND_VAR_INIT);
   gt_cond_error(error_code|=pthread_cond_destroy(&output_file->out_write_cond),SYS_COND_VAR_INIT);
+  gt_cond_error(error_code|=pthread_cond_destroy(&output_file->out_queue_cond),SYS_COND_VAR_INIT);
+  gt_cond_error(error_code|=pthread_cond_destroy(&output_file->out_flushed_cond),SYS_COND_VAR_INIT);
   gt_cond_error(error_code|=pthread_mutex_destroy(&output_file->out_file_mutex),SYS_MUTEX_DESTROY);
   // Free handler
   gt_free(output_file);
@@ -207,6 +224,10 @@ GT_INLINE gt_status gt_vofprintf(gt_output_file* const output_file,const char *t
   gt_status error_code;
   GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex)
   {
+    // Keep the order w.r.t. the buffers already dumped
+    while (output_file->write_queue_size>0) {
+      GT_CV_WAIT(output_file->out_flushed_cond,output_file->out_file_mutex);
+    }
     error_code = vfprintf(output_file->file,template,v_args);
   }
   GT_END_MUTEX_SECTION(output_file->out_file_mutex);
@@ -279,33 +300,85 @@ GT_INLINE void gt_output_file_release_buffer(
   GT_END_MUTEX_SECTION(output_file->out_file_mutex);
 }
 
-GT_INLINE gt_output_buffer* gt_output_file_write_buffer(
+/*
+ * Writer thread
+ */
+GT_INLINE void __gt_output_file_enqueue_buffer(
     gt_output_file* const output_file,gt_output_buffer* const output_buffer) {
   GT_OUTPUT_FILE_CONSISTENCY_CHECK(output_file);
-  if (gt_output_buffer_get_used(output_buffer) > 0) {
-    int64_t bytes_written;
-    gt_vector* const vbuffer = gt_output_buffer_to_vchar(output_buffer);
-    GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex)
-    {
-      bytes_written = fwrite(gt_vector_get_mem(vbuffer,char),1,
-          gt_vector_get_used(vbuffer),output_file->file);
+  GT_OUTPUT_BUFFER_CHECK(output_buffer);
+  if (gt_output_buffer_get_used(output_buffer)==0) { // Nothing to write
+    __gt_buffered_output_file_release_buffer(output_file,output_buffer);
+    return;
+  }
+  const uint64_t tail = (output_file->write_queue_begin+output_file->write_queue_size)%GT_MAX_OUTPUT_BUFFERS;
+  gt_output_buffer_set_state(output_buffer,GT_OUTPUT_BUFFER_BUSY); // Owned by the writer
+  output_file->write_queue[tail] = output_buffer;
+  ++output_file->write_queue_size;
+  GT_CV_SIGNAL(output_file->out_queue_cond);
+}
+void* gt_output_file_writer_thread(void* const thread_arg) {
+  gt_output_file* const output_file = (gt_output_file*) thread_arg;
+  gt_output_buffer* queued_buffers[GT_MAX_OUTPUT_BUFFERS];
+  uint64_t i, num_buffers;
+  while (true) {
+    // Wait for queued buffers
+    GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex) {
+      while (output_file->write_queue_size==0 && !output_file->writer_stop) {
+        GT_CV_WAIT(output_file->out_queue_cond,output_file->out_file_mutex);
+      }
+      num_buffers = output_file->write_queue_size;
+      for (i=0;i<num_buffers;++i) {
+        queued_buffers[i] = output_file->write_queue[(output_file->write_queue_begin+i)%GT_MAX_OUTPUT_BUFFERS];
+      }
+    } GT_END_MUTEX_SECTION(output_file->out_file_mutex);
+    if (num_buffers==0) break; // Stopped & drained
+    // Write all of them in a row (out of the mutex)
+    for (i=0;i<num_buffers;++i) {
+      gt_vector* const vbuffer = gt_output_buffer_to_vchar(queued_buffers[i]);
+      const int64_t bytes_written =
+          fwrite(gt_vector_get_mem(vbuffer,char),1,gt_vector_get_used(vbuffer),output_file->file);
+      gt_cond_fatal_error(bytes_written!=gt_vector_get_used(vbuffer),OUTPUT_FILE_FAIL_WRITE);
     }
-    GT_END_MUTEX_SECTION(output_file->out_file_mutex);
-    gt_cond_fatal_error(bytes_written!=gt_vector_get_used(vbuffer),OUTPUT_FILE_FAIL_WRITE);
+    // Give the buffers back
+    GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex) {
+      for (i=0;i<num_buffers;++i) {
+        __gt_buffered_output_file_release_buffer(output_file,queued_buffers[i]);
+      }
+      output_file->write_queue_begin = (output_file->write_queue_begin+num_buffers)%GT_MAX_OUTPUT_BUFFERS;
+      output_file->write_queue_size -= num_buffers;
+      if (output_file->write_queue_size==0) GT_CV_BROADCAST(output_file->out_flushed_cond);
+    } GT_END_MUTEX_SECTION(output_file->out_file_mutex);
+  }
+  return NULL;
+}
+
+/*
+ * Dump buffers
+ */
+GT_INLINE gt_output_buffer* gt_output_file_write_buffer(
+    gt_output_file* const output_file,gt_output_buffer* output_buffer) {
+  GT_OUTPUT_FILE_CONSISTENCY_CHECK(output_file);
+  if (gt_output_buffer_get_used(output_buffer) == 0) {
+    gt_output_buffer_initiallize(output_buffer,GT_OUTPUT_BUFFER_BUSY);
+    return output_buffer;
+  }
+  GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex)
+  {
+    __gt_output_file_enqueue_buffer(output_file,output_buffer);
+    output_buffer = __gt_buffered_output_file_request_buffer(output_file);
   }
-  gt_output_buffer_initiallize(output_buffer,GT_OUTPUT_BUFFER_BUSY);
+  GT_END_MUTEX_SECTION(output_file->out_file_mutex);
   return output_buffer;
 }
 GT_INLINE gt_output_buffer* gt_output_file_sorted_write_buffer_asynchronous(
     gt_output_file* const output_file,gt_output_buffer* output_buffer,const bool asynchronous) {
   GT_OUTPUT_FILE_CONSISTENCY_CHECK(output_file);
-  // Set the block buffer as write pending and set the victim
-  bool victim;
-  uint32_t mayor_block_id, minor_block_id;
   GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex)
   {
-    victim = (output_file->mayor_block_id==gt_output_buffer_get_mayor_block_id(output_buffer) &&
-              output_file->minor_block_id==gt_output_buffer_get_minor_block_id(output_buffer));
+    // Set the block buffer as write pending and set the victim
+    bool victim = (output_file->mayor_block_id==gt_output_buffer_get_mayor_block_id(output_buffer) &&
+                   output_file->minor_block_id==gt_output_buffer_get_minor_block_id(output_buffer));
     while (!asynchronous && !victim) {
       GT_CV_WAIT(output_file->out_write_cond,output_file->out_file_mutex);
       victim = (output_file->mayor_block_id==gt_output_buffer_get_mayor_block_id(output_buffer) &&
@@ -314,69 +387,49 @@ GT_INLINE gt_output_buffer* gt_output_file_sorted_write_buffer_asynchronous(
     // Set the buffer as write pending
     ++output_file->buffer_write_pending;
     gt_output_buffer_set_state(output_buffer,GT_OUTPUT_BUFFER_WRITE_PENDING);
-    if (!victim) { // Enqueue the buffer and continue (someone else will do the writing)
-      output_buffer = __gt_buffered_output_file_request_buffer(output_file);
-      GT_END_MUTEX_SECTION(output_file->out_file_mutex);
-      return output_buffer;
-    } else {
-      mayor_block_id = output_file->mayor_block_id;
-      minor_block_id = output_file->minor_block_id;
-    }
-  }
-  GT_END_MUTEX_SECTION(output_file->out_file_mutex);
-  // I'm the victim, I will output as much as I can
-  do {
-    // Write the current buffer
-    if (gt_output_buffer_get_used(output_buffer) > 0) {
-      gt_vector* const vbuffer = gt_output_buffer_to_vchar(output_buffer);
-      const int64_t bytes_written =
-          fwrite(gt_vector_get_mem(vbuffer,char),1,gt_vector_get_used(vbuffer),output_file->file);
-      gt_cond_fatal_error(bytes_written!=gt_vector_get_used(vbuffer),OUTPUT_FILE_FAIL_WRITE);
-    }
-    // Update buffers' state
-    GT_BEGIN_MUTEX_SECTION(output_file->out_file_mutex) {
-      // Decrement write-pending blocks and update next block ID (mayorID,minorID)
-      --output_file->buffer_write_pending;
-      if (output_buffer->is_final_block) {
-        ++mayor_block_id;
-        minor_block_id = 0;
-      } else {
-        ++minor_block_id;
-      }
-      // Search for the next block buffer in order
-      bool next_found = false;
-      if (output_file->buffer_write_pending>0) {
-        uint64_t i;
-        for (i=0;i<GT_MAX_OUTPUT_BUFFERS&&output_file->buffer[i]!=NULL;++i) {
-          if (mayor_block_id==gt_output_buffer_get_mayor_block_id(output_file->buffer[i]) &&
-              minor_block_id==gt_output_buffer_get_minor_block_id(output_file->buffer[i])) {
-            if (gt_output_buffer_get_state(output_file->buffer[i])!=GT_OUTPUT_BUFFER_WRITE_PENDING) {
-              break; // Cannot dump a busy buffer
-            } else {
-              // I'm still the victim, free the current buffer and output the new one
-              __gt_buffered_output_file_release_buffer(output_file,output_buffer);
-              next_found = true;
-              output_buffer = output_file->buffer[i];
+    if (victim) {
+      // I'm the victim, I will queue as many blocks (in order) as I can
+      uint32_t mayor_block_id = output_file->mayor_block_id;
+      uint32_t minor_block_id = output_file->minor_block_id;
+      while (output_buffer!=NULL) {
+        // Queue the current buffer & update next block ID (mayorID,minorID)
+        --output_file->buffer_write_pending;
+        if (output_buffer->is_final_block) {
+          ++mayor_block_id;
+          minor_block_id = 0;
+        } else {
+          ++minor_block_id;
+        }
+        __gt_output_file_enqueue_buffer(output_file,output_buffer);
+        // Search for the next block buffer in order (cannot queue a busy buffer)
+        output_buffer = NULL;
+        if (output_file->buffer_write_pending>0) {
+          uint64_t i;
+          for (i=0;i<GT_MAX_OUTPUT_BUFFERS&&output_file->buffer[i]!=NULL;++i) {
+            if (mayor_block_id==gt_output_buffer_get_mayor_block_id(output_file->buffer[i]) &&
+                minor_block_id==gt_output_buffer_get_minor_block_id(output_file->buffer[i])) {
+              if (gt_output_buffer_get_state(output_file->buffer[i])==GT_OUTPUT_BUFFER_WRITE_PENDING) {
+                output_buffer = output_file->buffer[i];
+              }
               break;
             }
           }
         }
       }
-      if (!next_found) {
-        // Fine, I'm done, let's get out of here ASAP
-        output_file->mayor_block_id = mayor_block_id;
-        output_file->minor_block_id = minor_block_id;
-        gt_output_buffer_initiallize(output_buffer,GT_OUTPUT_BUFFER_BUSY);
-        GT_CV_BROADCAST(output_file->out_write_cond);
-        GT_END_MUTEX_SECTION(output_file->out_file_mutex);
-        return output_buffer;
-      }
-    } GT_END_MUTEX_SECTION(output_file->out_file_mutex);
-  } while (true);
+      output_file->mayor_block_id = mayor_block_id;
+      output_file->minor_block_id = minor_block_id;
+      GT_CV_BROADCAST(output_file->out_write_cond);
+    }
+    // Someone else (or the writer) will do the writing. Continue with a fresh buffer
+    output_buffer = __gt_buffered_output_file_request_buffer(output_file);
+  }
+  GT_END_MUTEX_SECTION(output_file->out_file_mutex);
+  return output_buffer;
 }
 GT_INLINE gt_output_buffer* gt_output_file_dump_buffer(
     gt_output_file* const output_file,gt_output_buffer* const output_buffer,const bool asynchronous) {
   GT_OUTPUT_FILE_CONSISTENCY_CHECK(output_file);
+  GT_STAGE_PROF_SCOPE(GT_STAGE_OUTPUT_WAIT);
   switch (output_file->file_type) {
     case SORTED_FILE:
       return gt_output_file_sorted_write_buffer_asynchronous(output_file,output_buffer,asynchronous);
@@ -868,8 +868,8 @@ GT_INLINE gt_status gt_output_map_gprint_pretty_map_block_sa(
   const uint64_t sequence_length = gt_map_get_length(map);
   gt_string* const sequence = gt_string_new(sequence_length+1);
   gt_status error_code;
-  if ((error_code=gt_sequence_archive_retrieve_sequence_chunk(sequence_archive,
-      gt_map_get_seq_name(map),gt_map_get_strand(map),gt_map_get_position(map),
+  if ((error_code=gt_sequence_archive_retrieve_contig_chunk(sequence_archive,
+      gt_map_get_seq_id(map),gt_map_get_strand(map),gt_map_get_position(map),
       sequence_length,0,sequence))) return error_code;
   // Check Alignment
   return gt_output_map_gprint_map_block_pretty(gprinter,map,
@@ -572,7 +572,7 @@ GT_INLINE gt_status gt_output_sam_gprint_core_fields_pe(gt_generic_printer* cons
   // (8) Print PNEXT
   // (9) Print TLEN
   if (mate!=NULL) {
-    if (map!=NULL && !gt_string_equals(map->seq_name,mate->seq_name)) {
+    if (map!=NULL && map->seq_id!=mate->seq_id) {
       gt_gprintf(gprinter,"\t"PRIgts"\t%"PRIu64"\t%"PRId64,PRIgts_content(mate->seq_name),mate_position,template_length);
     } else {
       gt_gprintf(gprinter,"\t=\t%"PRIu64"\t%"PRId64,mate_position,template_length);
@@ -45,3 +45,171 @@ void gt_profiler_exit() {
 }
 
 #endif
+
+/*
+ * Stage Profiler
+ */
+#ifdef GT_PROFILE_RDTSC
+  #include <x86intrin.h>
+#endif
+typedef struct {
+  uint64_t stage_ticks[GT_STAGE_NUM_STAGES];
+  uint64_t stage_calls[GT_STAGE_NUM_STAGES];
+  gt_stage stage_stack[GT_STAGE_NESTING_DEPTH]; // Innermost stage at [depth]
+  uint64_t depth;
+  uint64_t last_tick;
+} gt_stage_profile;
+
+bool gt_profiler_stages_enabled = false;
+static pthread_mutex_t gt_profiler_stages_mutex = PTHREAD_MUTEX_INITIALIZER;
+static gt_vector* gt_profiler_stages_threads = NULL; /* (gt_stage_profile*) */
+static __thread gt_stage_profile* gt_profiler_stages_thread = NULL;
+static __thread gt_stage_profile gt_profiler_stages_thread_dummy; // Accounts nothing (not profiling)
+static __thread uint64_t gt_profiler_stages_thread_generation = 0;
+static uint64_t gt_profiler_stages_generation = 1; // Invalidates the thread profiles on destroy
+static uint64_t gt_profiler_stages_start_tick = 0;
+static double gt_profiler_stages_tick_seconds = 1E-9;
+static char* gt_profiler_stages_names[GT_STAGE_NUM_STAGES] = {
+  "process", "input_wait", "parse", "format", "output_wait"
+};
+
+static uint64_t gt_profiler_stages_get_tick() {
+#ifdef GT_PROFILE_RDTSC
+  return __rdtsc();
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (uint64_t)now.tv_sec*1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+static gt_stage_profile* gt_profiler_stages_get_thread_profile() {
+  if (gt_expect_false(gt_profiler_stages_thread_generation!=gt_profiler_stages_generation)) {
+    gt_stage_profile* profile = NULL;
+    GT_BEGIN_MUTEX_SECTION(gt_profiler_stages_mutex) {
+      // Ending a stage begun before the profiler was destroyed registers nothing
+      if (gt_profiler_stages_threads!=NULL && gt_profiler_stages_enabled) {
+        profile = gt_calloc(1,gt_stage_profile,true);
+        profile->stage_stack[0] = GT_STAGE_PROCESS;
+        profile->last_tick = gt_profiler_stages_get_tick();
+        gt_vector_insert(gt_profiler_stages_threads,profile,gt_stage_profile*);
+        gt_profiler_stages_thread = profile;
+        gt_profiler_stages_thread_generation = gt_profiler_stages_generation;
+      }
+    } GT_END_MUTEX_SECTION(gt_profiler_stages_mutex);
+    if (profile==NULL) return &gt_profiler_stages_thread_dummy;
+  }
+  return gt_profiler_stages_thread;
+}
+static void gt_profiler_stages_account(gt_stage_profile* const profile) {
+  const uint64_t now = gt_profiler_stages_get_tick();
+  const gt_stage current_stage = profile->stage_stack[GT_MIN(profile->depth,GT_STAGE_NESTING_DEPTH-1)];
+  profile->stage_ticks[current_stage] += now - profile->last_tick;
+  profile->last_tick = now;
+}
+void gt_profiler_stage_begin(const gt_stage stage) {
+  gt_stage_profile* const profile = gt_profiler_stages_get_thread_profile();
+  gt_profiler_stages_account(profile);
+  ++(profile->depth);
+  if (profile->depth < GT_STAGE_NESTING_DEPTH) profile->stage_stack[profile->depth] = stage;
+  ++(profile->stage_calls[stage]);
+}
+void gt_profiler_stage_end(const gt_stage stage) {
+  gt_stage_profile* const profile = gt_profiler_stages_get_thread_profile();
+  gt_profiler_stages_account(profile);
+  if (profile->depth > 0) --(profile->depth);
+}
+gt_stage gt_profiler_stage_scope_begin(const gt_stage stage) {
+  if (gt_expect_true(!gt_profiler_stages_enabled)) return GT_STAGE_NUM_STAGES;
+  gt_profiler_stage_begin(stage);
+  return stage;
+}
+void gt_profiler_stage_scope_end(gt_stage* const stage) {
+  if (gt_expect_true(*stage==GT_STAGE_NUM_STAGES)) return;
+  gt_profiler_stage_end(*stage);
+}
+
+/*
+ * Stage Profiler Setup & Report
+ */
+void gt_profiler_stages_enable() {
+  GT_BEGIN_MUTEX_SECTION(gt_profiler_stages_mutex) {
+    if (gt_profiler_stages_threads==NULL) {
+      gt_profiler_stages_threads = gt_vector_new(16,sizeof(gt_stage_profile*));
+    }
+#ifdef GT_PROFILE_RDTSC
+    // Calibrate the TSC against the monotonic clock
+    struct timespec begin_time, end_time, delay = { .tv_sec=0, .tv_nsec=20000000 };
+    clock_gettime(CLOCK_MONOTONIC,&begin_time);
+    const uint64_t begin_tick = __rdtsc();
+    nanosleep(&delay,NULL);
+    clock_gettime(CLOCK_MONOTONIC,&end_time);
+    const uint64_t end_tick = __rdtsc();
+    const double elapsed = (end_time.tv_sec-begin_time.tv_sec) + (end_time.tv_nsec-begin_time.tv_nsec)/1E9;
+    gt_profiler_stages_tick_seconds = elapsed/(double)(end_tick-begin_tick);
+#endif
+    gt_profiler_stages_start_tick = gt_profiler_stages_get_tick();
+    gt_profiler_stages_enabled = true;
+  } GT_END_MUTEX_SECTION(gt_profiler_stages_mutex);
+  gt_profiler_stages_get_thread_profile(); // Register the calling thread
+}
+void gt_profiler_stages_destroy() {
+  GT_BEGIN_MUTEX_SECTION(gt_profiler_stages_mutex) {
+    gt_profiler_stages_enabled = false;
+    if (gt_profiler_stages_threads!=NULL) {
+      GT_VECTOR_ITERATE(gt_profiler_stages_threads,thread_profile,thread_pos,gt_stage_profile*) {
+        gt_free(*thread_profile);
+      }
+      gt_vector_delete(gt_profiler_stages_threads);
+      gt_profiler_stages_threads = NULL;
+    }
+    // Other threads still point to their (freed) profiles. They register again
+    // (or account nothing, if the profiler is not enabled again) on their next stage mark
+    ++gt_profiler_stages_generation;
+    gt_profiler_stages_thread = NULL;
+  } GT_END_MUTEX_SECTION(gt_profiler_stages_mutex);
+}
+char* gt_profiler_stage_get_name(const gt_stage stage) {
+  return gt_profiler_stages_names[stage];
+}
+char* gt_profiler_stages_get_clock_name() {
+#ifdef GT_PROFILE_RDTSC
+  return "rdtsc";
+#else
+  return "monotonic";
+#endif
+}
+double gt_profiler_stages_get_wall_time() {
+  return (double)(gt_profiler_stages_get_tick()-gt_profiler_stages_start_tick)*gt_profiler_stages_tick_seconds;
+}
+uint64_t gt_profiler_stages_get_num_threads() {
+  uint64_t num_threads;
+  GT_BEGIN_MUTEX_SECTION(gt_profiler_stages_mutex) {
+    num_threads = (gt_profiler_stages_threads!=NULL) ? gt_vector_get_used(gt_profiler_stages_threads) : 0;
+  } GT_END_MUTEX_SECTION(gt_profiler_stages_mutex);
+  return num_threads;
+}
+void gt_profiler_stages_get_times(
+    const uint64_t thread_idx,double* const stage_time,uint64_t* const stage_calls) {
+  GT_NULL_CHECK(stage_time); GT_NULL_CHECK(stage_calls);
+  uint64_t i;
+  for (i=0;i<GT_STAGE_NUM_STAGES;++i) {
+    stage_time[i] = 0.0;
+    stage_calls[i] = 0;
+  }
+  // Account the time of the calling thread up to now
+  if (gt_profiler_stages_thread!=NULL && gt_profiler_stages_thread_generation==gt_profiler_stages_generation) {
+    gt_profiler_stages_account(gt_profiler_stages_thread);
+  }
+  // Merge the selected thread profiles
+  GT_BEGIN_MUTEX_SECTION(gt_profiler_stages_mutex) {
+    if (gt_profiler_stages_threads!=NULL) {
+      GT_VECTOR_ITERATE(gt_profiler_stages_threads,thread_profile,thread_pos,gt_stage_profile*) {
+        if (thread_idx!=UINT64_MAX && thread_idx!=thread_pos) continue;
+        for (i=0;i<GT_STAGE_NUM_STAGES;++i) {
+          stage_time[i] += (double)(*thread_profile)->stage_ticks[i]*gt_profiler_stages_tick_seconds;
+          stage_calls[i] += (*thread_profile)->stage_calls[i];
+        }
+      }
+    }
+  } GT_END_MUTEX_SECTION(gt_profiler_stages_mutex);
+}
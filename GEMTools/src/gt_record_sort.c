@@ -0,0 +1,655 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_record_sort.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: External sort of MAP/SAM records by tag under a memory budget
+ */
+
+#include <omp.h>
+#include "gt_record_sort.h"
+#include "gt_buffered_input_file.h"
+#include "gt_buffered_output_file.h"
+
+/*
+ * Constants
+ */
+#define GT_RECORD_SORT_MIN_THREAD_MEMORY GT_BUFFER_SIZE_256K
+#define GT_RECORD_SORT_SAMPLE_SIZE       GT_BUFFER_SIZE_64K  /* Bytes of records between sampled keys */
+#define GT_RECORD_SORT_RANGE_SIZE        GT_BUFFER_SIZE_16M  /* Target bytes merged per key range */
+#define GT_RECORD_SORT_RANGES_PER_THREAD 4
+#define GT_RECORD_SORT_IO_BUFFER         GT_BUFFER_SIZE_1M
+#define GT_RECORD_SORT_MIN_IO_BUFFER     GT_BUFFER_SIZE_64K
+#define GT_RECORD_SORT_MAX_RUNS          64  /* File runs kept open (merged down once reached) */
+#define GT_RECORD_SORT_MERGE_FAN_IN      32  /* File runs merged into one by an intermediate pass */
+#define GT_RECORD_SORT_MERGE_MEMORY_SHARE 4  /* Up to 1/4 of the budget goes to the merge read-ahead */
+#define GT_RECORD_SORT_OUTPUT_DUMP       GT_BUFFER_SIZE_8M
+
+/*
+ * Records
+ *   In memory, records are lines of a thread buffer. In a run file, each record is
+ *   preceded by its header {seq,key_length,length}
+ */
+typedef struct {
+  union {
+    uint64_t offset;  // Offset in the thread buffer (while buffering)
+    char* record;     // Record itself (once sorted)
+  };
+  uint64_t seq;       // Input line of the record (tie-breaker)
+  uint32_t key_length;
+  uint32_t length;    // Including EOL
+} gt_record_sort_entry;
+typedef struct {
+  uint64_t seq;
+  uint32_t key_length;
+  uint32_t length;
+} gt_record_sort_header;
+/*
+ * Runs
+ *   Sorted records, either in a temporal file (@fd!=-1) or in memory.
+ *   Every GT_RECORD_SORT_SAMPLE_SIZE bytes a record is sampled into the index
+ *   (its key and position, i.e. file offset or entry number)
+ */
+typedef struct {
+  uint64_t position;
+  uint64_t seq;
+  uint64_t key_offset;  // Offset in @index_keys
+  uint64_t key_length;
+} gt_record_sort_sample;
+typedef struct {
+  /* File run */
+  int fd;
+  char* file_name;
+  uint64_t size;
+  /* Memory run */
+  gt_vector* buffer;    // (char)
+  gt_vector* entries;   // (gt_record_sort_entry)
+  /* Sparse index */
+  gt_vector* index;     // (gt_record_sort_sample)
+  gt_vector* index_keys; // (char)
+} gt_record_sort_run;
+/*
+ * Key (plus tie-breaker) delimiting merge ranges
+ */
+typedef struct {
+  const char* key;
+  uint64_t key_length;
+  uint64_t seq;
+} gt_record_sort_splitter;
+/*
+ * Merge cursor over a run
+ */
+typedef struct {
+  gt_record_sort_run* run;
+  /* Current record */
+  const char* record;
+  uint64_t key_length;
+  uint64_t length;
+  uint64_t seq;
+  /* Position */
+  uint64_t entry_pos;   // Next entry (memory run)
+  uint64_t file_pos;    // File offset of @buffer[0] (file run)
+  uint64_t buffer_pos;  // Next header in @buffer (file run)
+  gt_vector* buffer;    // (char)
+  uint64_t buffer_size; // Bytes read ahead at once (file run)
+} gt_record_sort_cursor;
+/*
+ * K-way merge of runs (heap of cursors, smallest record on top)
+ */
+typedef struct {
+  gt_record_sort_cursor* cursors;
+  gt_record_sort_cursor** heap;
+  uint64_t num_cursors;
+  uint64_t heap_size;
+  const gt_record_sort_splitter* upper_bound;
+} gt_record_sort_merger;
+
+/*
+ * Keys
+ */
+GT_INLINE uint64_t gt_record_sort_get_key_length(const char* const record,const uint64_t length) {
+  uint64_t key_length = 0;
+  while (key_length<length && record[key_length]!=TAB && record[key_length]!=SPACE &&
+         record[key_length]!=EOL && record[key_length]!=DOS_EOL) ++key_length;
+  // Remove the pair suffix
+  if (key_length>2 && record[key_length-2]==SLASH &&
+      (record[key_length-1]=='1' || record[key_length-1]=='2')) key_length-=2;
+  return key_length;
+}
+GT_INLINE int gt_record_sort_cmp_keys(
+    const char* const key_a,const uint64_t length_a,const char* const key_b,const uint64_t length_b) {
+  const int cmp = memcmp(key_a,key_b,GT_MIN(length_a,length_b));
+  if (cmp!=0) return cmp;
+  return (length_a<length_b) ? -1 : (length_a>length_b);
+}
+GT_INLINE int gt_record_sort_cmp(
+    const char* const key_a,const uint64_t length_a,const uint64_t seq_a,
+    const char* const key_b,const uint64_t length_b,const uint64_t seq_b) {
+  const int cmp = gt_record_sort_cmp_keys(key_a,length_a,key_b,length_b);
+  if (cmp!=0) return cmp;
+  return (seq_a<seq_b) ? -1 : (seq_a>seq_b);
+}
+int gt_record_sort_cmp_entries(const void* const a,const void* const b) {
+  const gt_record_sort_entry* const entry_a = a;
+  const gt_record_sort_entry* const entry_b = b;
+  return gt_record_sort_cmp(entry_a->record,entry_a->key_length,entry_a->seq,
+      entry_b->record,entry_b->key_length,entry_b->seq);
+}
+int gt_record_sort_cmp_splitters(const void* const a,const void* const b) {
+  const gt_record_sort_splitter* const splitter_a = a;
+  const gt_record_sort_splitter* const splitter_b = b;
+  return gt_record_sort_cmp(splitter_a->key,splitter_a->key_length,splitter_a->seq,
+      splitter_b->key,splitter_b->key_length,splitter_b->seq);
+}
+
+/*
+ * Runs
+ */
+GT_INLINE gt_record_sort_run* gt_record_sort_run_new() {
+  gt_record_sort_run* const run = gt_alloc(gt_record_sort_run);
+  run->fd = -1;
+  run->file_name = NULL;
+  run->size = 0;
+  run->buffer = NULL;
+  run->entries = NULL;
+  run->index = gt_vector_new(16,sizeof(gt_record_sort_sample));
+  run->index_keys = gt_vector_new(GT_BUFFER_SIZE_1K,sizeof(char));
+  return run;
+}
+GT_INLINE void gt_record_sort_run_delete(gt_record_sort_run* const run) {
+  if (run->fd!=-1) {
+    gt_cond_fatal_error(close(run->fd),FILE_CLOSE,run->file_name);
+    gt_free(run->file_name);
+  }
+  if (run->buffer!=NULL) gt_vector_delete(run->buffer);
+  if (run->entries!=NULL) gt_vector_delete(run->entries);
+  gt_vector_delete(run->index);
+  gt_vector_delete(run->index_keys);
+  gt_free(run);
+}
+GT_INLINE void gt_record_sort_run_add_sample(
+    gt_record_sort_run* const run,const char* const key,const uint64_t key_length,
+    const uint64_t seq,const uint64_t position) {
+  gt_vector_reserve_additional(run->index,1);
+  gt_record_sort_sample* const sample = gt_vector_get_free_elm(run->index,gt_record_sort_sample);
+  gt_vector_inc_used(run->index);
+  sample->position = position;
+  sample->seq = seq;
+  sample->key_offset = gt_vector_get_used(run->index_keys);
+  sample->key_length = key_length;
+  gt_vector_reserve_additional(run->index_keys,key_length);
+  memcpy(gt_vector_get_mem(run->index_keys,char)+sample->key_offset,key,key_length);
+  gt_vector_add_used(run->index_keys,key_length);
+}
+/*
+ * Sorts the buffered records (@entries hold offsets into @buffer)
+ */
+GT_INLINE void gt_record_sort_entries(gt_vector* const buffer,gt_vector* const entries) {
+  char* const records = gt_vector_get_mem(buffer,char);
+  GT_VECTOR_ITERATE(entries,entry,entry_pos,gt_record_sort_entry) {
+    entry->record = records + entry->offset;
+  }
+  qsort(gt_vector_get_mem(entries,gt_record_sort_entry),gt_vector_get_used(entries),
+      sizeof(gt_record_sort_entry),gt_record_sort_cmp_entries);
+}
+/*
+ * Keeps the buffered records as a run in memory (takes ownership of the vectors)
+ */
+GT_INLINE gt_record_sort_run* gt_record_sort_run_new_memory(gt_vector* const buffer,gt_vector* const entries) {
+  gt_record_sort_entries(buffer,entries);
+  gt_record_sort_run* const run = gt_record_sort_run_new();
+  run->buffer = buffer;
+  run->entries = entries;
+  uint64_t next_sample = 0, bytes = 0;
+  GT_VECTOR_ITERATE(entries,entry,entry_pos,gt_record_sort_entry) {
+    if (bytes>=next_sample) {
+      gt_record_sort_run_add_sample(run,entry->record,entry->key_length,entry->seq,entry_pos);
+      next_sample = bytes + GT_RECORD_SORT_SAMPLE_SIZE;
+    }
+    bytes += entry->length;
+  }
+  run->size = bytes;
+  return run;
+}
+/*
+ * Writes records into a temporal run file (sampled every GT_RECORD_SORT_SAMPLE_SIZE bytes)
+ */
+GT_INLINE void gt_record_sort_write(
+    const int fd,const char* const file_name,gt_vector* const io_buffer) {
+  const uint64_t num_bytes = gt_vector_get_used(io_buffer);
+  const char* const bytes = gt_vector_get_mem(io_buffer,char);
+  uint64_t written = 0;
+  while (written<num_bytes) {
+    const ssize_t count = write(fd,bytes+written,num_bytes-written);
+    gt_cond_fatal_error__perror(count<=0,FILE_WRITE,file_name);
+    written += count;
+  }
+  gt_vector_clear(io_buffer);
+}
+GT_INLINE gt_record_sort_run* gt_record_sort_run_new_tmp() {
+  gt_record_sort_run* const run = gt_record_sort_run_new();
+  run->file_name = gt_calloc(strlen(gt_mm_get_tmp_folder())+22,char,true);
+  sprintf(run->file_name,"%sgt_record_sort_XXXXXX",gt_mm_get_tmp_folder());
+  run->fd = mkstemp(run->file_name);
+  gt_cond_fatal_error__perror(run->fd==-1,SYS_MKSTEMP,run->file_name);
+  gt_cond_fatal_error__perror(unlink(run->file_name),SYS_HANDLE_TMP); // Make it temporary
+  return run;
+}
+GT_INLINE void gt_record_sort_run_append(
+    gt_record_sort_run* const run,gt_vector* const io_buffer,
+    const char* const record,const uint64_t key_length,const uint64_t length,const uint64_t seq) {
+  // Sample (at the first record and then every GT_RECORD_SORT_SAMPLE_SIZE bytes)
+  const uint64_t num_samples = gt_vector_get_used(run->index);
+  if (num_samples==0 || run->size>=gt_vector_get_elm(run->index,num_samples-1,gt_record_sort_sample)->position+GT_RECORD_SORT_SAMPLE_SIZE) {
+    gt_record_sort_run_add_sample(run,record,key_length,seq,run->size);
+  }
+  // Header + record
+  const gt_record_sort_header header = { .seq=seq, .key_length=key_length, .length=length };
+  const uint64_t record_size = sizeof(gt_record_sort_header)+length;
+  gt_vector_reserve_additional(io_buffer,record_size);
+  char* const dst = gt_vector_get_mem(io_buffer,char)+gt_vector_get_used(io_buffer);
+  memcpy(dst,&header,sizeof(gt_record_sort_header));
+  memcpy(dst+sizeof(gt_record_sort_header),record,length);
+  gt_vector_add_used(io_buffer,record_size);
+  run->size += record_size;
+  if (gt_vector_get_used(io_buffer)>=GT_RECORD_SORT_IO_BUFFER) {
+    gt_record_sort_write(run->fd,run->file_name,io_buffer);
+  }
+}
+/*
+ * Spills the buffered records into a temporal run file (the vectors are cleared)
+ */
+GT_INLINE gt_record_sort_run* gt_record_sort_run_new_file(gt_vector* const buffer,gt_vector* const entries) {
+  gt_record_sort_entries(buffer,entries);
+  gt_record_sort_run* const run = gt_record_sort_run_new_tmp();
+  gt_vector* const io_buffer = gt_vector_new(GT_RECORD_SORT_IO_BUFFER+GT_BUFFER_SIZE_1K,sizeof(char));
+  GT_VECTOR_ITERATE(entries,entry,entry_pos,gt_record_sort_entry) {
+    gt_record_sort_run_append(run,io_buffer,entry->record,entry->key_length,entry->length,entry->seq);
+  }
+  gt_record_sort_write(run->fd,run->file_name,io_buffer);
+  gt_vector_delete(io_buffer);
+  // Clear
+  gt_vector_clear(buffer);
+  gt_vector_clear(entries);
+  return run;
+}
+
+/*
+ * Cursors
+ */
+GT_INLINE void gt_record_sort_cursor_init(
+    gt_record_sort_cursor* const cursor,gt_record_sort_run* const run,const uint64_t buffer_size) {
+  cursor->run = run;
+  cursor->record = NULL;
+  cursor->entry_pos = 0;
+  cursor->file_pos = 0;
+  cursor->buffer_pos = 0;
+  cursor->buffer = (run->fd!=-1) ? gt_vector_new(buffer_size,sizeof(char)) : NULL;
+  cursor->buffer_size = buffer_size;
+}
+GT_INLINE void gt_record_sort_cursor_destroy(gt_record_sort_cursor* const cursor) {
+  if (cursor->buffer!=NULL) gt_vector_delete(cursor->buffer);
+}
+GT_INLINE void gt_record_sort_cursor_seek(gt_record_sort_cursor* const cursor,const uint64_t position) {
+  if (cursor->run->fd==-1) {
+    cursor->entry_pos = position;
+  } else {
+    cursor->file_pos = position;
+    cursor->buffer_pos = 0;
+    gt_vector_clear(cursor->buffer);
+  }
+}
+/*
+ * Makes sure @num_bytes from the current position are in the buffer (false if EOF)
+ */
+GT_INLINE bool gt_record_sort_cursor_fill(gt_record_sort_cursor* const cursor,const uint64_t num_bytes) {
+  gt_vector* const buffer = cursor->buffer;
+  const uint64_t available = gt_vector_get_used(buffer)-cursor->buffer_pos;
+  if (available>=num_bytes) return true;
+  gt_record_sort_run* const run = cursor->run;
+  // Discard the consumed bytes
+  char* const memory = gt_vector_get_mem(buffer,char);
+  memmove(memory,memory+cursor->buffer_pos,available);
+  cursor->file_pos += cursor->buffer_pos;
+  cursor->buffer_pos = 0;
+  gt_vector_set_used(buffer,available);
+  // Read
+  const uint64_t file_left = run->size-(cursor->file_pos+available);
+  if (available+file_left<num_bytes) return false;
+  const uint64_t to_read = GT_MIN(file_left,GT_MAX(num_bytes,cursor->buffer_size)-available); // Keep the buffer size
+  gt_vector_reserve(buffer,available+to_read,false);
+  uint64_t read_bytes = 0;
+  while (read_bytes<to_read) {
+    const ssize_t count = pread(run->fd,gt_vector_get_mem(buffer,char)+available+read_bytes,
+        to_read-read_bytes,cursor->file_pos+available+read_bytes);
+    gt_cond_fatal_error__perror(count<=0,FILE_READ,run->file_name);
+    read_bytes += count;
+  }
+  gt_vector_set_used(buffer,available+to_read);
+  return true;
+}
+GT_INLINE bool gt_record_sort_cursor_next(gt_record_sort_cursor* const cursor) {
+  gt_record_sort_run* const run = cursor->run;
+  if (run->fd==-1) {
+    if (cursor->entry_pos>=gt_vector_get_used(run->entries)) return false;
+    gt_record_sort_entry* const entry = gt_vector_get_elm(run->entries,cursor->entry_pos,gt_record_sort_entry);
+    cursor->record = entry->record;
+    cursor->key_length = entry->key_length;
+    cursor->length = entry->length;
+    cursor->seq = entry->seq;
+    ++cursor->entry_pos;
+  } else {
+    if (!gt_record_sort_cursor_fill(cursor,sizeof(gt_record_sort_header))) return false;
+    gt_record_sort_header header;
+    memcpy(&header,gt_vector_get_mem(cursor->buffer,char)+cursor->buffer_pos,sizeof(gt_record_sort_header));
+    const uint64_t record_size = sizeof(gt_record_sort_header)+header.length;
+    gt_cond_fatal_error(!gt_record_sort_cursor_fill(cursor,record_size),FILE_READ,run->file_name);
+    cursor->record = gt_vector_get_mem(cursor->buffer,char)+cursor->buffer_pos+sizeof(gt_record_sort_header);
+    cursor->key_length = header.key_length;
+    cursor->length = header.length;
+    cursor->seq = header.seq;
+    cursor->buffer_pos += record_size;
+  }
+  return true;
+}
+GT_INLINE int gt_record_sort_cursor_cmp(
+    const gt_record_sort_cursor* const cursor,const gt_record_sort_splitter* const splitter) {
+  return gt_record_sort_cmp(cursor->record,cursor->key_length,cursor->seq,
+      splitter->key,splitter->key_length,splitter->seq);
+}
+GT_INLINE bool gt_record_sort_cursor_less(
+    const gt_record_sort_cursor* const cursor_a,const gt_record_sort_cursor* const cursor_b) {
+  return gt_record_sort_cmp(cursor_a->record,cursor_a->key_length,cursor_a->seq,
+      cursor_b->record,cursor_b->key_length,cursor_b->seq) < 0;
+}
+/*
+ * Positions the cursor at the first record not below @lower_bound (false if none is below @upper_bound)
+ */
+GT_INLINE bool gt_record_sort_cursor_start(
+    gt_record_sort_cursor* const cursor,
+    const gt_record_sort_splitter* const lower_bound,const gt_record_sort_splitter* const upper_bound) {
+  gt_record_sort_run* const run = cursor->run;
+  if (lower_bound!=NULL) {
+    // Last sample below the lower bound
+    const char* const keys = gt_vector_get_mem(run->index_keys,char);
+    gt_record_sort_sample* const samples = gt_vector_get_mem(run->index,gt_record_sort_sample);
+    uint64_t lo = 0, hi = gt_vector_get_used(run->index);
+    while (lo<hi) {
+      const uint64_t mid = lo+(hi-lo)/2;
+      if (gt_record_sort_cmp(keys+samples[mid].key_offset,samples[mid].key_length,samples[mid].seq,
+          lower_bound->key,lower_bound->key_length,lower_bound->seq) < 0) lo = mid+1; else hi = mid;
+    }
+    gt_record_sort_cursor_seek(cursor,(lo>0) ? samples[lo-1].position : 0);
+  }
+  do {
+    if (!gt_record_sort_cursor_next(cursor)) return false;
+  } while (lower_bound!=NULL && gt_record_sort_cursor_cmp(cursor,lower_bound)<0);
+  return upper_bound==NULL || gt_record_sort_cursor_cmp(cursor,upper_bound)<0;
+}
+
+/*
+ * Merge
+ */
+GT_INLINE void gt_record_sort_heap_sift_down(gt_record_sort_cursor** const heap,const uint64_t heap_size,uint64_t pos) {
+  gt_record_sort_cursor* const cursor = heap[pos];
+  while (true) {
+    uint64_t child = 2*pos+1;
+    if (child>=heap_size) break;
+    if (child+1<heap_size && gt_record_sort_cursor_less(heap[child+1],heap[child])) ++child;
+    if (!gt_record_sort_cursor_less(heap[child],cursor)) break;
+    heap[pos] = heap[child];
+    pos = child;
+  }
+  heap[pos] = cursor;
+}
+GT_INLINE void gt_record_sort_merger_init(
+    gt_record_sort_merger* const merger,gt_record_sort_run** const runs,const uint64_t num_runs,
+    const gt_record_sort_splitter* const lower_bound,const gt_record_sort_splitter* const upper_bound,
+    const uint64_t buffer_size) {
+  merger->cursors = gt_calloc(num_runs,gt_record_sort_cursor,false);
+  merger->heap = gt_calloc(num_runs,gt_record_sort_cursor*,false);
+  merger->num_cursors = num_runs;
+  merger->heap_size = 0;
+  merger->upper_bound = upper_bound;
+  // Position the cursors
+  uint64_t i;
+  for (i=0;i<num_runs;++i) {
+    gt_record_sort_cursor_init(merger->cursors+i,runs[i],buffer_size);
+    if (gt_record_sort_cursor_start(merger->cursors+i,lower_bound,upper_bound)) {
+      merger->heap[merger->heap_size++] = merger->cursors+i;
+    }
+  }
+  for (i=merger->heap_size;i-->0;) gt_record_sort_heap_sift_down(merger->heap,merger->heap_size,i);
+}
+GT_INLINE void gt_record_sort_merger_destroy(gt_record_sort_merger* const merger) {
+  uint64_t i;
+  for (i=0;i<merger->num_cursors;++i) gt_record_sort_cursor_destroy(merger->cursors+i);
+  gt_free(merger->heap);
+  gt_free(merger->cursors);
+}
+/*
+ * Current record (NULL once all runs are merged)
+ */
+GT_INLINE gt_record_sort_cursor* gt_record_sort_merger_get(gt_record_sort_merger* const merger) {
+  return (merger->heap_size>0) ? merger->heap[0] : NULL;
+}
+GT_INLINE void gt_record_sort_merger_next(gt_record_sort_merger* const merger) {
+  gt_record_sort_cursor* const cursor = merger->heap[0];
+  if (!gt_record_sort_cursor_next(cursor) ||
+      (merger->upper_bound!=NULL && gt_record_sort_cursor_cmp(cursor,merger->upper_bound)>=0)) {
+    merger->heap[0] = merger->heap[--merger->heap_size];
+  }
+  if (merger->heap_size>0) gt_record_sort_heap_sift_down(merger->heap,merger->heap_size,0);
+}
+GT_INLINE void gt_record_sort_merge_range(
+    gt_vector* const runs,gt_buffered_output_file* const buffered_output,
+    const gt_record_sort_splitter* const lower_bound,const gt_record_sort_splitter* const upper_bound,
+    const uint64_t buffer_size) {
+  gt_record_sort_merger merger;
+  gt_record_sort_merger_init(&merger,gt_vector_get_mem(runs,gt_record_sort_run*),
+      gt_vector_get_used(runs),lower_bound,upper_bound,buffer_size);
+  gt_vector* output = gt_output_buffer_to_vchar(gt_buffered_output_file_get_buffer(buffered_output));
+  gt_record_sort_cursor* cursor;
+  while ((cursor=gt_record_sort_merger_get(&merger))!=NULL) {
+    // Output the record
+    if (gt_vector_get_used(output)>=GT_RECORD_SORT_OUTPUT_DUMP) {
+      gt_buffered_output_file_safety_dump(buffered_output);
+      output = gt_output_buffer_to_vchar(gt_buffered_output_file_get_buffer(buffered_output));
+    }
+    gt_vector_reserve_additional(output,cursor->length);
+    memcpy(gt_vector_get_mem(output,char)+gt_vector_get_used(output),cursor->record,cursor->length);
+    gt_vector_add_used(output,cursor->length);
+    gt_record_sort_merger_next(&merger);
+  }
+  gt_record_sort_merger_destroy(&merger);
+}
+/*
+ * Intermediate pass. Merges file runs into a new one (the merged runs are deleted)
+ */
+GT_INLINE gt_record_sort_run* gt_record_sort_merge_runs(
+    gt_record_sort_run** const runs,const uint64_t num_runs,const uint64_t buffer_size) {
+  gt_record_sort_run* const merged_run = gt_record_sort_run_new_tmp();
+  gt_vector* const io_buffer = gt_vector_new(GT_RECORD_SORT_IO_BUFFER+GT_BUFFER_SIZE_1K,sizeof(char));
+  gt_record_sort_merger merger;
+  gt_record_sort_merger_init(&merger,runs,num_runs,NULL,NULL,buffer_size);
+  gt_record_sort_cursor* cursor;
+  while ((cursor=gt_record_sort_merger_get(&merger))!=NULL) {
+    gt_record_sort_run_append(merged_run,io_buffer,cursor->record,cursor->key_length,cursor->length,cursor->seq);
+    gt_record_sort_merger_next(&merger);
+  }
+  gt_record_sort_merger_destroy(&merger);
+  gt_record_sort_write(merged_run->fd,merged_run->file_name,io_buffer);
+  gt_vector_delete(io_buffer);
+  uint64_t i;
+  for (i=0;i<num_runs;++i) gt_record_sort_run_delete(runs[i]);
+  return merged_run;
+}
+int gt_record_sort_cmp_run_size(const void* const a,const void* const b) {
+  const gt_record_sort_run* const run_a = *(gt_record_sort_run* const*)a;
+  const gt_record_sort_run* const run_b = *(gt_record_sort_run* const*)b;
+  return (run_a->size<run_b->size) ? -1 : (run_a->size>run_b->size);
+}
+/*
+ * Adds a spilled run. Once GT_RECORD_SORT_MAX_RUNS are kept, the GT_RECORD_SORT_MERGE_FAN_IN
+ * smallest are merged into one (bounds the open files and the fan-in of the final merge)
+ */
+GT_INLINE void gt_record_sort_add_file_run(
+    gt_vector* const runs,gt_record_sort_run* run,const uint64_t buffer_size) {
+  gt_record_sort_run* merge_runs[GT_RECORD_SORT_MERGE_FAN_IN];
+  while (true) {
+    bool merge = false;
+    #pragma omp critical (gt_record_sort_runs)
+    {
+      gt_vector_insert(runs,run,gt_record_sort_run*);
+      const uint64_t num_runs = gt_vector_get_used(runs);
+      if (num_runs>=GT_RECORD_SORT_MAX_RUNS) {
+        gt_record_sort_run** const runs_mem = gt_vector_get_mem(runs,gt_record_sort_run*);
+        qsort(runs_mem,num_runs,sizeof(gt_record_sort_run*),gt_record_sort_cmp_run_size);
+        memcpy(merge_runs,runs_mem,GT_RECORD_SORT_MERGE_FAN_IN*sizeof(gt_record_sort_run*));
+        memmove(runs_mem,runs_mem+GT_RECORD_SORT_MERGE_FAN_IN,
+            (num_runs-GT_RECORD_SORT_MERGE_FAN_IN)*sizeof(gt_record_sort_run*));
+        gt_vector_set_used(runs,num_runs-GT_RECORD_SORT_MERGE_FAN_IN);
+        merge = true;
+      }
+    }
+    if (!merge) return;
+    run = gt_record_sort_merge_runs(merge_runs,GT_RECORD_SORT_MERGE_FAN_IN,buffer_size);
+  }
+}
+/*
+ * Cuts the key space at the sampled keys into ranges of (roughly) GT_RECORD_SORT_RANGE_SIZE bytes
+ */
+GT_INLINE uint64_t gt_record_sort_get_splitters(
+    gt_vector* const runs,gt_vector* const splitters,const uint64_t num_threads) {
+  gt_vector* const samples = gt_vector_new(64,sizeof(gt_record_sort_splitter));
+  uint64_t total_size = 0;
+  GT_VECTOR_ITERATE(runs,run_ptr,run_pos,gt_record_sort_run*) {
+    gt_record_sort_run* const run = *run_ptr;
+    const char* const keys = gt_vector_get_mem(run->index_keys,char);
+    GT_VECTOR_ITERATE(run->index,sample,sample_pos,gt_record_sort_sample) {
+      gt_vector_reserve_additional(samples,1);
+      gt_record_sort_splitter* const splitter = gt_vector_get_free_elm(samples,gt_record_sort_splitter);
+      gt_vector_inc_used(samples);
+      splitter->key = keys+sample->key_offset;
+      splitter->key_length = sample->key_length;
+      splitter->seq = sample->seq;
+    }
+    total_size += run->size;
+  }
+  const uint64_t num_samples = gt_vector_get_used(samples);
+  uint64_t num_ranges = GT_MAX(total_size/GT_RECORD_SORT_RANGE_SIZE,(num_threads>1) ? GT_RECORD_SORT_RANGES_PER_THREAD*num_threads : 1);
+  num_ranges = GT_MAX(GT_MIN(num_ranges,num_samples),1);
+  // Pick the splitters
+  qsort(gt_vector_get_mem(samples,gt_record_sort_splitter),num_samples,
+      sizeof(gt_record_sort_splitter),gt_record_sort_cmp_splitters);
+  uint64_t i;
+  gt_vector_clear(splitters);
+  for (i=1;i<num_ranges;++i) {
+    gt_vector_insert(splitters,
+        *gt_vector_get_elm(samples,(i*num_samples)/num_ranges,gt_record_sort_splitter),gt_record_sort_splitter);
+  }
+  gt_vector_delete(samples);
+  return num_ranges;
+}
+
+/*
+ * Sort
+ */
+GT_INLINE uint64_t gt_record_sort(
+    gt_input_file* const input_file,gt_output_file* const output_file,
+    const uint64_t memory_budget,const uint64_t num_threads) {
+  GT_INPUT_FILE_CHECK(input_file);
+  GT_OUTPUT_FILE_CHECK(output_file);
+  GT_ZERO_CHECK(num_threads);
+  gt_cond_fatal_error(input_file->file_format!=MAP && input_file->file_format!=SAM,
+      FILE_RECORD_SORT_FORMAT,input_file->file_name);
+  // SAM headers go first
+  gt_buffered_output_file* const header_output = gt_buffered_output_file_new(output_file);
+  gt_buffered_output_file_set_block_ids(header_output,0,0);
+  if (input_file->file_format==SAM && input_file->buffer_begin>0) {
+    gt_vector* const output = gt_output_buffer_to_vchar(gt_buffered_output_file_get_buffer(header_output));
+    gt_vector_reserve_additional(output,input_file->buffer_begin);
+    memcpy(gt_vector_get_mem(output,char)+gt_vector_get_used(output),input_file->file_buffer,input_file->buffer_begin);
+    gt_vector_add_used(output,input_file->buffer_begin);
+  }
+  gt_buffered_output_file_close(header_output);
+  // Split the budget between the merge read-ahead (per run and thread) and the buffered records
+  const uint64_t cursor_buffer_size = GT_MIN(GT_MAX(
+      memory_budget/(GT_RECORD_SORT_MERGE_MEMORY_SHARE*num_threads*GT_RECORD_SORT_MAX_RUNS),
+      GT_RECORD_SORT_MIN_IO_BUFFER),GT_RECORD_SORT_IO_BUFFER);
+  const uint64_t merge_memory = num_threads*GT_RECORD_SORT_MAX_RUNS*cursor_buffer_size;
+  const uint64_t thread_memory = GT_MAX((memory_budget>merge_memory) ? (memory_budget-merge_memory)/num_threads : 0,
+      GT_RECORD_SORT_MIN_THREAD_MEMORY);
+  // Buffer & spill sorted runs
+  gt_vector* const runs = gt_vector_new(num_threads,sizeof(gt_record_sort_run*));
+  uint64_t num_records = 0;
+  #pragma omp parallel num_threads(num_threads) reduction(+:num_records)
+  {
+    gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+    gt_vector* buffer = gt_vector_new(GT_BUFFER_SIZE_1M,sizeof(char));
+    gt_vector* entries = gt_vector_new(GT_BUFFER_SIZE_16K,sizeof(gt_record_sort_entry));
+    gt_record_sort_run* run;
+    while (gt_buffered_input_file_get_block(buffered_input,0)>0) {
+      const char* line = gt_vector_get_mem(buffered_input->block_buffer,char);
+      const char* const block_end = line+gt_vector_get_used(buffered_input->block_buffer);
+      uint64_t seq = buffered_input->current_line_num;
+      for (;line<block_end;++seq) {
+        const char* const eol = memchr(line,EOL,block_end-line);
+        const uint64_t length = (eol!=NULL) ? (eol-line)+1 : block_end-line;
+        if (length>1) {
+          // Spill the buffer if full
+          if (gt_vector_get_used(entries)>0 && gt_vector_get_used(buffer)+length+
+              (gt_vector_get_used(entries)+1)*sizeof(gt_record_sort_entry)>thread_memory) {
+            run = gt_record_sort_run_new_file(buffer,entries);
+            gt_record_sort_add_file_run(runs,run,cursor_buffer_size);
+          }
+          // Buffer the record
+          gt_vector_reserve_additional(entries,1);
+          gt_record_sort_entry* const entry = gt_vector_get_free_elm(entries,gt_record_sort_entry);
+          gt_vector_inc_used(entries);
+          entry->offset = gt_vector_get_used(buffer);
+          entry->seq = seq;
+          entry->key_length = gt_record_sort_get_key_length(line,length);
+          entry->length = length;
+          gt_vector_reserve_additional(buffer,length);
+          memcpy(gt_vector_get_mem(buffer,char)+entry->offset,line,length);
+          gt_vector_add_used(buffer,length);
+          ++num_records;
+        }
+        line += length;
+      }
+    }
+    gt_buffered_input_file_close(buffered_input);
+    // Keep the rest in memory
+    if (gt_vector_get_used(entries)>0) {
+      run = gt_record_sort_run_new_memory(buffer,entries);
+      #pragma omp critical (gt_record_sort_runs)
+      {
+        gt_vector_insert(runs,run,gt_record_sort_run*);
+      }
+    } else {
+      gt_vector_delete(buffer);
+      gt_vector_delete(entries);
+    }
+  }
+  // Merge the runs range by range (each into its block of the output)
+  gt_vector* const splitters = gt_vector_new(64,sizeof(gt_record_sort_splitter));
+  const uint64_t num_ranges = gt_record_sort_get_splitters(runs,splitters,num_threads);
+  const gt_record_sort_splitter* const splitter = gt_vector_get_mem(splitters,gt_record_sort_splitter);
+  uint64_t range;
+  #pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+  for (range=0;range<num_ranges;++range) {
+    gt_buffered_output_file* const buffered_output = gt_buffered_output_file_new(output_file);
+    gt_buffered_output_file_set_block_ids(buffered_output,range+1,0);
+    gt_record_sort_merge_range(runs,buffered_output,
+        (range>0) ? splitter+(range-1) : NULL,(range+1<num_ranges) ? splitter+range : NULL,cursor_buffer_size);
+    gt_buffered_output_file_close(buffered_output);
+  }
+  // Free
+  gt_vector_delete(splitters);
+  GT_VECTOR_ITERATE(runs,run_ptr,run_pos,gt_record_sort_run*) {
+    gt_record_sort_run_delete(*run_ptr);
+  }
+  gt_vector_delete(runs);
+  return num_records;
+}
@@ -0,0 +1,148 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_scan.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Vectorized (SSE2/AVX2) character scanning primitives used by
+ *   the input file block splitting and the MAP/SAM/FASTQ field tokenizers
+ */
+
+#include "gt_scan.h"
+
+/*
+ * Vector operators (one bit per byte in the comparison masks)
+ */
+#if defined(__AVX2__)
+  #define GT_SCAN_SIMD
+  typedef __m256i gt_scan_vector;
+  #define GT_SCAN_LOAD(address) _mm256_load_si256((const __m256i*)(address))
+  #define GT_SCAN_LOADU(address) _mm256_loadu_si256((const __m256i*)(address))
+  #define GT_SCAN_SET1(character) _mm256_set1_epi8(character)
+  #define GT_SCAN_CMPEQ(vector_a,vector_b) _mm256_cmpeq_epi8(vector_a,vector_b)
+  #define GT_SCAN_OR(vector_a,vector_b) _mm256_or_si256(vector_a,vector_b)
+  #define GT_SCAN_MASK(vector) ((uint64_t)(uint32_t)_mm256_movemask_epi8(vector))
+#elif defined(__SSE2__)
+  #define GT_SCAN_SIMD
+  typedef __m128i gt_scan_vector;
+  #define GT_SCAN_LOAD(address) _mm_load_si128((const __m128i*)(address))
+  #define GT_SCAN_LOADU(address) _mm_loadu_si128((const __m128i*)(address))
+  #define GT_SCAN_SET1(character) _mm_set1_epi8(character)
+  #define GT_SCAN_CMPEQ(vector_a,vector_b) _mm_cmpeq_epi8(vector_a,vector_b)
+  #define GT_SCAN_OR(vector_a,vector_b) _mm_or_si128(vector_a,vector_b)
+  #define GT_SCAN_MASK(vector) ((uint64_t)(uint16_t)_mm_movemask_epi8(vector))
+#endif
+#define GT_SCAN_FIRST(mask) __builtin_ctzll(mask)
+#define GT_SCAN_LOWER_BITS(num_bits) ((UINT64_ONE<<(num_bits))-1)
+
+/*
+ * Bounded scanning [begin,end)
+ */
+GT_INLINE const char* gt_scan_eol(const char* const begin,const char* const end) {
+  const char* centinel = begin;
+#ifdef GT_SCAN_SIMD
+  const gt_scan_vector eol = GT_SCAN_SET1(EOL);
+  const gt_scan_vector dos_eol = GT_SCAN_SET1(DOS_EOL);
+  for (;centinel+GT_SCAN_VECTOR_WIDTH<=end;centinel+=GT_SCAN_VECTOR_WIDTH) {
+    const gt_scan_vector chunk = GT_SCAN_LOADU(centinel);
+    const uint64_t mask = GT_SCAN_MASK(GT_SCAN_OR(GT_SCAN_CMPEQ(chunk,eol),GT_SCAN_CMPEQ(chunk,dos_eol)));
+    if (mask) return centinel+GT_SCAN_FIRST(mask);
+  }
+#endif
+  for (;centinel<end;++centinel) {
+    if (*centinel==EOL || *centinel==DOS_EOL) return centinel;
+  }
+  return end;
+}
+GT_INLINE const char* gt_scan_eol_count(
+    const char* const begin,const char* const end,const char counted_char,uint64_t* const count) {
+  const char* centinel = begin;
+  uint64_t num_counted = 0;
+#ifdef GT_SCAN_SIMD
+  const gt_scan_vector eol = GT_SCAN_SET1(EOL);
+  const gt_scan_vector dos_eol = GT_SCAN_SET1(DOS_EOL);
+  const gt_scan_vector counted = GT_SCAN_SET1(counted_char);
+  for (;centinel+GT_SCAN_VECTOR_WIDTH<=end;centinel+=GT_SCAN_VECTOR_WIDTH) {
+    const gt_scan_vector chunk = GT_SCAN_LOADU(centinel);
+    const uint64_t mask_eol = GT_SCAN_MASK(GT_SCAN_OR(GT_SCAN_CMPEQ(chunk,eol),GT_SCAN_CMPEQ(chunk,dos_eol)));
+    const uint64_t mask_counted = GT_SCAN_MASK(GT_SCAN_CMPEQ(chunk,counted));
+    if (mask_eol) {
+      const uint64_t eol_pos = GT_SCAN_FIRST(mask_eol);
+      *count += num_counted + GT_POPCOUNT_64(mask_counted & GT_SCAN_LOWER_BITS(eol_pos));
+      return centinel+eol_pos;
+    }
+    num_counted += GT_POPCOUNT_64(mask_counted);
+  }
+#endif
+  for (;centinel<end;++centinel) {
+    if (*centinel==EOL || *centinel==DOS_EOL) break;
+    if (*centinel==counted_char) ++num_counted;
+  }
+  *count += num_counted;
+  return centinel;
+}
+GT_INLINE const char* gt_scan_chr3(
+    const char* const begin,const char* const end,const char c1,const char c2,const char c3) {
+  const char* centinel = begin;
+#ifdef GT_SCAN_SIMD
+  const gt_scan_vector v1 = GT_SCAN_SET1(c1);
+  const gt_scan_vector v2 = GT_SCAN_SET1(c2);
+  const gt_scan_vector v3 = GT_SCAN_SET1(c3);
+  for (;centinel+GT_SCAN_VECTOR_WIDTH<=end;centinel+=GT_SCAN_VECTOR_WIDTH) {
+    const gt_scan_vector chunk = GT_SCAN_LOADU(centinel);
+    const uint64_t mask = GT_SCAN_MASK(GT_SCAN_OR(GT_SCAN_OR(
+        GT_SCAN_CMPEQ(chunk,v1),GT_SCAN_CMPEQ(chunk,v2)),GT_SCAN_CMPEQ(chunk,v3)));
+    if (mask) return centinel+GT_SCAN_FIRST(mask);
+  }
+#endif
+  for (;centinel<end;++centinel) {
+    if (*centinel==c1 || *centinel==c2 || *centinel==c3) return centinel;
+  }
+  return end;
+}
+GT_INLINE uint64_t gt_scan_count(const char* const begin,const char* const end,const char counted_char) {
+  const char* centinel = begin;
+  uint64_t num_counted = 0;
+#ifdef GT_SCAN_SIMD
+  const gt_scan_vector counted = GT_SCAN_SET1(counted_char);
+  for (;centinel+GT_SCAN_VECTOR_WIDTH<=end;centinel+=GT_SCAN_VECTOR_WIDTH) {
+    num_counted += GT_POPCOUNT_64(GT_SCAN_MASK(GT_SCAN_CMPEQ(GT_SCAN_LOADU(centinel),counted)));
+  }
+#endif
+  for (;centinel<end;++centinel) {
+    if (*centinel==counted_char) ++num_counted;
+  }
+  return num_counted;
+}
+
+/*
+ * Unbounded scanning (text terminated by EOL or EOS)
+ */
+GT_INLINE const char* gt_scan_until(const char* const text,const char c1,const char c2) {
+#ifdef GT_SCAN_SIMD
+  const gt_scan_vector v1 = GT_SCAN_SET1(c1);
+  const gt_scan_vector v2 = GT_SCAN_SET1(c2);
+  const gt_scan_vector eol = GT_SCAN_SET1(EOL);
+  const gt_scan_vector eos = GT_SCAN_SET1(EOS);
+  #define GT_SCAN_UNTIL_MASK(chunk) GT_SCAN_MASK(GT_SCAN_OR( \
+      GT_SCAN_OR(GT_SCAN_CMPEQ(chunk,v1),GT_SCAN_CMPEQ(chunk,v2)), \
+      GT_SCAN_OR(GT_SCAN_CMPEQ(chunk,eol),GT_SCAN_CMPEQ(chunk,eos))))
+  // First (aligned) chunk. Discard the bytes before @text
+  const uint64_t offset = (uintptr_t)text % GT_SCAN_VECTOR_WIDTH;
+  const char* centinel = text-offset;
+  gt_scan_vector chunk = GT_SCAN_LOAD(centinel);
+  uint64_t mask = GT_SCAN_UNTIL_MASK(chunk) >> offset;
+  if (mask) return text+GT_SCAN_FIRST(mask);
+  // Remaining (aligned) chunks
+  while (true) {
+    centinel += GT_SCAN_VECTOR_WIDTH;
+    chunk = GT_SCAN_LOAD(centinel);
+    mask = GT_SCAN_UNTIL_MASK(chunk);
+    if (mask) return centinel+GT_SCAN_FIRST(mask);
+  }
+  #undef GT_SCAN_UNTIL_MASK
+#else
+  const char* centinel = text;
+  while (*centinel!=c1 && *centinel!=c2 && *centinel!=EOL && *centinel!=EOS) ++centinel;
+  return centinel;
+#endif
+}
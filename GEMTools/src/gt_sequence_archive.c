@@ -13,6 +13,7 @@
 #define GT_SEQ_ARCHIVE_NUM_BLOCKS 15000
 #define GT_SEQ_ARCHIVE_BLOCK_SIZE GT_BUFFER_SIZE_256K
 #define GT_SEQ_ARCHIVE_NUM_INITIAL_BED_INTERVALS 5
+#define GT_SEQ_ARCHIVE_NUM_INITIAL_CONTIGS 100
 
 /*
  * SequenceARCHIVE Constructor
@@ -20,6 +21,7 @@
 GT_INLINE gt_sequence_archive* gt_sequence_archive_new(const gt_sequence_archive_t sequence_archive_type) {
   gt_sequence_archive* seq_archive = gt_alloc(gt_sequence_archive);
   seq_archive->sequences = gt_shash_new();
+  seq_archive->contig_sequences = gt_vector_new(GT_SEQ_ARCHIVE_NUM_INITIAL_CONTIGS,sizeof(gt_segmented_sequence*));
   seq_archive->sequence_archive_type = sequence_archive_type;
   if (sequence_archive_type == GT_BED_ARCHIVE) {
     seq_archive->bed_intervals = gt_shash_new();
@@ -34,6 +36,7 @@ GT_INLINE void gt_sequence_archive_clear(gt_sequence_archive* const seq_archive)
     gt_segmented_sequence_delete(sequence);
   } GT_SHASH_END_ITERATE;
   gt_shash_clear(seq_archive->sequences,false);
+  gt_vector_clear(seq_archive->contig_sequences);
   if (seq_archive->sequence_archive_type == GT_BED_ARCHIVE) {
     GT_SHASH_BEGIN_ELEMENT_ITERATE(seq_archive->bed_intervals,interval_vector,gt_vector) {
       gt_vector_clear(interval_vector);
@@ -53,6 +56,7 @@ GT_INLINE void gt_sequence_archive_delete(gt_sequence_archive* const seq_archive
     gt_segmented_sequence_delete(sequence);
   } GT_SHASH_END_ITERATE;
   gt_shash_delete(seq_archive->sequences,false);
+  gt_vector_delete(seq_archive->contig_sequences);
   if (seq_archive->sequence_archive_type == GT_BED_ARCHIVE) {
     GT_SHASH_BEGIN_ELEMENT_ITERATE(seq_archive->bed_intervals,interval_vector,gt_vector) {
       gt_vector_delete(interval_vector);
@@ -65,6 +69,19 @@ GT_INLINE void gt_sequence_archive_delete(gt_sequence_archive* const seq_archive
   gt_free(seq_archive);
 }
 
+/*
+ * SequenceARCHIVE contig index (sequences by contig ID)
+ */
+GT_INLINE void gt_sequence_archive_set_contig_sequence(
+    gt_sequence_archive* const seq_archive,char* const seq_id,gt_segmented_sequence* const sequence) {
+  const uint32_t contig_id = gt_contig_dictionary_get_id(seq_id,strlen(seq_id));
+  if (contig_id >= gt_vector_get_used(seq_archive->contig_sequences)) {
+    if (sequence==NULL) return;
+    gt_vector_reserve(seq_archive->contig_sequences,contig_id+1,true);
+    gt_vector_set_used(seq_archive->contig_sequences,contig_id+1);
+  }
+  *gt_vector_get_elm(seq_archive->contig_sequences,contig_id,gt_segmented_sequence*) = sequence;
+}
 /*
  * SequenceARCHIVE handler
  */
@@ -72,28 +89,37 @@ GT_INLINE void gt_sequence_archive_add_segmented_sequence(gt_sequence_archive* c
   GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
   GT_SEGMENTED_SEQ_CHECK(sequence);
   gt_shash_insert(seq_archive->sequences,gt_string_get_string(sequence->seq_name),sequence,gt_segmented_sequence);
+  gt_sequence_archive_set_contig_sequence(seq_archive,gt_string_get_string(sequence->seq_name),sequence);
 }
 GT_INLINE void gt_sequence_archive_remove_segmented_sequence(gt_sequence_archive* const seq_archive,char* const seq_id) {
   GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
   gt_segmented_sequence* seg_seq = gt_sequence_archive_get_segmented_sequence(seq_archive,seq_id);
   if (seg_seq != NULL) gt_segmented_sequence_delete(seg_seq);
   gt_shash_remove(seq_archive->sequences,seq_id,false);
+  gt_sequence_archive_set_contig_sequence(seq_archive,seq_id,NULL);
 }
 GT_INLINE gt_segmented_sequence* gt_sequence_archive_get_segmented_sequence(gt_sequence_archive* const seq_archive,char* const seq_id) {
   GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
   return gt_shash_get(seq_archive->sequences,seq_id,gt_segmented_sequence);
 }
+GT_INLINE gt_segmented_sequence* gt_sequence_archive_get_contig_sequence(gt_sequence_archive* const seq_archive,const uint32_t contig_id) {
+  GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
+  if (contig_id >= gt_vector_get_used(seq_archive->contig_sequences)) return NULL;
+  return *gt_vector_get_elm(seq_archive->contig_sequences,contig_id,gt_segmented_sequence*);
+}
 /* GT_BED_ARCHIVE */
 GT_INLINE void gt_sequence_archive_add_bed_sequence(gt_sequence_archive* const seq_archive,gt_segmented_sequence* const sequence) {
   GT_SEQUENCE_BED_ARCHIVE_CHECK(seq_archive);
   GT_SEGMENTED_SEQ_CHECK(sequence);
   gt_shash_insert(seq_archive->sequences,gt_string_get_string(sequence->seq_name),sequence,gt_segmented_sequence);
+  gt_sequence_archive_set_contig_sequence(seq_archive,gt_string_get_string(sequence->seq_name),sequence);
 }
 GT_INLINE void gt_sequence_archive_remove_bed_sequence(gt_sequence_archive* const seq_archive,char* const seq_id) {
   GT_SEQUENCE_BED_ARCHIVE_CHECK(seq_archive);
   gt_segmented_sequence* seg_seq = gt_shash_get(seq_archive->sequences,seq_id,gt_segmented_sequence);
   if (seg_seq != NULL) gt_segmented_sequence_delete(seg_seq);
   gt_shash_remove(seq_archive->sequences,seq_id,false);
+  gt_sequence_archive_set_contig_sequence(seq_archive,seq_id,NULL);
 }
 GT_INLINE gt_vector* gt_sequence_archive_get_bed_intervals_vector_dyn(gt_sequence_archive* const seq_archive,char* const seq_id) {
   GT_SEQUENCE_BED_ARCHIVE_CHECK(seq_archive);
@@ -144,16 +170,10 @@ GT_INLINE gt_status gt_sequence_archive_get_sequence_string(
   if (strand==REVERSE) gt_dna_string_reverse_complement(string);
   return 0;
 }
-GT_INLINE gt_status gt_sequence_archive_retrieve_sequence_chunk(
-    gt_sequence_archive* const seq_archive,char* const seq_id,const gt_strand strand,
+GT_INLINE gt_status gt_sequence_archive_retrieve_segmented_sequence_chunk(
+    gt_sequence_archive* const seq_archive,gt_segmented_sequence* const seg_seq,char* const seq_id,const gt_strand strand,
     const uint64_t position,const uint64_t length,const uint64_t extra_length,gt_string* const string) {
-  GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
-  GT_ZERO_CHECK(position);
-  GT_NULL_CHECK(seq_id);
-  GT_STRING_CHECK_NO_STATIC(string);
   gt_status error_code;
-  // Retrieve the sequence
-  gt_segmented_sequence* seg_seq = gt_sequence_archive_get_segmented_sequence(seq_archive,seq_id);
   if (seg_seq==NULL) {
     gt_error(SEQ_ARCHIVE_NOT_FOUND,seq_id);
     return GT_SEQUENCE_NOT_FOUND;
@@ -198,6 +218,26 @@ GT_INLINE gt_status gt_sequence_archive_retrieve_sequence_chunk(
   if (strand==REVERSE) gt_dna_string_reverse_complement(string);
   return 0;
 }
+GT_INLINE gt_status gt_sequence_archive_retrieve_sequence_chunk(
+    gt_sequence_archive* const seq_archive,char* const seq_id,const gt_strand strand,
+    const uint64_t position,const uint64_t length,const uint64_t extra_length,gt_string* const string) {
+  GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
+  GT_ZERO_CHECK(position);
+  GT_NULL_CHECK(seq_id);
+  GT_STRING_CHECK_NO_STATIC(string);
+  return gt_sequence_archive_retrieve_segmented_sequence_chunk(seq_archive,
+      gt_sequence_archive_get_segmented_sequence(seq_archive,seq_id),seq_id,strand,position,length,extra_length,string);
+}
+GT_INLINE gt_status gt_sequence_archive_retrieve_contig_chunk(
+    gt_sequence_archive* const seq_archive,const uint32_t contig_id,const gt_strand strand,
+    const uint64_t position,const uint64_t length,const uint64_t extra_length,gt_string* const string) {
+  GT_SEQUENCE_ARCHIVE_CHECK(seq_archive);
+  GT_ZERO_CHECK(position);
+  GT_STRING_CHECK_NO_STATIC(string);
+  return gt_sequence_archive_retrieve_segmented_sequence_chunk(seq_archive,
+      gt_sequence_archive_get_contig_sequence(seq_archive,contig_id),
+      gt_string_get_string(gt_contig_dictionary_get_name(contig_id)),strand,position,length,extra_length,string);
+}
 
 
 /*
@@ -12,74 +12,112 @@
  * Handy Macros
  */
 #define GT_STATS_GET_PERCENTAGE_ERROR(percentage,one_per_cent) (uint64_t)((double)percentage*one_per_cent)
-#define GT_STATS_VECTOR_ADD(VECTOR_A,VECTOR_B,RANGE) { \
-  uint64_t iii; \
-  for (iii=0;iii<RANGE;++iii) { VECTOR_A[iii] += VECTOR_B[iii]; } \
+
+/*
+ * Histograms memory layout
+ *   All the histograms of a gt_stats (profiles included) are carved out of a single
+ *   cache-aligned block. Each one is padded up to a whole cache line, so merging two
+ *   stats is a single vectorized add over the block
+ */
+#define GT_STATS_CACHE_LINE_SIZE 64
+#define GT_STATS_CACHE_LINE_COUNTERS (GT_STATS_CACHE_LINE_SIZE/sizeof(uint64_t))
+#define GT_STATS_HISTOGRAM_PADDED_RANGE(RANGE) \
+  ((((RANGE)+GT_STATS_CACHE_LINE_COUNTERS-1)/GT_STATS_CACHE_LINE_COUNTERS)*GT_STATS_CACHE_LINE_COUNTERS)
+#define GT_MAPS_PROFILE_HISTOGRAMS_SIZE ( \
+  5*GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_MISMS_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_LARGE_READ_POS_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INSS_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_MISMS_BASE_RANGE*GT_STATS_MISMS_BASE_RANGE) + \
+  2*GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_QUAL_SCORE_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_MISMS_1_CONTEXT_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_TRANSITION_1_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_TRANSITION_2_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_TRANSITION_3_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_TRANSITION_4_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_1_CONTEXT) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_INDEL_2_CONTEXT))
+#define GT_SPLITMAPS_PROFILE_HISTOGRAMS_SIZE ( \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_NUM_JUNCTION_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_LEN_JUNCTION_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_SHORT_READ_POS_RANGE))
+#define GT_POPULATION_PROFILE_HISTOGRAMS_SIZE ( \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_DIVERSITY_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_DOMINANT_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_DIVERSITY_DOMINANT_RANGE))
+#define GT_STATS_HISTOGRAMS_SIZE ( \
+  2*GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_LENGTH_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_LENGTH__MMAP_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_LENGTH__QUAL_SCORE_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_QUAL_SCORE_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_QUAL_SCORE__MMAP_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_MISMS_BASE_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_MMAP_RANGE) + \
+  GT_STATS_HISTOGRAM_PADDED_RANGE(GT_STATS_UNIQ_RANGE) + \
+  GT_MAPS_PROFILE_HISTOGRAMS_SIZE + \
+  GT_SPLITMAPS_PROFILE_HISTOGRAMS_SIZE + \
+  GT_POPULATION_PROFILE_HISTOGRAMS_SIZE)
+
+GT_INLINE uint64_t* gt_stats_histograms_new() {
+  void* histograms;
+  gt_cond_fatal_error(posix_memalign(&histograms,GT_STATS_CACHE_LINE_SIZE,
+      GT_STATS_HISTOGRAMS_SIZE*sizeof(uint64_t)),MEM_ALLOC_INFO,GT_STATS_HISTOGRAMS_SIZE*sizeof(uint64_t));
+  memset(histograms,0,GT_STATS_HISTOGRAMS_SIZE*sizeof(uint64_t));
+  return histograms;
+}
+GT_INLINE uint64_t* gt_stats_histogram_carve(uint64_t** const histograms_cursor,const uint64_t range) {
+  uint64_t* const histogram = *histograms_cursor;
+  *histograms_cursor += GT_STATS_HISTOGRAM_PADDED_RANGE(range);
+  return histogram;
+}
+GT_INLINE void gt_stats_histograms_add(uint64_t* const histograms_dst,const uint64_t* const histograms_src) {
+  // Both blocks are cache-aligned and padded, so the compiler emits a straight vector loop
+  uint64_t* const dst = __builtin_assume_aligned(histograms_dst,GT_STATS_CACHE_LINE_SIZE);
+  const uint64_t* const src = __builtin_assume_aligned(histograms_src,GT_STATS_CACHE_LINE_SIZE);
+  uint64_t i;
+  for (i=0;i<GT_STATS_HISTOGRAMS_SIZE;++i) dst[i] += src[i];
 }
 
 /*
  * MAPS Error Profile
  */
-GT_INLINE gt_maps_profile* gt_maps_profile_new() {
+GT_INLINE gt_maps_profile* gt_maps_profile_new(uint64_t** const histograms_cursor) {
   // Allocate handler
   gt_maps_profile* maps_profile = gt_alloc(gt_maps_profile);
   /*
    * Init
    */
   // Mismatch/Indel Profile
-  maps_profile->mismatches = gt_calloc(GT_STATS_MISMS_RANGE,uint64_t,true);
-  maps_profile->levenshtein = gt_calloc(GT_STATS_MISMS_RANGE,uint64_t,true);
-  maps_profile->insertion_length = gt_calloc(GT_STATS_MISMS_RANGE,uint64_t,true);
-  maps_profile->deletion_length = gt_calloc(GT_STATS_MISMS_RANGE,uint64_t,true);
-  maps_profile->errors_events = gt_calloc(GT_STATS_MISMS_RANGE,uint64_t,true);
+  maps_profile->mismatches = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_RANGE);
+  maps_profile->levenshtein = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_RANGE);
+  maps_profile->insertion_length = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_RANGE);
+  maps_profile->deletion_length = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_RANGE);
+  maps_profile->errors_events = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_RANGE);
   // Mismatch/Indel Distribution
-  maps_profile->total_mismatches=0;
-  maps_profile->total_levenshtein=0;
-  maps_profile->total_indel_length=0;
-  maps_profile->total_errors_events=0;
-  maps_profile->error_position = gt_calloc(GT_STATS_LARGE_READ_POS_RANGE,uint64_t,true);
-  // Trim/Mapping stats
-  maps_profile->total_bases=0;
-  maps_profile->total_bases_matching=0;
-  maps_profile->total_bases_trimmed=0;
-  // Strandness combinations
-  maps_profile->single_strand_f=0;
-  maps_profile->single_strand_r=0;
-  maps_profile->pair_strand_rf=0;
-  maps_profile->pair_strand_fr=0;
-  maps_profile->pair_strand_ff=0;
-  maps_profile->pair_strand_rr=0;
+  maps_profile->error_position = gt_stats_histogram_carve(histograms_cursor,GT_STATS_LARGE_READ_POS_RANGE);
   // Insert Size Distribution
-  maps_profile->inss = gt_calloc(GT_STATS_INSS_RANGE,uint64_t,true);
+  maps_profile->inss = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INSS_RANGE);
   // Mismatch/Errors bases
-  maps_profile->misms_transition = gt_calloc(GT_STATS_MISMS_BASE_RANGE*GT_STATS_MISMS_BASE_RANGE,uint64_t,true);
-  maps_profile->qual_score_misms = gt_calloc(GT_STATS_QUAL_SCORE_RANGE,uint64_t,true);
-  maps_profile->misms_1context = gt_calloc(GT_STATS_MISMS_1_CONTEXT_RANGE,uint64_t,true);
-  maps_profile->indel_transition_1 = gt_calloc(GT_STATS_INDEL_TRANSITION_1_RANGE,uint64_t,true);
-  maps_profile->indel_transition_2 = gt_calloc(GT_STATS_INDEL_TRANSITION_2_RANGE,uint64_t,true);
-  maps_profile->indel_transition_3 = gt_calloc(GT_STATS_INDEL_TRANSITION_3_RANGE,uint64_t,true);
-  maps_profile->indel_transition_4 = gt_calloc(GT_STATS_INDEL_TRANSITION_4_RANGE,uint64_t,true);
-  maps_profile->indel_1context = gt_calloc(GT_STATS_INDEL_1_CONTEXT,uint64_t,true);
-  maps_profile->indel_2context = gt_calloc(GT_STATS_INDEL_2_CONTEXT,uint64_t,true);
-  maps_profile->qual_score_errors = gt_calloc(GT_STATS_QUAL_SCORE_RANGE,uint64_t,true);
+  maps_profile->misms_transition = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_BASE_RANGE*GT_STATS_MISMS_BASE_RANGE);
+  maps_profile->qual_score_misms = gt_stats_histogram_carve(histograms_cursor,GT_STATS_QUAL_SCORE_RANGE);
+  maps_profile->misms_1context = gt_stats_histogram_carve(histograms_cursor,GT_STATS_MISMS_1_CONTEXT_RANGE);
+  maps_profile->indel_transition_1 = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_TRANSITION_1_RANGE);
+  maps_profile->indel_transition_2 = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_TRANSITION_2_RANGE);
+  maps_profile->indel_transition_3 = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_TRANSITION_3_RANGE);
+  maps_profile->indel_transition_4 = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_TRANSITION_4_RANGE);
+  maps_profile->indel_1context = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_1_CONTEXT);
+  maps_profile->indel_2context = gt_stats_histogram_carve(histograms_cursor,GT_STATS_INDEL_2_CONTEXT);
+  maps_profile->qual_score_errors = gt_stats_histogram_carve(histograms_cursor,GT_STATS_QUAL_SCORE_RANGE);
   return maps_profile;
 }
 GT_INLINE void gt_maps_profile_clear(gt_maps_profile* const maps_profile) {
   /*
-   * Init
+   * Init (Histograms are cleared along with the whole stats block)
    */
-  // Mismatch/Indel Profile
-  memset(maps_profile->mismatches,0,GT_STATS_MISMS_RANGE*sizeof(uint64_t));
-  memset(maps_profile->levenshtein,0,GT_STATS_MISMS_RANGE*sizeof(uint64_t));
-  memset(maps_profile->insertion_length,0,GT_STATS_MISMS_RANGE*sizeof(uint64_t));
-  memset(maps_profile->deletion_length,0,GT_STATS_MISMS_RANGE*sizeof(uint64_t));
-  memset(maps_profile->errors_events,0,GT_STATS_MISMS_RANGE*sizeof(uint64_t));
   // Mismatch/Indel Distribution
   maps_profile->total_mismatches=0;
   maps_profile->total_levenshtein=0;
   maps_profile->total_indel_length=0;
   maps_profile->total_errors_events=0;
-  memset(maps_profile->error_position,0,GT_STATS_LARGE_READ_POS_RANGE*sizeof(uint64_t));
   // Trim/Mapping stats
   maps_profile->total_bases=0;
   maps_profile->total_bases_matching=0;
@@ -91,59 +129,17 @@ GT_INLINE void gt_maps_profile_clear(gt_maps_profile* const maps_profile) {
   maps_profile->pair_strand_fr=0;
   maps_profile->pair_strand_ff=0;
   maps_profile->pair_strand_rr=0;
-  // Insert Size Distribution
-  memset(maps_profile->inss,0,GT_STATS_INSS_RANGE*sizeof(uint64_t));
-  // Mismatch/Errors bases
-  memset(maps_profile->misms_transition,0,GT_STATS_MISMS_BASE_RANGE*GT_STATS_MISMS_BASE_RANGE*sizeof(uint64_t));
-  memset(maps_profile->qual_score_misms,0,GT_STATS_QUAL_SCORE_RANGE*sizeof(uint64_t));
-  memset(maps_profile->misms_1context,0,GT_STATS_MISMS_1_CONTEXT_RANGE*sizeof(uint64_t));
-  memset(maps_profile->indel_transition_1,0,GT_STATS_INDEL_TRANSITION_1_RANGE*sizeof(uint64_t));
-  memset(maps_profile->indel_transition_2,0,GT_STATS_INDEL_TRANSITION_2_RANGE*sizeof(uint64_t));
-  memset(maps_profile->indel_transition_3,0,GT_STATS_INDEL_TRANSITION_3_RANGE*sizeof(uint64_t));
-  memset(maps_profile->indel_transition_4,0,GT_STATS_INDEL_TRANSITION_4_RANGE*sizeof(uint64_t));
-  memset(maps_profile->indel_1context,0,GT_STATS_INDEL_1_CONTEXT*sizeof(uint64_t));
-  memset(maps_profile->indel_2context,0,GT_STATS_INDEL_2_CONTEXT*sizeof(uint64_t));
-  memset(maps_profile->qual_score_errors,0,GT_STATS_QUAL_SCORE_RANGE*sizeof(uint64_t));
-
 }
 GT_INLINE void gt_maps_profile_delete(gt_maps_profile* const maps_profile) {
-  // Mismatch/Indel Profile
-  gt_free(maps_profile->mismatches);
-  gt_free(maps_profile->levenshtein);
-  gt_free(maps_profile->insertion_length);
-  gt_free(maps_profile->deletion_length);
-  gt_free(maps_profile->errors_events);
-  // Mismatch/Indel Distribution
-  gt_free(maps_profile->error_position);
-  // Insert Size Distribution
-  gt_free(maps_profile->inss);
-  // Mismatch/Errors bases
-  gt_free(maps_profile->misms_transition);
-  gt_free(maps_profile->qual_score_misms);
-  gt_free(maps_profile->misms_1context);
-  gt_free(maps_profile->indel_transition_1);
-  gt_free(maps_profile->indel_transition_2);
-  gt_free(maps_profile->indel_transition_3);
-  gt_free(maps_profile->indel_transition_4);
-  gt_free(maps_profile->indel_1context);
-  gt_free(maps_profile->indel_2context);
-  gt_free(maps_profile->qual_score_errors);
   gt_free(maps_profile);
 }
 GT_INLINE void gt_maps_profile_merge(
     gt_maps_profile* const maps_profile_dst,gt_maps_profile* const maps_profile_src) {
-  // Mismatch/Indel Profile
-  GT_STATS_VECTOR_ADD(maps_profile_dst->mismatches,maps_profile_src->mismatches,GT_STATS_MISMS_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->levenshtein,maps_profile_src->levenshtein,GT_STATS_MISMS_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->insertion_length,maps_profile_src->insertion_length,GT_STATS_MISMS_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->deletion_length,maps_profile_src->deletion_length,GT_STATS_MISMS_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->errors_events,maps_profile_src->errors_events,GT_STATS_MISMS_RANGE);
   // Mismatch/Indel Distribution
   maps_profile_dst->total_mismatches+=maps_profile_src->total_mismatches;
   maps_profile_dst->total_levenshtein+=maps_profile_src->total_levenshtein;
   maps_profile_dst->total_indel_length+=maps_profile_src->total_indel_length;
   maps_profile_dst->total_errors_events+=maps_profile_src->total_errors_events;
-  GT_STATS_VECTOR_ADD(maps_profile_dst->error_position,maps_profile_src->error_position,GT_STATS_LARGE_READ_POS_RANGE);
   // Trim/Mapping stats
   maps_profile_dst->total_bases+=maps_profile_src->total_bases;
   maps_profile_dst->total_bases_matching+=maps_profile_src->total_bases_matching;
@@ -155,64 +151,36 @@ GT_INLINE void gt_maps_profile_merge(
   maps_profile_dst->pair_strand_fr+=maps_profile_src->pair_strand_fr;
   maps_profile_dst->pair_strand_ff+=maps_profile_src->pair_strand_ff;
   maps_profile_dst->pair_strand_rr+=maps_profile_src->pair_strand_rr;
-  // Insert Size Distribution
-  GT_STATS_VECTOR_ADD(maps_profile_dst->inss,maps_profile_src->inss,GT_STATS_INSS_RANGE);
-  // Mismatch/Errors bases
-  GT_STATS_VECTOR_ADD(maps_profile_dst->misms_transition,maps_profile_src->misms_transition,GT_STATS_MISMS_BASE_RANGE*GT_STATS_MISMS_BASE_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->qual_score_misms,maps_profile_src->qual_score_misms,GT_STATS_QUAL_SCORE_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->misms_1context,maps_profile_src->misms_1context,GT_STATS_MISMS_1_CONTEXT_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_transition_1,maps_profile_src->indel_transition_1,GT_STATS_INDEL_TRANSITION_1_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_transition_2,maps_profile_src->indel_transition_2,GT_STATS_INDEL_TRANSITION_2_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_transition_3,maps_profile_src->indel_transition_3,GT_STATS_INDEL_TRANSITION_3_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_transition_4,maps_profile_src->indel_transition_4,GT_STATS_INDEL_TRANSITION_4_RANGE);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_1context,maps_profile_src->indel_1context,GT_STATS_INDEL_1_CONTEXT);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->indel_2context,maps_profile_src->indel_2context,GT_STATS_INDEL_2_CONTEXT);
-  GT_STATS_VECTOR_ADD(maps_profile_dst->qual_score_errors,maps_profile_src->qual_score_errors,GT_STATS_QUAL_SCORE_RANGE);
 }
 /*
  * SPLITMAPS Profile
  */
-GT_INLINE gt_splitmaps_profile* gt_splitmaps_profile_new() {
+GT_INLINE gt_splitmaps_profile* gt_splitmaps_profile_new(uint64_t** const histograms_cursor) {
   // Allocate handler
   gt_splitmaps_profile* splitmaps_profile = gt_alloc(gt_splitmaps_profile);
   /*
    * Init
    */
-  // General SM
-  splitmaps_profile->num_mapped_with_splitmaps = 0;
-  splitmaps_profile->num_mapped_only_splitmaps = 0;
-  splitmaps_profile->total_splitmaps = 0;
-  splitmaps_profile->total_junctions = 0;
-  splitmaps_profile->num_junctions = gt_calloc(GT_STATS_NUM_JUNCTION_RANGE,uint64_t,true);
-  splitmaps_profile->length_junctions = gt_calloc(GT_STATS_LEN_JUNCTION_RANGE,uint64_t,true);
-  splitmaps_profile->junction_position = gt_calloc(GT_STATS_SHORT_READ_POS_RANGE,uint64_t,true);
-  // Paired SM combinations
-  splitmaps_profile->pe_sm_sm = 0;
-  splitmaps_profile->pe_sm_rm = 0;
-  splitmaps_profile->pe_rm_rm = 0;
+  splitmaps_profile->num_junctions = gt_stats_histogram_carve(histograms_cursor,GT_STATS_NUM_JUNCTION_RANGE);
+  splitmaps_profile->length_junctions = gt_stats_histogram_carve(histograms_cursor,GT_STATS_LEN_JUNCTION_RANGE);
+  splitmaps_profile->junction_position = gt_stats_histogram_carve(histograms_cursor,GT_STATS_SHORT_READ_POS_RANGE);
   return splitmaps_profile;
 }
 GT_INLINE void gt_splitmaps_profile_clear(gt_splitmaps_profile* const splitmaps_profile) {
   /*
-   * Init
+   * Init (Histograms are cleared along with the whole stats block)
    */
   // General SM
   splitmaps_profile->num_mapped_with_splitmaps = 0;
   splitmaps_profile->num_mapped_only_splitmaps = 0;
   splitmaps_profile->total_splitmaps = 0;
   splitmaps_profile->total_junctions = 0;
-  memset(splitmaps_profile->num_junctions,0,GT_STATS_NUM_JUNCTION_RANGE*sizeof(uint64_t));
-  memset(splitmaps_profile->length_junctions,0,GT_STATS_LEN_JUNCTION_RANGE*sizeof(uint64_t));
-  memset(splitmaps_profile->junction_position,0,GT_STATS_SHORT_READ_POS_RANGE*sizeof(uint64_t));
   // Paired SM combinations
   splitmaps_profile->pe_sm_sm = 0;
   splitmaps_profile->pe_sm_rm = 0;
   splitmaps_profile->pe_rm_rm = 0;
 }
 GT_INLINE void gt_splitmaps_profile_delete(gt_splitmaps_profile* const splitmaps_profile) {
-  gt_free(splitmaps_profile->num_junctions);
-  gt_free(splitmaps_profile->length_junctions);
-  gt_free(splitmaps_profile->junction_position);
   gt_free(splitmaps_profile);
 }
 GT_INLINE void gt_splitmaps_profile_merge(
@@ -222,75 +190,123 @@ GT_INLINE void gt_splitmaps_profile_merge(
   splitmaps_profile_dst->num_mapped_only_splitmaps += splitmaps_profile_src->num_mapped_only_splitmaps;
   splitmaps_profile_dst->total_splitmaps += splitmaps_profile_src->total_splitmaps;
   splitmaps_profile_dst->total_junctions += splitmaps_profile_src->total_junctions;
-  GT_STATS_VECTOR_ADD(splitmaps_profile_dst->num_junctions,splitmaps_profile_src->num_junctions,GT_STATS_NUM_JUNCTION_RANGE);
-  GT_STATS_VECTOR_ADD(splitmaps_profile_dst->length_junctions,splitmaps_profile_src->length_junctions,GT_STATS_LEN_JUNCTION_RANGE);
-  GT_STATS_VECTOR_ADD(splitmaps_profile_dst->junction_position,splitmaps_profile_src->junction_position,GT_STATS_SHORT_READ_POS_RANGE);
   // Paired SM combinations
   splitmaps_profile_dst->pe_sm_sm += splitmaps_profile_src->pe_sm_sm;
   splitmaps_profile_dst->pe_sm_rm += splitmaps_profile_src->pe_sm_rm;
   splitmaps_profile_dst->pe_rm_rm += splitmaps_profile_src->pe_rm_rm;
 }
+/*
+ * Global diversity set
+ */
+GT_INLINE gt_diversity_set* gt_diversity_set_new() {
+  gt_diversity_set* const diversity_set = gt_alloc(gt_diversity_set);
+  uint64_t i;
+  for (i=0;i<GT_STATS_DIVERSITY_NUM_SHARDS;++i) {
+    gt_cond_fatal_error(pthread_mutex_init(&diversity_set->shards[i].mutex,NULL),SYS_MUTEX_INIT);
+    diversity_set->shards[i].sequences = gt_shash_new();
+  }
+  return diversity_set;
+}
+GT_INLINE void gt_diversity_set_clear(gt_diversity_set* const diversity_set) {
+  uint64_t i;
+  for (i=0;i<GT_STATS_DIVERSITY_NUM_SHARDS;++i) {
+    gt_shash_clear(diversity_set->shards[i].sequences,true);
+  }
+}
+GT_INLINE void gt_diversity_set_delete(gt_diversity_set* const diversity_set) {
+  uint64_t i;
+  for (i=0;i<GT_STATS_DIVERSITY_NUM_SHARDS;++i) {
+    gt_cond_fatal_error(pthread_mutex_destroy(&diversity_set->shards[i].mutex),SYS_MUTEX_DESTROY);
+    gt_shash_delete(diversity_set->shards[i].sequences,true);
+  }
+  gt_free(diversity_set);
+}
+GT_INLINE gt_diversity_shard* gt_diversity_set_get_shard(gt_diversity_set* const diversity_set,const char* const seq_name) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  const char* centinel;
+  for (centinel=seq_name;*centinel;++centinel) {
+    hash = (hash ^ (uint8_t)*centinel) * 1099511628211ull;
+  }
+  return diversity_set->shards+(hash%GT_STATS_DIVERSITY_NUM_SHARDS);
+}
+GT_INLINE void gt_diversity_set_add(gt_diversity_set* const diversity_set,char* const seq_name) {
+  gt_diversity_shard* const shard = gt_diversity_set_get_shard(diversity_set,seq_name);
+  GT_BEGIN_MUTEX_SECTION(shard->mutex) {
+    uint64_t* count = gt_shash_get_element(shard->sequences,seq_name);
+    if (count==NULL) {
+      count = gt_malloc_uint64();
+      *count = 1;
+      gt_shash_insert(shard->sequences,seq_name,count,uint64_t);
+    } else {
+      ++(*count);
+    }
+  } GT_END_MUTEX_SECTION(shard->mutex);
+}
+GT_INLINE uint64_t gt_diversity_set_get_num_elements(gt_diversity_set* const diversity_set) {
+  uint64_t i, num_elements = 0;
+  for (i=0;i<GT_STATS_DIVERSITY_NUM_SHARDS;++i) {
+    GT_BEGIN_MUTEX_SECTION(diversity_set->shards[i].mutex) {
+      num_elements += gt_shash_get_num_elements(diversity_set->shards[i].sequences);
+    } GT_END_MUTEX_SECTION(diversity_set->shards[i].mutex);
+  }
+  return num_elements;
+}
 /*
  * POPULATION Profile
  */
-GT_INLINE gt_population_profile* gt_population_profile_new() {
+GT_INLINE gt_population_profile* gt_population_profile_new(
+    uint64_t** const histograms_cursor,gt_diversity_set* const global_diversity) {
   // Allocate handler
   gt_population_profile* population_profile = gt_alloc(gt_population_profile);
   /*
    * Init
    */
   // Diversity
-  population_profile->local_diversity = gt_calloc(GT_STATS_DIVERSITY_RANGE,uint64_t,true);
-  population_profile->local_dominant = gt_calloc(GT_STATS_DOMINANT_RANGE,uint64_t,true);
-  population_profile->local_diversity__dominant = gt_calloc(GT_STATS_DIVERSITY_DOMINANT_RANGE,uint64_t,true);
-  population_profile->global_diversity = 0;
-  // Quimeras
-  population_profile->num_map_quimeras = 0;
-  population_profile->num_pair_quimeras = 0;
+  population_profile->local_diversity = gt_stats_histogram_carve(histograms_cursor,GT_STATS_DIVERSITY_RANGE);
+  population_profile->local_dominant = gt_stats_histogram_carve(histograms_cursor,GT_STATS_DOMINANT_RANGE);
+  population_profile->local_diversity__dominant = gt_stats_histogram_carve(histograms_cursor,GT_STATS_DIVERSITY_DOMINANT_RANGE);
   // Aux
-  population_profile->_local_diversity_hash = gt_shash_new();
+  population_profile->_local_diversity = gt_vector_new(GT_STATS_DIVERSITY_RANGE,sizeof(gt_diversity_counter));
   population_profile->_global_diversity_hash = gt_shash_new();
+  population_profile->_global_diversity_owner = (global_diversity==NULL);
+  population_profile->_global_diversity = (global_diversity==NULL) ? gt_diversity_set_new() : global_diversity;
   return population_profile;
 }
 GT_INLINE void gt_population_profile_clear(gt_population_profile* const population_profile) {
   // Diversity
-  memset(population_profile->local_diversity,0,GT_STATS_DIVERSITY_RANGE*sizeof(uint64_t));
-  memset(population_profile->local_dominant,0,GT_STATS_DOMINANT_RANGE*sizeof(uint64_t));
-  memset(population_profile->local_diversity__dominant,0,GT_STATS_DIVERSITY_DOMINANT_RANGE*sizeof(uint64_t));
   population_profile->global_diversity = 0;
   // Quimeras
   population_profile->num_map_quimeras = 0;
   population_profile->num_pair_quimeras = 0;
   // Auxiliary
-  gt_shash_clear(population_profile->_local_diversity_hash,true);
+  gt_vector_clear(population_profile->_local_diversity);
   gt_shash_clear(population_profile->_global_diversity_hash,true);
+  if (population_profile->_global_diversity_owner) gt_diversity_set_clear(population_profile->_global_diversity);
 }
 GT_INLINE void gt_population_profile_delete(gt_population_profile* const population_profile) {
-  gt_free(population_profile->local_diversity);
-  gt_free(population_profile->local_dominant);
-  gt_free(population_profile->local_diversity__dominant);
+  gt_vector_delete(population_profile->_local_diversity);
+  gt_shash_delete(population_profile->_global_diversity_hash,true);
+  if (population_profile->_global_diversity_owner) gt_diversity_set_delete(population_profile->_global_diversity);
+  gt_free(population_profile);
 }
 GT_INLINE void gt_population_profile_merge(
     gt_population_profile* const population_profile_dst,gt_population_profile* const population_profile_src) {
-  // Diversity
-  GT_STATS_VECTOR_ADD(population_profile_dst->local_diversity,population_profile_src->local_diversity,GT_STATS_DIVERSITY_RANGE);
-  GT_STATS_VECTOR_ADD(population_profile_dst->local_dominant,population_profile_src->local_dominant,GT_STATS_DOMINANT_RANGE);
-  GT_STATS_VECTOR_ADD(population_profile_dst->local_diversity__dominant,population_profile_src->local_diversity__dominant,GT_STATS_DIVERSITY_DOMINANT_RANGE);
   // Quimeras
   population_profile_dst->num_map_quimeras += population_profile_src->num_map_quimeras;
   population_profile_dst->num_pair_quimeras += population_profile_src->num_pair_quimeras;
-  // Global diversity
-  GT_SHASH_BEGIN_ITERATE(population_profile_src->_global_diversity_hash,key,count_src,uint64_t) {
-    uint64_t* count_dst = gt_shash_get_element(population_profile_dst->_global_diversity_hash,key);
-    if (count_dst==NULL) {
-      count_dst = gt_malloc_uint64();
-      *count_dst = *count_src;
-      gt_shash_insert(population_profile_dst->_global_diversity_hash,key,count_dst,uint64_t);
-    } else {
-      *count_dst+=*count_src;
-    }
-  } GT_SHASH_END_ITERATE;
-  population_profile_dst->global_diversity = gt_shash_get_num_elements(population_profile_dst->_global_diversity_hash);
+  // Global diversity (only independent sets need to be merged)
+  if (population_profile_dst->_global_diversity!=population_profile_src->_global_diversity) {
+    GT_SHASH_BEGIN_KEY_ITERATE(population_profile_src->_global_diversity_hash,key) {
+      if (!gt_shash_is_contained(population_profile_dst->_global_diversity_hash,key)) {
+        uint64_t* const published = gt_malloc_uint64();
+        *published = 1;
+        gt_shash_insert(population_profile_dst->_global_diversity_hash,key,published,uint64_t);
+        gt_diversity_set_add(population_profile_dst->_global_diversity,key);
+      }
+    } GT_SHASH_END_ITERATE;
+  }
+  population_profile_dst->global_diversity = gt_diversity_set_get_num_elements(population_profile_dst->_global_diversity);
 }
 
 /*
@@ -353,16 +369,11 @@ GT_INLINE void gt_stats_get_mmap_distribution(uint64_t* const mmap,const int64_t
   if (num_maps>0) ++mmap[gt_stats_get_mmap_bucket(num_maps)];
 }
 GT_INLINE void gt_stats_get_nucleotide_stats(uint64_t* const nt_counting,gt_string* const read) {
-  GT_STRING_ITERATE(read,read_string,pos) {
-    ++nt_counting[gt_cdna_encode[(uint8_t)read_string[pos]]];
-  }
+  gt_cycle_stats_count_bases(gt_string_get_string(read),gt_string_get_length(read),nt_counting);
 }
 GT_INLINE uint8_t gt_stats_get_avg_qualities(gt_string* const qualities) {
-  uint64_t avg_qual = 0;
-  GT_STRING_ITERATE(qualities,buffer,pos) {
-    avg_qual += (uint8_t)buffer[pos];
-  }
-  return avg_qual/gt_string_get_length(qualities);
+  const uint64_t length = gt_string_get_length(qualities);
+  return gt_cycle_stats_sum_qualities(gt_string_get_string(qualities),length)/length;
 }
 GT_INLINE uint64_t gt_stats_get_read_length_bucket(const uint64_t read_length) {
   if (read_length <= 5) {
@@ -498,41 +509,45 @@ GT_INLINE uint64_t gt_stats_get_local_dominant_bucket(const uint64_t local_domin
 /*
  * STATS Profile
  */
-GT_INLINE gt_stats* gt_stats_new() {
+GT_INLINE gt_stats* gt_stats_new_(gt_diversity_set* const global_diversity) {
   // Allocate handler
   gt_stats* stats = gt_alloc(gt_stats);
+  // Histograms
+  stats->histograms = gt_stats_histograms_new();
+  uint64_t* histograms_cursor = stats->histograms;
   // Length
-  stats->min_length=UINT64_MAX;
-  stats->max_length=0;
-  stats->total_bases=0;
-  stats->total_bases_aligned=0;
-  stats->mapped_min_length=UINT64_MAX;
-  stats->mapped_max_length=0;
-  stats->length = gt_calloc(GT_STATS_LENGTH_RANGE,uint64_t,true);
-  stats->length_mapped = gt_calloc(GT_STATS_LENGTH_RANGE,uint64_t,true);
-  stats->length__mmap = gt_calloc(GT_STATS_LENGTH__MMAP_RANGE,uint64_t,true);
-  stats->length__quality = gt_calloc(GT_STATS_LENGTH__QUAL_SCORE_RANGE,uint64_t,true);
-  stats->avg_quality = gt_calloc(GT_STATS_QUAL_SCORE_RANGE,uint64_t,true);
-  stats->mmap__avg_quality = gt_calloc(GT_STATS_QUAL_SCORE__MMAP_RANGE,uint64_t,true);
+  stats->length = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_LENGTH_RANGE);
+  stats->length_mapped = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_LENGTH_RANGE);
+  stats->length__mmap = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_LENGTH__MMAP_RANGE);
+  stats->length__quality = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_LENGTH__QUAL_SCORE_RANGE);
+  stats->avg_quality = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_QUAL_SCORE_RANGE);
+  stats->mmap__avg_quality = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_QUAL_SCORE__MMAP_RANGE);
   // Nucleotide counting (wrt to the maps=read+errors)
-  stats->nt_counting = gt_calloc(GT_STATS_MISMS_BASE_RANGE,uint64_t,true);
-  // Mapped/Maps/MMaps/Uniq...
-  stats->num_blocks=0;
-  stats->num_alignments=0;
-  stats->num_maps=0;
-  stats->num_mapped=0;
-  stats->num_mapped_reads=0;
-  stats->mmap = gt_calloc(GT_STATS_MMAP_RANGE,uint64_t,true); // MMaps
-  stats->uniq = gt_calloc(GT_STATS_UNIQ_RANGE,uint64_t,true); // Uniq
+  stats->nt_counting = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_MISMS_BASE_RANGE);
+  // MMaps/Uniq
+  stats->mmap = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_MMAP_RANGE);
+  stats->uniq = gt_stats_histogram_carve(&histograms_cursor,GT_STATS_UNIQ_RANGE);
   // Maps Error Profile
-  stats->maps_profile = gt_maps_profile_new();
+  stats->maps_profile = gt_maps_profile_new(&histograms_cursor);
   // Split maps Profile
-  stats->splitmaps_profile = gt_splitmaps_profile_new();
+  stats->splitmaps_profile = gt_splitmaps_profile_new(&histograms_cursor);
   // Population profile
-  stats->population_profile = gt_population_profile_new();
+  stats->population_profile = gt_population_profile_new(&histograms_cursor,global_diversity);
+  gt_check(histograms_cursor!=stats->histograms+GT_STATS_HISTOGRAMS_SIZE,ALG_INCONSISNTENCY);
+  // Counters (all the profiles' counters too)
+  gt_stats_clear(stats);
   return stats;
 }
+GT_INLINE gt_stats* gt_stats_new() {
+  return gt_stats_new_(NULL);
+}
+GT_INLINE gt_stats* gt_stats_new_shared(gt_stats* const stats_master) {
+  GT_NULL_CHECK(stats_master);
+  return gt_stats_new_(stats_master->population_profile->_global_diversity);
+}
 GT_INLINE void gt_stats_clear(gt_stats* const stats) {
+  // Histograms
+  memset(stats->histograms,0,GT_STATS_HISTOGRAMS_SIZE*sizeof(uint64_t));
   // Length
   stats->min_length=UINT64_MAX;
   stats->max_length=0;
@@ -540,24 +555,12 @@ GT_INLINE void gt_stats_clear(gt_stats* const stats) {
   stats->total_bases_aligned=0;
   stats->mapped_min_length=UINT64_MAX;
   stats->mapped_max_length=0;
-  memset(stats->length,0,GT_STATS_LENGTH_RANGE*sizeof(uint64_t));
-  memset(stats->length_mapped,0,GT_STATS_LENGTH_RANGE*sizeof(uint64_t));
-  memset(stats->length__mmap,0,GT_STATS_LENGTH__MMAP_RANGE*sizeof(uint64_t));
-  memset(stats->length__quality,0,GT_STATS_LENGTH__QUAL_SCORE_RANGE*sizeof(uint64_t));
-  memset(stats->avg_quality,0,GT_STATS_QUAL_SCORE_RANGE*sizeof(uint64_t));
-  memset(stats->mmap__avg_quality,0,GT_STATS_QUAL_SCORE__MMAP_RANGE*sizeof(uint64_t));
-  // Nucleotide counting (wrt to the maps=read+errors)
-  memset(stats->nt_counting,0,GT_STATS_MISMS_BASE_RANGE*sizeof(uint64_t)); // MMaps
   // Mapped/Maps/MMaps/Uniq...
   stats->num_blocks=0;
   stats->num_alignments=0;
   stats->num_maps=0;
   stats->num_mapped=0;
   stats->num_mapped_reads=0;
-  // MMap Distribution
-  memset(stats->mmap,0,GT_STATS_MMAP_RANGE*sizeof(uint64_t)); // MMaps
-  // Uniq Distribution
-  memset(stats->uniq,0,GT_STATS_UNIQ_RANGE*sizeof(uint64_t)); // Uniq
   // Maps Error Profile
   gt_maps_profile_clear(stats->maps_profile);
   // Split maps Profile
@@ -566,80 +569,92 @@ GT_INLINE void gt_stats_clear(gt_stats* const stats) {
   gt_population_profile_clear(stats->population_profile);
 }
 GT_INLINE void gt_stats_delete(gt_stats* const stats) {
-  gt_free(stats->length);
-  gt_free(stats->length_mapped);
-  gt_free(stats->length__mmap);
-  gt_free(stats->length__quality);
-  gt_free(stats->avg_quality);
-  gt_free(stats->mmap__avg_quality);
-  gt_free(stats->nt_counting);
-  gt_free(stats->mmap);
-  gt_free(stats->uniq);
   gt_maps_profile_delete(stats->maps_profile);
   gt_splitmaps_profile_delete(stats->splitmaps_profile);
   gt_population_profile_delete(stats->population_profile);
+  free(stats->histograms);
   gt_free(stats);
 }
 
 /*
  * STATS Merge
  */
+GT_INLINE void gt_stats_merge_pair(gt_stats* const stats_dst,gt_stats* const stats_src) {
+  // Histograms
+  gt_stats_histograms_add(stats_dst->histograms,stats_src->histograms);
+  // Length
+  stats_dst->min_length = GT_MIN(stats_dst->min_length,stats_src->min_length);
+  stats_dst->max_length = GT_MAX(stats_dst->max_length,stats_src->max_length);
+  stats_dst->total_bases += stats_src->total_bases;
+  stats_dst->total_bases_aligned += stats_src->total_bases_aligned;
+  stats_dst->mapped_min_length = GT_MIN(stats_dst->mapped_min_length,stats_src->mapped_min_length);
+  stats_dst->mapped_max_length = GT_MAX(stats_dst->mapped_max_length,stats_src->mapped_max_length);
+  // Mapped/Maps
+  stats_dst->num_blocks += stats_src->num_blocks;
+  stats_dst->num_alignments += stats_src->num_alignments;
+  stats_dst->num_maps += stats_src->num_maps;
+  stats_dst->num_mapped += stats_src->num_mapped;
+  stats_dst->num_mapped_reads += stats_src->num_mapped_reads;
+  // Merge Maps Error Profile
+  gt_maps_profile_merge(stats_dst->maps_profile,stats_src->maps_profile);
+  // Merge SplitMaps Profile
+  gt_splitmaps_profile_merge(stats_dst->splitmaps_profile,stats_src->splitmaps_profile);
+  // Population profile
+  gt_population_profile_merge(stats_dst->population_profile,stats_src->population_profile);
+}
 GT_INLINE void gt_stats_merge(gt_stats** const stats,const uint64_t stats_array_size) {
-  uint64_t i;
-  for (i=1;i<stats_array_size;++i) {
-    // Length
-    stats[0]->min_length = GT_MIN(stats[0]->min_length,stats[i]->min_length);
-    stats[0]->max_length = GT_MAX(stats[0]->max_length,stats[i]->max_length);
-    stats[0]->total_bases += stats[i]->total_bases;
-    stats[0]->total_bases_aligned += stats[i]->total_bases_aligned;
-    stats[0]->mapped_min_length = GT_MIN(stats[0]->mapped_min_length,stats[i]->mapped_min_length);
-    stats[0]->mapped_max_length = GT_MAX(stats[0]->mapped_max_length,stats[i]->mapped_max_length);
-    GT_STATS_VECTOR_ADD(stats[0]->length,stats[i]->length,GT_STATS_LENGTH_RANGE);
-    GT_STATS_VECTOR_ADD(stats[0]->length_mapped,stats[i]->length_mapped,GT_STATS_LENGTH_RANGE);
-    GT_STATS_VECTOR_ADD(stats[0]->length__mmap,stats[i]->length__mmap,GT_STATS_LENGTH__MMAP_RANGE);
-    GT_STATS_VECTOR_ADD(stats[0]->length__quality,stats[i]->length__quality,GT_STATS_LENGTH__QUAL_SCORE_RANGE);
-    GT_STATS_VECTOR_ADD(stats[0]->avg_quality,stats[i]->avg_quality,GT_STATS_QUAL_SCORE_RANGE);
-    GT_STATS_VECTOR_ADD(stats[0]->mmap__avg_quality,stats[i]->mmap__avg_quality,GT_STATS_QUAL_SCORE__MMAP_RANGE);
-    // Nucleotide counting (wrt to the maps=read+errors)
-    GT_STATS_VECTOR_ADD(stats[0]->nt_counting,stats[i]->nt_counting,GT_STATS_MISMS_BASE_RANGE);
-    // Mapped/Maps
-    stats[0]->num_blocks += stats[i]->num_blocks;
-    stats[0]->num_alignments += stats[i]->num_alignments;
-    stats[0]->num_maps += stats[i]->num_maps;
-    stats[0]->num_mapped += stats[i]->num_mapped;
-    stats[0]->num_mapped_reads += stats[i]->num_mapped_reads;
-    // MMap Distribution
-    GT_STATS_VECTOR_ADD(stats[0]->mmap,stats[i]->mmap,GT_STATS_MMAP_RANGE);
-    // Uniq Distribution
-    GT_STATS_VECTOR_ADD(stats[0]->uniq,stats[i]->uniq,GT_STATS_UNIQ_RANGE);
-    // Merge Maps Error Profile
-    gt_maps_profile_merge(stats[0]->maps_profile,stats[i]->maps_profile);
-    // Merge SplitMaps Profile
-    gt_splitmaps_profile_merge(stats[0]->splitmaps_profile,stats[i]->splitmaps_profile);
-    // Population profile
-    gt_population_profile_merge(stats[0]->population_profile,stats[i]->population_profile);
-    // Free Handlers
-    gt_stats_delete(stats[i]);
+  // Pairwise tree reduction (log2(stats_array_size) rounds of independent merges)
+  uint64_t stride;
+  for (stride=1;stride<stats_array_size;stride*=2) {
+    int64_t i;
+#ifdef HAVE_OPENMP
+    #pragma omp parallel for if (stats_array_size>2)
+#endif
+    for (i=0;i<(int64_t)stats_array_size-(int64_t)stride;i+=2*stride) {
+      gt_stats_merge_pair(stats[i],stats[i+stride]);
+      gt_stats_delete(stats[i+stride]);
+    }
+  }
+  // Global diversity
+  if (stats_array_size>0) {
+    stats[0]->population_profile->global_diversity =
+        gt_diversity_set_get_num_elements(stats[0]->population_profile->_global_diversity);
   }
 }
 /*
  * Calculate stats
  */
-GT_INLINE void gt_stats_add_map_to_population(gt_shash* const diversity_hash,gt_string* const seq_name) {
-  uint64_t* count = gt_shash_get_element(diversity_hash,gt_string_get_string(seq_name));
+GT_INLINE void gt_stats_add_map_to_local_population(gt_vector* const local_diversity,gt_string* const seq_name) {
+  GT_VECTOR_ITERATE(local_diversity,counter,counter_pos,gt_diversity_counter) {
+    if (counter->seq_name==seq_name) { // Interned names
+      ++(counter->count);
+      return;
+    }
+  }
+  gt_vector_reserve_additional(local_diversity,1);
+  gt_diversity_counter* const new_counter = gt_vector_get_free_elm(local_diversity,gt_diversity_counter);
+  new_counter->seq_name = seq_name;
+  new_counter->count = 1;
+  gt_vector_add_used(local_diversity,1);
+}
+GT_INLINE void gt_stats_add_map_to_global_population(gt_population_profile* const population_profile,gt_string* const seq_name) {
+  // Publish into the global set the first time this profile sees the sequence
+  char* const seq_name_string = gt_string_get_string(seq_name);
+  uint64_t* count = gt_shash_get_element(population_profile->_global_diversity_hash,seq_name_string);
   if (count==NULL) {
     count = gt_malloc_uint64();
     *count = 1;
-    gt_shash_insert(diversity_hash,gt_string_get_string(seq_name),count,uint64_t);
+    gt_shash_insert(population_profile->_global_diversity_hash,seq_name_string,count,uint64_t);
+    gt_diversity_set_add(population_profile->_global_diversity,seq_name_string);
   } else {
     ++(*count);
   }
 }
-GT_INLINE uint64_t gt_stats_get_local_dominant(gt_shash* const diversity_hash) {
+GT_INLINE uint64_t gt_stats_get_local_dominant(gt_vector* const local_diversity) {
   uint64_t local_dominant = 0;
-  GT_SHASH_BEGIN_ELEMENT_ITERATE(diversity_hash,count,uint64_t) {
-    if (local_dominant < *count) local_dominant = *count;
-  } GT_SHASH_END_ITERATE;
+  GT_VECTOR_ITERATE(local_diversity,counter,counter_pos,gt_diversity_counter) {
+    if (local_dominant < counter->count) local_dominant = counter->count;
+  }
   return local_dominant;
 }
 GT_INLINE void gt_stats_make_population_profile(
@@ -649,24 +664,24 @@ GT_INLINE void gt_stats_make_population_profile(
   const uint64_t paired_map = (num_blocks_template==2);
   // Check population
   uint64_t num_maps=0;
-  gt_shash_clear(population_profile->_local_diversity_hash,true);
+  gt_vector_clear(population_profile->_local_diversity);
   // Iterate over all/best maps
   GT_TEMPLATE_ITERATE(template,mmap) {
     GT_MMAP_ITERATE(mmap,map,end_pos) {
       ++num_maps;
-      gt_stats_add_map_to_population(population_profile->_local_diversity_hash,map->seq_name);
-      gt_stats_add_map_to_population(population_profile->_global_diversity_hash,map->seq_name);
+      gt_stats_add_map_to_local_population(population_profile->_local_diversity,map->seq_name);
+      gt_stats_add_map_to_global_population(population_profile,map->seq_name);
       if (gt_map_segment_get_num_segments(map)>1) ++population_profile->num_map_quimeras;
     }
     if (paired_map) {
-      if (!gt_string_equals(mmap[0]->seq_name,mmap[1]->seq_name)) ++population_profile->num_pair_quimeras;
+      if (mmap[0]->seq_id!=mmap[1]->seq_id) ++population_profile->num_pair_quimeras;
     }
     // FIRST-MAP :: Break if we just proccess the first one
     if (stats_analysis->first_map) break;
   }
-  const uint64_t local_diversity = gt_shash_get_num_elements(population_profile->_local_diversity_hash);
+  const uint64_t local_diversity = gt_vector_get_used(population_profile->_local_diversity);
   const uint64_t local_diversity_bucket = gt_stats_get_local_diversity_bucket(local_diversity);
-  const uint64_t local_dominant = gt_stats_get_local_dominant(population_profile->_local_diversity_hash);
+  const uint64_t local_dominant = gt_stats_get_local_dominant(population_profile->_local_diversity);
   const uint64_t local_dominant_bucket = gt_stats_get_local_dominant_bucket(local_dominant,num_maps);
   ++population_profile->local_diversity[local_diversity_bucket];
   ++population_profile->local_dominant[local_dominant_bucket];
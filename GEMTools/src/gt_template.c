@@ -29,6 +29,7 @@ GT_INLINE gt_template* gt_template_new() {
   template->mmaps = gt_vector_new(GT_TEMPLATE_NUM_INITIAL_MMAPS,sizeof(gt_mmap));
   template->attributes = gt_attributes_new();
   template->alg_dictionary = NULL;
+  template->mmap_index = NULL;
   return template;
 }
 GT_INLINE void gt_template_clear_handler(gt_template* const template) {
@@ -41,6 +42,7 @@ GT_INLINE void gt_template_clear(gt_template* const template,const bool delete_a
   if (delete_alignments) gt_template_delete_blocks(template);
   gt_vector_clear(template->counters);
   gt_vector_clear(template->mmaps);
+  gt_template_invalidate_mmap_index(template);
   gt_template_clear_handler(template);
 }
 GT_INLINE void gt_template_delete(gt_template* const template) {
@@ -50,6 +52,7 @@ GT_INLINE void gt_template_delete(gt_template* const template) {
   gt_vector_delete(template->counters);
   gt_vector_delete(template->mmaps);
   gt_attributes_delete(template->attributes);
+  if (template->mmap_index!=NULL) gt_map_index_delete(template->mmap_index);
   gt_free(template);
 }
 
@@ -290,6 +293,18 @@ GT_INLINE void gt_template_clear_mmaps(gt_template* const template) {
     gt_alignment_clear_maps(alignment);
   } GT_TEMPLATE_END_REDUCTION__RETURN;
   gt_vector_clear(template->mmaps);
+  gt_template_invalidate_mmap_index(template);
+}
+GT_INLINE void gt_template_invalidate_mmap_index(gt_template* const template) {
+  GT_TEMPLATE_CHECK(template);
+  if (template->mmap_index!=NULL) gt_map_index_clear(template->mmap_index);
+}
+GT_INLINE void gt_template_update_mmap_index(gt_template* const template,const uint64_t position) {
+  if (template->mmap_index!=NULL && position < template->mmap_index->num_indexed) {
+    gt_mmap* const mmap_ph = gt_vector_get_elm(template->mmaps,position,gt_mmap);
+    gt_map_index_add(template->mmap_index,
+        gt_map_index_mmap_key(mmap_ph->mmap,gt_template_get_num_blocks(template)),position);
+  }
 }
 /* MMap attributes */
 GT_INLINE void gt_template_mmap_attributes_clear(gt_mmap_attributes* const mmap_attributes) {
@@ -307,6 +322,7 @@ GT_INLINE void gt_template_set_mmap(gt_template* const template,const uint64_t p
   GT_TEMPLATE_CHECK(template);
   GT_MMAP_CHECK(mmap);
   gt_vector_set_elm(template->mmaps,position,gt_mmap,*mmap);
+  gt_template_update_mmap_index(template,position);
 }
 GT_INLINE void gt_template_add_mmap(gt_template* const template,gt_mmap* const mmap) {
   GT_TEMPLATE_CHECK(template);
@@ -340,6 +356,7 @@ GT_INLINE void gt_template_set_mmap_array(
   } else {
     gt_template_mmap_attributes_clear(&mmap_ph->attributes);
   }
+  gt_template_update_mmap_index(template,position);
 }
 GT_INLINE void gt_template_add_mmap_array(
     gt_template* const template,gt_map** const mmap,gt_mmap_attributes* const mmap_attributes) {
@@ -378,6 +395,7 @@ GT_INLINE void gt_template_set_mmap_ends(
   } else {
     gt_template_mmap_attributes_clear(&mmap_ph->attributes);
   }
+  gt_template_update_mmap_index(template,position);
 }
 GT_INLINE void gt_template_add_mmap_ends(
     gt_template* const template,
@@ -542,6 +560,7 @@ GT_INLINE void gt_template_swap(gt_template* const template_a,gt_template* const
   GT_SWAP(template_a->alignment_end2,template_b->alignment_end2);
   GT_SWAP(template_a->counters,template_b->counters);
   GT_SWAP(template_a->mmaps,template_b->mmaps);
+  GT_SWAP(template_a->mmap_index,template_b->mmap_index);
   GT_SWAP(template_a->attributes,template_b->attributes);
 }
 /*
@@ -163,6 +163,42 @@ GT_INLINE void gt_template_insert_mmap_gtvector_fx(
   gt_check(gt_vector_get_used(mmap)!=gt_template_get_num_blocks(template),TEMPLATE_ADD_BAD_NUM_BLOCKS);
   gt_template_insert_mmap_fx(gt_mmap_cmp_fx,template,gt_vector_get_mem(mmap,gt_map*),mmap_attributes);
 }
+GT_INLINE bool gt_template_find_mmap_indexed(
+    gt_template* const template,gt_map** const mmap,
+    uint64_t* const found_mmap_pos,gt_map*** const found_mmap,gt_mmap_attributes** const found_mmap_attributes) {
+  // Handle reduction to alignment
+  GT_TEMPLATE_IF_REDUCES_TO_ALINGMENT(template,alignment) {
+    gt_map* found_map;
+    if (!gt_alignment_find_map_fx(gt_map_cmp,alignment,mmap[0],found_mmap_pos,&found_map)) return false;
+    *found_mmap = gt_vector_get_elm(alignment->maps,*found_mmap_pos,gt_map*);
+    if (found_mmap_attributes) *found_mmap_attributes = NULL;
+    return true;
+  } GT_TEMPLATE_END_REDUCTION;
+  // Index the mmaps added since the last search
+  if (template->mmap_index==NULL) template->mmap_index = gt_map_index_new();
+  gt_map_index* const mmap_index = template->mmap_index;
+  const uint64_t num_blocks = gt_template_get_num_blocks(template);
+  const uint64_t num_mmaps = gt_vector_get_used(template->mmaps);
+  if (num_mmaps < mmap_index->num_indexed) gt_map_index_clear(mmap_index);
+  gt_mmap* const mmaps = gt_vector_get_mem(template->mmaps,gt_mmap);
+  uint64_t pos;
+  for (pos=mmap_index->num_indexed;pos<num_mmaps;++pos) {
+    gt_map_index_add(mmap_index,gt_map_index_mmap_key(mmaps[pos].mmap,num_blocks),pos);
+  }
+  mmap_index->num_indexed = num_mmaps;
+  // Confirm the candidates (keeping the first occurrence, as the linear scan does)
+  const uint64_t key = gt_map_index_mmap_key(mmap,num_blocks);
+  uint64_t slot = gt_map_index_probe_begin(mmap_index,key);
+  uint64_t candidate_pos, first_pos = GT_MAP_INDEX_NOT_FOUND;
+  while ((candidate_pos=gt_map_index_probe(mmap_index,key,&slot))!=GT_MAP_INDEX_NOT_FOUND) {
+    if (candidate_pos<first_pos && gt_mmap_cmp(mmaps[candidate_pos].mmap,mmap,num_blocks)==0) first_pos = candidate_pos;
+  }
+  if (first_pos==GT_MAP_INDEX_NOT_FOUND) return false;
+  *found_mmap_pos = first_pos;
+  *found_mmap = mmaps[first_pos].mmap;
+  if (found_mmap_attributes) *found_mmap_attributes = &mmaps[first_pos].attributes;
+  return true;
+}
 GT_INLINE bool gt_template_find_mmap_fx(
     int64_t (*gt_mmap_cmp_fx)(gt_map**,gt_map**,uint64_t),
     gt_template* const template,gt_map** const mmap,
@@ -176,6 +212,10 @@ GT_INLINE bool gt_template_find_mmap_fx(
   const uint64_t num_blocks = gt_template_get_num_blocks(template);
   uint64_t pos = 0;
   if(template->alg_dictionary == NULL || template->alg_dictionary->refs_dictionary == NULL){
+    // Hashed search (only valid for exact comparisons)
+    if (gt_mmap_cmp_fx==gt_mmap_cmp && gt_template_get_num_mmaps(template) >= GT_MAP_INDEX_THRESHOLD) {
+      return gt_template_find_mmap_indexed(template,mmap,found_mmap_pos,found_mmap,found_mmap_attributes);
+    }
     GT_TEMPLATE_ITERATE_MMAP__ATTR_(template,template_mmap,mmap_attribute) {
       if (gt_mmap_cmp_fx(template_mmap,mmap,num_blocks)==0) {
         *found_mmap_pos = pos;
@@ -234,6 +274,7 @@ GT_INLINE void gt_template_reduce_mmaps(gt_template* const template,const uint64
   const uint64_t num_matches = gt_template_get_num_mmaps(template);
   if (max_num_matches < num_matches) {
     gt_vector_set_used(template->mmaps,max_num_matches);
+    gt_template_invalidate_mmap_index(template);
     gt_template_recalculate_counters(template);
   }
 }
@@ -270,7 +311,7 @@ GT_INLINE int64_t gt_template_get_insert_size(gt_map** const mmap,gt_status* gt_
     block[1]=map_it2;
     length[1]+=gt_map_get_base_length(block[1]);
   } 
-  if(gt_string_equals(block[0]->seq_name,block[1]->seq_name)) {
+  if(block[0]->seq_id==block[1]->seq_id) {
     if(block[0]->strand!=block[1]->strand) {
       if(block[0]->strand==FORWARD) {
       		x=1+block[1]->position+length[1]-(block[0]->position+length[0]-gt_map_get_base_length(block[0]));
@@ -388,15 +429,36 @@ typedef struct {
   gt_map* end_1;
   gt_map* end_2;
 } gt_mmap_placeholder;
-int gt_mmap_cmp_distance__score(gt_mmap* const mmap_a,gt_mmap* const mmap_b) {
-  // Sort by distance
-  const int64_t distance_a = mmap_a->attributes.distance;
-  const int64_t distance_b = mmap_b->attributes.distance;
-  if (distance_a != distance_b) return distance_a-distance_b;
-  // Sort by score (here we cannot do the trick as gt_score fills the whole uint64_t range)
-  const uint64_t score_a = mmap_a->attributes.gt_score;
-  const uint64_t score_b = mmap_b->attributes.gt_score;
-  return (score_a > score_b) ? -1 : (score_a < score_b ? 1 : 0);
+#define GT_SORT_KEYS_STACK 32
+GT_INLINE void gt_template_select_by_distance__score(gt_template* const template,const uint64_t max_num_matches) {
+  const uint64_t num_mmaps = gt_template_get_num_mmaps(template);
+  if (num_mmaps==0) return;
+  const uint64_t num_selected = GT_MIN(max_num_matches,num_mmaps);
+  // Compute keys (mmap attributes already hold the distance)
+  gt_sort_key keys_stack[GT_SORT_KEYS_STACK];
+  gt_mmap selected_stack[GT_SORT_KEYS_STACK];
+  const bool on_stack = (num_mmaps <= GT_SORT_KEYS_STACK);
+  gt_sort_key* const keys = (on_stack) ? keys_stack : gt_calloc(num_mmaps,gt_sort_key,false);
+  gt_mmap* const selected = (on_stack) ? selected_stack : gt_calloc(num_selected,gt_mmap,false);
+  gt_mmap* const mmaps = gt_vector_get_mem(template->mmaps,gt_mmap);
+  uint64_t i;
+  for (i=0;i<num_mmaps;++i) {
+    keys[i].distance = mmaps[i].attributes.distance;
+    keys[i].score = mmaps[i].attributes.gt_score;
+    keys[i].position = i;
+  }
+  // Select (maps are owned by the alignments)
+  gt_sort_keys_select(keys,num_mmaps,num_selected);
+  for (i=0;i<num_selected;++i) selected[i] = mmaps[keys[i].position];
+  memcpy(mmaps,selected,num_selected*sizeof(gt_mmap));
+  gt_vector_set_used(template->mmaps,num_selected);
+  gt_template_invalidate_mmap_index(template);
+  if (num_selected < num_mmaps) gt_template_recalculate_counters(template);
+  // Free
+  if (!on_stack) {
+    gt_free(keys);
+    gt_free(selected);
+  }
 }
 /*
  * Template's Maps Sorting
@@ -406,21 +468,28 @@ GT_INLINE void gt_template_sort_by_distance__score(gt_template* const template)
   GT_TEMPLATE_IF_REDUCES_TO_ALINGMENT(template,alignment) {
     return gt_alignment_sort_by_distance__score(alignment);
   } GT_TEMPLATE_END_REDUCTION;
-  // Sort
-  const uint64_t num_mmap = gt_template_get_num_mmaps(template);
-  qsort(gt_vector_get_mem(template->mmaps,gt_mmap),num_mmap,sizeof(gt_mmap),
-      (int (*)(const void *,const void *))gt_mmap_cmp_distance__score);
+  gt_template_select_by_distance__score(template,GT_ALL);
 }
-
 GT_INLINE void gt_template_sort_by_distance__score_no_split(gt_template* const template) {
   GT_TEMPLATE_CHECK(template);
   GT_TEMPLATE_IF_REDUCES_TO_ALINGMENT(template,alignment) {
     return gt_alignment_sort_by_distance__score_no_split(alignment);
   } GT_TEMPLATE_END_REDUCTION;
-  // Sort
-  const uint64_t num_mmap = gt_template_get_num_mmaps(template);
-  qsort(gt_vector_get_mem(template->mmaps,gt_mmap),num_mmap,sizeof(gt_mmap),
-      (int (*)(const void *,const void *))gt_mmap_cmp_distance__score);
+  gt_template_select_by_distance__score(template,GT_ALL);
+}
+GT_INLINE void gt_template_reduce_mmaps_by_distance__score(gt_template* const template,const uint64_t max_num_matches) {
+  GT_TEMPLATE_CHECK(template);
+  GT_TEMPLATE_IF_REDUCES_TO_ALINGMENT(template,alignment) {
+    gt_alignment_reduce_maps_by_distance__score(alignment,max_num_matches);
+  } GT_TEMPLATE_END_REDUCTION__RETURN;
+  gt_template_select_by_distance__score(template,max_num_matches);
+}
+GT_INLINE void gt_template_reduce_mmaps_by_distance__score_no_split(gt_template* const template,const uint64_t max_num_matches) {
+  GT_TEMPLATE_CHECK(template);
+  GT_TEMPLATE_IF_REDUCES_TO_ALINGMENT(template,alignment) {
+    gt_alignment_reduce_maps_by_distance__score_no_split(alignment,max_num_matches);
+  } GT_TEMPLATE_END_REDUCTION__RETURN;
+  gt_template_select_by_distance__score(template,max_num_matches);
 }
 /*
  * Template's MMaps Utils
@@ -0,0 +1,63 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_contig_dictionary.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+START_TEST(gt_test_contig_dictionary_intern)
+{
+  // Names are interned once (IDs are stable and dense)
+  const uint32_t chr1 = gt_contig_dictionary_get_id("chr1\tACGT",4);
+  const uint32_t chr2 = gt_contig_dictionary_get_id("chr2",4);
+  fail_unless(chr1!=GT_CONTIG_NULL && chr2!=GT_CONTIG_NULL && chr1!=chr2,"Failed interning names");
+  fail_unless(gt_contig_dictionary_get_id("chr1",4)==chr1,"Failed looking up interned name");
+  fail_unless(gt_contig_dictionary_get_id("chr10",4)==chr1,"Failed looking up name prefix");
+  fail_unless(gt_contig_dictionary_get_id("",0)==GT_CONTIG_NULL,"Failed looking up empty name");
+  fail_unless(gt_strcmp(gt_string_get_string(gt_contig_dictionary_get_name(chr2)),"chr2")==0,"Failed retrieving name");
+  // Force the table to grow
+  char name[16];
+  uint64_t i;
+  for (i=0;i<5000;++i) {
+    sprintf(name,"contig_%"PRIu64,i);
+    gt_contig_dictionary_get_id(name,strlen(name));
+  }
+  fail_unless(gt_contig_dictionary_get_id("chr2",4)==chr2,"Failed looking up name after growing");
+  sprintf(name,"contig_%d",4321);
+  gt_string* const contig_name = gt_contig_dictionary_get_name(gt_contig_dictionary_get_id(name,strlen(name)));
+  fail_unless(gt_strcmp(gt_string_get_string(contig_name),name)==0,"Failed retrieving name after growing");
+}
+END_TEST
+
+START_TEST(gt_test_contig_dictionary_map)
+{
+  gt_map* const map_a = gt_map_new();
+  gt_map* const map_b = gt_map_new();
+  fail_unless(gt_map_get_seq_id(map_a)==GT_CONTIG_NULL && gt_map_get_seq_name_length(map_a)==0,"Failed empty seq_name");
+  gt_map_set_seq_name(map_a,"chrX:+:100",4);
+  gt_map_set_seq_name(map_b,"chrX",4);
+  fail_unless(gt_map_get_seq_id(map_a)==gt_map_get_seq_id(map_b),"Failed sharing contig ID");
+  fail_unless(gt_map_get_string_seq_name(map_a)==gt_map_get_string_seq_name(map_b),"Failed sharing interned name");
+  gt_map* const map_copy = gt_map_copy(map_a);
+  fail_unless(gt_map_get_seq_id(map_copy)==gt_map_get_seq_id(map_a),"Failed copying contig ID");
+  gt_map_clear(map_b);
+  fail_unless(gt_map_get_seq_id(map_b)==GT_CONTIG_NULL,"Failed clearing contig ID");
+  gt_map_delete(map_a);
+  gt_map_delete(map_b);
+  gt_map_delete(map_copy);
+}
+END_TEST
+
+Suite *gt_contig_dictionary_suite(void) {
+  Suite *s = suite_create("gt_contig_dictionary");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create("contig dictionary");
+  tcase_add_test(tc_core,gt_test_contig_dictionary_intern);
+  tcase_add_test(tc_core,gt_test_contig_dictionary_map);
+  suite_add_tcase(s,tc_core);
+
+  return s;
+}
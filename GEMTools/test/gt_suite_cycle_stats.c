@@ -0,0 +1,99 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_cycle_stats.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+#define GT_CYCLE_TEST_LENGTH 75  /* Several vector chunks plus a scalar tail */
+#define GT_CYCLE_TEST_QUALS  41
+#define GT_CYCLE_TEST_READS  600 /* Forces a few automatic flushes */
+
+START_TEST(gt_test_cycle_stats_read)
+{
+  const char* const read = "ACGTNacgtnACGTACGTACGTACGTACGTACGTACGTACGTAAAAACCCCCGGGGGTTTTTNNNNN.-XACGT";
+  const uint64_t length = strlen(read);
+  uint64_t nt_counting[5] = {0,0,0,0,0}, expected[5] = {0,0,0,0,0}, i;
+  for (i=0;i<length;++i) {
+    switch (read[i]) {
+      case 'A': case 'a': ++expected[0]; break;
+      case 'C': case 'c': ++expected[1]; break;
+      case 'G': case 'g': ++expected[2]; break;
+      case 'T': case 't': ++expected[3]; break;
+      default: ++expected[4]; break;
+    }
+  }
+  gt_cycle_stats_count_bases(read,length,nt_counting);
+  for (i=0;i<5;++i) fail_unless(nt_counting[i]==expected[i],"Failed counting bases");
+  // Qualities
+  uint64_t sum = 0;
+  for (i=0;i<length;++i) sum += (uint8_t)read[i];
+  fail_unless(gt_cycle_stats_sum_qualities(read,length)==sum,"Failed adding qualities");
+  fail_unless(gt_cycle_stats_sum_qualities(read,3)==('A'+'C'+'G'),"Failed adding qualities (short)");
+}
+END_TEST
+
+void gt_cycle_test_histogram(const bool binned) {
+  const char bases[] = "NACGT";
+  const uint64_t row_length = GT_CYCLE_TEST_QUALS*GT_CYCLE_NUM_BASES;
+  uint64_t** const histogram = gt_calloc(GT_CYCLE_TEST_LENGTH,uint64_t*,true);
+  uint64_t** const expected = gt_calloc(GT_CYCLE_TEST_LENGTH,uint64_t*,true);
+  uint64_t i, j;
+  for (i=0;i<GT_CYCLE_TEST_LENGTH;++i) {
+    histogram[i] = gt_calloc(row_length,uint64_t,true);
+    expected[i] = gt_calloc(row_length,uint64_t,true);
+  }
+  // Count reads of varying length into both histograms
+  gt_cycle_histogram* const cycle_histogram = gt_cycle_histogram_new(33,GT_CYCLE_TEST_QUALS-1);
+  char read[GT_CYCLE_TEST_LENGTH], qualities[GT_CYCLE_TEST_LENGTH];
+  uint64_t seed = 1;
+  for (i=0;i<GT_CYCLE_TEST_READS;++i) {
+    const uint64_t length = GT_CYCLE_TEST_LENGTH - (i%7);
+    for (j=0;j<length;++j) {
+      seed = seed*6364136223846793005ull+1442695040888963407ull;
+      const uint64_t base = (seed>>33)%GT_CYCLE_NUM_BASES;
+      const uint64_t qual = binned ? ((seed>>40)%4)*10+2 : (seed>>40)%GT_CYCLE_TEST_QUALS;
+      read[j] = bases[base];
+      qualities[j] = 33+qual;
+      ++expected[j][qual*GT_CYCLE_NUM_BASES+base];
+    }
+    fail_unless(gt_cycle_histogram_add(cycle_histogram,histogram,read,qualities,length),"Failed adding read");
+  }
+  gt_cycle_histogram_flush(cycle_histogram,histogram);
+  for (i=0;i<GT_CYCLE_TEST_LENGTH;++i) {
+    fail_unless(memcmp(histogram[i],expected[i],row_length*sizeof(uint64_t))==0,"Failed counting cycle");
+  }
+  // Illegal characters
+  read[0] = 'X';
+  fail_unless(!gt_cycle_histogram_add(cycle_histogram,histogram,read,qualities,GT_CYCLE_TEST_LENGTH),"Failed rejecting base");
+  read[0] = 'A'; qualities[GT_CYCLE_TEST_LENGTH-1] = 33+GT_CYCLE_TEST_QUALS;
+  fail_unless(!gt_cycle_histogram_add(cycle_histogram,histogram,read,qualities,GT_CYCLE_TEST_LENGTH),"Failed rejecting quality");
+  // Free
+  gt_cycle_histogram_delete(cycle_histogram);
+  for (i=0;i<GT_CYCLE_TEST_LENGTH;++i) {
+    gt_free(histogram[i]);
+    gt_free(expected[i]);
+  }
+  gt_free(histogram);
+  gt_free(expected);
+}
+START_TEST(gt_test_cycle_stats_histogram)
+{
+  gt_cycle_test_histogram(true);  // Fits the palette
+  gt_cycle_test_histogram(false); // Falls back to scalar counting
+}
+END_TEST
+
+Suite *gt_cycle_stats_suite(void) {
+  Suite *s = suite_create("gt_cycle_stats");
+
+  /* Cycle stats test case */
+  TCase *test_case = tcase_create("Cycle stats");
+  tcase_add_test(test_case,gt_test_cycle_stats_read);
+  tcase_add_test(test_case,gt_test_cycle_stats_histogram);
+  suite_add_tcase(s,test_case);
+
+  return s;
+}
@@ -152,6 +152,71 @@ START_TEST(gt_test_gtf_find_matches)
 }
 END_TEST
 
+START_TEST(gt_test_gtf_coverage)
+{
+  // Gene_A: single transcript (+) of 2x100 bases; Gene_B: two transcripts (-)
+  FILE* fp = tmpfile();
+  fputs("chr1\ttest\tgene\t1001\t1300\t.\t+\t.\tgene_id \"Gene_A\";\n"
+        "chr1\ttest\ttranscript\t1001\t1300\t.\t+\t.\tgene_id \"Gene_A\"; transcript_id \"A_1\";\n"
+        "chr1\ttest\texon\t1001\t1100\t.\t+\t.\tgene_id \"Gene_A\"; transcript_id \"A_1\";\n"
+        "chr1\ttest\texon\t1201\t1300\t.\t+\t.\tgene_id \"Gene_A\"; transcript_id \"A_1\";\n"
+        "chr1\ttest\tgene\t5001\t5600\t.\t-\t.\tgene_id \"Gene_B\";\n"
+        "chr1\ttest\ttranscript\t5001\t5600\t.\t-\t.\tgene_id \"Gene_B\"; transcript_id \"B_1\";\n"
+        "chr1\ttest\texon\t5001\t5600\t.\t-\t.\tgene_id \"Gene_B\"; transcript_id \"B_1\";\n"
+        "chr1\ttest\ttranscript\t5001\t5400\t.\t-\t.\tgene_id \"Gene_B\"; transcript_id \"B_2\";\n"
+        "chr1\ttest\texon\t5001\t5100\t.\t-\t.\tgene_id \"Gene_B\"; transcript_id \"B_2\";\n"
+        "chr1\ttest\texon\t5301\t5400\t.\t-\t.\tgene_id \"Gene_B\"; transcript_id \"B_2\";\n",fp);
+  rewind(fp);
+  gt_gtf* gtf = gt_gtf_read_from_stream(fp, 1);
+  gt_gtf_build_coverage_tables(gtf);
+  // Tables (exons sorted by start)
+  gt_gtf_coverage_table* table = gt_shash_get(gtf->gene_coverage, "Gene_B", gt_gtf_coverage_table);
+  fail_unless(table != NULL && gt_vector_get_used(table->exons) == 3, "Failed building gene table");
+  gt_gtf_coverage_exon* exons = gt_vector_get_mem(table->exons, gt_gtf_coverage_exon);
+  uint64_t* max_ends = gt_vector_get_mem(table->max_ends, uint64_t);
+  fail_unless(exons[0].start == 5001 && exons[2].start == 5301, "Failed sorting gene table");
+  fail_unless(max_ends[1] == 5600 && max_ends[2] == 5600, "Failed max ends");
+  fail_unless(!exons[0].single_transcript, "Failed single transcript flag");
+  table = gt_shash_get(gtf->gene_coverage, "Gene_A", gt_gtf_coverage_table);
+  exons = gt_vector_get_mem(table->exons, gt_gtf_coverage_exon);
+  fail_unless(exons[1].transcript_length == 200 && exons[1].transcript_start_bucket == 49, "Failed exon offset");
+  // Count the first half of the first exon of Gene_A
+  gt_map* map = NULL;
+  fail_unless(gt_input_map_parse_map("chr1:+:1001:50",&map,NULL)==0,"Failed parsing map");
+  gt_gtf_count_parms* params = gt_gtf_count_params_new(true);
+  params->num_maps = 1;
+  gt_shash* gene_counts = gt_shash_new();
+  gt_gtf_count_map(gtf, map, NULL, NULL, gene_counts, NULL, params);
+  uint64_t i;
+  for(i=0; i<GT_GTF_COVERAGE_BUCKETS; i++){
+    const uint64_t expected = (i <= 24) ? 1 : 0;
+    fail_unless(params->gene_body_coverage[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_ALL, i)] == expected, "Failed gene body coverage");
+    fail_unless(params->gene_body_coverage[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_250, i)] == expected, "Failed length range coverage");
+    fail_unless(params->single_transcript_coverage[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_ALL, i)] == expected, "Failed single transcript coverage");
+  }
+  gt_shash_delete(gene_counts, true);
+  gt_gtf_count_params_delete(params);
+  gt_map_delete(map);
+  // Pair across chromosomes (the end on chr2 overlaps Gene_A coordinates but not its contig)
+  gt_map* map2 = NULL;
+  fail_unless(gt_input_map_parse_map("chr1:+:1010:50",&map,NULL)==0,"Failed parsing map");
+  fail_unless(gt_input_map_parse_map("chr2:-:1210:50",&map2,NULL)==0,"Failed parsing map");
+  params = gt_gtf_count_params_new(true);
+  params->num_maps = 1;
+  gene_counts = gt_shash_new();
+  gt_gtf_count_map(gtf, map, map2, NULL, gene_counts, NULL, params);
+  for(i=0; i<GT_GTF_COVERAGE_BUCKETS; i++){
+    const uint64_t expected = (i >= 4 && i <= 28) ? 1 : 0;
+    fail_unless(params->gene_body_coverage[GT_GTF_COVERGAGE_GET_BUCKET(GT_GTF_COVERAGE_LENGTH_ALL, i)] == expected, "Failed cross-chromosome coverage");
+  }
+  gt_shash_delete(gene_counts, true);
+  gt_gtf_count_params_delete(params);
+  gt_map_delete(map);
+  gt_map_delete(map2);
+  fclose(fp);
+}
+END_TEST
+
 Suite *gt_gtf_suite(void) {
   Suite *s = suite_create("gt_gtf");
 
@@ -162,6 +227,7 @@ Suite *gt_gtf_suite(void) {
   tcase_add_test(tc_core,gt_test_gtf_read);
   tcase_add_test(tc_core,gt_test_gtf_search);
   tcase_add_test(tc_core,gt_test_gtf_find_matches);
+  tcase_add_test(tc_core,gt_test_gtf_coverage);
   suite_add_tcase(s,tc_core);
 
   return s;
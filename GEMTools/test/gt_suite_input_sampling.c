@@ -0,0 +1,136 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_input_sampling.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+#define GT_SAMPLING_TEST_MAP   'M'
+#define GT_SAMPLING_TEST_SAM   'S'
+#define GT_SAMPLING_TEST_FASTQ 'Q'
+
+/*
+ * Record @id (its read length varies, so seeks land anywhere in the lines)
+ */
+uint64_t gt_sampling_test_sprint_record(
+    char* const buffer,const char format,const uint64_t id,const uint64_t read_length) {
+  const uint64_t length = read_length + id%7;
+  char* const read = gt_malloc(length+1);
+  char* const qualities = gt_malloc(length+1);
+  uint64_t i;
+  for (i=0;i<length;++i) {
+    read[i] = "ACGT"[(id+i)%4];
+    qualities[i] = '5'+(id+i)%10;
+  }
+  read[length] = '\0';
+  qualities[length] = '\0';
+  int printed = 0;
+  switch (format) {
+    case GT_SAMPLING_TEST_MAP:
+      printed = sprintf(buffer,"r%"PRIu64"\t%s\t%s\t1\tchr1:+:%"PRIu64":%"PRIu64"\n",id,read,qualities,id+1,length);
+      break;
+    case GT_SAMPLING_TEST_SAM:
+      printed = sprintf(buffer,"r%"PRIu64"\t0\tchr1\t%"PRIu64"\t255\t%"PRIu64"M\t*\t0\t0\t%s\t%s\n",id,id+1,length,read,qualities);
+      break;
+    case GT_SAMPLING_TEST_FASTQ:
+      printed = sprintf(buffer,"@r%"PRIu64"\n%s\n+\n%s\n",id,read,qualities);
+      break;
+  }
+  gt_free(read);
+  gt_free(qualities);
+  return printed;
+}
+void gt_sampling_test_write(
+    char* const file_name,const char format,const uint64_t num_records,const uint64_t read_length) {
+  const int fd = mkstemp(file_name);
+  fail_unless(fd!=-1,"Failed creating temporal file");
+  FILE* const stream = fdopen(fd,"w");
+  if (format==GT_SAMPLING_TEST_SAM) fprintf(stream,"@HD\tVN:1.0\tSO:unsorted\n@SQ\tSN:chr1\tLN:100000000\n");
+  char* const buffer = gt_malloc(2*read_length+128);
+  uint64_t i;
+  for (i=0;i<num_records;++i) {
+    fwrite(buffer,1,gt_sampling_test_sprint_record(buffer,format,i,read_length),stream);
+  }
+  gt_free(buffer);
+  fclose(stream);
+}
+/*
+ * Samples @num_samples records and checks that each of them is a whole record of the file
+ */
+void gt_sampling_test_check(
+    char* const file_name,const char format,const uint64_t read_length,
+    const bool mmap_file,const uint64_t num_samples) {
+  gt_input_file* const input_file = gt_input_file_open(file_name,mmap_file);
+  gt_input_file_set_sampling(input_file,num_samples);
+  fail_unless(gt_input_file_is_sampling(input_file),"Failed setting sampling");
+  // Read all the sampled lines
+  gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+  gt_vector* const lines = gt_vector_new(GT_BUFFER_SIZE_1M,sizeof(char));
+  while (gt_buffered_input_file_get_block(buffered_input,0)>0) {
+    const uint64_t block_size = gt_vector_get_used(buffered_input->block_buffer);
+    gt_vector_reserve_additional(lines,block_size);
+    memcpy(gt_vector_get_mem(lines,char)+gt_vector_get_used(lines),
+        gt_vector_get_mem(buffered_input->block_buffer,char),block_size);
+    gt_vector_add_used(lines,block_size);
+  }
+  gt_buffered_input_file_close(buffered_input);
+  gt_input_file_close(input_file);
+  // Check the records (in file order)
+  char* const expected = gt_malloc(2*read_length+128);
+  const char* record = gt_vector_get_mem(lines,char);
+  const char* const end = record+gt_vector_get_used(lines);
+  uint64_t num_records = 0, last_id = 0;
+  while (record<end) {
+    const char* const tag = (format==GT_SAMPLING_TEST_FASTQ) ? record+2 : record+1;
+    fail_unless(*record==((format==GT_SAMPLING_TEST_FASTQ) ? '@' : 'r'),"Failed synchronizing to a record");
+    const uint64_t id = strtoull(tag,NULL,10);
+    fail_unless(num_records>0 || id==0,"Failed sampling from the first record (after the headers)");
+    fail_unless(num_records==0 || id>last_id,"Failed sampling in file order");
+    const uint64_t length = gt_sampling_test_sprint_record(expected,format,id,read_length);
+    fail_unless(record+length<=end && strncmp(record,expected,length)==0,"Failed reading a whole record");
+    record += length;
+    last_id = id;
+    ++num_records;
+  }
+  fail_unless(num_records==num_samples,"Failed sampling the number of records");
+  gt_free(expected);
+  gt_vector_delete(lines);
+}
+void gt_sampling_test(const char format,const uint64_t num_records,const uint64_t read_length,const uint64_t num_samples) {
+  char file_name[] = "/tmp/gt_sampling_test_XXXXXX";
+  gt_sampling_test_write(file_name,format,num_records,read_length);
+  gt_sampling_test_check(file_name,format,read_length,false,num_samples);
+  gt_sampling_test_check(file_name,format,read_length,true,num_samples);
+  unlink(file_name);
+}
+
+START_TEST(gt_test_input_sampling_formats)
+{
+  gt_sampling_test(GT_SAMPLING_TEST_MAP,30000,50,5000);
+  gt_sampling_test(GT_SAMPLING_TEST_FASTQ,30000,50,5000);
+  gt_sampling_test(GT_SAMPLING_TEST_SAM,30000,50,5000); // With headers
+  gt_sampling_test(GT_SAMPLING_TEST_MAP,30000,50,300);  // Single chunk
+}
+END_TEST
+
+START_TEST(gt_test_input_sampling_read_ahead)
+{
+  // Larger than an input buffer, so the read-ahead thread is still reading when sampling starts
+  gt_sampling_test(GT_SAMPLING_TEST_MAP,25000,1500,5000);
+}
+END_TEST
+
+Suite *gt_input_sampling_suite(void) {
+  Suite *s = suite_create("gt_input_sampling");
+
+  /* Sampling test case */
+  TCase *test_case = tcase_create("Input sampling");
+  tcase_set_timeout(test_case,60);
+  tcase_add_test(test_case,gt_test_input_sampling_formats);
+  tcase_add_test(test_case,gt_test_input_sampling_read_ahead);
+  suite_add_tcase(s,test_case);
+
+  return s;
+}
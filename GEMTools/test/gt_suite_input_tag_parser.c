@@ -352,6 +352,39 @@ START_TEST(gt_test_tag_parsing_generic_parser_single_paired_casava_additional)
 END_TEST
 
 
+START_TEST(gt_test_tag_parsing_generic_parser_paired_files)
+{
+	gt_input_file* input_end1 = gt_input_file_open("testdata/paired_end1.fastq", false);
+	gt_input_file* input_end2 = gt_input_file_open("testdata/paired_end2.fastq", false);
+	gt_buffered_input_file* buffered_input_end1 = gt_buffered_input_file_new(input_end1);
+	gt_buffered_input_file* buffered_input_end2 = gt_buffered_input_file_new(input_end2);
+	gt_generic_parser_attributes* attr = gt_input_generic_parser_attributes_new(false);
+	pthread_mutex_t input_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+	// check first template, both ends from separate files
+	fail_unless(gt_input_generic_parser_get_paired_template(buffered_input_end1, buffered_input_end2, &input_mutex, template, attr) == GT_STATUS_OK, "Failed to read input");
+	fail_unless(gt_template_get_num_blocks(template) == 2, "Template is not paired");
+	gt_string_set_string(tag, "read1");
+	fail_unless(gt_string_cmp(template->tag, tag) == 0, "Tag is not read1");
+	gt_output_fasta_sprint_template(expected, template, fastq_attributes);
+	gt_string_set_string(tag, "@read1/1\nACGT\n+\n####\n@read1/2\nGGCA\n+\n$$$$\n");
+	fail_unless(gt_string_cmp(tag, expected) == 0, "Not the right output: '%s'\n", gt_string_get_string(expected));
+
+	// check second template and end of files
+	fail_unless(gt_input_generic_parser_get_paired_template(buffered_input_end1, buffered_input_end2, &input_mutex, template, attr) == GT_STATUS_OK, "Failed to read input");
+	gt_string_set_string(tag, "CCAT");
+	fail_unless(gt_string_cmp(gt_template_get_block(template, 1)->read, tag) == 0, "End/2 read is not CCAT");
+	fail_unless(gt_input_generic_parser_get_paired_template(buffered_input_end1, buffered_input_end2, &input_mutex, template, attr) == GT_IGP_EOF, "Expected end of file");
+
+	gt_input_generic_parser_attributes_delete(attr);
+	gt_buffered_input_file_close(buffered_input_end1);
+	gt_buffered_input_file_close(buffered_input_end2);
+	gt_input_file_close(input_end1);
+	gt_input_file_close(input_end2);
+}
+END_TEST
+
+
 
 Suite *gt_input_tag_parser_suite(void) {
   Suite *s = suite_create("gt_input_parser");
@@ -370,6 +403,7 @@ Suite *gt_input_tag_parser_suite(void) {
   tcase_add_test(tc_tag_string_parser,gt_test_tag_parsing_generic_parser_single_paired_map_output_casava_additional_no_casava_no_extra);
   tcase_add_test(tc_tag_string_parser,gt_test_tag_parsing_generic_parser_single_paired_map_output_casava_additional_no_casava_no_extra_fastq);
   tcase_add_test(tc_tag_string_parser,gt_test_tag_parsing_generic_parser_single_paired_map_output_casava_additional_fasta);
+  tcase_add_test(tc_tag_string_parser,gt_test_tag_parsing_generic_parser_paired_files);
 
   suite_add_tcase(s,tc_tag_string_parser);
 
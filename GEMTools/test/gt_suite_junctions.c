@@ -0,0 +1,123 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_junctions.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+START_TEST(gt_test_junctions_table)
+{
+  gt_junction_table* const junction_table = gt_junction_table_new();
+  const uint32_t chr1 = gt_contig_dictionary_get_id("chr1",4);
+  const uint32_t chr2 = gt_contig_dictionary_get_id("chr2",4);
+  // Add & merge
+  gt_junction_table_add(junction_table,chr1,100,200,UNKNOWN,1);
+  gt_junction_table_add(junction_table,chr1,100,200,REVERSE,2);
+  gt_junction_table_add(junction_table,chr2,100,200,UNKNOWN,1);
+  fail_unless(gt_junction_table_get_num_junctions(junction_table)==2,"Failed merging junctions");
+  gt_junction* junction = gt_junction_table_get(junction_table,chr1,100,200);
+  fail_unless(junction!=NULL && junction->support==3,"Failed adding support");
+  fail_unless(junction->strand==REVERSE,"Failed merging strand");
+  fail_unless(gt_junction_table_get(junction_table,chr1,100,201)==NULL,"Failed missing junction");
+  // Grow
+  uint64_t i;
+  for (i=0;i<10000;++i) gt_junction_table_add(junction_table,chr1,i,i+1000,UNKNOWN,1);
+  for (i=0;i<10000;++i) gt_junction_table_add(junction_table,chr1,i,i+1000,UNKNOWN,1);
+  fail_unless(gt_junction_table_get_num_junctions(junction_table)==10002,"Failed growing table");
+  junction = gt_junction_table_get(junction_table,chr1,9999,10999);
+  fail_unless(junction!=NULL && junction->support==2,"Failed rehashing table");
+  gt_junction_table_clear(junction_table);
+  fail_unless(gt_junction_table_get_num_junctions(junction_table)==0,"Failed clearing table");
+  gt_junction_table_delete(junction_table);
+}
+END_TEST
+
+START_TEST(gt_test_junctions_set)
+{
+  gt_junction_set* const junction_set = gt_junction_set_new();
+  gt_junction_table* const junction_table = gt_junction_table_new();
+  const uint32_t chr1 = gt_contig_dictionary_get_id("chr1",4);
+  const uint32_t chr2 = gt_contig_dictionary_get_id("chr2",4);
+  gt_junction_table_add(junction_table,chr2,50,60,UNKNOWN,1);
+  gt_junction_table_add(junction_table,chr1,300,400,UNKNOWN,1);
+  gt_junction_table_add(junction_table,chr1,100,200,UNKNOWN,1);
+  gt_junction_set_flush_table(junction_set,junction_table);
+  fail_unless(gt_junction_table_get_num_junctions(junction_table)==0,"Failed clearing flushed table");
+  gt_junction_table_add(junction_table,chr1,100,200,UNKNOWN,4);
+  gt_junction_set_flush_table(junction_set,junction_table);
+  fail_unless(gt_junction_set_get_num_junctions(junction_set)==3,"Failed flushing table");
+  // Sorted junctions
+  gt_vector* const junctions = gt_vector_new(4,sizeof(gt_junction));
+  gt_junction_set_get_junctions(junction_set,junctions);
+  gt_junction* const junction = gt_vector_get_mem(junctions,gt_junction);
+  fail_unless(gt_vector_get_used(junctions)==3,"Failed getting junctions");
+  fail_unless(junction[0].seq_id==chr1 && junction[0].begin==100 && junction[0].support==5,"Failed sorting junctions");
+  fail_unless(junction[1].seq_id==chr1 && junction[1].begin==300,"Failed sorting junctions");
+  fail_unless(junction[2].seq_id==chr2,"Failed sorting junctions by contig");
+  gt_vector_delete(junctions);
+  gt_junction_table_delete(junction_table);
+  gt_junction_set_delete(junction_set);
+}
+END_TEST
+
+START_TEST(gt_test_junctions_map)
+{
+  gt_junction_table* const junction_table = gt_junction_table_new();
+  gt_map* map = NULL;
+  // 10 bases, 50 bases of intron, 10 bases
+  fail_unless(gt_input_map_parse_map("chr1:+:100:10>50*10",&map,NULL)==0,"Failed parsing split-map");
+  fail_unless(gt_junction_table_add_map(junction_table,map,4,2500000)==1,"Failed adding split-map");
+  const uint32_t chr1 = gt_contig_dictionary_get_id("chr1",4);
+  gt_junction* const junction = gt_junction_table_get(junction_table,chr1,109,160);
+  fail_unless(junction!=NULL && junction->support==1,"Failed junction coordinates");
+  // Blocks too short or introns too long are skipped
+  fail_unless(gt_junction_table_add_map(junction_table,map,11,2500000)==0,"Failed min block length");
+  fail_unless(gt_junction_table_add_map(junction_table,map,4,49)==0,"Failed max intron length");
+  gt_map_delete(map);
+  // Reverse strand with trims (SAM CIGAR 20I24M177N27M5I)
+  map = NULL;
+  fail_unless(gt_input_map_parse_map("chr1:-:17032:(5)27>177*24(20)",&map,NULL)==0,"Failed parsing trimmed split-map");
+  fail_unless(gt_junction_table_add_map(junction_table,map,4,2500000)==1,"Failed adding trimmed split-map");
+  fail_unless(gt_junction_table_get(junction_table,chr1,17055,17233)!=NULL,"Failed trimmed junction coordinates");
+  gt_map_delete(map);
+  gt_junction_table_delete(junction_table);
+}
+END_TEST
+
+START_TEST(gt_test_junctions_parse)
+{
+  gt_junction junction;
+  FILE* const stream = tmpfile();
+  char buffer[128];
+  // Forward
+  fail_unless(gt_junction_parse("chr1\t+\t100\tchr1\t+\t200\t7\n",&junction)==GT_STATUS_OK,"Failed parsing junction");
+  fail_unless(junction.strand==FORWARD && junction.begin==100 && junction.end==200 && junction.support==7,"Failed parsing junction fields");
+  // Reverse (donor first)
+  fail_unless(gt_junction_parse("chr1\t-\t200\tchr1\t-\t100",&junction)==GT_STATUS_OK,"Failed parsing reverse junction");
+  fail_unless(junction.strand==REVERSE && junction.begin==100 && junction.end==200 && junction.support==1,"Failed parsing reverse junction fields");
+  junction.annotation = GT_JUNCTION_NOVEL;
+  gt_junction_fprint(stream,&junction,true);
+  rewind(stream);
+  fail_unless(fgets(buffer,128,stream)!=NULL && strcmp(buffer,"chr1\t-\t200\tchr1\t-\t100\t1\tnovel\n")==0,"Failed printing junction");
+  // Malformed
+  fail_unless(gt_junction_parse("chr1\t+\t100\tchr2\t+\t200",&junction)==GT_STATUS_FAIL,"Failed rejecting inter-contig junction");
+  fail_unless(gt_junction_parse("chr1\t+\t100",&junction)==GT_STATUS_FAIL,"Failed rejecting truncated junction");
+  fclose(stream);
+}
+END_TEST
+
+Suite *gt_junctions_suite(void) {
+  Suite *s = suite_create("gt_junctions");
+
+  /* Junctions test case */
+  TCase *test_case = tcase_create("Junctions");
+  tcase_add_test(test_case,gt_test_junctions_table);
+  tcase_add_test(test_case,gt_test_junctions_set);
+  tcase_add_test(test_case,gt_test_junctions_map);
+  tcase_add_test(test_case,gt_test_junctions_parse);
+  suite_add_tcase(s,test_case);
+
+  return s;
+}
@@ -0,0 +1,67 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_numa.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+void* gt_test_numa_loader(void* const loader_arg) {
+  uint64_t* const num_calls = (uint64_t*) loader_arg;
+  __sync_fetch_and_add(num_calls,1);
+  return (void*)(gt_numa_get_thread_node()+1);
+}
+
+START_TEST(gt_test_numa_cpulist)
+{
+  cpu_set_t cpu_set;
+  fail_unless(gt_numa_parse_cpulist("0-3,8-11,16\n",&cpu_set)==9,"Failed parsing cpulist");
+  fail_unless(CPU_ISSET(0,&cpu_set) && CPU_ISSET(3,&cpu_set) && !CPU_ISSET(4,&cpu_set),"Failed parsing CPU range");
+  fail_unless(CPU_ISSET(11,&cpu_set) && CPU_ISSET(16,&cpu_set) && !CPU_ISSET(12,&cpu_set),"Failed parsing CPU list");
+  fail_unless(gt_numa_parse_cpulist("5",&cpu_set)==1 && CPU_ISSET(5,&cpu_set),"Failed parsing single CPU");
+  fail_unless(gt_numa_parse_cpulist("\n",&cpu_set)==0,"Failed parsing empty cpulist");
+}
+END_TEST
+
+START_TEST(gt_test_numa_replicate)
+{
+  // Disabled (single replica)
+  uint64_t num_calls = 0;
+  void** replicas = gt_numa_replicate(gt_test_numa_loader,&num_calls);
+  fail_unless(num_calls==1 && replicas[0]==(void*)1,"Failed single replica");
+  fail_unless(gt_numa_get_replica(replicas)==replicas[0],"Failed getting replica");
+  gt_free(replicas);
+  // Enabled (one replica per node, loaded from the node)
+  gt_numa_enable();
+  const uint64_t num_nodes = gt_numa_get_num_nodes();
+  fail_unless(num_nodes>=1,"Failed reading topology");
+  num_calls = 0;
+  replicas = gt_numa_replicate(gt_test_numa_loader,&num_calls);
+  fail_unless(num_calls==num_nodes,"Failed replicating");
+  uint64_t node;
+  for (node=0;node<num_nodes;++node) {
+    fail_unless(replicas[node]==(void*)(node+1),"Failed loading replica on its node");
+  }
+  // Threads are spread in contiguous ranges
+  gt_numa_bind_thread(0,4);
+  fail_unless(gt_numa_get_thread_node()==0,"Failed binding first thread");
+  gt_numa_bind_thread(3,4);
+  fail_unless(gt_numa_get_thread_node()==(3*num_nodes)/4,"Failed binding last thread");
+  fail_unless(gt_numa_get_replica(replicas)==replicas[(3*num_nodes)/4],"Failed getting node replica");
+  gt_numa_bind_thread_to_node(0);
+  gt_free(replicas);
+}
+END_TEST
+
+Suite *gt_numa_suite(void) {
+  Suite *s = suite_create("gt_numa");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create("numa");
+  tcase_add_test(tc_core,gt_test_numa_cpulist);
+  tcase_add_test(tc_core,gt_test_numa_replicate);
+  suite_add_tcase(s,tc_core);
+
+  return s;
+}
@@ -0,0 +1,110 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_profiler.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+GT_INLINE void gt_test_profiler_stages_parse(void) {
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
+  GT_STAGE_PROF_BEGIN(GT_STAGE_FORMAT);
+  GT_STAGE_PROF_END(GT_STAGE_FORMAT);
+}
+
+START_TEST(gt_test_profiler_stages)
+{
+  double stage_time[GT_STAGE_NUM_STAGES];
+  uint64_t stage_calls[GT_STAGE_NUM_STAGES];
+  // Disabled (nothing is accounted)
+  gt_test_profiler_stages_parse();
+  fail_unless(gt_profiler_stages_get_num_threads()==0,"Failed disabled profiler");
+  // Enabled
+  gt_profiler_stages_enable();
+  uint64_t i;
+  for (i=0;i<10;++i) gt_test_profiler_stages_parse();
+  GT_STAGE_PROF_BEGIN(GT_STAGE_OUTPUT_WAIT);
+  struct timespec delay = { .tv_sec=0, .tv_nsec=2000000 };
+  nanosleep(&delay,NULL);
+  GT_STAGE_PROF_END(GT_STAGE_OUTPUT_WAIT);
+  fail_unless(gt_profiler_stages_get_num_threads()==1,"Failed registering thread");
+  gt_profiler_stages_get_times(UINT64_MAX,stage_time,stage_calls);
+  fail_unless(stage_calls[GT_STAGE_PARSE]==10 && stage_calls[GT_STAGE_FORMAT]==10,"Failed counting nested stages");
+  fail_unless(stage_calls[GT_STAGE_OUTPUT_WAIT]==1 && stage_calls[GT_STAGE_INPUT_WAIT]==0,"Failed counting stages");
+  fail_unless(stage_time[GT_STAGE_OUTPUT_WAIT]>=0.001,"Failed timing stage");
+  // Stages are exclusive (they add up to the elapsed time)
+  double total_time = 0.0;
+  for (i=0;i<GT_STAGE_NUM_STAGES;++i) total_time += stage_time[i];
+  fail_unless(total_time<=gt_profiler_stages_get_wall_time(),"Failed exclusive stage times");
+  gt_profiler_stages_destroy();
+  fail_unless(!gt_profiler_stages_enabled && gt_profiler_stages_get_num_threads()==0,"Failed destroying profiler");
+}
+END_TEST
+
+pthread_barrier_t gt_test_profiler_barrier;
+void* gt_test_profiler_stages_thread(void* const arg) {
+  gt_test_profiler_stages_parse();
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  pthread_barrier_wait(&gt_test_profiler_barrier); // Profiler destroyed & enabled again
+  gt_test_profiler_stages_parse();
+  return NULL;
+}
+void* gt_test_profiler_stages_scope_thread(void* const arg) {
+  GT_STAGE_PROF_SCOPE(GT_STAGE_PARSE);
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  pthread_barrier_wait(&gt_test_profiler_barrier); // Profiler destroyed
+  GT_STAGE_PROF_BEGIN(GT_STAGE_FORMAT);
+  GT_STAGE_PROF_END(GT_STAGE_FORMAT);
+  return NULL; // Ends the scope
+}
+START_TEST(gt_test_profiler_stages_restart)
+{
+  double stage_time[GT_STAGE_NUM_STAGES];
+  uint64_t stage_calls[GT_STAGE_NUM_STAGES];
+  pthread_t thread;
+  pthread_barrier_init(&gt_test_profiler_barrier,NULL,2);
+  gt_profiler_stages_enable();
+  pthread_create(&thread,NULL,gt_test_profiler_stages_thread,NULL);
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  fail_unless(gt_profiler_stages_get_num_threads()==2,"Failed registering threads");
+  gt_profiler_stages_destroy();
+  gt_profiler_stages_enable();
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  pthread_join(thread,NULL);
+  // The thread registers a new profile (instead of using the freed one)
+  fail_unless(gt_profiler_stages_get_num_threads()==2,"Failed registering threads again");
+  gt_profiler_stages_get_times(UINT64_MAX,stage_time,stage_calls);
+  fail_unless(stage_calls[GT_STAGE_PARSE]==1,"Failed resetting the profiles");
+  gt_profiler_stages_destroy();
+  pthread_barrier_destroy(&gt_test_profiler_barrier);
+}
+END_TEST
+START_TEST(gt_test_profiler_stages_destroy_in_scope)
+{
+  pthread_t thread;
+  pthread_barrier_init(&gt_test_profiler_barrier,NULL,2);
+  gt_profiler_stages_enable();
+  pthread_create(&thread,NULL,gt_test_profiler_stages_scope_thread,NULL);
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  gt_profiler_stages_destroy();
+  pthread_barrier_wait(&gt_test_profiler_barrier);
+  pthread_join(thread,NULL);
+  // The thread ends its stage without profiling (nor registering again)
+  fail_unless(gt_profiler_stages_get_num_threads()==0,"Failed ending a stage after destroy");
+  pthread_barrier_destroy(&gt_test_profiler_barrier);
+}
+END_TEST
+
+Suite *gt_profiler_suite(void) {
+  Suite *s = suite_create("gt_profiler");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create("stage profiler");
+  tcase_add_test(tc_core,gt_test_profiler_stages);
+  tcase_add_test(tc_core,gt_test_profiler_stages_restart);
+  tcase_add_test(tc_core,gt_test_profiler_stages_destroy_in_scope);
+  suite_add_tcase(s,tc_core);
+
+  return s;
+}
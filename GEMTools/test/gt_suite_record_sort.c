@@ -0,0 +1,94 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_record_sort.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+#define GT_RECORD_SORT_TEST_RECORDS 40000 /* ~2MB, spills a few runs per thread */
+#define GT_RECORD_SORT_TEST_MANY_RECORDS 300000 /* ~17MB, spills enough runs for intermediate merges */
+#define GT_RECORD_SORT_TEST_TAGS    5000
+
+START_TEST(gt_test_record_sort_key)
+{
+  fail_unless(gt_record_sort_get_key_length("read1/1\tACGT\n",13)==5,"Failed removing pair suffix");
+  fail_unless(gt_record_sort_get_key_length("read1/3\tACGT\n",13)==7,"Failed keeping suffix");
+  fail_unless(gt_record_sort_get_key_length("read1 comment\tACGT\n",19)==5,"Failed cutting key at SPACE");
+  fail_unless(gt_record_sort_get_key_length("/1\n",3)==2,"Failed short key");
+  fail_unless(gt_record_sort_cmp_keys("read1",5,"read10",6)<0,"Failed comparing prefix");
+  fail_unless(gt_record_sort_cmp_keys("read2",5,"read10",6)>0,"Failed comparing keys");
+  fail_unless(gt_record_sort_cmp_keys("read2",5,"read2",5)==0,"Failed comparing equal keys");
+}
+END_TEST
+
+void gt_record_sort_test_file(const uint64_t num_records,const uint64_t num_threads) {
+  char input_name[] = "/tmp/gt_record_sort_test_in_XXXXXX";
+  char output_name[] = "/tmp/gt_record_sort_test_out_XXXXXX";
+  const int input_fd = mkstemp(input_name), output_fd = mkstemp(output_name);
+  fail_unless(input_fd!=-1 && output_fd!=-1,"Failed creating temporal files");
+  close(output_fd);
+  // Records with repeated tags (the map position keeps the input order)
+  FILE* const input_stream = fdopen(input_fd,"w");
+  uint64_t i, seed = 1;
+  for (i=0;i<num_records;++i) {
+    seed = seed*6364136223846793005ull+1442695040888963407ull;
+    fprintf(input_stream,"read%"PRIu64"/%"PRIu64"\tACGTACGTAC\tIIIIIIIIII\t1\tchr1:+:%"PRIu64":10\n",
+        (seed>>33)%GT_RECORD_SORT_TEST_TAGS,i%2+1,i);
+  }
+  fclose(input_stream);
+  // Sort (with the smallest budget)
+  gt_input_file* const input_file = gt_input_file_open(input_name,false);
+  gt_output_file* const output_file = gt_output_file_new(output_name,SORTED_FILE);
+  fail_unless(gt_record_sort(input_file,output_file,0,num_threads)==num_records,"Failed counting records");
+  gt_input_file_close(input_file);
+  gt_output_file_close(output_file);
+  // Check
+  FILE* const output_stream = fopen(output_name,"r");
+  char line[128], last_key[128];
+  uint64_t last_key_length = 0, last_seq = 0, num_lines = 0, sum_seq = 0;
+  while (fgets(line,128,output_stream)!=NULL) {
+    const uint64_t key_length = gt_record_sort_get_key_length(line,strlen(line));
+    const uint64_t seq = strtoull(strrchr(line,'+')+2,NULL,10);
+    if (num_lines>0) {
+      const int cmp = gt_record_sort_cmp_keys(last_key,last_key_length,line,key_length);
+      fail_unless(cmp<0 || (cmp==0 && last_seq<seq),"Failed sorting records");
+    }
+    memcpy(last_key,line,key_length);
+    last_key_length = key_length;
+    last_seq = seq;
+    sum_seq += seq;
+    ++num_lines;
+  }
+  fclose(output_stream);
+  fail_unless(num_lines==num_records,"Failed writing records");
+  fail_unless(sum_seq==num_records*(num_records-1)/2,"Failed keeping records");
+  unlink(input_name);
+  unlink(output_name);
+}
+START_TEST(gt_test_record_sort_file)
+{
+  gt_record_sort_test_file(GT_RECORD_SORT_TEST_RECORDS,1);
+  gt_record_sort_test_file(GT_RECORD_SORT_TEST_RECORDS,3); // Parallel merge
+}
+END_TEST
+START_TEST(gt_test_record_sort_many_runs)
+{
+  gt_record_sort_test_file(GT_RECORD_SORT_TEST_MANY_RECORDS,1);
+  gt_record_sort_test_file(GT_RECORD_SORT_TEST_MANY_RECORDS,4); // Concurrent intermediate merges
+}
+END_TEST
+
+Suite *gt_record_sort_suite(void) {
+  Suite *s = suite_create("gt_record_sort");
+
+  /* Record sort test case */
+  TCase *test_case = tcase_create("Record sort");
+  tcase_add_test(test_case,gt_test_record_sort_key);
+  tcase_add_test(test_case,gt_test_record_sort_file);
+  tcase_add_test(test_case,gt_test_record_sort_many_runs);
+  suite_add_tcase(s,test_case);
+
+  return s;
+}
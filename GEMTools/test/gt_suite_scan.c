@@ -0,0 +1,59 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt_suite_scan.c
+ * DATE: 19/10/2026
+ * DESCRIPTION: // TODO
+ */
+
+#include "gt_test.h"
+
+// Long enough as to span several vector chunks (and the scalar tail)
+#define GT_SCAN_TEST_LINE "seq1\tACGT ACGT ACGT\tchr1:+:100:4,chr2:-:200:4\t0:1:2:3:4:5:6:7:8:9:10:11:12:13:14:15:16\n"
+
+START_TEST(gt_test_scan_eol)
+{
+  const char* const line = GT_SCAN_TEST_LINE;
+  const uint64_t length = strlen(line);
+  const char* const end = line+length;
+  fail_unless(gt_scan_eol(line,end)==end-1,"Failed scanning EOL");
+  fail_unless(gt_scan_eol(line,end-1)==end-1,"Failed scanning EOL (no EOL in range)");
+  const char* const dos_line = "ACGTACGTACGTACGTACGTACGTACGTACGTACGTACGT\r\n";
+  fail_unless(gt_scan_eol(dos_line,dos_line+strlen(dos_line))==dos_line+40,"Failed scanning DOS_EOL");
+  // Counting TABs up to the EOL
+  uint64_t num_tabs = 0;
+  fail_unless(gt_scan_eol_count(line,end,TAB,&num_tabs)==end-1,"Failed scanning EOL (counting)");
+  fail_unless(num_tabs==3,"Failed counting TABs");
+}
+END_TEST
+
+START_TEST(gt_test_scan_fields)
+{
+  const char* const line = GT_SCAN_TEST_LINE;
+  const char* const end = line+strlen(line);
+  // Bounded
+  fail_unless(gt_scan_chr3(line,end,TAB,EOL,DOS_EOL)==line+4,"Failed scanning TAB");
+  fail_unless(gt_scan_chr3(line+5,end,SPACE,TAB,EOL)==line+9,"Failed scanning SPACE");
+  fail_unless(gt_scan_chr3(line,end,'#','#','#')==end,"Failed scanning missing character");
+  fail_unless(gt_scan_count(line,end,COLON)==22,"Failed counting COLONs");
+  // Unbounded (from every alignment)
+  uint64_t i;
+  for (i=0;line+i<end;++i) {
+    const char* expected = line+i;
+    while (*expected!=COMA && *expected!=SPACE && *expected!=EOL && *expected!=EOS) ++expected;
+    fail_unless(gt_scan_until(line+i,COMA,SPACE)==expected,"Failed scanning until COMA/SPACE");
+  }
+  fail_unless(gt_scan_until("ACGT",TAB,SPACE)[0]==EOS,"Failed scanning until EOS");
+}
+END_TEST
+
+Suite *gt_scan_suite(void) {
+  Suite *s = suite_create("gt_scan");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create("vectorized character scanning");
+  tcase_add_test(tc_core,gt_test_scan_eol);
+  tcase_add_test(tc_core,gt_test_scan_fields);
+  suite_add_tcase(s,tc_core);
+
+  return s;
+}
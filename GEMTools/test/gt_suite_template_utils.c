@@ -257,6 +257,133 @@ START_TEST(gt_test_loosing_alignments)
 }
 END_TEST
 
+gt_map* gt_test_map_new(const char* const seq_name,const gt_strand strand,const uint64_t position) {
+  gt_map* const map = gt_map_new();
+  gt_map_set_seq_name(map,seq_name,strlen(seq_name));
+  gt_map_set_strand(map,strand);
+  gt_map_set_position(map,position);
+  gt_map_set_base_length(map,4);
+  return map;
+}
+
+START_TEST(gt_test_alignment_map_index)
+{
+  // Enough maps to switch to the hashed duplicates detection
+  const uint64_t num_maps = 4*GT_MAP_INDEX_THRESHOLD;
+  uint64_t i;
+  for (i=0;i<num_maps;++i) {
+    gt_alignment_insert_map(alignment,gt_test_map_new((i%2)?"chr1":"chr2",(i%3)?FORWARD:REVERSE,100+i),true);
+  }
+  fail_unless(gt_alignment_get_num_maps(alignment)==num_maps,"Failed adding maps");
+  // Duplicates are detected
+  for (i=0;i<num_maps;++i) {
+    gt_alignment_insert_map(alignment,gt_test_map_new((i%2)?"chr1":"chr2",(i%3)?FORWARD:REVERSE,100+i),true);
+  }
+  fail_unless(gt_alignment_get_num_maps(alignment)==num_maps,"Failed detecting duplicated maps");
+  gt_map* const other_strand = gt_test_map_new("chr1",REVERSE,101);
+  fail_unless(!gt_alignment_is_map_contained(alignment,other_strand),"Failed comparing strands");
+  gt_map_delete(other_strand);
+  // Reordering & removing maps
+  gt_alignment_sort_by_distance__score(alignment);
+  gt_map* const last_map = gt_alignment_get_map(alignment,num_maps-1);
+  fail_unless(gt_alignment_is_map_contained(alignment,last_map),"Failed finding map after sorting");
+  gt_map* const map = gt_map_copy(last_map);
+  gt_alignment_reduce_maps(alignment,num_maps-1);
+  fail_unless(!gt_alignment_is_map_contained(alignment,map),"Failed removing map from the index");
+  gt_alignment_insert_map(alignment,map,true);
+  fail_unless(gt_alignment_get_num_maps(alignment)==num_maps,"Failed adding map after reducing");
+}
+END_TEST
+
+START_TEST(gt_test_template_mmap_index)
+{
+  // Paired template with enough mmaps to switch to the hashed duplicates detection
+  gt_string* const template_string = gt_string_new(1024);
+  gt_sprintf_append(template_string,"ID\tACGT ACGT\t#### ####\t0:40\t");
+  uint64_t i;
+  for (i=0;i<40;++i) {
+    gt_sprintf_append(template_string,"%schr1:+:%"PRIu64":4::chr1:-:%"PRIu64":4",(i>0)?",":"",100+i,200+(i%4));
+  }
+  fail_unless(gt_input_map_parse_template(gt_string_get_string(template_string),source)==0);
+  fail_unless(gt_template_get_num_mmaps(source)==40);
+  GT_TEMPLATE_ITERATE_MMAP__ATTR_(source,mmap,mmap_attr) {
+    fail_unless(gt_template_is_mmap_contained(source,mmap),"Failed finding mmap");
+  }
+  // Duplicates are detected
+  gt_template* const template_dup = gt_template_dup(source,true,true);
+  gt_template_merge_template_mmaps(source,template_dup);
+  fail_unless(gt_template_get_num_mmaps(source)==40,"Failed detecting duplicated mmaps");
+  gt_template_delete(template_dup);
+  gt_string_delete(template_string);
+}
+END_TEST
+
+GT_INLINE void gt_test_template_check_reduce_by_distance__score(gt_template* const template) {
+  const uint64_t num_mmaps = gt_template_get_num_mmaps(template);
+  gt_string* const expected = gt_string_new(1024);
+  gt_string* const selected = gt_string_new(1024);
+  uint64_t num_kept;
+  for (num_kept=0;num_kept<=num_mmaps+1;++num_kept) {
+    // Full sort + reduce
+    gt_template* const template_sorted = gt_template_dup(template,true,true);
+    gt_template_sort_by_distance__score(template_sorted);
+    gt_template_reduce_mmaps(template_sorted,num_kept);
+    // Partial selection
+    gt_template* const template_selected = gt_template_dup(template,true,true);
+    gt_template_reduce_mmaps_by_distance__score(template_selected,num_kept);
+    fail_unless(gt_template_get_num_mmaps(template_selected)==GT_MIN(num_kept,num_mmaps),"Failed reducing mmaps");
+    gt_string_clear(expected); gt_string_clear(selected);
+    gt_output_map_sprint_template(expected,template_sorted,output_attributes);
+    gt_output_map_sprint_template(selected,template_selected,output_attributes);
+    fail_unless(gt_string_equals(expected,selected),"Failed selecting the best mmaps");
+    gt_template_delete(template_sorted);
+    gt_template_delete(template_selected);
+  }
+  gt_string_delete(expected);
+  gt_string_delete(selected);
+}
+START_TEST(gt_test_template_reduce_by_distance__score)
+{
+  static char* const mismatches[] = { "4", "A3", "AC2", "ACG1" };
+  gt_string* const template_string = gt_string_new(1024);
+  uint64_t i;
+  // Single-end (more maps than sort keys on the stack)
+  gt_sprintf_append(template_string,"ID\tACGT\t####\t50\t");
+  for (i=0;i<50;++i) {
+    gt_sprintf_append(template_string,"%schr1:+:%"PRIu64":%s",(i>0)?",":"",100+i,mismatches[(i*7)%4]);
+  }
+  fail_unless(gt_input_map_parse_template(gt_string_get_string(template_string),source)==0);
+  gt_test_template_check_reduce_by_distance__score(source);
+  // Sorted by distance, ties keep the input order
+  gt_template_sort_by_distance__score(source);
+  gt_map* previous_map = NULL;
+  GT_TEMPLATE_ITERATE_MMAP(source,mmap) {
+    if (previous_map!=NULL) {
+      const uint64_t previous_distance = gt_map_get_global_distance(previous_map);
+      fail_unless(previous_distance < gt_map_get_global_distance(mmap[0]) ||
+          (previous_distance==gt_map_get_global_distance(mmap[0]) &&
+           gt_map_get_position(previous_map) < gt_map_get_position(mmap[0])),"Failed sorting maps");
+    }
+    previous_map = mmap[0];
+  }
+  // Paired-end
+  gt_string_clear(template_string);
+  gt_sprintf_append(template_string,"ID\tACGT ACGT\t#### ####\t40\t");
+  for (i=0;i<40;++i) {
+    gt_sprintf_append(template_string,"%schr1:+:%"PRIu64":%s::chr1:-:%"PRIu64":%s",
+        (i>0)?",":"",100+i,mismatches[(i*3)%4],200+i,mismatches[(i*5)%4]);
+  }
+  fail_unless(gt_input_map_parse_template(gt_string_get_string(template_string),target)==0);
+  fail_unless(gt_template_get_num_mmaps(target)==40);
+  i = 0;
+  GT_TEMPLATE_ITERATE_MMAP__ATTR_(target,mmap_pe,mmap_attr) {
+    mmap_attr->gt_score = (i++)%3; // Ties broken by score
+  }
+  gt_test_template_check_reduce_by_distance__score(target);
+  gt_string_delete(template_string);
+}
+END_TEST
+
 Suite *gt_template_utils_suite(void) {
   Suite *s = suite_create("gt_template_utils");
 
@@ -270,6 +397,9 @@ Suite *gt_template_utils_suite(void) {
   tcase_add_test(test_case,gt_test_template_to_string);
   tcase_add_test(test_case,gt_test_template_copy);
   tcase_add_test(test_case,gt_test_loosing_alignments);
+  tcase_add_test(test_case,gt_test_alignment_map_index);
+  tcase_add_test(test_case,gt_test_template_mmap_index);
+  tcase_add_test(test_case,gt_test_template_reduce_by_distance__score);
   suite_add_tcase(s,test_case);
 
   return s;
@@ -9,11 +9,21 @@
 
 // Include Suites
 #include "gt_suite_ihash.c"
+#include "gt_suite_scan.c"
+#include "gt_suite_contig_dictionary.c"
+#include "gt_suite_profiler.c"
+#include "gt_suite_numa.c"
+#include "gt_suite_cycle_stats.c"
 //#include "gt_suite_shash.c"
 
 int main(void) {
   SRunner *sr = srunner_create(gt_ihash_suite());
   //srunner_add_suite(sr,gt_ihash_suite());
+  srunner_add_suite(sr,gt_scan_suite());
+  srunner_add_suite(sr,gt_contig_dictionary_suite());
+  srunner_add_suite(sr,gt_profiler_suite());
+  srunner_add_suite(sr,gt_numa_suite());
+  srunner_add_suite(sr,gt_cycle_stats_suite());
   
   // add logging to xml
   srunner_set_xml(sr, "reports/check-test-commons.xml");
@@ -9,10 +9,12 @@
 
 // Include Suites
 #include "gt_suite_gtf.c"
+#include "gt_suite_junctions.c"
 
 int main(void) {
   SRunner *sr = srunner_create(gt_gtf_suite());
   srunner_add_suite (sr, gt_gtf_suite());
+  srunner_add_suite (sr, gt_junctions_suite());
 
   // add logging to xml
   srunner_set_xml(sr, "reports/check-test-gtf.xml");
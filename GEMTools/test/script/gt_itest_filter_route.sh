@@ -0,0 +1,29 @@
+#!/bin/bash
+
+filter=../bin/gt.filter
+function check_tags(){
+    # Tags of the templates written into $1 (in order) must be $2
+    tags=$(cut -f1 $1 | tr '\n' ' ')
+    [ "$tags" == "$2" ] || { echo "Wrong templates in $3 ('$tags' instead of '$2')" >&2; exit 1; }
+}
+
+dir="$(mktemp -d -t gt_filter_route.XXXXXX)"
+printf "unique_chr1\tACGTACGTAC\tIIIIIIIIII\t1\tchr1:+:100:10\n" > $dir/in.map
+printf "unique_chr2\tACGTACGTAC\tIIIIIIIIII\t1\tchr2:+:100:10\n" >> $dir/in.map
+printf "multimap_chr2\tACGTACGTAC\tIIIIIIIIII\t2\tchr2:+:200:10,chr1:+:200:10\n" >> $dir/in.map
+printf "multimap_chr1\tACGTACGTAC\tIIIIIIIIII\t2\tchr1:+:300:10,chr2:+:300:10\n" >> $dir/in.map
+printf "unmapped\tACGTACGTAC\tIIIIIIIIII\t0\t-\n" >> $dir/in.map
+echo -n "Runing with:: routes unique,contig=chr2,mapped "
+$filter -i $dir/in.map -o $dir/rest.map --route unique,$dir/unique.map \
+    --route contig=chr2,$dir/chr2.map --route mapped,$dir/mapped.map || { echo "gt.filter failed" >&2; exit 1; }
+# Each class in its own file (the first matching route wins)
+check_tags $dir/unique.map "unique_chr1 unique_chr2 " "unique route"
+check_tags $dir/chr2.map "multimap_chr2 " "contig route"
+check_tags $dir/mapped.map "multimap_chr1 " "mapped route"
+check_tags $dir/rest.map "unmapped " "output"
+echo ": Done"
+echo -n "Runing with:: routes and --sort-by-tag "
+$filter -i $dir/in.map --sort-by-tag --route any,$dir/any.map 2>/dev/null && { echo "Expected '--route' to be rejected" >&2; exit 1; }
+[ -e $dir/any.map ] && { echo "Route file created" >&2; exit 1; }
+echo ": Done"
+rm -r $dir
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+scorereads=../bin/gt.scorereads
+function write_pairs(){
+    # $1 templates, the last $2 of them uniquely mapped pairs (the rest map twice)
+    for i in $(seq 1 $1); do
+        if [ $i -gt $(($1-$2)) ]; then
+            printf "r$i/1\tACGTACGTAC\tIIIIIIIIII\t1\tchr1:+:%d:10\n" $((1000+i))
+            printf "r$i/2\tGTACGTACGT\tIIIIIIIIII\t1\tchr1:-:%d:10\n" $((1200+i*(i%5)))
+        else
+            printf "r$i/1\tACGTACGTAC\tIIIIIIIIII\t0:2\tchr1:+:%d:10,chr2:+:%d:10\n" $((1000+i)) $((1000+i))
+            printf "r$i/2\tGTACGTACGT\tIIIIIIIIII\t0:2\tchr1:-:%d:10,chr2:-:%d:10\n" $((1200+i)) $((1200+i))
+        fi
+    done
+}
+function test_learn_insert_dist(){
+    # $1 templates, $2 unique pairs, $3 pairs to learn from, $4 whether learning falls back
+    input="$(mktemp -t gt_scorereads_in.XXXXXX)"
+    out="$(mktemp -t gt_scorereads_out.XXXXXX)"
+    echo -n "Runing with:: templates:$1 unique:$2 learn:$3 "
+    write_pairs $1 $2 > $input
+    log=$($scorereads -p --learn-insert-dist $3 -o $out < $input 2>&1) || { echo "gt.scorereads failed" >&2; exit 1; }
+    [ $(wc -l < $out) -eq $1 ] || { echo "Templates lost, check $out" >&2; exit 1; }
+    if [ "$4" == "fallback" ]; then
+        echo "$log" | grep -q "Not enough uniquely mapped pairs" || { echo "Expected the learning fallback" >&2; exit 1; }
+    else
+        echo "$log" | grep -q "Not enough uniquely mapped pairs" && { echo "Unexpected learning fallback" >&2; exit 1; }
+    fi
+    rm $input $out
+    echo ": Done"
+}
+
+test_learn_insert_dist 40 20 10 learned
+test_learn_insert_dist 40 2 10 fallback      # Fewer unique pairs than asked (EOF)
+test_learn_insert_dist 6000 20 10 fallback   # Unique pairs past the templates kept (cap of 16 per pair)
+test_learn_insert_dist 6000 20 400 learned   # Unique pairs within the templates kept
@@ -224,7 +224,7 @@ static uint64_t parse_id_tag(gt_string *tag,id_tag *idt)
 	return err;
 }
 
-static as_stats* as_stats_new(bool paired)
+static as_stats* as_stats_new(bool paired,int qual_offset)
 {
 	as_stats* stats=as_calloc((size_t)1,sizeof(as_stats));
 	stats->max_indel_length=50; // We can expand if necessary
@@ -233,6 +233,7 @@ static as_stats* as_stats_new(bool paired)
 	for(i=0;i<j;i++) {
 		int k;
 		for(k=0;k<2;k++) stats->indel_length[i*2+k]=as_calloc(sizeof(uint64_t),stats->max_indel_length+1);
+		stats->cycle_histogram[i]=gt_cycle_histogram_new(qual_offset,MAX_QUAL);
 	}
 	stats->insert_size=0;
 	stats->loc_hash=0;
@@ -243,6 +244,7 @@ static void as_stats_free(as_stats *stats)
 {
 	uint64_t i,j=(stats->paired==true?2:1);
 	for(i=0;i<j;i++) {
+		gt_cycle_histogram_delete(stats->cycle_histogram[i]);
 		if(stats->curr_read_store[i]) {
 			free(stats->read_length_stats[i]);
 			uint64_t k;
@@ -394,6 +396,17 @@ static void as_stats_resize(as_stats *stats,uint64_t rd,uint64_t l)
 	}
 }
 
+static void as_stats_flush(as_stats *stats)
+{
+	uint64_t j,nrd=(stats->paired==true?2:1);
+	for(j=0;j<nrd;j++) {
+		gt_cycle_histogram* ch=stats->cycle_histogram[j];
+		gt_cycle_histogram_flush(ch,stats->base_counts_by_cycle[j]);
+		stats->yield[j]=ch->base_counts[GT_CYCLE_BASE_A]+ch->base_counts[GT_CYCLE_BASE_C]+
+				ch->base_counts[GT_CYCLE_BASE_G]+ch->base_counts[GT_CYCLE_BASE_T]; // Non N bases
+	}
+}
+
 static void get_error_profile(as_stats *stats,gt_alignment *al,uint64_t rd,int qual_offset)
 {
 	static int mis_type[]={0,2,1,2,2,0,2,1,1,2,0,2,2,1,2,0};
@@ -481,20 +494,19 @@ static void as_collect_stats(gt_template* template,as_stats* stats,as_param *par
 		// Update yield max_read_length and resize stats arrays if necessary
 		if(stats->max_read_length[j]<len[j]) as_stats_resize(stats,j,len[j]);
 		stats->read_length_stats[j][len[j]]++;
-		uint64_t i,yld=0;
-		char *p=rd[j];
-		char *q=ql[j];
-		uint64_t **bc=stats->base_counts_by_cycle[j];
-		for(i=0;i<len[j];i++) {
-			int base=base_tab[(int)p[i]]-1;
-			int qual=q[i]-qual_offset;
-			if(qual<0 || qual>MAX_QUAL || base<0) {
-				gt_fatal_error_msg("Illegal base or quality character '%c %c' in read\n",p[i],q[i]);
+		// Base/quality counts by cycle (the yield is taken from them on as_stats_flush())
+		if(!gt_cycle_histogram_add(stats->cycle_histogram[j],stats->base_counts_by_cycle[j],rd[j],ql[j],len[j])) {
+			uint64_t i;
+			char *p=rd[j];
+			char *q=ql[j];
+			for(i=0;i<len[j];i++) {
+				int base=base_tab[(int)p[i]]-1;
+				int qual=q[i]-qual_offset;
+				if(qual<0 || qual>MAX_QUAL || base<0) {
+					gt_fatal_error_msg("Illegal base or quality character '%c %c' in read\n",p[i],q[i]);
+				}
 			}
-			if(base) yld++;
-			bc[i][qual*5+base]++;
 		}
-		stats->yield[j]+=yld;
 	}
 	// Filter maps (both single and paired end) to remove maps after first zero strata after the first hit
 	uint64_t nmaps[3]={0,0,0};
@@ -1401,7 +1413,7 @@ int main(int argc,char *argv[])
 			gt_status error_code;
 			gt_template *template=gt_template_new();
 			id_tag *idt=new_id_tag();
-			stats[tid]=as_stats_new(gt_input_generic_parser_attributes_is_paired(param.parser_attr));
+			stats[tid]=as_stats_new(gt_input_generic_parser_attributes_is_paired(param.parser_attr),param.qual_offset);
 			stats[tid]->loc_hash=&lh;
 			while(gt_input_map_parser_synch_blocks(buffered_input1,buffered_input2,&mutex)) {
 				error_code=gt_input_map_parser_get_template(buffered_input1,template,NULL);
@@ -1450,6 +1462,7 @@ int main(int argc,char *argv[])
 				}
 				as_collect_stats(template,stats[tid],&param,idt);
 			}
+			as_stats_flush(stats[tid]);
 			gt_template_delete(template);
 			gt_buffered_input_file_close(buffered_input1);
 			gt_buffered_input_file_close(buffered_input2);
@@ -1470,7 +1483,7 @@ int main(int argc,char *argv[])
 			gt_buffered_input_file* buffered_input=gt_buffered_input_file_new(input_file);
 			gt_status error_code;
 			gt_template *template=gt_template_new();
-			stats[tid]=as_stats_new(gt_input_generic_parser_attributes_is_paired(param.parser_attr));
+			stats[tid]=as_stats_new(gt_input_generic_parser_attributes_is_paired(param.parser_attr),param.qual_offset);
 			stats[tid]->loc_hash=&lh;
 			id_tag *idt=new_id_tag();
 			while ((error_code=gt_input_generic_parser_get_template(buffered_input,template,param.parser_attr))) {
@@ -1498,6 +1511,7 @@ int main(int argc,char *argv[])
 				}
 				as_collect_stats(template,stats[tid],&param,idt);
 			}
+			as_stats_flush(stats[tid]);
 			// Clean
 			gt_template_delete(template);
 			gt_buffered_input_file_close(buffered_input);
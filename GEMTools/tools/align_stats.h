@@ -101,6 +101,7 @@ typedef struct {
   uint64_t *indel_length[4]; // [rd*2+x][indel size]  For insertions and deletions
   uint64_t max_indel_length;
   uint64_t **base_counts_by_cycle[2];      // [read][cycle][qual*5+base]
+  gt_cycle_histogram *cycle_histogram[2];  // Counts into base_counts_by_cycle
   uint64_t *mm_stats[2*(MAX_QUAL+1)]; // [read*(MAX_QUAL+1)+qual][cycle]
   uint64_t *qual_stats[2*(MAX_QUAL+1)]; // [read*(MAX_QUAL+1)+qual][cycle]
   uint64_t tv_stats[2][MAX_QUAL+1];
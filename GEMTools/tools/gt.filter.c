@@ -25,14 +25,34 @@ typedef struct {
   uint64_t max;
 } gt_filter_quality_range;
 
+/*
+ * Output routes (each template is classified once and written to the first matching route)
+ */
+typedef enum {
+  GT_FILTER_ROUTE_UNMAPPED, GT_FILTER_ROUTE_MAPPED,
+  GT_FILTER_ROUTE_UNIQUE, GT_FILTER_ROUTE_MULTIMAP,
+  GT_FILTER_ROUTE_SPLIT, GT_FILTER_ROUTE_CONTIG, GT_FILTER_ROUTE_ANY
+} gt_filter_route_class;
+typedef struct {
+  gt_filter_route_class route_class;
+  char* contig; // GT_FILTER_ROUTE_CONTIG
+  char* name_output_file;
+  gt_file_format output_format;
+  gt_output_file_compression compression;
+  gt_output_file* output_file;
+} gt_filter_route;
+#define GT_FILTER_NO_ROUTE UINT64_MAX
+
 typedef struct {
   /* I/O */
   char* name_input_file;
+  char* name_input_file_end2;
+  uint64_t sample_input;
   char* name_output_file;
   char* name_reference_file;
   char* name_gem_index_file;
   char* annotation;
-  gt_gtf* gtf;
+  void** gtf; /* (gt_gtf*) One replica per NUMA node */
   bool mmap_input;
   bool paired_end;
   bool no_output;
@@ -41,6 +61,7 @@ typedef struct {
   bool check_duplicates;
   char* name_discarded_output_file;
   gt_file_format discarded_output_format;
+  gt_vector* routes; /* (gt_filter_route) */
   /* Filter Read/Qualities */
   bool hard_trim;
   uint64_t left_trim;
@@ -120,6 +141,9 @@ typedef struct {
   bool show_sequence_list; // Display sequence list in the GEMindex/.fa...
   bool display_pretty; // Display pretty printed map(s)
   bool group_reads; // Group previously split reads
+  bool sort_by_tag; // Sort the records by tag (external sort)
+  uint64_t sort_memory;
+  char* tmp_folder;
   bool sample_read; // Sample the read in chunks (annotated by chunk group)
   float split_chunk_size;
   float split_step_size;
@@ -139,6 +163,8 @@ typedef struct {
 gt_filter_args parameters = {
     /* I/O */
     .name_input_file=NULL,
+    .name_input_file_end2=NULL,
+    .sample_input=0,
     .name_output_file=NULL,
     .name_reference_file=NULL,
     .name_gem_index_file=NULL,
@@ -152,6 +178,7 @@ gt_filter_args parameters = {
     .name_discarded_output_file=NULL,
     .discarded_output_format=FILE_FORMAT_UNKNOWN,
     .check_duplicates=false,
+    .routes=NULL,
     /* Filter Read/Qualities */
     .hard_trim=false,
     .left_trim=0,
@@ -230,6 +257,9 @@ gt_filter_args parameters = {
     .show_sequence_list = false,
     .display_pretty = false,
     .group_reads = false,
+    .sort_by_tag = false,
+    .sort_memory = GT_RECORD_SORT_DEFAULT_MEMORY,
+    .tmp_folder = NULL,
     .sample_read = false,
     .split_chunk_size = -1.0,
     .split_step_size = -1.0,
@@ -324,16 +354,11 @@ GT_INLINE bool gt_filter_check_maps(
  */
 void gt_filter_delete_map_ids(gt_vector* filter_map_ids) {
   // Free vector
-  if (filter_map_ids!=NULL) {
-    GT_VECTOR_ITERATE(filter_map_ids,map_id,pos,gt_string*) {
-      gt_string_delete(*map_id);
-    }
-    gt_vector_delete(filter_map_ids);
-  }
+  if (filter_map_ids!=NULL) gt_vector_delete(filter_map_ids);
 }
-GT_INLINE bool gt_filter_is_sequence_name_allowed(gt_string* const seq_name) {
-  GT_VECTOR_ITERATE(parameters.map_ids,map_id,pos,gt_string*) {
-    if (gt_string_equals(seq_name,*map_id)) return true;
+GT_INLINE bool gt_filter_is_sequence_name_allowed(const uint32_t seq_id) {
+  GT_VECTOR_ITERATE(parameters.map_ids,map_id,pos,uint32_t) {
+    if (seq_id==*map_id) return true;
   }
   return false;
 }
@@ -343,7 +368,7 @@ GT_INLINE bool gt_filter_is_quality_value_allowed(const uint64_t quality_score)
   }
   return false;
 }
-GT_INLINE void gt_filter_prune_matches(gt_template* const template) {
+GT_INLINE void gt_filter_prune_matches(gt_template* const template,const bool sort_pending) {
   uint64_t max_num_matches = GT_ALL;
   if (parameters.max_decoded_matches!=GT_ALL || parameters.min_decoded_strata!=0) {
     uint64_t max_strata;
@@ -353,11 +378,34 @@ GT_INLINE void gt_filter_prune_matches(gt_template* const template) {
   if (parameters.max_output_matches!=GT_ALL) {
     max_num_matches = GT_MIN(max_num_matches,parameters.max_output_matches);
   }
-  // Reduce matches
+  // Reduce matches (if the sort was left to us, only the matches kept get sorted)
   if (max_num_matches < GT_ALL) {
-    gt_template_reduce_mmaps(template,max_num_matches);
+    if (sort_pending) {
+      gt_template_reduce_mmaps_by_distance__score_no_split(template,max_num_matches);
+    } else {
+      gt_template_reduce_mmaps(template,max_num_matches);
+    }
+  } else if (sort_pending) {
+    gt_template_sort_by_distance__score_no_split(template);
   }
 }
+/*
+ * With --no-penalty-for-splitmaps the maps are sorted before filtering. When pruning
+ * is the only step left that depends on that order, the sort is left to the pruning
+ */
+GT_INLINE bool gt_filter_is_sort_left_to_pruning(gt_template* const template) {
+  if (!parameters.matches_pruning) return false;
+  // Discarding filters (discarded templates are printed sorted)
+  if (parameters.mapped || parameters.unmapped || parameters.unique_level>=0.0 ||
+      parameters.min_length>=0.0 || parameters.max_length>=0.0 ||
+      parameters.min_maps>=0 || parameters.max_maps>=0) return false;
+  // Steps modifying the maps or depending on their order
+  if (parameters.hard_trim || parameters.restore_trim || parameters.realign_levenshtein ||
+      parameters.realign_hamming || parameters.mismatch_recovery) return false;
+  if (parameters.perform_dna_map_filter || parameters.perform_rna_map_filter || parameters.perform_annotation_filter) return false;
+  if (parameters.reduce_to_unique_strata>=0 || parameters.reduce_to_unique!=UINT64_MAX || parameters.reduce_to_pairs) return false;
+  return gt_template_get_num_blocks(template)!=2; // Split-pairs coherence check
+}
 GT_INLINE bool gt_filter_has_junction(gt_map* const map,const uint64_t start,const uint64_t end) {
   GT_MAP_ITERATE(map,map_block) {
     if (gt_map_has_next_block(map_block)) {
@@ -438,7 +486,7 @@ GT_INLINE void gt_filter_add_from_hit(gt_template* const template,gt_gtf_hit* hi
 
 GT_INLINE bool gt_filter_make_reduce_by_annotation_alignment(gt_template* const template_dst,gt_alignment* const alignment, uint64_t block, gt_gtf_hits* hits) {
   bool filtered = false;
-  gt_gtf_search_alignment_hits(parameters.gtf, hits, alignment);
+  gt_gtf_search_alignment_hits(gt_numa_get_replica(parameters.gtf), hits, alignment);
   bool prot_coding = (parameters.reduce_to_protein_coding && hits->num_protein_coding >= 1);
   bool gene_id = (parameters.reduce_by_gene_id && hits->num_paired_genes >= 1);
   bool junction_hits = (parameters.reduce_by_junctions && hits->junction_hit_ration > 0.0);
@@ -491,7 +539,7 @@ GT_INLINE bool gt_filter_make_reduce_by_annotation(gt_template* const template_d
         return filtered;
     } else {
       gt_gtf_hits* hits = gt_gtf_hits_new();
-      gt_gtf_search_template_hits(parameters.gtf, hits, template_src);
+      gt_gtf_search_template_hits(gt_numa_get_replica(parameters.gtf), hits, template_src);
       bool prot_coding = (parameters.reduce_to_protein_coding && hits->num_protein_coding >= 1);
       bool gene_id = (parameters.reduce_by_gene_id && hits->num_paired_genes >= 1);
       bool junction_hits = (parameters.reduce_by_junctions && hits->junction_hit_ration > 0.0);
@@ -546,7 +594,7 @@ void gt_alignment_dna_filter(gt_alignment* const alignment_dst,gt_alignment* con
   GT_ALIGNMENT_ITERATE(alignment_src,map) {
     // Check sequence name
     if (parameters.map_ids!=NULL) {
-      if (!gt_filter_is_sequence_name_allowed(map->seq_name)) continue;
+      if (!gt_filter_is_sequence_name_allowed(map->seq_id)) continue;
     }
     // Filter strata beyond first mapping
     const int64_t current_stratum = parameters.no_penalty_for_splitmaps ? gt_map_get_no_split_distance(map) : gt_map_get_global_distance(map);
@@ -680,8 +728,8 @@ void gt_template_dna_filter(gt_template* const template_dst,gt_template* const t
             (current_stratum-first_matching_distance) > gt_template_get_read_proportion(template_src,parameters.max_strata_after_map)) break;
         // Check sequence name
         if (parameters.map_ids!=NULL) {
-          if (!gt_filter_is_sequence_name_allowed(mmap[0]->seq_name)) continue;
-          if (!gt_filter_is_sequence_name_allowed(mmap[1]->seq_name)) continue;
+          if (!gt_filter_is_sequence_name_allowed(mmap[0]->seq_id)) continue;
+          if (!gt_filter_is_sequence_name_allowed(mmap[1]->seq_id)) continue;
         }
         // Check strata
         if (parameters.min_event_distance != GT_FILTER_FLOAT_NO_VALUE || parameters.max_event_distance != GT_FILTER_FLOAT_NO_VALUE) {
@@ -759,7 +807,7 @@ void gt_alignment_rna_filter(gt_alignment* const alignment_dst,gt_alignment* con
   GT_ALIGNMENT_ITERATE(alignment_src,map) {
     // Check sequence name
     if (parameters.map_ids!=NULL) {
-      if (!gt_filter_is_sequence_name_allowed(map->seq_name)) continue;
+      if (!gt_filter_is_sequence_name_allowed(map->seq_id)) continue;
     }
     // Check SM contained
     const uint64_t num_blocks = gt_map_get_num_blocks(map);
@@ -848,9 +896,11 @@ GT_INLINE bool gt_filter_apply_filters(
   /*
    * Recalculate counters without penalty for splitmaps
    */
+  bool sort_pending = false;
   if (parameters.no_penalty_for_splitmaps) {
     gt_template_recalculate_counters_no_splits(template);
-    gt_template_sort_by_distance__score_no_split(template);
+    sort_pending = gt_filter_is_sort_left_to_pruning(template);
+    if (!sort_pending) gt_template_sort_by_distance__score_no_split(template);
   }
   /*
    * Process Read/Qualities // TODO: move out of filter (this is processing)
@@ -1043,7 +1093,7 @@ GT_INLINE bool gt_filter_apply_filters(
   }
 
   // Map pruning
-  if (parameters.matches_pruning) gt_filter_prune_matches(template);
+  if (parameters.matches_pruning) gt_filter_prune_matches(template,sort_pending);
   // Make counters
   if (parameters.make_counters || parameters.no_penalty_for_splitmaps) {
     gt_template_recalculate_counters(template);
@@ -1051,13 +1101,68 @@ GT_INLINE bool gt_filter_apply_filters(
   // Ok, go on
   return true;
 }
+/*
+ * Output routing
+ */
+GT_INLINE gt_map** gt_filter_route_get_primary_mmap(gt_template* const template,uint64_t* const num_blocks) {
+  if (gt_template_get_num_mmaps(template)>0) {
+    *num_blocks = gt_template_get_num_blocks(template);
+    return gt_template_get_mmap_array(template,0,NULL);
+  }
+  // Unpaired ends (take the first end with maps)
+  *num_blocks = 1;
+  GT_TEMPLATE_ITERATE_ALIGNMENT(template,alignment) {
+    if (gt_alignment_get_num_maps(alignment)>0) return gt_vector_get_mem(alignment->maps,gt_map*);
+  }
+  return NULL;
+}
+GT_INLINE bool gt_filter_route_match(
+    gt_filter_route* const route,const uint64_t num_maps,gt_map** const primary_mmap,const uint64_t num_blocks) {
+  uint64_t i;
+  switch (route->route_class) {
+    case GT_FILTER_ROUTE_UNMAPPED: return num_maps==0;
+    case GT_FILTER_ROUTE_MAPPED: return num_maps>0;
+    case GT_FILTER_ROUTE_UNIQUE: return num_maps==1;
+    case GT_FILTER_ROUTE_MULTIMAP: return num_maps>1;
+    case GT_FILTER_ROUTE_SPLIT:
+      if (primary_mmap==NULL) return false;
+      for (i=0;i<num_blocks;++i) {
+        if (primary_mmap[i]!=NULL && gt_map_get_num_blocks(primary_mmap[i])>1) return true;
+      }
+      return false;
+    case GT_FILTER_ROUTE_CONTIG:
+      if (primary_mmap==NULL) return false;
+      for (i=0;i<num_blocks;++i) {
+        if (primary_mmap[i]==NULL) continue;
+        const uint64_t length = gt_map_get_seq_name_length(primary_mmap[i]);
+        return length==strlen(route->contig) && strncmp(gt_map_get_seq_name(primary_mmap[i]),route->contig,length)==0;
+      }
+      return false;
+    case GT_FILTER_ROUTE_ANY: return true;
+    default: GT_INVALID_CASE(); break;
+  }
+  return false;
+}
+GT_INLINE uint64_t gt_filter_route_template(gt_template* const template) {
+  if (parameters.routes==NULL) return GT_FILTER_NO_ROUTE;
+  // Classify once
+  const uint64_t num_maps = gt_filter_get_num_maps(template);
+  uint64_t num_blocks = 0;
+  gt_map** const primary_mmap = (num_maps>0) ? gt_filter_route_get_primary_mmap(template,&num_blocks) : NULL;
+  // First matching route
+  GT_VECTOR_ITERATE(parameters.routes,route,route_pos,gt_filter_route) {
+    if (gt_filter_route_match(route,num_maps,primary_mmap,num_blocks)) return route_pos;
+  }
+  return GT_FILTER_NO_ROUTE;
+}
 GT_INLINE void gt_filter__print(
     const gt_file_format file_format,const uint64_t line_no,
     gt_sequence_archive* const sequence_archive,gt_template* const template,
     uint64_t* const total_algs_checked,uint64_t* const total_algs_correct,
     uint64_t* const total_maps_checked,uint64_t* const total_maps_correct,
     gt_buffered_output_file* const buffered_output,gt_generic_printer_attributes* const generic_printer_attributes,
-    gt_buffered_output_file* const buffered_discarded_output,gt_generic_printer_attributes* const discarded_output_attributes) {
+    gt_buffered_output_file* const buffered_discarded_output,gt_generic_printer_attributes* const discarded_output_attributes,
+    gt_buffered_output_file** const buffered_route_output,gt_generic_printer_attributes** const route_output_attributes) {
   bool discaded = false;
   /*
    * Apply Filters
@@ -1078,7 +1183,13 @@ GT_INLINE void gt_filter__print(
   /*
    * Print template
    */
-  if (!parameters.no_output && !discaded) {
+  const uint64_t route = (!discaded) ? gt_filter_route_template(template) : GT_FILTER_NO_ROUTE;
+  if (route!=GT_FILTER_NO_ROUTE) {
+    if (gt_output_generic_bofprint_template(buffered_route_output[route],template,route_output_attributes[route])) {
+      gt_error_msg("Fatal error outputting read '"PRIgts"'(InputLine:%"PRIu64")\n",
+          PRIgts_content(gt_template_get_string_tag(template)),line_no);
+    }
+  } else if (!parameters.no_output && !discaded) {
     if (gt_output_generic_bofprint_template(buffered_output,template,generic_printer_attributes)) {
       gt_error_msg("Fatal error outputting read '"PRIgts"'(InputLine:%"PRIu64")\n",
           PRIgts_content(gt_template_get_string_tag(template)),line_no);
@@ -1198,6 +1309,20 @@ GT_INLINE void gt_filter_group_reads() {
   gt_input_file_close(input_file);
   gt_output_file_close(output_file);
 }
+GT_INLINE void gt_filter_sort_by_tag() {
+  // Open file IN/OUT
+  gt_input_file* input_file = (parameters.name_input_file==NULL) ?
+      gt_input_stream_open(stdin) : gt_input_file_open(parameters.name_input_file,parameters.mmap_input);
+  gt_output_file* output_file = (parameters.name_output_file==NULL) ?
+      gt_output_stream_new(stdout,SORTED_FILE) : gt_output_file_new(parameters.name_output_file,SORTED_FILE);
+  if (parameters.tmp_folder!=NULL) gt_mm_set_tmp_folder(parameters.tmp_folder);
+  // Sort
+  const uint64_t num_records = gt_record_sort(input_file,output_file,parameters.sort_memory,parameters.num_threads);
+  if (parameters.verbose) fprintf(stderr,"[GT.Filter] Sorted %"PRIu64" records\n",num_records);
+  // Clean
+  gt_input_file_close(input_file);
+  gt_output_file_close(output_file);
+}
 GT_INLINE void gt_filter_sample_read() {
   // Open file IN/OUT
   gt_input_file* input_file = (parameters.name_input_file==NULL) ?
@@ -1346,6 +1471,12 @@ gt_sequence_archive* gt_filter_open_sequence_archive(const bool load_sequences)
   gt_log("Done.");
   return sequence_archive;
 }
+void* gt_filter_sequence_archive_loader(void* const loader_arg) {
+  return gt_filter_open_sequence_archive(true);
+}
+void* gt_filter_gtf_loader(void* const loader_arg) {
+  return gt_gtf_read_from_file(parameters.annotation,GT_MAX(1,parameters.num_threads/gt_numa_get_num_nodes()));
+}
 GT_INLINE void gt_filter_display_sequence_list(){
   // Show sequence archive summary
   gt_sequence_archive* sequence_archive = gt_filter_open_sequence_archive(false);
@@ -1370,6 +1501,17 @@ void gt_filter_read__write() {
   // Open file IN/OUT
   gt_input_file* input_file = (parameters.name_input_file==NULL) ?
       gt_input_stream_open(stdin) : gt_input_file_open(parameters.name_input_file,parameters.mmap_input);
+  gt_input_file* input_file_end2 = NULL;
+  pthread_mutex_t input_mutex_end2 = PTHREAD_MUTEX_INITIALIZER;
+  if (parameters.name_input_file_end2!=NULL) {
+    input_file_end2 = gt_input_file_open(parameters.name_input_file_end2,parameters.mmap_input);
+    if (input_file->file_format!=input_file_end2->file_format ||
+        (input_file->file_format!=FASTA && input_file->file_format!=MAP)) {
+      gt_fatal_error_msg("Paired files '%s','%s' must be both FASTA/FASTQ or both MAP",
+          parameters.name_input_file,parameters.name_input_file_end2);
+    }
+  }
+  if (parameters.sample_input>0) gt_input_file_set_sampling(input_file,parameters.sample_input);
   gt_output_file* output_file, *dicarded_output_file;
 
   // Open out file
@@ -1386,16 +1528,26 @@ void gt_filter_read__write() {
       }
     }
   }
+  // Open routes
+  const uint64_t num_routes = (parameters.routes!=NULL) ? gt_vector_get_used(parameters.routes) : 0;
+  if (num_routes>0) {
+    GT_VECTOR_ITERATE(parameters.routes,route,route_pos,gt_filter_route) {
+      route->output_file = gt_streq(route->name_output_file,"stdout") ?
+          gt_output_stream_new_compress(stdout,SORTED_FILE,route->compression) :
+          gt_output_file_new_compress(route->name_output_file,SORTED_FILE,route->compression);
+      if (route->output_format==FILE_FORMAT_UNKNOWN) route->output_format = input_file->file_format;
+    }
+  }
 
-  // Open reference file
-  gt_sequence_archive* sequence_archive = NULL;
+  // Open reference file (one replica per NUMA node)
+  void** sequence_archives = NULL;
   if (parameters.load_index) {
-    sequence_archive = gt_filter_open_sequence_archive(true);
+    sequence_archives = gt_numa_replicate(gt_filter_sequence_archive_loader,NULL);
   }
 
   // read annotaiton if specified
   if (parameters.annotation != NULL && parameters.perform_annotation_filter) {
-    parameters.gtf = gt_gtf_read_from_file(parameters.annotation, parameters.num_threads);
+    parameters.gtf = gt_numa_replicate(gt_filter_gtf_loader,NULL);
   }
 
   // Parallel reading+process
@@ -1404,6 +1556,10 @@ void gt_filter_read__write() {
   #pragma omp parallel num_threads(parameters.num_threads) reduction(+:total_algs_checked,total_algs_correct,total_maps_checked,total_maps_correct)
 #endif
   {
+#ifdef HAVE_OPENMP
+    gt_numa_bind_thread(omp_get_thread_num(),parameters.num_threads);
+#endif
+    gt_sequence_archive* const sequence_archive = (sequence_archives!=NULL) ? gt_numa_get_replica(sequence_archives) : NULL;
     // Prepare IN/OUT buffers & printers
     gt_status error_code;
     gt_buffered_input_file* buffered_input = gt_buffered_input_file_new(input_file);
@@ -1416,6 +1572,17 @@ void gt_filter_read__write() {
         gt_buffered_input_file_attach_buffered_output(buffered_input,buffered_discarded_output);
       }
     }
+    gt_buffered_output_file** buffered_route_output = NULL;
+    gt_generic_printer_attributes** route_output_attributes = NULL;
+    if (num_routes>0) {
+      buffered_route_output = gt_calloc(num_routes,gt_buffered_output_file*,false);
+      route_output_attributes = gt_calloc(num_routes,gt_generic_printer_attributes*,false);
+      GT_VECTOR_ITERATE(parameters.routes,route,route_pos,gt_filter_route) {
+        buffered_route_output[route_pos] = gt_buffered_output_file_new(route->output_file);
+        gt_buffered_input_file_attach_buffered_output(buffered_input,buffered_route_output[route_pos]);
+        route_output_attributes[route_pos] = gt_generic_printer_attributes_new(route->output_format);
+      }
+    }
     // Prepare IN/OUT parser/printer attributes
     gt_generic_printer_attributes *generic_printer_attributes=NULL, *discarded_output_attributes=NULL;
     if (parameters.output_format==FILE_FORMAT_UNKNOWN) parameters.output_format = input_file->file_format; // Select output format
@@ -1430,7 +1597,25 @@ void gt_filter_read__write() {
      */
     uint64_t record_num = 0;
     gt_template* template = gt_template_new();
-    if (parameters.check_format && parameters.check_file_format==FASTA) {
+    if (input_file_end2!=NULL) {
+      /*
+       * Paired files I/O loop
+       */
+      gt_buffered_input_file* const buffered_input_end2 = gt_buffered_input_file_new(input_file_end2);
+      gt_generic_parser_attributes* generic_parser_attributes = gt_input_generic_parser_attributes_new(false);
+      gt_input_map_parser_attributes_set_max_parsed_maps(generic_parser_attributes->map_parser_attributes,parameters.max_input_matches); // Limit max-matches
+      while ((error_code=gt_input_generic_parser_get_paired_template(
+          buffered_input,buffered_input_end2,&input_mutex_end2,template,generic_parser_attributes))) {
+        GT_FILTER_CHECK_PARSING_ERROR("paired ");
+        // Apply all filters and print
+        gt_filter__print(input_file->file_format,buffered_input->current_line_num-1,sequence_archive,template,
+            &total_algs_checked,&total_algs_correct,&total_maps_checked,&total_maps_correct,
+            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes,
+            buffered_route_output,route_output_attributes);
+      }
+      gt_input_generic_parser_attributes_delete(generic_parser_attributes);
+      gt_buffered_input_file_close(buffered_input_end2);
+    } else if (parameters.check_format && parameters.check_file_format==FASTA) {
       /*
        * FASTA I/O loop
        */
@@ -1439,7 +1624,8 @@ void gt_filter_read__write() {
         // Apply all filters and print
         gt_filter__print(input_file->file_format,buffered_input->current_line_num-1,sequence_archive,template,
             &total_algs_checked,&total_algs_correct,&total_maps_checked,&total_maps_correct,
-            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes);
+            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes,
+            buffered_route_output,route_output_attributes);
       }
     } else if (parameters.check_format && parameters.check_file_format==MAP) {
       /*
@@ -1451,7 +1637,8 @@ void gt_filter_read__write() {
         // Apply all filters and print
         gt_filter__print(input_file->file_format,buffered_input->current_line_num-1,sequence_archive,template,
             &total_algs_checked,&total_algs_correct,&total_maps_checked,&total_maps_correct,
-            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes);
+            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes,
+            buffered_route_output,route_output_attributes);
       }
       gt_input_map_parser_attributes_delete(attr);
     } else if (parameters.check_format && parameters.check_file_format==SAM) {
@@ -1464,7 +1651,8 @@ void gt_filter_read__write() {
         // Apply all filters and print
         gt_filter__print(input_file->file_format,buffered_input->current_line_num-1,sequence_archive,template,
             &total_algs_checked,&total_algs_correct,&total_maps_checked,&total_maps_correct,
-            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes);
+            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes,
+            buffered_route_output,route_output_attributes);
       }
       gt_input_sam_parser_attributes_delete(attr);
     } else {
@@ -1478,7 +1666,8 @@ void gt_filter_read__write() {
         // Apply all filters and print
         gt_filter__print(input_file->file_format,buffered_input->current_line_num-1,sequence_archive,template,
             &total_algs_checked,&total_algs_correct,&total_maps_checked,&total_maps_correct,
-            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes);
+            buffered_output,generic_printer_attributes,buffered_discarded_output,discarded_output_attributes,
+            buffered_route_output,route_output_attributes);
       }
       gt_input_generic_parser_attributes_delete(generic_parser_attributes);
     }
@@ -1490,6 +1679,15 @@ void gt_filter_read__write() {
       gt_buffered_output_file_close(buffered_output);
       if (parameters.discarded_output) gt_buffered_output_file_close(buffered_discarded_output);
     }
+    if (num_routes>0) {
+      uint64_t route_pos;
+      for (route_pos=0;route_pos<num_routes;++route_pos) {
+        gt_buffered_output_file_close(buffered_route_output[route_pos]);
+        gt_generic_printer_attributes_delete(route_output_attributes[route_pos]);
+      }
+      gt_free(buffered_route_output);
+      gt_free(route_output_attributes);
+    }
   }
   /*
    * Print check report
@@ -1500,14 +1698,25 @@ void gt_filter_read__write() {
         total_maps_correct,GT_GET_PERCENTAGE(total_maps_correct,total_maps_checked));
   }
   // Release archive & Clean
-  if (sequence_archive) gt_sequence_archive_delete(sequence_archive);
+  if (sequence_archives) {
+    uint64_t node;
+    for (node=0;node<gt_numa_get_num_nodes();++node) gt_sequence_archive_delete(sequence_archives[node]);
+    gt_free(sequence_archives);
+  }
   gt_filter_delete_map_ids(parameters.map_ids);
   if (parameters.quality_score_ranges!=NULL) gt_vector_delete(parameters.quality_score_ranges);
   gt_input_file_close(input_file);
+  if (input_file_end2!=NULL) gt_input_file_close(input_file_end2);
   if (!parameters.no_output) {
     gt_output_file_close(output_file);
     if (parameters.discarded_output)  gt_output_file_close(dicarded_output_file);
   }
+  if (num_routes>0) {
+    GT_VECTOR_ITERATE(parameters.routes,route,route_pos,gt_filter_route) {
+      gt_output_file_close(route->output_file);
+    }
+    gt_vector_delete(parameters.routes);
+  }
 }
 /*
  * Argument Parsing
@@ -1561,6 +1770,55 @@ void gt_filter_get_discarded_output_arguments(char* const optarg) {
     }
   }
 }
+void gt_filter_get_route_arguments(char* const optarg) {
+  if (parameters.routes==NULL) parameters.routes = gt_vector_new(4,sizeof(gt_filter_route));
+  gt_filter_route route = { .contig=NULL, .output_format=FILE_FORMAT_UNKNOWN, .compression=NONE, .output_file=NULL };
+  // Class
+  char *opt = strtok(optarg,",");
+  if (opt==NULL) gt_fatal_error_msg("Route requires <class>,<file>");
+  if (gt_streq(opt,"unmapped")) {
+    route.route_class = GT_FILTER_ROUTE_UNMAPPED;
+  } else if (gt_streq(opt,"mapped")) {
+    route.route_class = GT_FILTER_ROUTE_MAPPED;
+  } else if (gt_streq(opt,"unique")) {
+    route.route_class = GT_FILTER_ROUTE_UNIQUE;
+  } else if (gt_streq(opt,"multimap")) {
+    route.route_class = GT_FILTER_ROUTE_MULTIMAP;
+  } else if (gt_streq(opt,"split")) {
+    route.route_class = GT_FILTER_ROUTE_SPLIT;
+  } else if (strncmp(opt,"contig=",7)==0 && opt[7]!='\0') {
+    route.route_class = GT_FILTER_ROUTE_CONTIG;
+    route.contig = opt+7;
+  } else if (gt_streq(opt,"any")) {
+    route.route_class = GT_FILTER_ROUTE_ANY;
+  } else {
+    gt_fatal_error_msg("Route class '%s' not recognized",opt);
+  }
+  // File
+  opt = strtok(NULL,",");
+  if (opt==NULL) gt_fatal_error_msg("Route requires <class>,<file>");
+  route.name_output_file = opt;
+  const uint64_t name_length = strlen(opt);
+  if (name_length>3 && gt_streq(opt+name_length-3,".gz")) route.compression = GZIP;
+  if (name_length>4 && gt_streq(opt+name_length-4,".bz2")) route.compression = BZIP2;
+  // Format & Compression
+  while ((opt=strtok(NULL,","))!=NULL) {
+    if (gt_streq(opt,"FASTA")) {
+      route.output_format = FASTA;
+    } else if (gt_streq(opt,"MAP")) {
+      route.output_format = MAP;
+    } else if (gt_streq(opt,"SAM")) {
+      route.output_format = SAM;
+    } else if (gt_streq(opt,"gzip")) {
+      route.compression = GZIP;
+    } else if (gt_streq(opt,"bzip2")) {
+      route.compression = BZIP2;
+    } else {
+      gt_fatal_error_msg("Route option '%s' not recognized",opt);
+    }
+  }
+  gt_vector_insert(parameters.routes,route,gt_filter_route);
+}
 void gt_filter_get_argument_pair_strandness(char* const strandness_opt) {
   char *opt;
   opt = strtok(strandness_opt,",");
@@ -1582,16 +1840,15 @@ void gt_filter_get_argument_pair_strandness(char* const strandness_opt) {
 }
 void gt_filter_get_argument_map_id(char* const maps_ids) {
   // Allocate vector
-  parameters.map_ids = gt_vector_new(20,sizeof(gt_string*));
+  parameters.map_ids = gt_vector_new(20,sizeof(uint32_t));
   // Add all the valid map Ids (sequence names)
   char *opt;
   opt = strtok(maps_ids,",");
   while (opt!=NULL) {
-    // Get id
-    gt_string* map_id = gt_string_new(0);
-    gt_string_set_string(map_id,opt);
+    // Get id (at the contig dictionary)
+    const uint32_t map_id = gt_contig_dictionary_get_id(opt,strlen(opt));
     // Add to the vector
-    gt_vector_insert(parameters.map_ids,map_id,gt_string*);
+    gt_vector_insert(parameters.map_ids,map_id,uint32_t);
     // Next
     opt = strtok(NULL,","); // Reload
   }
@@ -1663,6 +1920,16 @@ void parse_arguments(int argc,char** argv) {
     case 205: // check-duplicates
       parameters.check_duplicates = true;
       break;
+    case 206: // i2
+      parameters.name_input_file_end2 = optarg;
+      parameters.paired_end = true;
+      break;
+    case 207: // sample-input
+      parameters.sample_input = atol(optarg);
+      break;
+    case 208: // route
+      gt_filter_get_route_arguments(optarg);
+      break;
     /* Filter Read/Qualities */
     case 300: // hard-trim
       parameters.hard_trim = true;
@@ -1897,6 +2164,33 @@ void parse_arguments(int argc,char** argv) {
       parameters.special_functionality = true;
       parameters.group_reads = true;
       break;
+    case 903: // sort-by-tag
+      parameters.special_functionality = true;
+      parameters.sort_by_tag = true;
+      break;
+    case 904: { // sort-memory
+      char* units;
+      parameters.sort_memory = strtoull(optarg,&units,10);
+      switch (*units) {
+        case 'K': case 'k': parameters.sort_memory <<= 10; ++units; break;
+        case 'M': case 'm': parameters.sort_memory <<= 20; ++units; break;
+        case 'G': case 'g': parameters.sort_memory <<= 30; ++units; break;
+        default: break;
+      }
+      gt_cond_fatal_error_msg(units==optarg || *units!='\0' || parameters.sort_memory==0,
+          "Invalid memory size '%s' (use <number>[K|M|G])",optarg);
+      break;
+    }
+    case 905: { // tmp-folder
+      const uint64_t length = strlen(optarg);
+      if (length>0 && optarg[length-1]!='/') {
+        parameters.tmp_folder = gt_calloc(length+2,char,true);
+        sprintf(parameters.tmp_folder,"%s/",optarg);
+      } else {
+        parameters.tmp_folder = optarg;
+      }
+      break;
+    }
     /* Display/Information */
     case 1000:
       parameters.special_functionality = true;
@@ -1927,6 +2221,12 @@ void parse_arguments(int argc,char** argv) {
     case 'v': // verbose
       parameters.verbose = true;
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
+    case 1101: // numa
+      gt_numa_enable();
+      break;
     case 'h': // help
       fprintf(stderr, "USE: ./gt.filter [ARGS]...\n");
       gt_options_fprint_menu(stderr,gt_filter_options,gt_filter_groups,false,false);
@@ -1950,6 +2250,27 @@ void parse_arguments(int argc,char** argv) {
   if (parameters.load_index && parameters.name_reference_file==NULL && parameters.name_gem_index_file==NULL) {
     gt_fatal_error_msg("Reference file required");
   }
+  if (parameters.name_input_file_end2!=NULL) {
+    if (parameters.name_input_file==NULL) gt_fatal_error_msg("Paired input files require both '--input' and '--i2'");
+    if (parameters.check_format || parameters.show_sequence_list || parameters.group_reads ||
+        parameters.sample_read || parameters.sort_by_tag) {
+      gt_fatal_error_msg("Option '--i2' is only supported by the filtering mode");
+    }
+  }
+  if (parameters.sample_input>0) {
+    if (parameters.name_input_file==NULL) gt_fatal_error_msg("Option '--sample-input' requires '--input'");
+    if (parameters.name_input_file_end2!=NULL) gt_fatal_error_msg("Option '--sample-input' is not supported with '--i2'");
+    if (parameters.check_format || parameters.show_sequence_list || parameters.group_reads ||
+        parameters.sample_read || parameters.sort_by_tag) {
+      gt_fatal_error_msg("Option '--sample-input' is only supported by the filtering mode");
+    }
+  }
+  if (parameters.routes!=NULL) {
+    if (parameters.show_sequence_list || parameters.group_reads || parameters.sample_read ||
+        parameters.sort_by_tag || parameters.error_plot || parameters.insert_size_plot) {
+      gt_fatal_error_msg("Option '--route' is only supported by the filtering mode");
+    }
+  }
   // Free
   gt_string_delete(gt_filter_short_getopt);
 }
@@ -1972,6 +2293,8 @@ int main(int argc,char** argv) {
     gt_filter_group_reads();
   } else if (parameters.sample_read) {
     gt_filter_sample_read();
+  } else if (parameters.sort_by_tag) {
+    gt_filter_sort_by_tag();
 
   // Depreciated
   } else if (parameters.error_plot) {
@@ -1984,6 +2307,11 @@ int main(int argc,char** argv) {
     gt_filter_read__write(); // Filter !!
   }
 
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
   return 0;
 }
 
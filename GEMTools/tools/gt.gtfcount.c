@@ -243,7 +243,7 @@ GT_INLINE void gt_gtfcount_count_alignment(gt_gtf* gtf, gt_alignment* alignment,
  * This call does the stats count and the gene counts and returns the total number of reads that were taken into account
  * for the stats counts (NOT for the read counts, that depdends on the weighting scheme)
  */
-GT_INLINE void gt_gtfcount_read(gt_gtf* const gtf,
+GT_INLINE void gt_gtfcount_read(void** const gtfs,
                                 gt_shash* const gene_counts,
                                 gt_shash* const type_counts,
                                 gt_shash* const single_patterns_counts,
@@ -266,24 +266,26 @@ GT_INLINE void gt_gtfcount_read(gt_gtf* const gtf,
   gt_gtfcount_count_stats** stats_list =  gt_calloc(parameters.num_threads, gt_gtfcount_count_stats*, true);
   gt_gtf_count_parms** thread_params = gt_calloc(parameters.num_threads, gt_gtf_count_parms*, true);
 
-  for(i=0; i<parameters.num_threads; i++){
-    gene_counts_list[i] = gt_shash_new();
-    type_counts_list[i] = gt_shash_new();
-    single_patterns_list[i] = gt_shash_new();
-    pair_patterns_list[i] = gt_shash_new();
-    stats_list[i] = gt_gtfcount_count_stats_new();
-  }
 
   // Parallel reading+process
   #pragma omp parallel num_threads(parameters.num_threads)
   {
+    // pin the thread and use the annotation of its node
+    uint64_t tid = omp_get_thread_num();
+    gt_numa_bind_thread(tid,parameters.num_threads);
+    gt_gtf* const gtf = gt_numa_get_replica(gtfs);
+
     gt_buffered_input_file* buffered_input = gt_buffered_input_file_new(input_file);
     gt_status error_code;
     gt_template* template = gt_template_new();
     gt_generic_parser_attributes* generic_parser_attr = gt_input_generic_parser_attributes_new(parameters.paired);
 
-    // local maps
-    uint64_t tid = omp_get_thread_num();
+    // local maps (allocated by the thread itself, so they are node-local)
+    gene_counts_list[tid] = gt_shash_new();
+    type_counts_list[tid] = gt_shash_new();
+    single_patterns_list[tid] = gt_shash_new();
+    pair_patterns_list[tid] = gt_shash_new();
+    stats_list[tid] = gt_gtfcount_count_stats_new();
     gt_shash* l_gene_counts = gene_counts_list[tid];
     gt_shash* l_type_counts = type_counts_list[tid];
     gt_shash* l_single_patterns = single_patterns_list[tid];
@@ -508,6 +510,12 @@ void parse_arguments(int argc,char** argv) {
     case 't':
       parameters.num_threads = atol(optarg);
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
+    case 1101: // numa
+      gt_numa_enable();
+      break;
     case 'h':
       fprintf(stderr, "USE: gt.gtfcount [OPERATION] [ARGS]...\n");
       gt_options_fprint_menu(stderr,gt_gtfcount_options,gt_gtfcount_groups,false,false);
@@ -816,14 +824,21 @@ GT_INLINE void gt_gtfcount_print_single_patterns(FILE* output, gt_gtfcount_count
 }
 
 
+void* gt_gtfcount_gtf_loader(void* const loader_arg) {
+  gt_gtf* const gtf = gt_gtf_read_from_file(parameters.annotation, GT_MAX(1,parameters.num_threads/gt_numa_get_num_nodes()));
+  if(parameters.coverage_profiles) gt_gtf_build_coverage_tables(gtf);
+  return gtf;
+}
+
 int main(int argc,char** argv) {
   // GT error handler
   gt_handle_error_signals();
   parse_arguments(argc,argv);
 
-  // read gtf file
+  // read gtf file (one replica per NUMA node)
   gt_gtfcount_warn("Reading GTF...");
-  gt_gtf* const gtf = gt_gtf_read_from_file(parameters.annotation, parameters.num_threads);
+  void** const gtfs = gt_numa_replicate(gt_gtfcount_gtf_loader,NULL);
+  gt_gtf* const gtf = gtfs[0];
   gt_gtfcount_warn("Done\n");
 
   // run the shell
@@ -842,7 +857,7 @@ int main(int argc,char** argv) {
   gt_gtfcount_count_stats* counting_stats = gt_gtfcount_count_stats_new();
 
   /// MAIN CALL TO COUNTING
-  gt_gtfcount_read(gtf, gene_counts, type_counts, single_pattern_counts, pair_pattern_counts, counting_stats);
+  gt_gtfcount_read(gtfs, gene_counts, type_counts, single_pattern_counts, pair_pattern_counts, counting_stats);
 
   // init output paramters
   parameters.output_file = stdout;
@@ -923,6 +938,11 @@ int main(int argc,char** argv) {
   gt_shash_delete(type_counts, true);
   gt_shash_delete(pair_pattern_counts, true);
   gt_shash_delete(single_pattern_counts, true);
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
   return 0;
 }
 
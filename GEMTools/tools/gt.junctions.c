@@ -0,0 +1,309 @@
+/*
+ * PROJECT: GEM-Tools library
+ * FILE: gt.junctions.c
+ * DATE: 19/10/2026
+ * AUTHOR(S): agent <agent@local>
+ * DESCRIPTION: Extracts the splice junctions of split maps (MAP/SAM), aggregates their
+ *   support (together with any given junctions files) and writes a GEM junctions file,
+ *   optionally annotated against a GTF
+ */
+
+#include <getopt.h>
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include "gem_tools.h"
+
+#define GT_JUNCTIONS_FLUSH_THRESHOLD 65536 /* Junctions a thread aggregates before flushing them */
+
+typedef struct {
+  /* I/O */
+  char* name_input_file;
+  char* name_output_file;
+  gt_vector* junction_files; // (char*)
+  char* annotation;
+  bool paired_end;
+  bool mmap_input;
+  /* Junctions */
+  uint64_t min_split_size;
+  uint64_t max_split_size;
+  uint64_t max_matches;
+  uint64_t min_coverage;
+  bool add_annotation;
+  bool print_support;
+  /* Misc */
+  bool verbose;
+  uint64_t num_threads;
+} gt_junctions_args;
+
+gt_junctions_args parameters = {
+  /* I/O */
+  .name_input_file=NULL,
+  .name_output_file=NULL,
+  .junction_files=NULL,
+  .annotation=NULL,
+  .paired_end=false,
+  .mmap_input=false,
+  /* Junctions */
+  .min_split_size=4,
+  .max_split_size=2500000,
+  .max_matches=1,
+  .min_coverage=0,
+  .add_annotation=false,
+  .print_support=false,
+  /* Misc */
+  .verbose=false,
+  .num_threads=1,
+};
+
+/*
+ * Junction extraction
+ */
+GT_INLINE void gt_junctions_flush(gt_junction_set* const junction_set,gt_junction_table* const junction_table,const bool force) {
+  if (force || gt_junction_table_get_num_junctions(junction_table) >= GT_JUNCTIONS_FLUSH_THRESHOLD) {
+    gt_junction_set_flush_table(junction_set,junction_table);
+  }
+}
+void gt_junctions_read_maps(gt_junction_set* const junction_set) {
+  // Open file
+  gt_input_file* const input_file = (parameters.name_input_file==NULL) ?
+      gt_input_stream_open(stdin) : gt_input_file_open(parameters.name_input_file,parameters.mmap_input);
+  // Parallel reading+process
+#ifdef HAVE_OPENMP
+  #pragma omp parallel num_threads(parameters.num_threads)
+#endif
+  {
+    gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+    gt_generic_parser_attributes* const generic_parser_attr = gt_input_generic_parser_attributes_new(parameters.paired_end);
+    gt_junction_table* const junction_table = gt_junction_table_new();
+    gt_template* const template = gt_template_new();
+    gt_status error_code;
+    while ((error_code=gt_input_generic_parser_get_template(buffered_input,template,generic_parser_attr))) {
+      if (error_code!=GT_IMP_OK) {
+        gt_error_msg("Error parsing file '%s'\n",parameters.name_input_file);
+        continue;
+      }
+      // Each end counts on its own (multi-maps are skipped beyond --max-matches)
+      GT_TEMPLATE_ITERATE_ALIGNMENT(template,alignment) {
+        if (gt_alignment_get_num_maps(alignment) > parameters.max_matches) continue;
+        GT_ALIGNMENT_ITERATE(alignment,map) {
+          gt_junction_table_add_map(junction_table,map,parameters.min_split_size,parameters.max_split_size);
+        }
+      }
+      gt_junctions_flush(junction_set,junction_table,false);
+    }
+    gt_junctions_flush(junction_set,junction_table,true);
+    // Clean
+    gt_template_delete(template);
+    gt_junction_table_delete(junction_table);
+    gt_input_generic_parser_attributes_delete(generic_parser_attr);
+    gt_buffered_input_file_close(buffered_input);
+  }
+  gt_input_file_close(input_file);
+}
+void gt_junctions_read_junctions_file(gt_junction_set* const junction_set,char* const file_name) {
+  gt_input_file* const input_file = gt_input_file_open(file_name,parameters.mmap_input);
+#ifdef HAVE_OPENMP
+  #pragma omp parallel num_threads(parameters.num_threads)
+#endif
+  {
+    gt_buffered_input_file* const buffered_input = gt_buffered_input_file_new(input_file);
+    gt_junction_table* const junction_table = gt_junction_table_new();
+    gt_junction junction;
+    while (gt_buffered_input_file_get_block(buffered_input,0)) {
+      const char* line = gt_vector_get_mem(buffered_input->block_buffer,char);
+      const char* const block_end = line + gt_vector_get_used(buffered_input->block_buffer);
+      while (line < block_end) {
+        if (gt_junction_parse(line,&junction)==GT_STATUS_OK) {
+          gt_junction_table_add(junction_table,junction.seq_id,junction.begin,junction.end,junction.strand,junction.support);
+        } else if (*line!=EOL && *line!=EOS && *line!='#') {
+          gt_error_msg("Invalid junction in '%s'\n",file_name);
+        }
+        while (line < block_end && *line!=EOL) ++line;
+        ++line;
+      }
+      gt_junctions_flush(junction_set,junction_table,false);
+    }
+    gt_junctions_flush(junction_set,junction_table,true);
+    gt_junction_table_delete(junction_table);
+    gt_buffered_input_file_close(buffered_input);
+  }
+  gt_input_file_close(input_file);
+}
+
+/*
+ * Annotation & output
+ */
+void gt_junctions_annotate(gt_vector* const junctions,const gt_gtf* const gtf) {
+  gt_junction* const junction = gt_vector_get_mem(junctions,gt_junction);
+  const int64_t num_junctions = gt_vector_get_used(junctions);
+#ifdef HAVE_OPENMP
+  #pragma omp parallel num_threads(parameters.num_threads)
+#endif
+  {
+    gt_vector* const hits = gt_vector_new(32,sizeof(gt_gtf_entry*));
+    int64_t i;
+#ifdef HAVE_OPENMP
+    #pragma omp for schedule(dynamic,1024)
+#endif
+    for (i=0;i<num_junctions;++i) {
+      gt_junction_annotate(gtf,junction+i,hits);
+    }
+    gt_vector_delete(hits);
+  }
+}
+void gt_junctions_print(FILE* const output,gt_vector* const junctions) {
+  uint64_t num_printed = 0, num_annotated = 0;
+  GT_VECTOR_ITERATE(junctions,junction,junction_pos,gt_junction) {
+    // Novel junctions need enough support (sites of the annotation are always kept)
+    if (junction->annotation==GT_JUNCTION_NOVEL && junction->support < parameters.min_coverage) continue;
+    gt_junction_fprint(output,junction,parameters.print_support);
+    ++num_printed;
+    if (junction->annotation==GT_JUNCTION_ANNOTATED) ++num_annotated;
+  }
+  if (parameters.verbose) {
+    fprintf(stderr,"Junctions: %"PRIu64" found, %"PRIu64" written (%"PRIu64" annotated)\n",
+        gt_vector_get_used(junctions),num_printed,num_annotated);
+  }
+}
+
+/*
+ * Arguments
+ */
+void usage(const bool print_inactive) {
+  fprintf(stderr, "USE: ./gt.junctions [ARGS]...\n");
+  gt_options_fprint_menu(stderr,gt_junctions_options,gt_junctions_groups,true,print_inactive);
+}
+void parse_arguments(int argc,char** argv) {
+  struct option* gt_junctions_getopt = gt_options_adaptor_getopt(gt_junctions_options);
+  gt_string* const gt_junctions_short_getopt = gt_options_adaptor_getopt_short(gt_junctions_options);
+  parameters.junction_files = gt_vector_new(4,sizeof(char*));
+  int option, option_index;
+  while (true) {
+    // Get option & Select case
+    if ((option=getopt_long(argc,argv,
+        gt_string_get_string(gt_junctions_short_getopt),gt_junctions_getopt,&option_index))==-1) break;
+    switch (option) {
+    /* I/O */
+    case 'i':
+      parameters.name_input_file = optarg;
+      break;
+    case 'o':
+      parameters.name_output_file = optarg;
+      break;
+    case 'j':
+      gt_vector_insert(parameters.junction_files,optarg,char*);
+      break;
+    case 'a':
+      parameters.annotation = optarg;
+      break;
+    case 'p':
+      parameters.paired_end = true;
+      break;
+    case 200:
+      parameters.mmap_input = true;
+      break;
+    /* Junctions */
+    case 300:
+      parameters.min_split_size = atol(optarg);
+      break;
+    case 301:
+      parameters.max_split_size = atol(optarg);
+      break;
+    case 'm':
+      parameters.max_matches = atol(optarg);
+      break;
+    case 'c':
+      parameters.min_coverage = atol(optarg);
+      break;
+    case 302:
+      parameters.add_annotation = true;
+      break;
+    case 's':
+      parameters.print_support = true;
+      break;
+    /* Misc */
+    case 'v':
+      parameters.verbose = true;
+      break;
+    case 't':
+#ifdef HAVE_OPENMP
+      parameters.num_threads = atol(optarg);
+#endif
+      break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
+    case 'h':
+      usage(false);
+      exit(1);
+    case 'H':
+      usage(true);
+      exit(1);
+    case 'J':
+      gt_options_fprint_json_menu(stderr,gt_junctions_options,gt_junctions_groups,true,false);
+      exit(1);
+      break;
+    case '?':
+    default:
+      gt_fatal_error_msg("Option not recognized");
+    }
+  }
+  // Check parameters
+  if (parameters.add_annotation && parameters.annotation==NULL) {
+    gt_fatal_error_msg("Option '--add-annotation' requires an annotation ('--annotation')");
+  }
+  if (parameters.num_threads==0) parameters.num_threads = 1;
+  // Free
+  gt_string_delete(gt_junctions_short_getopt);
+}
+
+int main(int argc,char** argv) {
+  // GT error handler
+  gt_handle_error_signals();
+  parse_arguments(argc,argv);
+
+  // Aggregate the junctions of the split maps and of the junctions files
+  gt_junction_set* const junction_set = gt_junction_set_new();
+  const uint64_t num_junction_files = gt_vector_get_used(parameters.junction_files);
+  if (parameters.name_input_file!=NULL || num_junction_files==0) {
+    gt_junctions_read_maps(junction_set);
+  }
+  GT_VECTOR_ITERATE(parameters.junction_files,junction_file,junction_file_pos,char*) {
+    gt_junctions_read_junctions_file(junction_set,*junction_file);
+  }
+
+  // Annotate
+  gt_gtf* gtf = NULL;
+  if (parameters.annotation!=NULL) {
+    gtf = gt_gtf_read_from_file(parameters.annotation,parameters.num_threads);
+    if (parameters.add_annotation) {
+      gt_junction_table* const annotation_junctions = gt_junction_table_new();
+      gt_junction_table_add_gtf(annotation_junctions,gtf);
+      gt_junction_set_flush_table(junction_set,annotation_junctions);
+      gt_junction_table_delete(annotation_junctions);
+    }
+  }
+  gt_vector* const junctions = gt_vector_new(GT_JUNCTIONS_FLUSH_THRESHOLD,sizeof(gt_junction));
+  gt_junction_set_get_junctions(junction_set,junctions);
+  gt_junction_set_delete(junction_set);
+  if (gtf!=NULL) gt_junctions_annotate(junctions,gtf);
+
+  // Output
+  FILE* const output = (parameters.name_output_file==NULL) ? stdout : fopen(parameters.name_output_file,"w");
+  gt_cond_fatal_error(output==NULL,FILE_OPEN,parameters.name_output_file);
+  gt_junctions_print(output,junctions);
+  if (parameters.name_output_file!=NULL) fclose(output);
+
+  // Clean
+  gt_vector_delete(junctions);
+  gt_vector_delete(parameters.junction_files);
+  if (gtf!=NULL) gt_gtf_delete(gtf);
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
+  return 0;
+}
@@ -241,6 +241,9 @@ void gt_map2sam_read__write() {
   #pragma omp parallel num_threads(parameters.num_threads)
 #endif
   {
+#ifdef HAVE_OPENMP
+    gt_numa_bind_thread(omp_get_thread_num(),parameters.num_threads);
+#endif
     gt_status error_code;
     gt_buffered_input_file* buffered_input = gt_buffered_input_file_new(input_file);
     gt_buffered_output_file* buffered_output = gt_buffered_output_file_new(output_file);
@@ -375,6 +378,12 @@ void parse_arguments(int argc,char** argv) {
       parameters.num_threads = atol(optarg);
 #endif
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
+    case 1101: // numa
+      gt_numa_enable();
+      break;
     case 'h':
       usage(gt_map2sam_options,gt_map2sam_groups,false);
       exit(1);
@@ -414,6 +423,11 @@ int main(int argc,char** argv) {
   // map2sam !!
   gt_map2sam_read__write();
 
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
   return 0;
 }
 
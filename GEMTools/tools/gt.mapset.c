@@ -22,6 +22,7 @@ typedef struct {
   gt_operation operation;
   char* name_input_file_1;
   char* name_input_file_2;
+  gt_vector* name_input_files_slaves; /* (char*) Every --i2 (merge-map) */
   char* name_output_file;
   bool mmap_input;
   bool paired_end;
@@ -36,6 +37,7 @@ gt_stats_args parameters = {
     .operation=GT_MAP_SET_UNKNOWN,
     .name_input_file_1=NULL,
     .name_input_file_2=NULL,
+    .name_input_files_slaves=NULL,
     .name_output_file=NULL,
     .mmap_input=false,
     .paired_end=false,
@@ -57,6 +59,9 @@ int64_t gt_mapset_mmap_cmp(gt_map** const map_1,gt_map** const map_2,const uint6
       parameters.eq_threshold*current_read_length: parameters.eq_threshold;
   return parameters.strict ? gt_mmap_cmp(map_1,map_2,num_maps) : gt_mmap_range_cmp(map_1,map_2,num_maps,eq_threshold);
 }
+// Strict comparisons use the library ones directly (so duplicates lookups can be hashed)
+int64_t (*gt_mapset_map_cmp_fx)(gt_map*,gt_map*) = gt_mapset_map_cmp;
+int64_t (*gt_mapset_mmap_cmp_fx)(gt_map**,gt_map**,uint64_t) = gt_mapset_mmap_cmp;
 
 GT_INLINE gt_status gt_mapset_read_template_sync(
     gt_buffered_input_file* const buffered_input_master,gt_buffered_input_file* const buffered_input_slave,
@@ -166,13 +171,13 @@ void gt_mapset_perform_set_operations() {
     gt_template *ptemplate;
     switch (parameters.operation) {
       case GT_MAP_SET_UNION:
-        ptemplate=gt_template_union_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_1,template_2);
+        ptemplate=gt_template_union_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_1,template_2);
         break;
       case GT_MAP_SET_INTERSECTION:
-        ptemplate=gt_template_intersect_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_1,template_2);
+        ptemplate=gt_template_intersect_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_1,template_2);
         break;
       case GT_MAP_SET_DIFFERENCE:
-        ptemplate=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_1,template_2);
+        ptemplate=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_1,template_2);
         break;
       default:
         gt_fatal_error(SELECTION_NOT_VALID);
@@ -236,9 +241,9 @@ void gt_mapset_perform_cmp_operations() {
         break;
       case GT_MAP_SET_COMPARE: {
         // Perform simple cmp operations
-        gt_template *template_master_minus_slave=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_1,template_2);
-        gt_template *template_slave_minus_master=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_2,template_1);
-        gt_template *template_intersection=gt_template_intersect_template_mmaps_fx(gt_mapset_mmap_cmp,gt_mapset_map_cmp,template_1,template_2);
+        gt_template *template_master_minus_slave=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_1,template_2);
+        gt_template *template_slave_minus_master=gt_template_subtract_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_2,template_1);
+        gt_template *template_intersection=gt_template_intersect_template_mmaps_fx(gt_mapset_mmap_cmp_fx,gt_mapset_map_cmp_fx,template_1,template_2);
         /*
          * Print results :: (TAG (Master-Slave){COUNTER MAPS} (Slave-Master){COUNTER MAPS} (Intersection){COUNTER MAPS})
          */
@@ -284,17 +289,37 @@ void gt_mapset_perform_cmp_operations() {
   gt_output_file_close(output_file);
 }
 
+gt_input_file* gt_mapset_open_input_file(char* const name_input_file) {
+  return (name_input_file==NULL || gt_streq(name_input_file,"-")) ?
+      gt_input_stream_open(stdin) : gt_input_file_open(name_input_file,parameters.mmap_input);
+}
 void gt_mapset_perform_merge_map() {
-  // Open file IN/OUT
-  gt_input_file* input_file_1 = gt_input_file_open(parameters.name_input_file_1,parameters.mmap_input);
-  gt_input_file* input_file_2 = (parameters.name_input_file_2==NULL) ?
-      gt_input_stream_open(stdin) : gt_input_file_open(parameters.name_input_file_2,parameters.mmap_input);
-  if (parameters.name_input_file_2==NULL) GT_SWAP(input_file_1,input_file_2);
+  /*
+   * Open file IN/OUT
+   *   Master (--i1) plus all the slaves (--i2), merged in one pass.
+   *   Without --i2, the master is read from stdin and --i1 is the only slave
+   */
+  uint64_t i, num_slaves;
+  gt_input_file** input_files;
+  if (parameters.name_input_files_slaves==NULL) {
+    num_slaves = 1;
+    input_files = gt_calloc(2,gt_input_file*,false);
+    input_files[0] = gt_input_stream_open(stdin);
+    input_files[1] = gt_input_file_open(parameters.name_input_file_1,parameters.mmap_input);
+  } else {
+    num_slaves = gt_vector_get_used(parameters.name_input_files_slaves);
+    input_files = gt_calloc(num_slaves+1,gt_input_file*,false);
+    input_files[0] = gt_mapset_open_input_file(parameters.name_input_file_1);
+    for (i=0;i<num_slaves;++i) {
+      input_files[i+1] = gt_mapset_open_input_file(*gt_vector_get_elm(parameters.name_input_files_slaves,i,char*));
+    }
+  }
   gt_output_file* output_file = (parameters.name_output_file==NULL) ?
       gt_output_stream_new(stdout,SORTED_FILE) : gt_output_file_new(parameters.name_output_file,SORTED_FILE);
 
-  // Mutex
+  // Mutex & Slaves' lookahead (shared by all threads)
   pthread_mutex_t input_mutex = PTHREAD_MUTEX_INITIALIZER;
+  gt_imp_subset_lookahead* const lookahead = gt_imp_subset_lookahead_new(num_slaves);
 
   // Parallel reading+process
 #ifdef HAVE_OPENMP
@@ -302,15 +327,19 @@ void gt_mapset_perform_merge_map() {
 #endif
   {
     if (parameters.files_contain_same_reads) {
-      gt_merge_synch_map_files(&input_mutex,parameters.paired_end,output_file,input_file_1,input_file_2);
+      gt_merge_synch_map_files_a(&input_mutex,parameters.paired_end,output_file,input_files,num_slaves+1);
     } else {
-      gt_merge_unsynch_map_files(&input_mutex,input_file_1,input_file_2,parameters.paired_end,output_file);
+      gt_merge_unsynch_map_files_a(&input_mutex,lookahead,parameters.paired_end,
+          output_file,input_files[0],input_files+1,num_slaves);
     }
   }
 
   // Clean
-  gt_input_file_close(input_file_1);
-  gt_input_file_close(input_file_2);
+  gt_imp_subset_lookahead_delete(lookahead,num_slaves);
+  for (i=0;i<=num_slaves;++i) {
+    gt_input_file_close(input_files[i]);
+  }
+  gt_free(input_files);
   gt_output_file_close(output_file);
 }
 void gt_mapset_display_compact_map() {
@@ -413,7 +442,9 @@ void parse_arguments(int argc,char** argv) {
       parameters.name_input_file_1 = optarg;
       break;
     case 301:
-      parameters.name_input_file_2 = optarg;
+      if (parameters.name_input_file_2==NULL) parameters.name_input_file_2 = optarg;
+      if (parameters.name_input_files_slaves==NULL) parameters.name_input_files_slaves = gt_vector_new(4,sizeof(char*));
+      gt_vector_insert(parameters.name_input_files_slaves,optarg,char*);
       break;
     case 'p':
       parameters.paired_end = true;
@@ -444,6 +475,9 @@ void parse_arguments(int argc,char** argv) {
       parameters.num_threads = atol(optarg);
 #endif
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
     case 'h':
       fprintf(stderr, "USE: ./gt.mapset [OPERATION] [ARGS]...\n");
       gt_options_fprint_menu(stderr,gt_mapset_options,gt_mapset_groups,false,false);
@@ -464,6 +498,10 @@ void parse_arguments(int argc,char** argv) {
   if (parameters.operation!=GT_DISPLAY_COMPACT_MAP && !parameters.name_input_file_1) {
     gt_fatal_error_msg("Input file 1 required (--i1)\n");
   }
+  if (parameters.operation!=GT_MERGE_MAP && parameters.name_input_files_slaves!=NULL &&
+      gt_vector_get_used(parameters.name_input_files_slaves)>1) {
+    gt_fatal_error_msg("Multiple input files (--i2) only allowed for 'merge-map'\n");
+  }
   // Free
   gt_string_delete(gt_mapset_short_getopt);
 }
@@ -475,6 +513,11 @@ int main(int argc,char** argv) {
   // Parsing command-line options
   parse_arguments(argc,argv);
 
+  if (parameters.strict) {
+    gt_mapset_map_cmp_fx = gt_map_cmp;
+    gt_mapset_mmap_cmp_fx = gt_mmap_cmp;
+  }
+
   // Do it !
   if (parameters.operation==GT_MERGE_MAP) {
     gt_mapset_perform_merge_map();
@@ -488,6 +531,13 @@ int main(int argc,char** argv) {
     gt_mapset_perform_cmp_operations();
   }
 
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
+  // Free
+  if (parameters.name_input_files_slaves!=NULL) gt_vector_delete(parameters.name_input_files_slaves);
   return 0;
 }
 
@@ -97,6 +97,9 @@ void parse_arguments(int argc,char** argv) {
     case 't':
       parameters.num_threads = atol(optarg);
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
     case 'h':
       fprintf(stderr, "USE: gt.gtfcount [OPERATION] [ARGS]...\n");
       gt_options_fprint_menu(stderr,gt_region_options,gt_region_groups,false,false);
@@ -126,6 +129,11 @@ int main(int argc,char** argv) {
   // read gtf file
   gt_gtf* const gtf = gt_gtf_read_from_file(parameters.annotation, parameters.num_threads);
   gt_region_read(gtf);
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
   return 0;
 }
 
@@ -33,11 +33,13 @@
 #define AL_REVERSE 8
 #define AL_DIRECTIONS ((AL_FORWARD)|(AL_REVERSE))
 #define AL_USED 128
+#define LEARN_MAX_TEMPLATES_PER_PAIR 16 /* Templates kept while learning the insert distribution, per pair asked */
 
 typedef struct {
   char *input_files[2];
   char *output_file;
   char *dist_file;
+  uint64_t learn_pairs; // Learn the insert distribution from the first pairs of the input
   double ins_cutoff;
   bool mmap_input;
   bool verbose;
@@ -47,18 +49,21 @@ typedef struct {
   gt_buffered_output_file *buf_output[2];
   int64_t min_insert;
   int64_t max_insert;
+  int insert_set[2];
   double *ins_dist;
   uint8_t *ins_phred;
   int num_threads;
   int mapping_cutoff;
   int indel_quality;
   int qual_offset; // quality offset (33 for FASTQ, 64 for Illumina)
+  uint8_t qual_score[256]; // Mismatch score by quality character
 } sr_param;
 
 sr_param param = {
 		.input_files={NULL,NULL},
 		.output_file=NULL,
 		.dist_file=NULL,
+		.learn_pairs=0,
 		.ins_cutoff=DEFAULT_INS_CUTOFF,
 		.mmap_input=false,
 		.compress=NONE,
@@ -70,6 +75,7 @@ sr_param param = {
 		.mapping_cutoff=0,
 		.min_insert=0,
 		.max_insert=0,
+		.insert_set={0,0},
 		.ins_dist=NULL,
 		.ins_phred=NULL
 };
@@ -111,7 +117,43 @@ typedef struct {
 	u_int64_t y;
 } hist_entry;
 
-void read_dist_file(sr_param *param,int iset[2])
+static void set_ins_dist(sr_param *param,hist_entry *hist,size_t ct,u_int64_t total)
+{
+	int *iset=param->insert_set;
+	double z1=param->ins_cutoff*(double)total;
+	double z2=(1.0-param->ins_cutoff)*(double)total;
+	double z=0.0;
+	int i;
+	for(i=0;i<ct;i++) {
+		z+=hist[i].y;
+		if(z>=z1) break;
+	}
+	int i1=i;
+	if(!iset[0] || hist[i].x>param->min_insert) param->min_insert=hist[i].x;
+	for(i++;i<ct;i++) {
+		z+=hist[i].y;
+		if(z>=z2) break;
+	}
+	int i2=i-1;
+	if(!iset[1] || hist[i2].x<param->max_insert) param->max_insert=hist[i2].x;
+	fprintf(stderr,"Insert distribution %"PRId64" - %"PRId64"\n",param->min_insert,param->max_insert);
+	int k=param->max_insert-param->min_insert+1;
+	param->ins_dist=sr_malloc(sizeof(double)*k);
+	param->ins_phred=sr_malloc((size_t)k);
+	for(i=0;i<k;i++) param->ins_dist[i]=0.0;
+	for(i=i1;i<=i2;i++) {
+		double zt=(double)hist[i].y/(double)total;
+		param->ins_dist[hist[i].x-param->min_insert]=zt;
+		int phred=255;
+		if(zt>0.0) {
+			phred=(int)(log(zt)*-10.0/log(10.0)+.5);
+			if(phred>255) phred=255;
+		}
+		param->ins_phred[hist[i].x-param->min_insert]=phred;
+	}
+}
+
+void read_dist_file(sr_param *param)
 {
 	gt_input_file* file=gt_input_file_open(param->dist_file,false);
 	gt_buffered_input_file* bfile=gt_buffered_input_file_new(file);
@@ -188,37 +230,7 @@ void read_dist_file(sr_param *param,int iset[2])
 		if(i<nl) break;
 	} while(nl);
 	if(first==false && ct>2) {
-		double z1=param->ins_cutoff*(double)total;
-		double z2=(1.0-param->ins_cutoff)*(double)total;
-		double z=0.0;
-		int i;
-		for(i=0;i<ct;i++) {
-			z+=hist[i].y;
-			if(z>=z1) break;
-		}
-		int i1=i;
-		if(!iset[0] || hist[i].x>param->min_insert) param->min_insert=hist[i].x;
-		for(i++;i<ct;i++) {
-			z+=hist[i].y;
-			if(z>=z2) break;
-		}
-		int i2=i-1;
-		if(!iset[1] || hist[i2].x<param->max_insert) param->max_insert=hist[i2].x;
-		fprintf(stderr,"Insert distribution %"PRId64" - %"PRId64"\n",param->min_insert,param->max_insert);
-		int k=param->max_insert-param->min_insert+1;
-		param->ins_dist=sr_malloc(sizeof(double)*k);
-		param->ins_phred=sr_malloc((size_t)k);
-		for(i=0;i<k;i++) param->ins_dist[i]=0.0;
-		for(i=i1;i<=i2;i++) {
-			double zt=(double)hist[i].y/(double)total;
-			param->ins_dist[hist[i].x-param->min_insert]=zt;
-			int phred=255;
-			if(zt>0.0) {
-				phred=(int)(log(zt)*-10.0/log(10.0)+.5);
-				if(phred>255) phred=255;
-			}
-			param->ins_phred[hist[i].x-param->min_insert]=phred;
-		}
+		set_ins_dist(param,hist,ct,total);
 	} else {
 		if(ftype==UNKNOWN) fprintf(stderr,"Insert distribution file format not recognized\n");
 		else fprintf(stderr,"No valid lines read in from insert distribution file\n");
@@ -228,58 +240,104 @@ void read_dist_file(sr_param *param,int iset[2])
 	gt_input_file_close(file);
 }
 
-static uint64_t calculate_dist_score(gt_alignment *al, gt_map *map, int qual_offset,int qual_penalty)
+/*
+ * Alignment scoring
+ *   The quality offset and the [0,MAX_QUAL] clamp are folded into a table indexed by the
+ *   quality character, so each mismatch costs a lookup. All the maps of an alignment are
+ *   scored in one pass before pairing, and the geometry each map needs for the insert size
+ *   (contig, strand and the span of its last block) is also taken once per map rather than
+ *   once per combination of maps
+ */
+static void init_qual_score(sr_param *param)
+{
+	int c;
+	for(c=0;c<256;c++) {
+		int quality_misms=(int)(signed char)c-param->qual_offset;
+		if(quality_misms>MAX_QUAL) quality_misms=MAX_QUAL;
+		else if(quality_misms<0) quality_misms=0;
+		param->qual_score[c]=quality_misms;
+	}
+}
+
+static uint64_t score_map(gt_map *map,const uint8_t *qual_score,const char *quals,uint64_t indel_score)
 {
-	register gt_string* const quals = al->qualities;
-	register const bool has_qualities = gt_alignment_has_qualities(al);
 	uint64_t score=0;
 	GT_MAP_ITERATE(map,map_block) {
-		GT_MISMS_ITERATE(map_block,misms) {
-			int quality_misms;
-			if (has_qualities) {
-				quality_misms = gt_string_get_string(quals)[misms->position]-qual_offset;
-				if(quality_misms>MAX_QUAL) quality_misms=MAX_QUAL;
-				else if(quality_misms<0) quality_misms=0;
-			} else quality_misms=MISSING_QUAL;
-			switch (misms->misms_type) {
-			case MISMS:
-				score+=quality_misms;
-				break;
-			case INS:
-			case DEL:
-				score+=qual_penalty;
-				break;
-			}
+		const gt_misms *misms=gt_vector_get_mem(map_block->mismatches,gt_misms);
+		const uint64_t num_misms=gt_vector_get_used(map_block->mismatches);
+		uint64_t i;
+		if(quals) {
+			for(i=0;i<num_misms;i++) score+=(misms[i].misms_type==MISMS)?qual_score[(uint8_t)quals[misms[i].position]]:indel_score;
+		} else {
+			for(i=0;i<num_misms;i++) score+=(misms[i].misms_type==MISMS)?MISSING_QUAL:indel_score;
 		}
 	}
 	if(score>MAX_GT_SCORE) score=MAX_GT_SCORE;
 	return score;
 }
 
+static void score_alignment(gt_alignment *alignment,sr_param *param)
+{
+	const char *quals=gt_alignment_has_qualities(alignment)?gt_string_get_string(alignment->qualities):NULL;
+	GT_ALIGNMENT_ITERATE(alignment,map) {
+		if(map->gt_score==GT_MAP_NO_GT_SCORE) map->gt_score=score_map(map,param->qual_score,quals,param->indel_quality);
+	}
+}
+
+typedef struct {
+	uint32_t seq_id;
+	gt_strand strand;
+	uint64_t begin; // Start of the last block
+	uint64_t end;   // Start of the last block plus the length of the whole map
+} map_span;
+
+static void get_map_spans(gt_alignment *alignment,map_span *span)
+{
+	GT_ALIGNMENT_ITERATE(alignment,map) {
+		gt_map *last_block=map;
+		uint64_t length=0;
+		GT_MAP_ITERATE(map,map_block) {
+			last_block=map_block;
+			length+=gt_map_get_base_length(map_block);
+		}
+		span->seq_id=last_block->seq_id;
+		span->strand=last_block->strand;
+		span->end=last_block->position+length;
+		span->begin=span->end-gt_map_get_base_length(last_block);
+		span++;
+	}
+}
+
 static void pair_read(gt_template *template,gt_alignment *alignment1,gt_alignment *alignment2,sr_param *param)
 {
 	gt_alignment_recalculate_counters(alignment1);
 	gt_alignment_recalculate_counters(alignment2);
 	gt_mmap_attributes attr;
-	gt_map *mmap[2];
 	uint64_t nmap[2];
 	nmap[0]=gt_alignment_get_num_maps(alignment1);
 	nmap[1]=gt_alignment_get_num_maps(alignment2);
 	if(nmap[0]+nmap[1]) {
+		score_alignment(alignment1,param);
+		score_alignment(alignment2,param);
+		map_span *span[2];
+		span[0]=sr_malloc(sizeof(map_span)*(size_t)(nmap[0]+nmap[1]));
+		span[1]=span[0]+nmap[0];
+		get_map_spans(alignment1,span[0]);
+		get_map_spans(alignment2,span[1]);
 		char *map_flag[2];
 		map_flag[0]=sr_calloc((size_t)(nmap[0]+nmap[1]),sizeof(char));
 		map_flag[1]=map_flag[0]+nmap[0];
-		uint64_t i=0;
-		GT_ALIGNMENT_ITERATE(alignment1,map1) {
-			if(map1->gt_score==GT_MAP_NO_GT_SCORE) map1->gt_score=calculate_dist_score(alignment1,map1,param->qual_offset,param->indel_quality);
-			mmap[0]=map1;
-			uint64_t j=0;
-			GT_ALIGNMENT_ITERATE(alignment2,map2) {
-				if(map2->gt_score==GT_MAP_NO_GT_SCORE) map2->gt_score=calculate_dist_score(alignment2,map2,param->qual_offset,param->indel_quality);
-				mmap[1]=map2;
-				gt_status gt_err;
-				int64_t x=gt_template_get_insert_size(mmap,&gt_err,0,0);
-				if(gt_err==GT_TEMPLATE_INSERT_SIZE_OK && x>=param->min_insert && x<=param->max_insert) {
+		uint64_t i,j;
+		for(i=0;i<nmap[0];i++) {
+			const map_span *span1=span[0]+i;
+			for(j=0;j<nmap[1];j++) {
+				const map_span *span2=span[1]+j;
+				// Same as gt_template_get_insert_size()
+				if(span1->seq_id!=span2->seq_id || span1->strand==span2->strand) continue;
+				int64_t x=(span1->strand==FORWARD)?1+span2->end-span1->begin:1+span1->end-span2->begin;
+				if(x>=param->min_insert && x<=param->max_insert) {
+					gt_map *map1=gt_alignment_get_map(alignment1,i);
+					gt_map *map2=gt_alignment_get_map(alignment2,j);
 					attr.distance=gt_map_get_global_distance(map1)+gt_map_get_global_distance(map2);
 					attr.gt_score=map1->gt_score|(map2->gt_score<<16);
 					if(param->ins_phred) attr.gt_score|=((uint64_t)param->ins_phred[x-param->min_insert]<<32);
@@ -288,9 +346,7 @@ static void pair_read(gt_template *template,gt_alignment *alignment1,gt_alignmen
 					gt_template_add_mmap_ends(template,map1,map2,&attr);
 					map_flag[0][i]=map_flag[1][j]=1;
 				}
-				j++;
 			}
-			i++;
 		}
 		for(i=0;i<nmap[0];i++) {
 			if(!map_flag[0][i]) {
@@ -313,10 +369,155 @@ static void pair_read(gt_template *template,gt_alignment *alignment1,gt_alignmen
 			}
 		}
 		free(map_flag[0]);
+		free(span[0]);
 	}
 	gt_attributes_remove(template->attributes,GT_ATTR_ID_TAG_PAIR);
 }
 
+/*
+ * Reads the next paired template, either interleaved from one file or from two MAP files
+ * (@buffered_input2!=NULL). Returns GT_IMP_EOF at the end of the input or on an ID mismatch
+ */
+static gt_status read_paired_template(gt_buffered_input_file *buffered_input1,gt_buffered_input_file *buffered_input2,
+		pthread_mutex_t *mutex,gt_template *template,sr_param *param)
+{
+	gt_status error_code;
+	if(!buffered_input2) {
+		error_code=gt_input_generic_parser_get_template(buffered_input1,template,param->parser_attr);
+		if(error_code!=GT_IMP_OK && error_code!=GT_IMP_EOF) gt_error_msg("Error parsing file '%s'\n",param->input_files[0]);
+		return error_code;
+	}
+	if(!gt_input_map_parser_synch_blocks(buffered_input1,buffered_input2,mutex)) return GT_IMP_EOF;
+	error_code=gt_input_map_parser_get_template(buffered_input1,template,NULL);
+	if(error_code!=GT_IMP_OK) {
+		gt_input_map_parser_get_template(buffered_input2,template,NULL);
+		gt_error_msg("Error parsing file '%s'\n",param->input_files[0]);
+		return GT_IMP_FAIL;
+	}
+	if(gt_template_get_num_blocks(template)!=1) {
+		gt_error_msg("Error parsing files '%s','%s': wrong number of blocks\n",param->input_files[0],param->input_files[1]);
+		return GT_IMP_FAIL;
+	}
+	gt_alignment *alignment2=gt_template_get_block_dyn(template,1);
+	error_code=gt_input_map_parser_get_alignment(buffered_input2,alignment2,NULL);
+	if (error_code!=GT_IMP_OK) {
+		gt_error_msg("Error parsing file '%s'\n",param->input_files[1]);
+		return GT_IMP_FAIL;
+	}
+	if(!(gt_string_nequals(template->tag,alignment2->tag,gt_string_get_length(template->tag)))) {
+		gt_error_msg("Fatal ID mismatch ('%*s','%*s') parsing files '%s','%s'\n",PRIgts_content(template->tag),PRIgts_content(alignment2->tag),param->input_files[0],param->input_files[1]);
+		return GT_IMP_EOF;
+	}
+	return GT_IMP_OK;
+}
+
+/*
+ * Insert distribution learning (--learn-insert-dist)
+ *   Instead of a separate stats pass, the start of the input is parsed and kept until
+ *   learn_pairs uniquely mapped pairs (same contig, opposite strands) have been seen. The rest
+ *   of that block is kept as well, so the threads resume the stream on a block boundary.
+ *   The kept templates are scored by the threads before they go on with the stream.
+ *   At most learn_pairs*LEARN_MAX_TEMPLATES_PER_PAIR templates (plus the rest of the block) are
+ *   kept; if the pairs are not found by then, no distribution is learned
+ */
+typedef struct {
+	gt_vector *templates; // (gt_template*)
+	gt_vector *inserts; // (int64_t)
+	uint64_t next_template;
+} sr_learner;
+
+sr_learner learner = {
+		.templates=NULL,
+		.inserts=NULL,
+		.next_template=0
+};
+
+static void learn_template(gt_template *template)
+{
+	gt_alignment *alignment1=gt_template_get_block(template,0);
+	gt_alignment *alignment2=gt_template_get_block(template,1);
+	if(gt_alignment_get_num_maps(alignment1)==1 && gt_alignment_get_num_maps(alignment2)==1) {
+		gt_map *mmap[2];
+		mmap[0]=gt_alignment_get_map(alignment1,0);
+		mmap[1]=gt_alignment_get_map(alignment2,0);
+		gt_status gt_err;
+		int64_t x=gt_template_get_insert_size(mmap,&gt_err,0,0);
+		if(gt_err==GT_TEMPLATE_INSERT_SIZE_OK && x>0) gt_vector_insert(learner.inserts,x,int64_t);
+	}
+	// Keep the template (the parser gets a fresh one)
+	gt_template *kept_template=gt_template_new();
+	gt_template_swap(kept_template,template);
+	gt_vector_insert(learner.templates,kept_template,gt_template*);
+}
+
+static int cmp_insert(const void *s1,const void *s2)
+{
+	const int64_t x1=*(const int64_t*)s1, x2=*(const int64_t*)s2;
+	return (x1>x2)-(x1<x2);
+}
+
+static void set_learned_ins_dist(sr_param *param)
+{
+	size_t n=gt_vector_get_used(learner.inserts);
+	int64_t *inserts=gt_vector_get_mem(learner.inserts,int64_t);
+	qsort(inserts,n,sizeof(int64_t),cmp_insert);
+	hist_entry *hist=sr_malloc(sizeof(hist_entry)*(n+1));
+	size_t i,ct=0;
+	for(i=0;i<n;i++) {
+		if(ct && hist[ct-1].x==inserts[i]) hist[ct-1].y++;
+		else {
+			hist[ct].x=inserts[i];
+			hist[ct++].y=1;
+		}
+	}
+	if(ct>2) set_ins_dist(param,hist,ct,(u_int64_t)n);
+	else fprintf(stderr,"Not enough uniquely mapped pairs to learn the insert distribution\n");
+	free(hist);
+}
+
+void learn_ins_dist(gt_input_file *input_file1,gt_input_file *input_file2,pthread_mutex_t *mutex,sr_param *param)
+{
+	learner.templates=gt_vector_new(param->learn_pairs,sizeof(gt_template*));
+	learner.inserts=gt_vector_new(param->learn_pairs,sizeof(int64_t));
+	gt_buffered_input_file* buffered_input1=gt_buffered_input_file_new(input_file1);
+	gt_buffered_input_file* buffered_input2=input_file2?gt_buffered_input_file_new(input_file2):NULL;
+	gt_template *template=gt_template_new();
+	gt_status error_code;
+	const uint64_t max_templates=param->learn_pairs*LEARN_MAX_TEMPLATES_PER_PAIR;
+	while((gt_vector_get_used(learner.inserts)<param->learn_pairs && gt_vector_get_used(learner.templates)<max_templates) ||
+			!gt_buffered_input_file_eob(buffered_input1)) {
+		if(!(error_code=read_paired_template(buffered_input1,buffered_input2,mutex,template,param))) break;
+		if(error_code==GT_IMP_OK) learn_template(template);
+	}
+	gt_template_delete(template);
+	gt_buffered_input_file_close(buffered_input1);
+	if(buffered_input2) gt_buffered_input_file_close(buffered_input2);
+	if(param->verbose) {
+		fprintf(stderr,"Learning insert distribution from %"PRIu64" pairs (%"PRIu64" templates kept)\n",
+				(uint64_t)gt_vector_get_used(learner.inserts),(uint64_t)gt_vector_get_used(learner.templates));
+	}
+	if(gt_vector_get_used(learner.inserts)<param->learn_pairs && gt_vector_get_used(learner.templates)>=max_templates) {
+		fprintf(stderr,"Not enough uniquely mapped pairs to learn the insert distribution\n");
+	} else set_learned_ins_dist(param);
+	gt_vector_delete(learner.inserts);
+	learner.inserts=NULL;
+}
+
+static void score_learned_templates(gt_buffered_output_file *buffered_output,sr_param *param)
+{
+	if(!learner.templates) return;
+	const uint64_t num_templates=gt_vector_get_used(learner.templates);
+	uint64_t i;
+	while((i=__sync_fetch_and_add(&learner.next_template,1))<num_templates) {
+		gt_template *template=*gt_vector_get_elm(learner.templates,i,gt_template*);
+		pair_read(template,gt_template_get_block(template,0),gt_template_get_block(template,1),param);
+		if (gt_output_generic_bofprint_template(buffered_output,template,param->printer_attr)) {
+			gt_error_msg("Fatal error outputting read '"PRIgts"'\n",PRIgts_content(gt_template_get_string_tag(template)));
+		}
+		gt_template_delete(template);
+	}
+}
+
 int parse_arguments(int argc,char** argv) {
 	int err=0;
 	param.parser_attr=gt_input_generic_parser_attributes_new(false);
@@ -324,7 +525,7 @@ int parse_arguments(int argc,char** argv) {
   gt_string* const gt_scorereads_short_getopt = gt_options_adaptor_getopt_short(gt_scorereads_options);
   int option, option_index;
   char *p;
-  int insert_set[2]={0,0};
+  int *insert_set=param.insert_set;
   while (true) {
     // Get option &  Select case
     if ((option=getopt_long(argc,argv,
@@ -334,6 +535,13 @@ int parse_arguments(int argc,char** argv) {
     case 'i':
     	param.dist_file = optarg;
     	break;
+    case 404:
+    	param.learn_pairs=strtoul(optarg,&p,10);
+    	if(*p || param.learn_pairs==0) {
+    		fprintf(stderr,"Illegal number of pairs to learn the insert distribution: '%s'\n",optarg);
+    		err=-7;
+    	}
+    	break;
     case 'o':
     	param.output_file = optarg;
     	break;
@@ -413,6 +621,9 @@ int parse_arguments(int argc,char** argv) {
       param.num_threads = atol(optarg);
 #endif
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
     case 'h':
       usage(gt_scorereads_options,gt_scorereads_groups,false);
       exit(1);
@@ -439,6 +650,10 @@ int parse_arguments(int argc,char** argv) {
     usage(gt_scorereads_options,gt_scorereads_groups,false);
 		err=-15;
 	}
+	if(!err && param.dist_file && param.learn_pairs) {
+		fputs("Options --insert-dist and --learn-insert-dist are mutually exclusive\n",stderr);
+		err=-15;
+	}
 	if(!err) {
 		if(param.output_file && param.compress!=NONE) {
 			size_t l=strlen(param.output_file);
@@ -461,10 +676,14 @@ int parse_arguments(int argc,char** argv) {
 				break;
 			}
 		}
-		if(gt_input_generic_parser_attributes_is_paired(param.parser_attr) && param.dist_file) read_dist_file(&param,insert_set);
-		else if(!insert_set[1]) {
+		init_qual_score(&param);
+		if(gt_input_generic_parser_attributes_is_paired(param.parser_attr) && param.dist_file) read_dist_file(&param);
+		else {
+			if(!insert_set[1]) {
 				if(param.min_insert<=1000) param.max_insert=1000;
 				else param.max_insert=param.min_insert+1000;
+			}
+			if(!gt_input_generic_parser_attributes_is_paired(param.parser_attr)) param.learn_pairs=0;
 		}
 	}
   // Free
@@ -502,6 +721,7 @@ int main(int argc,char *argv[])
 			if(input_file1->file_format!=MAP || input_file2->file_format!=MAP) {
 				gt_fatal_error_msg("Fatal error: paired files '%s','%s' are not in MAP format\n",param.input_files[0],param.input_files[1]);
 			}
+			if(param.learn_pairs) learn_ins_dist(input_file1,input_file2,&mutex,&param);
 #ifdef HAVE_OPENMP
 #pragma omp parallel num_threads(param.num_threads)
 #endif
@@ -512,28 +732,11 @@ int main(int argc,char *argv[])
 				gt_buffered_input_file_attach_buffered_output(buffered_input1,buffered_output);
 				gt_status error_code;
 				gt_template *template=gt_template_new();
-				while(gt_input_map_parser_synch_blocks(buffered_input1,buffered_input2,&mutex)) {
-					error_code=gt_input_map_parser_get_template(buffered_input1,template,NULL);
-					if(error_code!=GT_IMP_OK) {
-						gt_input_map_parser_get_template(buffered_input2,template,NULL);
-						gt_error_msg("Error parsing file '%s'\n",param.input_files[0]);
-						continue;
-					}
-					if(gt_template_get_num_blocks(template)!=1) {
-						gt_error_msg("Error parsing files '%s','%s': wrong number of blocks\n",param.input_files[0],param.input_files[1]);
-						continue;
-					}
+				score_learned_templates(buffered_output,&param);
+				while((error_code=read_paired_template(buffered_input1,buffered_input2,&mutex,template,&param))) {
+					if(error_code!=GT_IMP_OK) continue;
 					gt_alignment *alignment1=gt_template_get_block(template,0);
-					gt_alignment *alignment2=gt_template_get_block_dyn(template,1);
-					error_code=gt_input_map_parser_get_alignment(buffered_input2,alignment2,NULL);
-					if (error_code!=GT_IMP_OK) {
-						gt_error_msg("Error parsing file '%s'\n",param.input_files[1]);
-						continue;
-					}
-					if(!(gt_string_nequals(template->tag,alignment2->tag,gt_string_get_length(template->tag)))) {
-						gt_error_msg("Fatal ID mismatch ('%*s','%*s') parsing files '%s','%s'\n",PRIgts_content(template->tag),PRIgts_content(alignment2->tag),param.input_files[0],param.input_files[1]);
-						break;
-					}
+					gt_alignment *alignment2=gt_template_get_block(template,1);
 					pair_read(template,alignment1,alignment2,&param);
 					if (gt_output_generic_bofprint_template(buffered_output,template,param.printer_attr)) {
 						gt_error_msg("Fatal error outputting read '"PRIgts"'\n",PRIgts_content(gt_template_get_string_tag(template)));
@@ -548,6 +751,7 @@ int main(int argc,char *argv[])
 			gt_input_file_close(input_file2);
 		} else { // Single input file (could be single end or interleaved paired end
 			gt_input_file* input_file=param.input_files[0]?gt_input_file_open(param.input_files[0],param.mmap_input):gt_input_stream_open(stdin);
+			if(param.learn_pairs) learn_ins_dist(input_file,NULL,NULL,&param);
 #ifdef OPENMP
 #pragma omp parallel num_threads(param.num_threads)
 #endif
@@ -558,11 +762,9 @@ int main(int argc,char *argv[])
 				gt_status error_code;
 				gt_template *template=gt_template_new();
 				if(gt_input_generic_parser_attributes_is_paired(param.parser_attr)) {
-					while ((error_code=gt_input_generic_parser_get_template(buffered_input,template,param.parser_attr))) {
-						if (error_code!=GT_IMP_OK) {
-							gt_error_msg("Error parsing file '%s'\n",param.input_files[0]);
-							continue;
-						}
+					score_learned_templates(buffered_output,&param);
+					while ((error_code=read_paired_template(buffered_input,NULL,NULL,template,&param))) {
+						if (error_code!=GT_IMP_OK) continue;
 						gt_alignment *alignment1=gt_template_get_block(template,0);
 						gt_alignment *alignment2=gt_template_get_block(template,1);
 						pair_read(template,alignment1,alignment2,&param);
@@ -578,8 +780,8 @@ int main(int argc,char *argv[])
 						}
 						gt_alignment *alignment=gt_template_get_block(template,0);
 						gt_alignment_recalculate_counters(alignment);
+						score_alignment(alignment,&param);
 						GT_ALIGNMENT_ITERATE(alignment,map) {
-							if(map->gt_score==GT_MAP_NO_GT_SCORE) map->gt_score=calculate_dist_score(alignment,map,param.qual_offset,param.indel_quality);
 							map->phred_score=255;
 						}
 						if (gt_output_generic_bofprint_alignment(buffered_output,alignment,param.printer_attr)) {
@@ -596,11 +798,17 @@ int main(int argc,char *argv[])
 		}
 		gt_output_file_close(output_file);
 		gt_generic_printer_attributes_delete(param.printer_attr);
+		if(learner.templates) gt_vector_delete(learner.templates);
 		if(param.ins_dist) {
 			free(param.ins_dist);
 			free(param.ins_phred);
 		}
 	}
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
 	return err;
 }
 
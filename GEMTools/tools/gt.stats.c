@@ -25,6 +25,7 @@ typedef struct {
   bool mmap_input;
   bool paired_end;
   uint64_t num_reads;
+  uint64_t sample_input;
   /* [Tests] */
   bool first_map;
   bool maps_profile;
@@ -40,6 +41,12 @@ typedef struct {
   bool compact; // FIXME Deleteme
   bool print_json;
   bool print_both;
+  /* [Snapshots] */
+  uint64_t snapshot_reads;
+  double snapshot_seconds;
+  char* name_snapshot_file;
+  FILE* snapshot_file;
+  double convergence_tolerance;
   /* [Misc] */
   uint64_t num_threads;
 } gt_stats_args;
@@ -52,6 +59,7 @@ gt_stats_args parameters = {
     .mmap_input=false,
     .paired_end=false,
     .num_reads=0,
+    .sample_input=0,
     .output_file=NULL,
     .output_file_json=NULL,
     /* [Tests] */
@@ -71,6 +79,12 @@ gt_stats_args parameters = {
     .num_threads=1,
     .print_json=false,
     .print_both=false,
+    /* [Snapshots] */
+    .snapshot_reads=0,
+    .snapshot_seconds=0.0,
+    .name_snapshot_file=NULL,
+    .snapshot_file=NULL,
+    .convergence_tolerance=0.0,
 };
 /*
  * STATS Print results
@@ -421,13 +435,134 @@ void gt_stats_print_stats_compact(gt_stats* const stats,uint64_t num_reads,const
   fprintf(parameters.output_file,"%2.3f\n",num_templates?100.0*(float)all_uniq/(float)num_templates:0.0);
 }
 
+/*
+ * Incremental stats (Snapshots & Convergence)
+ *   Each thread accumulates into its own stats and periodically folds them into
+ *   the global stats. Snapshots are emitted (one JSON per line) from the global stats
+ */
+#define GT_STATS_FOLD_INTERVAL 10000 /* Max. templates accumulated per thread before folding */
+#define GT_STATS_CONVERGENCE_ROUNDS 3 /* Consecutive stable snapshots required to stop */
+#define GT_STATS_CONVERGENCE_SNAPSHOT_READS 100000 /* Snapshot period if only --converge is given */
+
+typedef struct {
+  gt_stats* stats; // Global stats
+  pthread_mutex_t mutex;
+  // Snapshots
+  struct timeval start_time;
+  struct timeval last_snapshot_time;
+  uint64_t last_snapshot_reads;
+  uint64_t num_snapshots;
+  // Convergence
+  double last_mapping_rate;
+  double last_inss_median;
+  uint64_t num_stable_snapshots;
+  volatile bool converged;
+} gt_stats_accumulator;
+
+double gt_stats_get_mapping_rate(gt_stats* const stats) {
+  return GT_DIV_F(stats->num_mapped,stats->num_alignments);
+}
+double gt_stats_get_inss_median(gt_stats* const stats) {
+  uint64_t* const inss = stats->maps_profile->inss;
+  uint64_t i, total = 0, acc = 0;
+  for (i=0;i<GT_STATS_INSS_RANGE;++i) total += inss[i];
+  if (total==0) return 0.0;
+  for (i=0;i<GT_STATS_INSS_RANGE;++i) {
+    acc += inss[i];
+    if (2*acc >= total) break;
+  }
+  return GT_STATS_INSS_MIN+(int64_t)i*GT_STATS_INSS_STEP;
+}
+void gt_stats_accumulator_init(gt_stats_accumulator* const accumulator) {
+  accumulator->stats = gt_stats_new();
+  gt_cond_fatal_error(pthread_mutex_init(&accumulator->mutex,NULL),SYS_MUTEX_INIT);
+  gettimeofday(&accumulator->start_time,NULL);
+  accumulator->last_snapshot_time = accumulator->start_time;
+  accumulator->last_snapshot_reads = 0;
+  accumulator->num_snapshots = 0;
+  accumulator->last_mapping_rate = 0.0;
+  accumulator->last_inss_median = 0.0;
+  accumulator->num_stable_snapshots = 0;
+  accumulator->converged = false;
+}
+void gt_stats_accumulator_destroy(gt_stats_accumulator* const accumulator) {
+  gt_cond_fatal_error(pthread_mutex_destroy(&accumulator->mutex),SYS_MUTEX_DESTROY);
+}
+void gt_stats_accumulator_check_convergence(gt_stats_accumulator* const accumulator) {
+  gt_stats* const stats = accumulator->stats;
+  const double mapping_rate = gt_stats_get_mapping_rate(stats);
+  const double inss_median = gt_stats_get_inss_median(stats);
+  if (accumulator->num_snapshots > 1) {
+    const double tolerance = parameters.convergence_tolerance;
+    bool stable = GT_ABS(mapping_rate-accumulator->last_mapping_rate) <= tolerance;
+    if (parameters.paired_end) {
+      const double inss_delta = GT_ABS(inss_median-accumulator->last_inss_median);
+      stable = stable && (inss_delta <= tolerance*GT_MAX(1.0,GT_ABS(accumulator->last_inss_median)));
+    }
+    accumulator->num_stable_snapshots = (stable) ? accumulator->num_stable_snapshots+1 : 0;
+    accumulator->converged = (accumulator->num_stable_snapshots >= GT_STATS_CONVERGENCE_ROUNDS);
+  }
+  accumulator->last_mapping_rate = mapping_rate;
+  accumulator->last_inss_median = inss_median;
+}
+void gt_stats_accumulator_print_snapshot(gt_stats_accumulator* const accumulator,struct timeval* const now) {
+  gt_stats* const stats = accumulator->stats;
+  JsonNode* root = json_mkobject();
+  json_append_member(root, "snapshot", json_mknumber(accumulator->num_snapshots));
+  json_append_member(root, "elapsed_seconds", json_mknumber(GT_TIME_DIFF(accumulator->start_time,(*now))));
+  json_append_member(root, "mapping_rate", json_mknumber(gt_stats_get_mapping_rate(stats)));
+  if (parameters.paired_end) {
+    json_append_member(root, "insert_size_median", json_mknumber(gt_stats_get_inss_median(stats)));
+  }
+  json_append_member(root, "converged", json_mkbool(accumulator->converged));
+  json_append_member(root, "general", gt_stats_print_json_general_stats(stats,stats->num_blocks,parameters.paired_end));
+  json_append_member(root, "maps_profile", gt_stats_print_json_maps_profile(stats,stats->num_blocks,parameters.paired_end));
+  json_append_member(root, "splits_profile", gt_stats_print_json_splits_profile(stats,stats->num_blocks,parameters.paired_end));
+  char* const snapshot = json_stringify(root,NULL);
+  fprintf(parameters.snapshot_file,"%s\n",snapshot);
+  fflush(parameters.snapshot_file);
+  free(snapshot);
+  json_delete(root);
+}
+void gt_stats_accumulator_fold(gt_stats_accumulator* const accumulator,gt_stats* const stats) {
+  GT_BEGIN_MUTEX_SECTION(accumulator->mutex) {
+    gt_stats_merge_pair(accumulator->stats,stats);
+    // Snapshot (every N reads or seconds)
+    const uint64_t num_reads = accumulator->stats->num_blocks;
+    struct timeval now;
+    gettimeofday(&now,NULL);
+    const bool snapshot_reads = parameters.snapshot_reads>0 &&
+        num_reads-accumulator->last_snapshot_reads >= parameters.snapshot_reads;
+    const bool snapshot_seconds = parameters.snapshot_seconds>0.0 &&
+        GT_TIME_DIFF(accumulator->last_snapshot_time,now) >= parameters.snapshot_seconds;
+    if (num_reads>0 && !accumulator->converged && (snapshot_reads || snapshot_seconds)) {
+      ++accumulator->num_snapshots;
+      accumulator->last_snapshot_reads = num_reads;
+      accumulator->last_snapshot_time = now;
+      if (parameters.convergence_tolerance>0.0) gt_stats_accumulator_check_convergence(accumulator);
+      gt_stats_accumulator_print_snapshot(accumulator,&now);
+    }
+  } GT_END_MUTEX_SECTION(accumulator->mutex);
+  gt_stats_clear(stats);
+}
+
 /*
  * CORE functions
  */
+void* gt_stats_reference_loader(void* const loader_arg) {
+  gt_sequence_archive* const sequence_archive = gt_sequence_archive_new(GT_CDNA_ARCHIVE);
+  gt_input_file* const reference_file = gt_input_file_open(parameters.name_reference_file,false);
+  if (gt_input_multifasta_parser_get_archive(reference_file,sequence_archive)!=GT_IFP_OK) {
+    fprintf(stderr,"\n");
+    gt_fatal_error_msg("Error parsing reference file '%s'\n",parameters.name_reference_file);
+  }
+  gt_input_file_close(reference_file);
+  return sequence_archive;
+}
 void gt_stats_parallel_generate_stats() {
   // Stats info
   gt_stats_analysis stats_analysis = GT_STATS_ANALYSIS_DEFAULT();
-  gt_stats** stats = gt_calloc(parameters.num_threads,gt_stats*,false);
+  gt_stats** stats = gt_calloc(parameters.num_threads,gt_stats*,true);
 
   // Select analysis
   stats_analysis.first_map = parameters.first_map;
@@ -441,18 +576,29 @@ void gt_stats_parallel_generate_stats() {
   // Open file
   gt_input_file* input_file = (parameters.name_input_file==NULL) ?
       gt_input_stream_open(stdin) : gt_input_file_open(parameters.name_input_file,parameters.mmap_input);
+  if (parameters.sample_input>0) gt_input_file_set_sampling(input_file,parameters.sample_input);
 
-  gt_sequence_archive* sequence_archive = NULL;
+  // Reference (one replica per NUMA node)
+  void** sequence_archives = NULL;
   if (stats_analysis.indel_profile) {
-    sequence_archive = gt_sequence_archive_new(GT_CDNA_ARCHIVE);
-    gt_input_file* const reference_file = gt_input_file_open(parameters.name_reference_file,false);
-    if (gt_input_multifasta_parser_get_archive(reference_file,sequence_archive)!=GT_IFP_OK) {
-      fprintf(stderr,"\n");
-      gt_fatal_error_msg("Error parsing reference file '%s'\n",parameters.name_reference_file);
-    }
-    gt_input_file_close(reference_file);
+    sequence_archives = gt_numa_replicate(gt_stats_reference_loader,NULL);
   }
 
+  // Incremental mode (threads periodically fold their stats into @accumulator)
+  const bool incremental = parameters.snapshot_reads>0 ||
+      parameters.snapshot_seconds>0.0 || parameters.convergence_tolerance>0.0;
+  gt_stats_accumulator accumulator;
+  uint64_t fold_interval = UINT64_MAX;
+  if (incremental) {
+    gt_stats_accumulator_init(&accumulator);
+    fold_interval = (parameters.snapshot_reads>0) ?
+        GT_MIN(GT_STATS_FOLD_INTERVAL,GT_MAX(1,parameters.snapshot_reads/parameters.num_threads)) : GT_STATS_FOLD_INTERVAL;
+  }
+
+  // Per-thread stats (sharing the global diversity set). Each thread allocates its own (node-local)
+  uint64_t i;
+  stats[0] = (incremental) ? gt_stats_new_shared(accumulator.stats) : gt_stats_new();
+
   // Parallel reading+process
 #ifdef HAVE_OPENMP
   #pragma omp parallel num_threads(parameters.num_threads)
@@ -463,12 +609,15 @@ void gt_stats_parallel_generate_stats() {
 #else
     uint64_t tid = 0;
 #endif
+    gt_numa_bind_thread(tid,parameters.num_threads);
+    if (tid>0) stats[tid] = gt_stats_new_shared(stats[0]);
+    gt_sequence_archive* const sequence_archive =
+        (sequence_archives!=NULL) ? gt_numa_get_replica(sequence_archives) : NULL;
 
     gt_buffered_input_file* buffered_input = gt_buffered_input_file_new(input_file);
 
     gt_status error_code;
     gt_template *template = gt_template_new();
-    stats[tid] = gt_stats_new();
     gt_generic_parser_attributes* generic_parser_attribute = gt_input_generic_parser_attributes_new(parameters.paired_end);
     while ((error_code=gt_input_generic_parser_get_template(buffered_input,template,generic_parser_attribute))) {
       if (error_code!=GT_IMP_OK) {
@@ -477,15 +626,37 @@ void gt_stats_parallel_generate_stats() {
 
       // Extract stats
       gt_stats_calculate_template_stats(stats[tid],template,sequence_archive,&stats_analysis);
+
+      // Fold into the global stats (and stop early if converged)
+      if (stats[tid]->num_alignments >= fold_interval) {
+        gt_stats_accumulator_fold(&accumulator,stats[tid]);
+        if (accumulator.converged) break;
+      }
     }
+    if (incremental) gt_stats_accumulator_fold(&accumulator,stats[tid]);
 
     // Clean
     gt_template_delete(template);
     gt_buffered_input_file_close(buffered_input);
   }
 
+  // Threads not spawned (if any)
+  for (i=1;i<parameters.num_threads;++i) {
+    if (stats[i]==NULL) stats[i] = gt_stats_new_shared(stats[0]);
+  }
+
   // Merge stats
-  gt_stats_merge(stats,parameters.num_threads);
+  if (incremental) {
+    for (i=0;i<parameters.num_threads;++i) gt_stats_delete(stats[i]);
+    stats[0] = accumulator.stats;
+    gt_stats_accumulator_destroy(&accumulator);
+    if (parameters.verbose && accumulator.converged) {
+      fprintf(stderr,"[GTStats] Converged after %"PRIu64" reads (%"PRIu64" snapshots)\n",
+          stats[0]->num_blocks,accumulator.num_snapshots);
+    }
+  } else {
+    gt_stats_merge(stats,parameters.num_threads);
+  }
 
   /*
    * Print Statistics
@@ -541,6 +712,9 @@ void parse_arguments(int argc,char** argv) {
     case 'n': // num-reads
       parameters.num_reads = atol(optarg);
       break;
+    case 201: // sample-input
+      parameters.sample_input = atol(optarg);
+      break;
     case 'o': // output
       parameters.name_output_file = optarg;
       break;
@@ -590,6 +764,19 @@ void parse_arguments(int argc,char** argv) {
     case 400:
       parameters.use_only_decoded_maps = true;
       break;
+    /* Snapshots */
+    case 500: // snapshot-reads
+      parameters.snapshot_reads = atol(optarg);
+      break;
+    case 501: // snapshot-seconds
+      parameters.snapshot_seconds = atof(optarg);
+      break;
+    case 502: // snapshot-output
+      parameters.name_snapshot_file = optarg;
+      break;
+    case 503: // converge
+      parameters.convergence_tolerance = atof(optarg);
+      break;
     /* Misc */
     case 't':
 #ifdef HAVE_OPENMP
@@ -599,6 +786,12 @@ void parse_arguments(int argc,char** argv) {
     case 'v':
       parameters.verbose = true;
       break;
+    case 1100: // profile
+      gt_profiler_stages_enable();
+      break;
+    case 1101: // numa
+      gt_numa_enable();
+      break;
     case 'h':
       fprintf(stderr, "USE: ./gt.stats [ARGS]...\n");
       gt_options_fprint_menu(stderr,gt_stats_options,gt_stats_groups,false,false);
@@ -622,6 +815,12 @@ void parse_arguments(int argc,char** argv) {
   if (parameters.indel_profile && parameters.name_reference_file==NULL) {
     gt_error_msg("To generate the indel-profile, a reference file(.fa/.fasta) or GEMindex(.gem) is required");
   }
+  if (parameters.convergence_tolerance<0.0) {
+    gt_fatal_error_msg("Convergence tolerance must be positive");
+  }
+  if (parameters.convergence_tolerance>0.0 && parameters.snapshot_reads==0 && parameters.snapshot_seconds<=0.0) {
+    parameters.snapshot_reads = GT_STATS_CONVERGENCE_SNAPSHOT_READS;
+  }
   // Free
   gt_string_delete(gt_stats_short_getopt);
 }
@@ -644,13 +843,26 @@ int main(int argc,char** argv) {
   if(parameters.print_json && !parameters.print_both){
     parameters.output_file_json = parameters.output_file;
   }
+  parameters.snapshot_file = stderr;
+  if (parameters.name_snapshot_file != NULL) {
+    parameters.snapshot_file = fopen(parameters.name_snapshot_file, "w");
+    gt_cond_fatal_error(parameters.snapshot_file==NULL,FILE_OPEN,parameters.name_snapshot_file);
+  }
   // Extract stats
   gt_stats_parallel_generate_stats();
   // close output
   if(parameters.name_output_file != NULL){
     fclose(parameters.output_file);
   }
+  if (parameters.name_snapshot_file != NULL) {
+    fclose(parameters.snapshot_file);
+  }
 
+  // Stage profile
+  if (gt_profiler_stages_enabled) {
+    gt_json_profiler_stages_fprint(stderr);
+    gt_profiler_stages_destroy();
+  }
   return 0;
 }
 
@@ -145,6 +145,7 @@ executables = execs_dict({
     "gt.map.2.sam": "gt.map.2.sam",
     "gt.mapset": "gt.mapset",
     "gt.gtfcount": "gt.gtfcount",
+    "gt.junctions": "gt.junctions",
     "gt.stats": "gt.stats"
     })
 
@@ -1160,23 +1161,16 @@ def merge(master, slaves, output=None, paired=False, same_content=False,
     # create tmpdir for the fifos
     tmpdir = tempfile.mkdtemp()
     gem.files.delete_on_exit.append(tmpdir)
-    current_master = master
-    current_process = None
-    for i, slave in enumerate(slaves):
-        current_output = None
-        if i == (len(slaves) - 1):
-            # last one
-            current_output = merge_out
-        current_process = _merge_two(current_master, slave, current_output,
-                                     tmpdir, i, paired, same_content, threads)
-        current_master = current_process.stdout
-    return _prepare_output(current_process, output=output)
-
-
-def _merge_two(master, slave, output, tmpdir, count,
+    # merge all the slaves in a single pass
+    process = _merge_all(master, slaves, merge_out, tmpdir,
+                         paired, same_content, threads)
+    return _prepare_output(process, output=output)
+
+
+def _merge_all(master, slaves, output, tmpdir,
                paired=False, same_content=False, threads=1):
-    """Helper function to merge to files. Return the merging
-    process.
+    """Helper function to merge the master with all the slaves
+    in one gt.mapset process. Return the merging process.
     """
     pa = [executables['gt.mapset'], '-C', 'merge-map', '-t', str(threads)]
     if paired:
@@ -1184,7 +1178,6 @@ def _merge_two(master, slave, output, tmpdir, count,
     if same_content:
         pa.append('-s')
 
-
     inmaster = master
     if isinstance(inmaster, basestring):  # from string
         inmaster = gem.files.open_file(inmaster)
@@ -1192,29 +1185,28 @@ def _merge_two(master, slave, output, tmpdir, count,
         inmaster = inmaster.stdout
     elif isinstance(inmaster, gt.InputFile):  # from gt input file
         inmaster = inmaster.raw_stream()
-
-    inslave = slave
-    fifo_in = None
-    fifo_out = None
-    if not isinstance(inslave, basestring):
-        # create a fifo and
-        filename = os.path.join(tmpdir, "%d" % count)
-        os.mkfifo(filename)
-        if not hasattr(inslave, 'stdout'):
-            inslave = inslave.raw_stream()
-        fifo_in = inslave
-        inslave = filename
+    pa.extend(['--i1', '-'])
+
+    # non-file slaves are streamed through fifos
+    fifos = []
+    for count, inslave in enumerate(slaves):
+        if not isinstance(inslave, basestring):
+            filename = os.path.join(tmpdir, "%d" % count)
+            os.mkfifo(filename)
+            if not hasattr(inslave, 'stdout'):
+                inslave = inslave.raw_stream()
+            fifos.append((filename, inslave))
+            inslave = filename
+        pa.extend(['--i2', inslave])
 
     if output is None:
         output = subprocess.PIPE
     elif isinstance(output, basestring):
         output = open(output, 'wb')
 
-    pa.append('--i1')
-    pa.append(inslave)
-
     p = subprocess.Popen(pa, stdin=inmaster, stdout=output)
-    if fifo_in is not None:
+    # gt.mapset opens the slaves in order, so do the fifos
+    for filename, fifo_in in fifos:
         fifo_out = open(filename, 'wb')
         subprocess.Popen(['cat'], stdin=fifo_in, stdout=fifo_out)
     return p
@@ -182,6 +182,10 @@ def interleave(reads, exclude=-1, threads=1):
     return gt.interleave(reads, threads=threads)
 
 
+def paired(reads, threads=1):
+    return gt.paired(reads, threads=threads)
+
+
 def cat(reads):
     return gt.cat(reads)
 
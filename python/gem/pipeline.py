@@ -7,6 +7,10 @@ import os
 import errno
 import signal
 import traceback
+import datetime
+import resource
+import select
+import multiprocessing
 
 from gem.utils import Timer
 import gem.gemtools as gt
@@ -40,9 +44,23 @@ class PipelineStep(object):
         self._files = None
         self.configuration = None
         self.final = final
+        self._threads = None
         if dependencies is not None:
             self.dependencies.extend(dependencies)
 
+    @property
+    def threads(self):
+        """Number of threads this step can use. Assigned by the
+        pipeline scheduler, defaults to all the pipeline threads
+        """
+        if self._threads is None:
+            return self.pipeline.threads
+        return self._threads
+
+    @threads.setter
+    def threads(self, threads):
+        self._threads = threads
+
     def prepare(self, id, pipeline, configuration):
         """Implement this to prepare the step"""
         self.pipeline = pipeline
@@ -102,6 +120,13 @@ class PipelineStep(object):
             return self.pipeline.open_input()
         return self.pipeline.open_step(self.dependencies[-1], raw=raw)
 
+    def streamed_dependencies(self):
+        """Return the dependencies whose output this step reads
+        exactly once, front to back. In streaming mode, only these
+        can be connected to the step through a named pipe
+        """
+        return self.dependencies[-1:]
+
     def open(self, raw=False):
         """Open the steps output. The default implementation
         opnes the last file"""
@@ -121,10 +146,11 @@ class PipelineStep(object):
         """Return true if this step is done and
         does not need execution
 
-        The basic implementation checks if all files exists
+        The basic implementation checks if all files exists. A named
+        pipe left behind by a streamed run does not count
         """
         for f in self.files():
-            if not os.path.exists(f):
+            if not os.path.isfile(f):
                 return False
         return True
 
@@ -168,7 +194,7 @@ class MergeStep(PipelineStep):
         master = inputs[0]
         slaves = inputs[1:]
         mapping = gem.merge(master, slaves, output=self._output(),
-                            threads=self.pipeline.threads,
+                            threads=self.threads,
                             same_content=same_content,
                             paired=False,
                             compress=self._compress())
@@ -176,7 +202,7 @@ class MergeStep(PipelineStep):
         if self.final:
             gem.score(mapping, self.configuration["index"], self._final_output(),
                 filter=self.pipeline.filter,
-                threads=max(2, self.pipeline.threads / 2),
+                threads=max(2, self.threads / 2),
                 quality=self.pipeline.quality,
                 compress=self.pipeline.compress
             )
@@ -188,6 +214,9 @@ class MergeStep(PipelineStep):
             raise PipelineError("You have to specify what to merge!")
         return [self.pipeline.open_step(i) for i in self.dependencies if i >= 0]
 
+    def streamed_dependencies(self):
+        return [i for i in self.dependencies if i >= 0]
+
 
 class FilterStep(PipelineStep):
     """Filter the result mapping"""
@@ -217,7 +246,7 @@ class FilterStep(PipelineStep):
             max_multi_maps=cfg['max_multi_maps'],
             gene_pairing=cfg['filter_annotation'] if cfg['annotation'] is not None else False,
             junction_filter=cfg['filter_annotation'] if cfg['annotation'] is not None else False,
-            threads=self.pipeline.threads,
+            threads=self.threads,
             keep_unique=True,
         )
 
@@ -232,7 +261,7 @@ class MergeAndPairStep(PipelineStep):
         slaves = inputs[1:]
 
         mapping = gem.merge(master, slaves, output=None,
-                            threads=max(1, self.pipeline.threads / 2),  # self.pipeline.threads,
+                            threads=max(1, self.threads / 2),  # self.threads,
                             same_content=same_content,
                             paired=False,
                             compress=self._compress())
@@ -250,7 +279,7 @@ class MergeAndPairStep(PipelineStep):
           min_matched_bases=cfg["min_matched_bases"],
           max_extendable_matches=cfg["max_extendable_matches"],
           max_matches_per_extension=cfg["max_matches_per_extension"],
-          threads=max(1, self.pipeline.threads / 2),  # self.pipeline.threads,
+          threads=max(1, self.threads / 2),  # self.threads,
           filter_max_matches=0,
           quality=self.pipeline.quality,
           compress=self._compress())
@@ -258,7 +287,7 @@ class MergeAndPairStep(PipelineStep):
         if self.final:
             gem.score(pair_mapping, cfg["index"], self._final_output(),
                 filter=self.pipeline.filter,
-                threads=max(1, self.pipeline.threads / 2),
+                threads=max(1, self.threads / 2),
                 quality=self.pipeline.quality,
                 compress=self.pipeline.compress,
                 raw=True)
@@ -270,6 +299,9 @@ class MergeAndPairStep(PipelineStep):
             raise PipelineError("You have to specify what to merge!")
         return [self.pipeline.open_step(i) for i in self.dependencies if i >= 0]
 
+    def streamed_dependencies(self):
+        return [i for i in self.dependencies if i >= 0]
+
 
 class CreateStatsStep(PipelineStep):
     """Create stats file"""
@@ -288,7 +320,7 @@ class CreateStatsStep(PipelineStep):
         infile = self._input()
         gem.stats(infile, output=outputs[0], json_output=outputs[1],
                   paired=cfg['paired'],
-                  threads=self.pipeline.threads)
+                  threads=self.threads)
 
 
 class CreateGtfStatsStep(PipelineStep):
@@ -314,7 +346,7 @@ class CreateGtfStatsStep(PipelineStep):
         counts_exon_threshold = cfg['counts_exon_threshold']
         gem.gtfcounts(infile, cfg['annotation'], output=output,
                       counts=gene_counts, json_output=json_stats,
-                      threads=self.pipeline.threads, weight=counts_weighted,
+                      threads=self.threads, weight=counts_weighted,
                       multimaps=counts_multimaps, paired=cfg['paired'],
                       coverage=True,
                       exon_threshold=counts_exon_threshold)
@@ -332,14 +364,14 @@ class CreateBamStep(PipelineStep):
     def run(self):
         cfg = self.configuration
         sam = gem.gem2sam(self._input(), cfg["index"],
-                          threads=self.pipeline.threads,
+                          threads=self.threads,
                           quality=self.pipeline.quality,
                           consensus=cfg['consensus'],
                           exclude_header=cfg['sam_no_seq_header'],
                           compact=cfg['sam_compact'],
                           single_end=not cfg['paired'],
                           calc_xs=cfg['calc_xs'])
-        gem.sam2bam(sam, self._final_output(), sorted=cfg["sort"], mapq=cfg["mapq"], threads=self.pipeline.threads, sort_memory=self.pipeline.sort_memory)
+        gem.sam2bam(sam, self._final_output(), sorted=cfg["sort"], mapq=cfg["mapq"], threads=self.threads, sort_memory=self.pipeline.sort_memory)
 
 
 class IndexBamStep(PipelineStep):
@@ -355,6 +387,10 @@ class IndexBamStep(PipelineStep):
         #cfg = self.configuration
         gem.bamIndex(self._input(raw=True), self._final_output())
 
+    def streamed_dependencies(self):
+        """samtools index needs the BAM file on disk"""
+        return []
+
 
 class MapStep(PipelineStep):
     """Mapping step"""
@@ -375,13 +411,13 @@ class MapStep(PipelineStep):
             delta=cfg["strata_after_best"],
             trim=cfg["trim"],
             quality=self.pipeline.quality,
-            threads=self.pipeline.threads,
+            threads=self.threads,
             compress=self._compress()
         )
         if self.final:
             gem.score(mapping, cfg["index"], self._final_output(),
                 filter=self.pipeline.filter,
-                threads=max(2, self.pipeline.threads / 2),
+                threads=max(2, self.threads / 2),
                 quality=self.pipeline.quality,
                 compress=self.pipeline.compress
             )
@@ -404,14 +440,14 @@ class PairalignStep(PipelineStep):
           min_matched_bases=cfg["min_matched_bases"],
           max_extendable_matches=cfg["max_extendable_matches"],
           max_matches_per_extension=cfg["max_matches_per_extension"],
-          threads=self.pipeline.threads,
+          threads=self.threads,
           quality=self.pipeline.quality,
           compress=self._compress())
 
         if self.final:
             gem.score(mapping, cfg["index"], self._final_output(),
                 filter=self.pipeline.filter,
-                threads=max(2, self.pipeline.threads / 2),
+                threads=max(2, self.threads / 2),
                 quality=self.pipeline.quality,
                 compress=self.pipeline.compress)
 
@@ -451,7 +487,7 @@ class CreateDenovoTranscriptomeStep(PipelineStep):
             filter=cfg["filter"],
             splice_consensus=cfg["junctions_consensus"],
             mismatches=cfg["mismatches"],
-            threads=self.pipeline.threads,
+            threads=self.threads,
             strata_after_first=cfg["strata_after_best"],
             coverage=cfg["coverage"],
             min_split=cfg["min_split_length"],
@@ -486,7 +522,7 @@ class CreateDenovoTranscriptomeStep(PipelineStep):
         if max_len <= 0:
             logging.gemtools.gt("Calculating max read length")
             max_len = gem.utils.get_max_read_length(self._input(),
-                                                    threads=self.pipeline.threads)
+                                                    threads=self.threads)
             if max_len < 0:
                 raise PipelineError("Unable to calculate max read length: %s" % file)
             logging.gemtools.gt("Max read length: %d", max_len)
@@ -494,9 +530,13 @@ class CreateDenovoTranscriptomeStep(PipelineStep):
         (denovo_transcriptome, denovo_keys) = gem.compute_transcriptome(max_len, cfg["index"], self.junctions_out, junctions_gtf_out)
 
         logging.gemtools.gt("Indexing denovo transcriptome")
-        gem.index(denovo_transcriptome, self.index_denovo_out, threads=self.pipeline.threads)
+        gem.index(denovo_transcriptome, self.index_denovo_out, threads=self.threads)
         return (self.index_denovo_out, self.denovo_keys)
 
+    def streamed_dependencies(self):
+        """The input might be read twice to compute the max read length"""
+        return []
+
     def cleanup(self, force=False):
         if force or (not self.final and self.pipeline.remove_temp):
             keep = [self.junctions_out, self.denovo_keys, self.denovo_out]
@@ -534,7 +574,7 @@ class ExtractJunctionsStep(PipelineStep):
             filter=cfg["filter"],
             splice_consensus=cfg["junctions_consensus"],
             mismatches=cfg["mismatches"],
-            threads=self.pipeline.threads,
+            threads=self.threads,
             strata_after_first=cfg["strata_after_best"],
             coverage=cfg["coverage"],
             min_split=cfg["min_split_length"],
@@ -576,7 +616,7 @@ class SplitMapStep(PipelineStep):
                 trim=cfg["trim"],
                 filter_splitmaps=True,
                 post_validate=True,
-                threads=self.pipeline.threads,
+                threads=self.threads,
                 extra=None)
         return splitmap
 
@@ -624,12 +664,12 @@ class TranscriptMapStep(PipelineStep):
             trim=cfg["trim"],
             key_file=cfg["keys"],
             quality=self.pipeline.quality,
-            threads=self.pipeline.threads
+            threads=self.threads
         )
         # filter for only split maps
         gem.filter.only_split_maps(mapping,
                                    outfile,
-                                   threads=self.pipeline.threads,
+                                   threads=self.threads,
                                    compress=self._compress())
 
 
@@ -646,6 +686,12 @@ class TranscriptMapStep(PipelineStep):
         else:
             return PipelineStep._input(self, raw=raw)
 
+    def streamed_dependencies(self):
+        if self.configuration["denovo"]:
+            # the last dependency is the denovo index
+            return self.dependencies[:1] if len(self.dependencies) > 1 else []
+        return PipelineStep.streamed_dependencies(self)
+
 
 class MappingPipeline(object):
     """General mapping pipeline class."""
@@ -686,6 +732,9 @@ class MappingPipeline(object):
         self.sort_memory = "768M"  # samtools sort memory
         self.direct_input = False  # if true, skip the preparation step
         self.force = False  # force computation of all steps
+        self.parallel_steps = 0  # max independent steps running concurrently (0 = no limit)
+        self.stream = False  # stream intermediate outputs through named pipes
+        self.step_times = {}  # step id -> (wall time, cpu time, threads) of the last run
 
         self.filter_max_matches = 25
         self.filter_min_strata = 1
@@ -1107,6 +1156,8 @@ class MappingPipeline(object):
         """Open the original input files"""
         if len(self.input) == 1:
             return gem.files.open(self.input[0])
+        elif len(self.input) == 2 and not self.single_end:
+            return gem.filter.paired([gem.files.open(f) for f in self.input], threads=max(1, self.threads / 2))
         else:
             return gem.filter.interleave([gem.files.open(f) for f in self.input], threads=max(1, self.threads / 2))
 
@@ -1332,6 +1383,7 @@ index generated from your annotation.""")
         printer("Sort BAM         : %s", self.bam_sort)
         printer("Index BAM        : %s", self.bam_index)
         printer("Keep Temporary   : %s", not self.remove_temp)
+        printer("Stream Steps     : %s", self.stream)
         printer("")
 
         if not run_step:
@@ -1413,8 +1465,6 @@ index generated from your annotation.""")
                                          "Done" if step.is_done() else "Compute")
             return
 
-        error = False
-
         all_done = True
         final_files = []
         # check final steps if we are not running a set of steps
@@ -1428,7 +1478,7 @@ index generated from your annotation.""")
                 return
 
         time = Timer()
-        times = {}
+        self.step_times = {}
 
         if run_step:
             # sort by id
@@ -1437,82 +1487,34 @@ index generated from your annotation.""")
         if run_step:
             ids = self.run_steps
 
-        step = None
-
-        # register signal handler to catch
-        # interruptions and perform cleanup
-         # register cleanup signal handler
-        def cleanup_in_signal(signal, frame):
-            logging.gemtools.warning("Job step canceled, forcing cleanup!")
-            step.cleanup(force=True)
-
-        signal.signal(signal.SIGINT, cleanup_in_signal)
-        signal.signal(signal.SIGQUIT, cleanup_in_signal)
-        signal.signal(signal.SIGHUP, cleanup_in_signal)
-        signal.signal(signal.SIGTERM, cleanup_in_signal)
-
+        # steps outside the run set count as finished
+        finished = set([s.id for s in self.steps if s.id not in ids])
+        pending = []
         for step_id in ids:
             step = self.steps[step_id]
-
             if run_step:
                 # check dependencies are done
                 for d in step.dependencies:
-                    if not self.steps[d].is_done():
+                    if d not in ids and not self.steps[d].is_done():
                         logging.gemtools.error("Step dependency is not completed : %s", self.steps[d].name)
-                        error = True
-                        break
+                        return
             if run_step or self.force or not step.is_done():
-                logging.gemtools.gt("Running step: %s" % step.name)
-                t = Timer()
-
-                if not os.path.exists(self.output_dir):
-                    # make sure we create the ouput folder
-                    logging.gemtools.warn("Creating output folder %s", self.output_dir)
-                    try:
-                        os.makedirs(self.output_dir)
-                    except OSError as exc: # Python >2.5
-                        if exc.errno == errno.EEXIST and os.path.isdir(path):
-                            pass
-                        else:
-                            logging.gemtools.error("unable to create output folder %s", self.output_dir)
-                            error = True
-                            break
-
-                try:
-                    step.run()
-                except KeyboardInterrupt:
-                    logging.gemtools.warning("Job step canceled, forcing cleanup!")
-                    error = True
-                    step.cleanup(force=True)
-                    break
-                except PipelineError, e:
-                    logging.gemtools.error("Error while executing step %s : %s" % (step.name, str(e)))
-                    logging.gemtools.warning("Cleaning up after failed step : %s", step.name)
-                    step.cleanup(force=True)
-                    error = True
-                    break
-                except gem.utils.ProcessError, e:
-                    logging.gemtools.error("Error while executing step %s : %s" % (step.name, str(e)))
-                    logging.gemtools.warning("Cleaning up after failed step : %s", step.name)
-                    step.cleanup(force=True)
-                    error = True
-                    break
-                except Exception, e:
-                    traceback.print_exc()
-                    logging.gemtools.error("Error while executing step %s : %s" % (step.name, str(e)))
-                    logging.gemtools.warning("Cleaning up after failed step : %s", step.name)
-                    step.cleanup(force=True)
-                    error = True
-                    break
-                finally:
-                    t.stop(step.name + " completed in %s", loglevel=None)
-                    times[step.id] = t.end
-                    if not error:
-                        logging.gemtools.gt("Step %s finished in : %s", step.name, t.end)
-                    else:
-                        logging.gemtools.gt("Step %s failed after : %s", step.name, t.end)
+                pending.append(step_id)
             else:
                 logging.gemtools.warning("Skipping step %s, output already exists" % (step.name))
+                finished.add(step_id)
+
+        if len(pending) > 0 and not os.path.exists(self.output_dir):
+            # make sure we create the ouput folder
+            logging.gemtools.warn("Creating output folder %s", self.output_dir)
+            try:
+                os.makedirs(self.output_dir)
+            except OSError as exc: # Python >2.5
+                if not (exc.errno == errno.EEXIST and os.path.isdir(self.output_dir)):
+                    logging.gemtools.error("unable to create output folder %s", self.output_dir)
+                    return
+
+        error = self.__schedule(pending, finished)
 
         # do celanup if not in error state
         if not error:
@@ -1523,14 +1525,203 @@ index generated from your annotation.""")
             time.stop("Completed in %s", loglevel=None)
             logging.gemtools.gt("Step Times")
             logging.gemtools.gt("-------------------------------------")
+            logging.gemtools.gt("{0:>25} : {1:>10} {2:>10} {3:>8}".format("", "wall", "cpu", "threads"))
             for s in self.steps:
-                if s.id in times:
-                    logging.gemtools.gt("{0:>25} : {1}".format(s.name, times[s.id]))
+                if s.id in self.step_times:
+                    (wall, cpu, threads) = self.step_times[s.id]
+                    logging.gemtools.gt("{0:>25} : {1:>10} {2:>10} {3:>8}".format(s.name, str(wall), str(cpu), threads))
                 else:
                     logging.gemtools.gt("{0:>25} : skipped".format(s.name))
             logging.gemtools.gt("-------------------------------------")
             logging.gemtools.gt("Pipeline run finshed in %s", time.end)
 
+    def __fused_steps(self, pending):
+        """Return the steps whose output is streamed into its consumer
+        through a named pipe instead of a temporary file, as a dict
+        producer id -> consumer id. A pending, non-final step with a single
+        output is fused if exactly one step depends on it, that step is
+        pending too and streams the dependency (streamed_dependencies()).
+        """
+        fused = {}
+        if not self.stream:
+            return fused
+        if not self.remove_temp:
+            logging.gemtools.warning("Keeping temporary files, steps are not streamed")
+            return fused
+        for step_id in pending:
+            step = self.steps[step_id]
+            if step.final or len(step.files()) != 1:
+                continue
+            consumers = [s.id for s in self.steps if step_id in s.dependencies]
+            if len(consumers) == 1 and consumers[0] in pending and \
+                    step_id in self.steps[consumers[0]].streamed_dependencies():
+                fused[step_id] = consumers[0]
+        return fused
+
+    def __schedule(self, pending, finished):
+        """Run the pending steps resolving the dependency graph. Steps whose
+        dependencies are finished start right away (in id order) and share
+        the free threads of the pipeline budget (self.threads). Per step
+        wall time, cpu time and threads are recorded in self.step_times.
+
+        In streaming mode, chains of fused steps (see __fused_steps) are
+        scheduled as a single unit. All the steps of a chain start together,
+        connected through named pipes, and each one gets the threads share
+        of the chain (the steps are throttled by each other).
+        Returns true if any step failed.
+        """
+        error = False
+        running = {}  # step id -> (process, result pipe, timer)
+        free_threads = self.threads
+        max_parallel = self.parallel_steps if self.parallel_steps > 0 else len(pending)
+
+        # group the fused steps into chains
+        fused = self.__fused_steps(pending)
+        chain_of = dict([(i, i) for i in pending])
+        for producer in sorted(fused.keys(), reverse=True):
+            for i in pending:
+                if chain_of[i] == chain_of[producer]:
+                    chain_of[i] = chain_of[fused[producer]]
+        chains = {}
+        for i in pending:
+            chains.setdefault(chain_of[i], []).append(i)
+        for (producer, consumer) in sorted(fused.items()):
+            logging.gemtools.gt("Streaming step %s into %s", self.steps[producer].name, self.steps[consumer].name)
+        active = set()  # running chains
+
+        # register signal handler to catch
+        # interruptions; the steps cleanup on their own
+        parent = os.getpid()
+
+        def cleanup_in_signal(signal, frame):
+            if os.getpid() != parent:
+                # step process killed before installing its own handlers
+                os._exit(1)
+            logging.gemtools.warning("Job step canceled, forcing cleanup!")
+            for (process, conn, t) in running.values():
+                process.terminate()
+
+        signal.signal(signal.SIGINT, cleanup_in_signal)
+        signal.signal(signal.SIGQUIT, cleanup_in_signal)
+        signal.signal(signal.SIGHUP, cleanup_in_signal)
+        signal.signal(signal.SIGTERM, cleanup_in_signal)
+
+        while len(pending) > 0 or len(running) > 0:
+            # start the ready chains
+            ready = []
+            if not error:
+                # negative ids are optional steps that were not created
+                for step_id in pending:
+                    chain = chains[chain_of[step_id]]
+                    if chain[0] == step_id and all(d < 0 or d in finished or d in chain for i in chain for d in self.steps[i].dependencies):
+                        ready.append(chain)
+            for (i, chain) in enumerate(ready):
+                if len(active) >= max_parallel or (free_threads <= 0 and len(active) > 0):
+                    break
+                threads = max(1, free_threads / min(len(ready) - i, max_parallel - len(active)))
+                free_threads -= threads
+                active.add(chain_of[chain[0]])
+                for step_id in chain:
+                    if step_id in fused:
+                        fifo = self.steps[step_id].files()[0]
+                        if os.path.lexists(fifo):
+                            os.remove(fifo)
+                        os.mkfifo(fifo)
+                for step_id in chain:
+                    step = self.steps[step_id]
+                    step.threads = threads
+                    pending.remove(step_id)
+                    logging.gemtools.gt("Running step: %s (%d threads)" % (step.name, step.threads))
+                    (conn_recv, conn_send) = multiprocessing.Pipe(False)
+                    process = multiprocessing.Process(target=self.__run_step, args=(step, conn_send))
+                    process.start()
+                    conn_send.close()
+                    running[step_id] = (process, conn_recv, Timer())
+
+            if len(running) == 0:
+                if len(pending) > 0 and not error:
+                    logging.gemtools.error("Unable to resolve the dependencies of steps : %s",
+                                           ", ".join([self.steps[i].name for i in pending]))
+                    error = True
+                break
+
+            # wait for any step to finish
+            conns = [conn for (process, conn, t) in running.values()]
+            try:
+                (readable, w, x) = select.select(conns, [], [], 1.0)
+            except select.error:
+                continue  # interrupted by a signal
+            for step_id in running.keys():
+                if step_id not in running:
+                    continue
+                (process, conn, t) = running[step_id]
+                if conn not in readable and process.is_alive():
+                    continue
+                step = self.steps[step_id]
+                status = "Job step canceled"
+                cpu = 0
+                try:
+                    (status, cpu) = conn.recv()
+                except (EOFError, IOError):
+                    step.cleanup(force=True)
+                process.join()
+                conn.close()
+                del running[step_id]
+                chain = chains[chain_of[step_id]]
+                if not any(i in running for i in chain):
+                    active.discard(chain_of[step_id])
+                    free_threads += step.threads
+                t.stop(step.name + " completed in %s", loglevel=None)
+                self.step_times[step_id] = (t.end, datetime.timedelta(seconds=int(cpu)), step.threads)
+                if status is None:
+                    finished.add(step_id)
+                    logging.gemtools.gt("Step %s finished in : %s (cpu %s)", step.name, t.end, self.step_times[step_id][1])
+                else:
+                    error = True
+                    logging.gemtools.gt("Step %s failed after : %s", step.name, t.end)
+                    # the rest of the chain would block on its pipes
+                    for i in chain:
+                        if i in running:
+                            running[i][0].terminate()
+        return error
+
+    def __run_step(self, step, conn):
+        """Execute a single step (in its own process) and send back
+        the error (None on success) and the cpu seconds spent by the
+        step, including the processes it started
+        """
+        def cleanup_in_signal(signal, frame):
+            step.cleanup(force=True)
+            os._exit(1)
+
+        signal.signal(signal.SIGINT, cleanup_in_signal)
+        signal.signal(signal.SIGQUIT, cleanup_in_signal)
+        signal.signal(signal.SIGHUP, cleanup_in_signal)
+        signal.signal(signal.SIGTERM, cleanup_in_signal)
+
+        status = None
+        try:
+            step.run()
+        except KeyboardInterrupt:
+            logging.gemtools.warning("Job step canceled, forcing cleanup!")
+            status = "Job step canceled"
+        except (PipelineError, gem.utils.ProcessError), e:
+            logging.gemtools.error("Error while executing step %s : %s" % (step.name, str(e)))
+            status = str(e)
+        except Exception, e:
+            traceback.print_exc()
+            logging.gemtools.error("Error while executing step %s : %s" % (step.name, str(e)))
+            status = str(e)
+        if status is not None:
+            logging.gemtools.warning("Cleaning up after failed step : %s", step.name)
+            step.cleanup(force=True)
+        cpu = 0
+        for who in [resource.RUSAGE_SELF, resource.RUSAGE_CHILDREN]:
+            usage = resource.getrusage(who)
+            cpu += usage.ru_utime + usage.ru_stime
+        conn.send((status, cpu))
+        conn.close()
+
     def cleanup(self):
         """Delete all remaining temporary and intermediate files
         """
@@ -1720,6 +1911,11 @@ index generated from your annotation.""")
         execution_group.add_argument('--run', dest="run_steps", type=int, default=None, nargs="+", metavar="cfg", help="Run given pipeline steps idenfified by the step id")
         execution_group.add_argument('--force', dest="force", default=None, action="store_true", help="Force running all steps and skip checking for completed steps")
         execution_group.add_argument('-t', '--threads', dest="threads", metavar="threads", type=int, help="Number of threads to use. Default %d" % self.threads)
+        execution_group.add_argument('--stream', dest="stream", action="store_true", default=None, help="""Connect linear chains of steps (i.e. map -> merge)
+            through named pipes. The steps of a chain run concurrently and their intermediate outputs never touch the disk.
+            Ignored together with --keep-temp""")
+        execution_group.add_argument('--parallel-steps', dest="parallel_steps", metavar="steps", type=int, help="""Maximum number of independent steps running concurrently. The steps
+            share the --threads budget. Use 1 to run the steps one after another. Default %d (no limit)""" % self.parallel_steps)
 
     def register_mapping(self, parser):
         """Register the genome mapping parameters with the
@@ -13,10 +13,17 @@ cdef extern from "stdint.h":
     ctypedef int uint64_t
     ctypedef int int64_t
     ctypedef int uint32_t
+    ctypedef int uint8_t
     cdef uint64_t UINT64_MAX
     cdef int64_t INT64_MAX
     cdef int64_t INT64_MIN
 
+cdef extern from "pthread.h" nogil:
+    ctypedef struct pthread_mutex_t:
+        pass
+    int pthread_mutex_init(pthread_mutex_t* mutex, void* attr)
+    int pthread_mutex_destroy(pthread_mutex_t* mutex)
+
 cdef extern from "Python.h":
     ctypedef struct FILE
     ctypedef struct PyObject:
@@ -132,6 +139,7 @@ cdef extern from "gem_tools.h" nogil:
 
 
     gt_generic_parser_attributes* gt_input_generic_parser_attributes_new(bool  paired_read)
+    void gt_input_generic_parser_attributes_delete(gt_generic_parser_attributes* attributes)
     void gt_input_generic_parser_attributes_reset_defaults(gt_generic_parser_attributes*  attributes)
     void gt_input_generic_parser_attributes_set_defaults(gt_generic_parser_attributes*  attributes)
     bool gt_input_generic_parser_attributes_is_paired(gt_generic_parser_attributes*  attributes)
@@ -140,6 +148,7 @@ cdef extern from "gem_tools.h" nogil:
 
     gt_status gt_input_generic_parser_get_alignment(gt_buffered_input_file* buffered_input,gt_alignment* alignment, gt_generic_parser_attributes* attributes)
     gt_status gt_input_generic_parser_get_template(gt_buffered_input_file* buffered_input,gt_template* template,gt_generic_parser_attributes* attributes)
+    gt_status gt_input_generic_parser_get_paired_template(gt_buffered_input_file* buffered_input_end1, gt_buffered_input_file* buffered_input_end2, pthread_mutex_t* input_mutex, gt_template* template, gt_generic_parser_attributes* attributes)
 
     ## map template parser
     gt_status gt_input_map_parse_template(char* string, gt_template* template)
@@ -239,6 +248,10 @@ cdef extern from "gem_tools.h" nogil:
     # template merge
     cdef gt_template* gt_template_union_template_mmaps(gt_template* src_A, gt_template* src_B)
 
+    # contig dictionary
+    gt_string* gt_contig_dictionary_get_name(uint32_t contig_id)
+    uint64_t gt_contig_dictionary_get_num_contigs()
+
 
     # output printer support
     enum gt_file_fasta_format:
@@ -301,4 +314,42 @@ cdef extern from "gem_tools.h" nogil:
 
 
 cdef extern from "gemtools_binding.h" nogil:
-    void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores)
\ No newline at end of file
+    # native template filters
+    ctypedef enum gt_template_predicate_t:
+        GT_PREDICATE_UNMAPPED
+        GT_PREDICATE_UNIQUE
+        GT_PREDICATE_TRIM
+    ctypedef struct gt_template_predicate:
+        gt_template_predicate_t type
+        uint64_t max_mismatches
+        uint64_t level
+        uint64_t left
+        uint64_t right
+
+    void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores,
+                         gt_template_predicate* predicates, uint64_t num_predicates)
+    void gt_write_stream_paired(gt_output_file* output, gt_input_file* input_end1, gt_input_file* input_end2, bool append_extra, bool clean_id, uint64_t threads, bool write_map, bool remove_scores,
+                                gt_template_predicate* predicates, uint64_t num_predicates)
+
+    # columnar template batches
+    cdef uint32_t GT_BATCH_NO_SEQ_ID
+    cdef uint8_t GT_BATCH_NO_STRAND
+    cdef uint8_t GT_BATCH_NO_MAPQ
+    ctypedef struct gt_template_batch:
+        uint64_t num_templates
+        uint64_t num_mmaps
+        uint64_t num_counters
+        uint8_t* num_blocks
+        uint64_t* mcs
+        uint64_t* mmap_offsets
+        uint64_t* counter_offsets
+        uint64_t* counters
+        uint64_t* distance
+        uint64_t* score
+        uint8_t* mapq
+        uint32_t* seq_id
+        uint64_t* position
+        uint8_t* strand
+    gt_template_batch* gt_template_batch_new(uint64_t max_templates)
+    void gt_template_batch_delete(gt_template_batch* batch)
+    uint64_t gt_template_batch_fill(gt_template_batch* batch, gt_buffered_input_file* buffered_input, gt_template* template, gt_generic_parser_attributes* attributes)
@@ -21,6 +21,12 @@ cdef class TemplateFilter(object):
         """
         return True
 
+    cdef bool _lower(self, gt_template_predicate* predicate):
+        """Fill the native predicate equivalent to this filter.
+        Returns false if there is none
+        """
+        return False
+
 
 cdef class filter_unmapped(TemplateFilter):
     """Filter for unmapped reads or reads with mismatches >= max_mismatches"""
@@ -39,6 +45,11 @@ cdef class filter_unmapped(TemplateFilter):
     cpdef bool filter(self, Template template):
         return template.is_unmapped(self.max_mismatches)
 
+    cdef bool _lower(self, gt_template_predicate* predicate):
+        predicate.type = GT_PREDICATE_UNMAPPED
+        predicate.max_mismatches = self.max_mismatches
+        return True
+
 cdef class filter_unique(TemplateFilter):
     """Filter for unique mappings up to given uniqueness level
     """
@@ -52,6 +63,11 @@ cdef class filter_unique(TemplateFilter):
         template_level = template.level(self.level)
         return template_level > 0 and template_level >= self.level
 
+    cdef bool _lower(self, gt_template_predicate* predicate):
+        predicate.type = GT_PREDICATE_UNIQUE
+        predicate.level = self.level
+        return True
+
 
 cdef class filter_trim(TemplateFilter):
     """Trimming filter that always returns true, but trims the
@@ -73,6 +89,33 @@ cdef class filter_trim(TemplateFilter):
         #gt_template_trim(template.template, self.left, self.right, self.min_length, self.set_extra)
         return True
 
+    cdef bool _lower(self, gt_template_predicate* predicate):
+        predicate.type = GT_PREDICATE_TRIM
+        predicate.left = self.left
+        predicate.right = self.right
+        return True
+
+
+cdef class TemplatePredicates(object):
+    """Native predicate list lowered from a chain of TemplateFilters.
+    The predicates run inside the (multi-threaded) writer of the source
+    with the GIL released (see filter.write_stream())
+    """
+    cdef gt_template_predicate* predicates
+    cdef uint64_t num_predicates
+
+    def __cinit__(self, filters):
+        cdef TemplateFilter f
+        self.num_predicates = 0
+        self.predicates = <gt_template_predicate*> malloc(max(1, len(filters)) * sizeof(gt_template_predicate))
+        for f in filters:
+            if not f._lower(&self.predicates[self.num_predicates]):
+                raise ValueError("Filter %s has no native predicate" % str(f))
+            self.num_predicates += 1
+
+    def __dealloc__(self):
+        free(self.predicates)
+
 cpdef unmapped(source, int64_t max_mismatches=GT_ALL):
     """Wrapper function that creates a filtered iterator"""
     return filter(source, filter_unmapped(max_mismatches))
@@ -119,10 +162,29 @@ cdef class filter(object):
     cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1):
         """Write the content of this filter to the output file.
 
+        If the chain of filters down to the source consists of the native
+        filters only (filter_unmapped, filter_unique, filter_trim, but not
+        subclasses) and the source is an InputFile, interleave, cat or paired
+        iterator, the chain is lowered to native predicates that run in the
+        multi-threaded writer of the source. Otherwise the templates are
+        filtered and written one by one.
+
         output   -- the output file
         write_map     -- if true, write map, otherwise write fasta/q sequence
         threads       -- number of threads to use (if supported by the iterator)
         """
+        source = self
+        filters = []
+        while isinstance(source, filter):
+            filters[:0] = (<filter> source).template_filter
+            source = (<filter> source).source
+        native = isinstance(source, (InputFile, interleave, paired))
+        for f in filters:
+            if type(f) not in (filter_unmapped, filter_unique, filter_trim):
+                native = False
+        if native:
+            source.write_stream(output, write_map=write_map, threads=threads, predicates=TemplatePredicates(filters))
+            return
         for t in self:
             output.write(t, write_map=write_map)
 
@@ -178,14 +240,15 @@ cdef class interleave(object):
                     if mises >= self.length or self.i >= self.length:
                         raise StopIteration()
 
-    cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1):
+    cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1, TemplatePredicates predicates=None):
         """Write the content interleaved to the output file
 
         output_file   -- the output file
         write_map     -- if true, write map, otherwise write fasta/q sequence
         threads       -- number of threads to use (if supported by the iterator)
+        predicates    -- optional native filters applied to the templates
         """
-        __run_write_stream(self.files, output, write_map, max(threads, self.threads), self.interleave, None)
+        __run_write_stream(self.files, output, write_map, max(threads, self.threads), self.interleave, None, predicates=predicates)
 
     cpdef close(self):
         try:
@@ -202,6 +265,84 @@ cdef class cat(interleave):
         interleave.__init__(self, files, interleave=False, threads=threads)
 
 
+cdef class paired(object):
+    """Paired iterator over templates from two input files, the first
+    holding end/1 and the second end/2 of every read. Both files are read
+    in synchronized blocks and each template carries both ends.
+    """
+    # the input files
+    cdef object files
+    # number of threads
+    cdef int64_t threads
+    # the source input files and buffers
+    cdef gt_input_file* input_end1
+    cdef gt_input_file* input_end2
+    cdef gt_buffered_input_file* buffered_input_end1
+    cdef gt_buffered_input_file* buffered_input_end2
+    cdef pthread_mutex_t input_mutex
+    # parser attributes
+    cdef gt_generic_parser_attributes* parser_attr
+    # the template instance that is used to iterate templates
+    cdef readonly Template template
+
+    def __init__(self, files, uint64_t threads=1):
+        if len(files) != 2:
+            raise ValueError("Paired iterator requires exactly two input files")
+        self.files = files
+        self.threads = threads
+        self.template = Template()
+        pthread_mutex_init(&self.input_mutex, NULL)
+
+    def __dealloc__(self):
+        self.close()
+        pthread_mutex_destroy(&self.input_mutex)
+
+    def __iter__(self):
+        self.input_end1 = (<InputFile> self.files[0])._open()
+        self.input_end2 = (<InputFile> self.files[1])._open()
+        self.buffered_input_end1 = gt_buffered_input_file_new(self.input_end1)
+        self.buffered_input_end2 = gt_buffered_input_file_new(self.input_end2)
+        self.parser_attr = gt_input_generic_parser_attributes_new(False)
+        return self
+
+    def __next__(self):
+        cdef gt_status s = gt_input_generic_parser_get_paired_template(self.buffered_input_end1, self.buffered_input_end2,
+                                                                       &self.input_mutex, self.template.template, self.parser_attr)
+        if s == GT_STATUS_OK:
+            return self.template
+        elif s == 0:
+            raise StopIteration()
+        else:
+            raise ValueError("Error parsing paired input files %s, %s" % (self.files[0].filename, self.files[1].filename))
+
+    cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1, TemplatePredicates predicates=None):
+        """Write the templates (both ends, one after the other) to the output file
+
+        output_file   -- the output file
+        write_map     -- if true, write map, otherwise write fasta/q sequence
+        threads       -- number of threads to use
+        predicates    -- optional native filters applied to the templates
+        """
+        __run_write_stream(self.files, output, write_map, max(threads, self.threads), True, None, function=__write_stream_paired, predicates=predicates)
+
+    cpdef close(self):
+        if self.buffered_input_end1 is not NULL:
+            gt_buffered_input_file_close(self.buffered_input_end1)
+            self.buffered_input_end1 = NULL
+        if self.buffered_input_end2 is not NULL:
+            gt_buffered_input_file_close(self.buffered_input_end2)
+            self.buffered_input_end2 = NULL
+        if self.parser_attr is not NULL:
+            gt_input_generic_parser_attributes_delete(self.parser_attr)
+            self.parser_attr = NULL
+        if self.input_end1 is not NULL:
+            gt_input_file_close(self.input_end1)
+            self.input_end1 = NULL
+        if self.input_end2 is not NULL:
+            gt_input_file_close(self.input_end2)
+            self.input_end2 = NULL
+
+
 cdef class OutputFile:
     """The OutputFile can write content to a file or
     or a stream.
@@ -434,7 +575,42 @@ cdef class InputFile(object):
                 self.process.wait()
         return s
 
-    cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1):
+    cpdef Batch next_batch(self, uint64_t size=65536):
+        """Parse the next (up to) size templates into a columnar Batch.
+        The templates are parsed in C with the GIL released and no
+        Template objects are created. Returns None at the end of the input.
+        """
+        cdef gt_template_batch* batch
+        cdef uint64_t num_templates
+        cdef gt_buffered_input_file* buffered_input
+        cdef gt_template* template
+        cdef gt_generic_parser_attributes* parser_attr
+        if self.buffered_input is NULL:
+            iter(self)
+        buffered_input = self.buffered_input
+        template = self.template.template
+        parser_attr = self.parser_attr
+        batch = gt_template_batch_new(size)
+        with nogil:
+            num_templates = gt_template_batch_fill(batch, buffered_input, template, parser_attr)
+        if num_templates == 0:
+            gt_template_batch_delete(batch)
+            if self.process is not None:
+                # if this is a stream based process, make sure we clean up
+                self.process.wait()
+            return None
+        return _create_batch(batch)
+
+    def batches(self, uint64_t size=65536):
+        """Iterate the input in columnar batches of up to size templates
+        (see next_batch())
+        """
+        batch = self.next_batch(size)
+        while batch is not None:
+            yield batch
+            batch = self.next_batch(size)
+
+    cpdef write_stream(self, OutputFile output, bool write_map=False, uint64_t threads=1, TemplatePredicates predicates=None):
         """Write the content of this input stream to the output file
         file.
 
@@ -442,8 +618,9 @@ cdef class InputFile(object):
         write_map     -- if true, write map, otherwise write fasta/q sequence
         interleave    -- interleave muliple inputs
         threads       -- number of threads to use (if supported by the iterator)
+        predicates    -- optional native filters applied to the templates
         """
-        __run_write_stream([self], output, write_map, threads, True, self.process, remove_scores=self.remove_scores)
+        __run_write_stream([self], output, write_map, threads, True, self.process, remove_scores=self.remove_scores, predicates=predicates)
 
     cpdef close(self):
         if self.buffered_input is not NULL:
@@ -457,9 +634,9 @@ cdef class InputFile(object):
             self.input_file = NULL
 
 
-cpdef __run_write_stream(source, OutputFile output, bool write_map=False, uint64_t threads=1, bool interleave=True, parent=None, function=__write_stream, bool async=False, bool remove_scores=False):
+cpdef __run_write_stream(source, OutputFile output, bool write_map=False, uint64_t threads=1, bool interleave=True, parent=None, function=__write_stream, bool async=False, bool remove_scores=False, TemplatePredicates predicates=None):
     import gem.utils
-    process = multiprocessing.Process(target=function, args=(source, output, write_map, threads, interleave, remove_scores))
+    process = multiprocessing.Process(target=function, args=(source, output, write_map, threads, interleave, remove_scores, predicates))
     gem.utils.register_process(process)
     process.start()
 
@@ -469,19 +646,25 @@ cpdef __run_write_stream(source, OutputFile output, bool write_map=False, uint64
             parent.wait()
     return process
 
-cpdef __write_stream(source, OutputFile output, bool write_map=False, uint64_t threads=1, bool interleave=True, bool remove_scores=False):
+cpdef __write_stream(source, OutputFile output, bool write_map=False, uint64_t threads=1, bool interleave=True, bool remove_scores=False, TemplatePredicates predicates=None):
     cdef gt_output_file* output_file = output.output_file
     cdef uint64_t num_inputs = len(source)
     cdef gt_input_file** inputs = <gt_input_file**>malloc( num_inputs *sizeof(gt_input_file*))
     cdef bool clean_id = output.clean_id
     cdef bool append_extra = output.append_extra
     cdef uint64_t use_threads = threads
+    cdef gt_template_predicate* native_predicates = NULL
+    cdef uint64_t num_predicates = 0
+    if predicates is not None:
+        native_predicates = predicates.predicates
+        num_predicates = predicates.num_predicates
 
     for i in range(num_inputs):
         inputs[i] = (<InputFile> source[i])._open()
 
     with nogil:
-        gt_write_stream(output_file, inputs, num_inputs, append_extra, clean_id, interleave, use_threads, write_map, remove_scores)
+        gt_write_stream(output_file, inputs, num_inputs, append_extra, clean_id, interleave, use_threads, write_map, remove_scores,
+                        native_predicates, num_predicates)
 
     output.close()
     for i in range(num_inputs):
@@ -489,6 +672,174 @@ cpdef __write_stream(source, OutputFile output, bool write_map=False, uint64_t t
     free(inputs)
 
 
+cpdef __write_stream_paired(source, OutputFile output, bool write_map=False, uint64_t threads=1, bool interleave=True, bool remove_scores=False, TemplatePredicates predicates=None):
+    cdef gt_output_file* output_file = output.output_file
+    cdef gt_input_file* input_end1 = (<InputFile> source[0])._open()
+    cdef gt_input_file* input_end2 = (<InputFile> source[1])._open()
+    cdef bool clean_id = output.clean_id
+    cdef bool append_extra = output.append_extra
+    cdef uint64_t use_threads = threads
+    cdef gt_template_predicate* native_predicates = NULL
+    cdef uint64_t num_predicates = 0
+    if predicates is not None:
+        native_predicates = predicates.predicates
+        num_predicates = predicates.num_predicates
+
+    with nogil:
+        gt_write_stream_paired(output_file, input_end1, input_end2, append_extra, clean_id, use_threads, write_map, remove_scores,
+                               native_predicates, num_predicates)
+
+    output.close()
+    gt_input_file_close(input_end1)
+    gt_input_file_close(input_end2)
+
+
+# missing values in the batch columns
+BATCH_NO_SEQ_ID = GT_BATCH_NO_SEQ_ID
+BATCH_NO_STRAND = GT_BATCH_NO_STRAND
+BATCH_NO_MAPQ = GT_BATCH_NO_MAPQ
+
+cpdef contig_name(uint32_t seq_id):
+    """Return the name of the contig with the given
+    id (i.e. the Batch seq_id column)
+    """
+    cdef gt_string* name
+    cdef char* chars
+    if seq_id >= gt_contig_dictionary_get_num_contigs():
+        raise ValueError("Unknown contig id %d" % seq_id)
+    name = gt_contig_dictionary_get_name(seq_id)
+    chars = gt_string_get_string(name)
+    return chars[:gt_string_get_length(name)]
+
+
+cdef Column _create_column(void* data, Py_ssize_t rows, int ndim, Py_ssize_t itemsize, char* format):
+    cdef Column column = Column()
+    column.data = data
+    column.format = format
+    column.ndim = ndim
+    column.itemsize = itemsize
+    column.shape[0] = rows
+    column.shape[1] = 2
+    column.strides[0] = itemsize * (2 if ndim == 2 else 1)
+    column.strides[1] = itemsize
+    return column
+
+
+cdef class Column:
+    """Contiguous typed column of a Batch. Columns implement the
+    buffer protocol, use numpy.asarray(column) or memoryview(column)
+    to access the values without copying them. Indexing returns
+    single values, or (end1, end2) tuples for the ends columns.
+    """
+    cdef void* data
+    cdef char* format
+    cdef int ndim
+    cdef Py_ssize_t itemsize
+    cdef Py_ssize_t shape[2]
+    cdef Py_ssize_t strides[2]
+
+    def __dealloc__(self):
+        free(self.data)
+
+    def __len__(self):
+        return self.shape[0]
+
+    def __getitem__(self, Py_ssize_t i):
+        if i < 0:
+            i += self.shape[0]
+        if i < 0 or i >= self.shape[0]:
+            raise IndexError("Column index out of range")
+        if self.ndim == 1:
+            return self._get(i)
+        return (self._get(2*i), self._get(2*i+1))
+
+    cdef object _get(self, Py_ssize_t i):
+        if self.itemsize == sizeof(uint8_t):
+            return (<uint8_t*> self.data)[i]
+        elif self.itemsize == sizeof(uint32_t):
+            return (<uint32_t*> self.data)[i]
+        return (<uint64_t*> self.data)[i]
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        buffer.buf = self.data
+        buffer.obj = self
+        buffer.len = self.shape[0] * self.strides[0]
+        buffer.readonly = 0
+        buffer.itemsize = self.itemsize
+        buffer.format = self.format
+        buffer.ndim = self.ndim
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        pass
+
+
+cdef Batch _create_batch(gt_template_batch* batch):
+    """Wrap the batch columns, the Batch takes them over"""
+    cdef Batch b = Batch()
+    b.num_templates = batch.num_templates
+    b.num_maps = batch.num_mmaps
+    b.blocks = _create_column(batch.num_blocks, batch.num_templates, 1, sizeof(uint8_t), "B")
+    b.mcs = _create_column(batch.mcs, batch.num_templates, 1, sizeof(uint64_t), "Q")
+    b.map_offsets = _create_column(batch.mmap_offsets, batch.num_templates+1, 1, sizeof(uint64_t), "Q")
+    b.counter_offsets = _create_column(batch.counter_offsets, batch.num_templates+1, 1, sizeof(uint64_t), "Q")
+    b.counters = _create_column(batch.counters, batch.num_counters, 1, sizeof(uint64_t), "Q")
+    b.distance = _create_column(batch.distance, batch.num_mmaps, 1, sizeof(uint64_t), "Q")
+    b.score = _create_column(batch.score, batch.num_mmaps, 1, sizeof(uint64_t), "Q")
+    b.mapq = _create_column(batch.mapq, batch.num_mmaps, 1, sizeof(uint8_t), "B")
+    b.seq_id = _create_column(batch.seq_id, batch.num_mmaps, 2, sizeof(uint32_t), "I")
+    b.position = _create_column(batch.position, batch.num_mmaps, 2, sizeof(uint64_t), "Q")
+    b.strand = _create_column(batch.strand, batch.num_mmaps, 2, sizeof(uint8_t), "B")
+    batch.num_blocks = NULL
+    batch.mcs = NULL
+    batch.mmap_offsets = NULL
+    batch.counter_offsets = NULL
+    batch.counters = NULL
+    batch.distance = NULL
+    batch.score = NULL
+    batch.mapq = NULL
+    batch.seq_id = NULL
+    batch.position = NULL
+    batch.strand = NULL
+    gt_template_batch_delete(batch)
+    return b
+
+
+cdef class Batch:
+    """Columnar batch of templates (see InputFile.batches()).
+
+    Template columns (one row per template):
+        blocks, mcs
+        map_offsets, counter_offsets -- num_templates+1 rows, the maps and
+            counters of template i are in [offsets[i], offsets[i+1])
+    Counter column: counters
+    Map columns (one row per map, pairs for paired templates):
+        distance, score, mapq
+    Ends columns (one (end1, end2) row per map):
+        seq_id (see contig_name()), position, strand
+        Missing ends are BATCH_NO_SEQ_ID, 0 and BATCH_NO_STRAND
+    """
+    cdef readonly uint64_t num_templates
+    cdef readonly uint64_t num_maps
+    cdef readonly Column blocks
+    cdef readonly Column mcs
+    cdef readonly Column map_offsets
+    cdef readonly Column counter_offsets
+    cdef readonly Column counters
+    cdef readonly Column distance
+    cdef readonly Column score
+    cdef readonly Column mapq
+    cdef readonly Column seq_id
+    cdef readonly Column position
+    cdef readonly Column strand
+
+    def __len__(self):
+        return self.num_templates
+
+
 cdef _create_alignment(gt_alignment* ali):
     a = Alignment(initialize=False)
     a.alignment = ali
@@ -10,7 +10,50 @@ bool gt_input_file_has_qualities(gt_input_file* file){
 }
 
 
-void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores){
+int64_t gt_template_uniqueness_level(gt_template* template, uint64_t max_level){
+  // Same as Template.level()
+  const uint64_t num_counters = gt_template_get_num_counters(template);
+  register uint64_t i, j;
+  int64_t level = 0;
+  for(i=0; i<num_counters; i++){
+    const uint64_t counter = gt_template_get_counter(template, i);
+    if(counter == 1){
+      for(j=i+1; j<num_counters; j++){
+        if(level >= (int64_t)max_level) return level;
+        if(gt_template_get_counter(template, j) > 0) return j-(i+1);
+        level++;
+      }
+      return num_counters-(i+1);
+    }else if(counter > 1){
+      return -1;
+    }
+  }
+  return -1;
+}
+
+bool gt_template_predicates_pass(gt_template* template, gt_template_predicate* predicates, uint64_t num_predicates){
+  register uint64_t i = 0;
+  for(i=0; i<num_predicates; i++){
+    gt_template_predicate* const predicate = predicates+i;
+    switch(predicate->type){
+      case GT_PREDICATE_UNMAPPED:
+        if(gt_template_is_thresholded_mapped(template, predicate->max_mismatches)) return false;
+        break;
+      case GT_PREDICATE_UNIQUE: {
+        const int64_t level = gt_template_uniqueness_level(template, predicate->level);
+        if(level <= 0 || level < (int64_t)predicate->level) return false;
+        break;
+      }
+      case GT_PREDICATE_TRIM:
+        gt_template_hard_trim(template, predicate->left, predicate->right);
+        break;
+    }
+  }
+  return true;
+}
+
+void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores,
+    gt_template_predicate* predicates, uint64_t num_predicates){
   // prepare attributes
 
   gt_output_fasta_attributes* attributes = 0;
@@ -56,6 +99,7 @@ void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t nu
       while( gt_input_generic_parser_synch_blocks_a(&input_mutex, buffered_input, num_inputs, parser_attributes) == GT_STATUS_OK ){
         for(i=0; i<num_inputs; i++){
           if( (status = gt_input_generic_parser_get_template(buffered_input[i], template, parser_attributes)) == GT_STATUS_OK){
+            if(!gt_template_predicates_pass(template, predicates, num_predicates)) continue;
             if(write_map){
               gt_output_map_bofprint_template(buffered_output, template, map_attributes);
             }else{
@@ -98,6 +142,7 @@ void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t nu
         // read
         while( gt_input_generic_parser_synch_blocks_a(&input_mutex, buffered_input, 1, parser_attributes) == GT_STATUS_OK ){
           if( (status = gt_input_generic_parser_get_template(current_input, template, parser_attributes)) == GT_STATUS_OK){
+            if(!gt_template_predicates_pass(template, predicates, num_predicates)) continue;
             if(write_map){
               gt_output_map_bofprint_template(buffered_output, template, map_attributes);
             }else{
@@ -124,4 +169,167 @@ void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t nu
   //     gt_input_file_close(inputs[i]);
   // }
   // gt_output_file_close(output);
-}
\ No newline at end of file
+}
+
+void gt_write_stream_paired(gt_output_file* output, gt_input_file* input_end1, gt_input_file* input_end2, bool append_extra, bool clean_id, uint64_t threads, bool write_map, bool remove_scores,
+    gt_template_predicate* predicates, uint64_t num_predicates){
+  // prepare attributes
+  gt_output_fasta_attributes* attributes = 0;
+  gt_output_map_attributes* map_attributes = 0;
+  if(!write_map){
+    attributes = gt_output_fasta_attributes_new();
+    gt_output_fasta_attributes_set_print_extra(attributes, append_extra);
+    gt_output_fasta_attributes_set_print_casava(attributes, !clean_id);
+    // check qualities
+    if(!gt_input_file_has_qualities(input_end1)){
+      gt_output_fasta_attributes_set_format(attributes, F_FASTA);
+    }
+  }else{
+    map_attributes = gt_output_map_attributes_new();
+    gt_output_map_attributes_set_print_extra(map_attributes, append_extra);
+    gt_output_map_attributes_set_print_casava(map_attributes, !clean_id);
+    gt_output_map_attributes_set_print_scores(map_attributes, !remove_scores);
+  }
+
+  // generic parser attributes, each file holds single end records
+  gt_generic_parser_attributes* parser_attributes = gt_input_generic_parser_attributes_new(false);
+  pthread_mutex_t input_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+  // main loop, each thread reads synchronized blocks from both files
+  #pragma omp parallel num_threads(threads)
+  {
+    gt_buffered_output_file* buffered_output = gt_buffered_output_file_new(output);
+    gt_buffered_input_file* buffered_input_end1 = gt_buffered_input_file_new(input_end1);
+    gt_buffered_input_file* buffered_input_end2 = gt_buffered_input_file_new(input_end2);
+    // attache first input to output
+    gt_buffered_input_file_attach_buffered_output(buffered_input_end1, buffered_output);
+
+    gt_template* template = gt_template_new();
+    gt_status status;
+    while( (status = gt_input_generic_parser_get_paired_template(buffered_input_end1, buffered_input_end2, &input_mutex, template, parser_attributes)) ){
+      if(status != GT_STATUS_OK){
+        gt_error_msg("Error parsing paired files '%s','%s' (line %"PRIu64")", input_end1->file_name, input_end2->file_name, buffered_input_end1->current_line_num-1);
+        continue;
+      }
+      if(!gt_template_predicates_pass(template, predicates, num_predicates)) continue;
+      if(write_map){
+        gt_output_map_bofprint_template(buffered_output, template, map_attributes);
+      }else{
+        gt_output_fasta_bofprint_template(buffered_output, template, attributes);
+      }
+    }
+    gt_buffered_output_file_close(buffered_output);
+    gt_buffered_input_file_close(buffered_input_end1);
+    gt_buffered_input_file_close(buffered_input_end2);
+    gt_template_delete(template);
+  }
+  if(attributes != NULL) gt_output_fasta_attributes_delete(attributes);
+  if(map_attributes != NULL)gt_output_map_attributes_delete(map_attributes);
+  gt_input_generic_parser_attributes_delete(parser_attributes);
+}
+
+gt_template_batch* gt_template_batch_new(uint64_t max_templates){
+  gt_template_batch* batch = malloc(sizeof(gt_template_batch));
+  if(max_templates == 0) max_templates = 1;
+  batch->num_templates = 0;
+  batch->num_mmaps = 0;
+  batch->num_counters = 0;
+  batch->max_templates = max_templates;
+  batch->max_mmaps = 2*max_templates;
+  batch->max_counters = 4*max_templates;
+  // template columns
+  batch->num_blocks = malloc(max_templates * sizeof(uint8_t));
+  batch->mcs = malloc(max_templates * sizeof(uint64_t));
+  batch->mmap_offsets = malloc((max_templates+1) * sizeof(uint64_t));
+  batch->counter_offsets = malloc((max_templates+1) * sizeof(uint64_t));
+  batch->counters = malloc(batch->max_counters * sizeof(uint64_t));
+  batch->mmap_offsets[0] = 0;
+  batch->counter_offsets[0] = 0;
+  // mmap columns
+  batch->distance = malloc(batch->max_mmaps * sizeof(uint64_t));
+  batch->score = malloc(batch->max_mmaps * sizeof(uint64_t));
+  batch->mapq = malloc(batch->max_mmaps * sizeof(uint8_t));
+  batch->seq_id = malloc(2 * batch->max_mmaps * sizeof(uint32_t));
+  batch->position = malloc(2 * batch->max_mmaps * sizeof(uint64_t));
+  batch->strand = malloc(2 * batch->max_mmaps * sizeof(uint8_t));
+  return batch;
+}
+
+void gt_template_batch_delete(gt_template_batch* batch){
+  // free(NULL) is a no-op, taken columns are NULL
+  free(batch->num_blocks);
+  free(batch->mcs);
+  free(batch->mmap_offsets);
+  free(batch->counter_offsets);
+  free(batch->counters);
+  free(batch->distance);
+  free(batch->score);
+  free(batch->mapq);
+  free(batch->seq_id);
+  free(batch->position);
+  free(batch->strand);
+  free(batch);
+}
+
+void gt_template_batch_add(gt_template_batch* batch, gt_template* template){
+  register uint64_t i = 0;
+  const uint64_t t = batch->num_templates;
+  const uint64_t num_blocks = gt_template_get_num_blocks(template);
+  const uint64_t num_counters = gt_template_get_num_counters(template);
+  const uint64_t num_mmaps = gt_template_get_num_mmaps(template);
+  // reserve
+  if(batch->num_counters + num_counters > batch->max_counters){
+    batch->max_counters = 2*(batch->num_counters + num_counters);
+    batch->counters = realloc(batch->counters, batch->max_counters * sizeof(uint64_t));
+  }
+  if(batch->num_mmaps + num_mmaps > batch->max_mmaps){
+    batch->max_mmaps = 2*(batch->num_mmaps + num_mmaps);
+    batch->distance = realloc(batch->distance, batch->max_mmaps * sizeof(uint64_t));
+    batch->score = realloc(batch->score, batch->max_mmaps * sizeof(uint64_t));
+    batch->mapq = realloc(batch->mapq, batch->max_mmaps * sizeof(uint8_t));
+    batch->seq_id = realloc(batch->seq_id, 2 * batch->max_mmaps * sizeof(uint32_t));
+    batch->position = realloc(batch->position, 2 * batch->max_mmaps * sizeof(uint64_t));
+    batch->strand = realloc(batch->strand, 2 * batch->max_mmaps * sizeof(uint8_t));
+  }
+  // template columns
+  batch->num_blocks[t] = num_blocks;
+  batch->mcs[t] = gt_template_get_mcs(template);
+  for(i=0; i<num_counters; i++){
+    batch->counters[batch->num_counters++] = gt_template_get_counter(template, i);
+  }
+  // mmap columns (single-end templates take the attributes from the map itself)
+  GT_TEMPLATE_ITERATE_MMAP__ATTR_(template, mmap, mmap_attributes){
+    const uint64_t m = batch->num_mmaps++;
+    if(mmap_attributes != NULL){
+      batch->distance[m] = mmap_attributes->distance;
+      batch->score[m] = mmap_attributes->gt_score;
+    }else{
+      batch->distance[m] = gt_map_get_global_distance(mmap[0]);
+      batch->score[m] = mmap[0]->gt_score;
+    }
+    batch->mapq[m] = (batch->score[m] == GT_MAP_NO_GT_SCORE) ? GT_BATCH_NO_MAPQ : get_mapq(batch->score[m]);
+    for(i=0; i<2; i++){
+      gt_map* const map = (i < num_blocks) ? mmap[i] : NULL;
+      if(map != NULL){
+        batch->seq_id[2*m+i] = gt_map_get_seq_id(map);
+        batch->position[2*m+i] = gt_map_get_position(map);
+        batch->strand[2*m+i] = gt_map_get_strand(map);
+      }else{
+        batch->seq_id[2*m+i] = GT_BATCH_NO_SEQ_ID;
+        batch->position[2*m+i] = 0;
+        batch->strand[2*m+i] = GT_BATCH_NO_STRAND;
+      }
+    }
+  }
+  batch->mmap_offsets[t+1] = batch->num_mmaps;
+  batch->counter_offsets[t+1] = batch->num_counters;
+  batch->num_templates++;
+}
+
+uint64_t gt_template_batch_fill(gt_template_batch* batch, gt_buffered_input_file* buffered_input, gt_template* template, gt_generic_parser_attributes* attributes){
+  while(batch->num_templates < batch->max_templates &&
+        gt_input_generic_parser_get_template(buffered_input, template, attributes) == GT_STATUS_OK){
+    gt_template_batch_add(batch, template);
+  }
+  return batch->num_templates;
+}
@@ -6,6 +6,69 @@
 
 #define get_mapq(score) ((int)floor((sqrt(score)/256.0)*255))
 
-void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores);
+/*
+ * Native template filters
+ *   Lowered version of the python TemplateFilter chains {filter_unmapped,filter_unique,filter_trim}.
+ *   Predicates are applied in order and the template passes if all of them pass (trim always
+ *   passes but modifies the template).
+ */
+typedef enum { GT_PREDICATE_UNMAPPED, GT_PREDICATE_UNIQUE, GT_PREDICATE_TRIM } gt_template_predicate_t;
+typedef struct {
+  gt_template_predicate_t type;
+  uint64_t max_mismatches; // GT_PREDICATE_UNMAPPED
+  uint64_t level;          // GT_PREDICATE_UNIQUE
+  uint64_t left;           // GT_PREDICATE_TRIM
+  uint64_t right;          // GT_PREDICATE_TRIM
+} gt_template_predicate;
+
+int64_t gt_template_uniqueness_level(gt_template* template, uint64_t max_level);
+bool gt_template_predicates_pass(gt_template* template, gt_template_predicate* predicates, uint64_t num_predicates);
+
+void gt_write_stream(gt_output_file* output, gt_input_file** inputs, uint64_t num_inputs, bool append_extra, bool clean_id, bool interleave, uint64_t threads, bool write_map, bool remove_scores,
+    gt_template_predicate* predicates, uint64_t num_predicates);
+void gt_write_stream_paired(gt_output_file* output, gt_input_file* input_end1, gt_input_file* input_end2, bool append_extra, bool clean_id, uint64_t threads, bool write_map, bool remove_scores,
+    gt_template_predicate* predicates, uint64_t num_predicates);
 bool gt_input_file_has_qualities(gt_input_file* file);
+
+/*
+ * Columnar batch of templates
+ *   Template columns have num_templates rows ({mmap,counter}_offsets have num_templates+1,
+ *   the mmaps/counters of template i are in [offsets[i],offsets[i+1]) ).
+ *   MMap columns have num_mmaps rows, the ends columns two values per row {end1,end2}.
+ *   Missing ends (single-end or unpaired) are GT_BATCH_NO_SEQ_ID/0/GT_BATCH_NO_STRAND.
+ *   Columns are malloc'ed; the owner of a column can take it and set it to NULL
+ *   before calling gt_template_batch_delete().
+ */
+#define GT_BATCH_NO_SEQ_ID UINT32_MAX
+#define GT_BATCH_NO_STRAND UINT8_MAX
+#define GT_BATCH_NO_MAPQ 255
+
+typedef struct {
+  uint64_t num_templates;
+  uint64_t num_mmaps;
+  uint64_t num_counters;
+  /* Template columns */
+  uint8_t* num_blocks;
+  uint64_t* mcs;
+  uint64_t* mmap_offsets;
+  uint64_t* counter_offsets;
+  uint64_t* counters;
+  /* MMap columns */
+  uint64_t* distance;
+  uint64_t* score;
+  uint8_t* mapq;
+  /* MMap ends columns */
+  uint32_t* seq_id;
+  uint64_t* position;
+  uint8_t* strand;
+  /* Allocated rows */
+  uint64_t max_templates;
+  uint64_t max_mmaps;
+  uint64_t max_counters;
+} gt_template_batch;
+
+gt_template_batch* gt_template_batch_new(uint64_t max_templates);
+void gt_template_batch_delete(gt_template_batch* batch);
+void gt_template_batch_add(gt_template_batch* batch, gt_template* template);
+uint64_t gt_template_batch_fill(gt_template_batch* batch, gt_buffered_input_file* buffered_input, gt_template* template, gt_generic_parser_attributes* attributes);
 #endif /* GEMTOOLS_BINDING_H */
@@ -120,6 +120,32 @@ def test_writing_input_file():
         assert len(lines) == 40
 
 
+@with_setup(setup_func, cleanup)
+def test_writing_native_filter_chain():
+    target = results_dir + "/write_native_filter.map"
+    out = gt.OutputFile(target)
+    infile = gt.InputFile(testfiles["bedconvert.map"])
+    gt.trim(gt.unique(infile, 2), left=10, right=10).write_stream(out, write_map=True, threads=2)
+    with open(target) as f:
+        lines = f.readlines()
+        assert len(lines) == 1
+        assert len(lines[0].split("\t")[1]) == 81
+
+
+@with_setup(setup_func, cleanup)
+def test_writing_python_filter_chain():
+    class filter_all(gt.TemplateFilter):
+        def filter(self, template):
+            return False
+    target = results_dir + "/write_python_filter.map"
+    out = gt.OutputFile(target)
+    infile = gt.InputFile(testfiles["bedconvert.map"])
+    gt.filter(gt.unique(infile, 2), filter_all()).write_stream(out, write_map=True)
+    out.close()
+    with open(target) as f:
+        assert len(f.readlines()) == 0
+
+
 @with_setup(setup_func, cleanup)
 def test_writing_interleaved_file():
     source1 = files.open(testfiles["reads_1.fastq"])
@@ -116,6 +116,34 @@ def test_template_merge():
     template_1.merge(template_2)
     assert template_1.to_map() == "A/1\tAAA\t###\t1\tchr1:+:50:3", "Not '%s'" % template_1.to_map()
 
+
+def test_template_batches():
+    templates = [(t.mcs, t.num_maps, [t.get_counter(i) for i in range(t.counters)])
+                 for t in gt.InputFile(testfiles["test.map"])]
+    batches = list(gt.InputFile(testfiles["test.map"]).batches(4))
+    assert [len(b) for b in batches] == [4, 4, 2], [len(b) for b in batches]
+    batch_templates = []
+    for b in batches:
+        for i in range(len(b)):
+            counters = [b.counters[j] for j in range(b.counter_offsets[i], b.counter_offsets[i + 1])]
+            batch_templates.append((b.mcs[i], b.map_offsets[i + 1] - b.map_offsets[i], counters))
+    assert batch_templates == templates, batch_templates
+    assert sum([b.num_maps for b in batches]) == 17
+
+
+def test_template_batch_map_columns():
+    batch = gt.InputFile(testfiles["test.map"]).next_batch()
+    assert len(batch) == 10
+    assert batch.blocks[0] == 1
+    assert gt.contig_name(batch.seq_id[0][0]) == "chr11", gt.contig_name(batch.seq_id[0][0])
+    assert batch.seq_id[0][1] == gt.BATCH_NO_SEQ_ID
+    assert batch.position[0] == (77597507, 0), batch.position[0]
+    assert batch.strand[0] == (0, gt.BATCH_NO_STRAND), batch.strand[0]
+    assert [batch.distance[i] for i in range(3)] == [1, 1, 2]
+    assert batch.mapq[0] == gt.BATCH_NO_MAPQ
+    # the columns are plain buffers
+    assert memoryview(batch.blocks).tobytes() == "\x01" * 10
+
 #
 #def test_template_counters_list():
 #    infile = gt.open_file(testfiles["paired_w_splitmap.map"])
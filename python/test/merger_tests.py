@@ -77,3 +77,15 @@ def test_file_merge_pairwise_same_content_big_sub():
                        threads=8, paired=True)
     num_reads = sum(1 for r in merged)
     assert num_reads == 20000
+
+
+@with_setup(setup_func, cleanup)
+def test_file_merge_multiple_slaves():
+    reads_1 = files.open(testfiles["20t.map.gz"])
+    reads_2 = files.open(testfiles["20t_sub.map.gz"])
+    reads_3 = files.open(testfiles["20t.map.gz"])
+    merged = gem.merge(reads_1, [reads_2, reads_3],
+                       output=results_dir + "/merge_result.map",
+                       threads=8, paired=True)
+    num_reads = sum(1 for r in merged)
+    assert num_reads == 20000